@@ -0,0 +1,316 @@
+
+#ifndef NOTSTD_ENUM_MAP_HXX
+#define NOTSTD_ENUM_MAP_HXX
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <notstd/utility.hxx>
+
+namespace notstd
+{
+/**
+ * @brief An associative container for a dense range of enumeration keys,
+ * storing one value slot per key in a fixed array and tracking which keys are
+ * present with a bitmask.
+ *
+ * Lookup is a bit test and an array index. Absent slots always hold a
+ * value-initialized value, so two maps compare equal exactly when their
+ * presence masks and slot arrays are equal, which is independent of the order
+ * entries were inserted in. Iteration visits present keys in ascending order.
+ *
+ * @tparam KeyT The enumeration key type.
+ * @tparam ValueT The mapped value type.
+ * @tparam KeyFirst The smallest key that can be held.
+ * @tparam KeyLast The largest key that can be held.
+ */
+template <typename KeyT, typename ValueT, KeyT KeyFirst, KeyT KeyLast>
+requires std::is_enum_v<KeyT>
+class enum_map
+{
+public:
+    using key_type = KeyT;
+    using mapped_type = ValueT;
+    using value_type = std::pair<KeyT, const ValueT&>;
+    using size_type = std::size_t;
+
+    static_assert(notstd::to_underlying(KeyFirst) <= notstd::to_underlying(KeyLast), "key range must not be empty");
+
+    /**
+     * @brief The number of key slots.
+     */
+    static constexpr size_type slot_count = static_cast<size_type>(notstd::to_underlying(KeyLast) - notstd::to_underlying(KeyFirst)) + 1;
+
+    static_assert(slot_count <= 64, "key range must span at most 64 keys");
+
+    /**
+     * @brief The type of the presence bitmask, the smallest that holds one bit
+     * per key slot.
+     */
+    using mask_type = std::conditional_t<(slot_count <= 32), uint32_t, uint64_t>;
+
+    /**
+     * @brief Iterator over the present entries, in ascending key order.
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = enum_map::value_type;
+        using reference = enum_map::value_type;
+
+        const_iterator() = default;
+
+        value_type
+        operator*() const noexcept
+        {
+            const auto slot = static_cast<size_type>(std::countr_zero(m_remaining));
+            return { to_key(slot), m_map->m_values[slot] };
+        }
+
+        const_iterator&
+        operator++() noexcept
+        {
+            m_remaining &= m_remaining - 1;
+            return *this;
+        }
+
+        const_iterator
+        operator++(int) noexcept
+        {
+            auto iterator = *this;
+            ++(*this);
+            return iterator;
+        }
+
+        bool
+        operator==(const const_iterator& other) const noexcept
+        {
+            return m_remaining == other.m_remaining;
+        }
+
+    private:
+        friend class enum_map;
+
+        const_iterator(const enum_map* map, mask_type remaining) noexcept :
+            m_map(map),
+            m_remaining(remaining)
+        {}
+
+        const enum_map* m_map{ nullptr };
+        mask_type m_remaining{ 0 };
+    };
+
+    enum_map() = default;
+
+    /**
+     * @brief Construct a new enum_map object holding the specified entries.
+     * Later entries replace earlier entries with the same key.
+     *
+     * @param entries The entries to insert.
+     */
+    enum_map(std::initializer_list<std::pair<KeyT, ValueT>> entries)
+    {
+        for (const auto& [key, value] : entries) {
+            insert_or_assign(key, value);
+        }
+    }
+
+    /**
+     * @brief Determine whether a value is present for the specified key.
+     *
+     * @param key The key to check.
+     * @return true If a value is present.
+     * @return false Otherwise.
+     */
+    constexpr bool
+    contains(KeyT key) const noexcept
+    {
+        const auto slot = to_slot(key);
+        return (slot < slot_count) && ((m_presence & bit(slot)) != 0);
+    }
+
+    /**
+     * @brief Get a pointer to the value for the specified key.
+     *
+     * @param key The key to look up.
+     * @return const ValueT* The value, or nullptr if not present.
+     */
+    constexpr const ValueT*
+    get(KeyT key) const noexcept
+    {
+        return contains(key) ? &m_values[to_slot(key)] : nullptr;
+    }
+
+    /**
+     * @brief Get the value for the specified key. Throws std::out_of_range if
+     * the key is not present.
+     *
+     * @param key The key to look up.
+     * @return const ValueT&
+     */
+    const ValueT&
+    at(KeyT key) const
+    {
+        if (!contains(key)) {
+            throw std::out_of_range("enum_map key not present");
+        }
+        return m_values[to_slot(key)];
+    }
+
+    /**
+     * @brief Get the value for the specified key, inserting a value-initialized
+     * value if it is not present. Throws std::out_of_range if the key is
+     * outside the range of the map.
+     *
+     * @param key The key to look up.
+     * @return ValueT&
+     */
+    ValueT&
+    operator[](KeyT key)
+    {
+        const auto slot = checked_slot(key);
+        m_presence |= bit(slot);
+        return m_values[slot];
+    }
+
+    /**
+     * @brief Set the value for the specified key. Throws std::out_of_range if
+     * the key is outside the range of the map.
+     *
+     * @param key The key to set.
+     * @param value The value to set.
+     * @return ValueT& The stored value.
+     */
+    template <typename ValueU>
+    ValueT&
+    insert_or_assign(KeyT key, ValueU&& value)
+    {
+        auto& slotValue = (*this)[key];
+        slotValue = std::forward<ValueU>(value);
+        return slotValue;
+    }
+
+    /**
+     * @brief Remove the value for the specified key, if present.
+     *
+     * @param key The key to remove.
+     * @return size_type The number of values removed.
+     */
+    size_type
+    erase(KeyT key)
+    {
+        if (!contains(key)) {
+            return 0;
+        }
+        const auto slot = to_slot(key);
+        m_presence &= ~bit(slot);
+        m_values[slot] = ValueT{};
+        return 1;
+    }
+
+    /**
+     * @brief Remove all values.
+     */
+    void
+    clear()
+    {
+        *this = enum_map{};
+    }
+
+    /**
+     * @brief Get the number of values present.
+     *
+     * @return size_type
+     */
+    constexpr size_type
+    size() const noexcept
+    {
+        return static_cast<size_type>(std::popcount(m_presence));
+    }
+
+    /**
+     * @brief Determine whether no values are present.
+     *
+     * @return true If the map is empty.
+     * @return false Otherwise.
+     */
+    constexpr bool
+    empty() const noexcept
+    {
+        return m_presence == 0;
+    }
+
+    /**
+     * @brief Get the presence bitmask, where bit i is set when the key
+     * KeyFirst + i is present.
+     *
+     * @return mask_type
+     */
+    constexpr mask_type
+    presence() const noexcept
+    {
+        return m_presence;
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return { this, m_presence };
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return { this, 0 };
+    }
+
+    bool
+    operator==(const enum_map&) const = default;
+
+private:
+    static constexpr mask_type
+    bit(size_type slot) noexcept
+    {
+        return static_cast<mask_type>(mask_type{ 1 } << slot);
+    }
+
+    static constexpr size_type
+    to_slot(KeyT key) noexcept
+    {
+        // Keys below KeyFirst wrap around to a slot beyond the range.
+        return static_cast<size_type>(notstd::to_underlying(key)) - static_cast<size_type>(notstd::to_underlying(KeyFirst));
+    }
+
+    static size_type
+    checked_slot(KeyT key)
+    {
+        const auto slot = to_slot(key);
+        if (slot >= slot_count) {
+            throw std::out_of_range("enum_map key out of range");
+        }
+        return slot;
+    }
+
+    static constexpr KeyT
+    to_key(size_type slot) noexcept
+    {
+        return static_cast<KeyT>(static_cast<size_type>(notstd::to_underlying(KeyFirst)) + slot);
+    }
+
+private:
+    mask_type m_presence{ 0 };
+    std::array<ValueT, slot_count> m_values{};
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_ENUM_MAP_HXX
@@ -0,0 +1,167 @@
+
+#ifndef NOT_STD_SEQLOCK_HXX
+#define NOT_STD_SEQLOCK_HXX
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace notstd
+{
+/**
+ * @brief Holds a value that many threads may read without blocking while
+ * others occasionally write it.
+ *
+ * Writers bump a sequence counter to an odd value, update the value, then
+ * bump the counter to the next even value. Readers copy the value and retry
+ * if the counter was odd or changed while copying. Readers therefore never
+ * block writers or each other, and only retry when they overlap a write.
+ *
+ * The value is stored as an array of atomic words so that the copies made
+ * by readers racing a writer are well-defined. Concurrent writers are
+ * serialized by the sequence counter, but the design favors a single writer.
+ *
+ * @tparam T The type of value held. This must be trivially copyable.
+ */
+template <typename T>
+class seqlock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock values must be trivially copyable");
+
+public:
+    /**
+     * @brief Construct a new seqlock object holding a value-initialized value.
+     */
+    seqlock() noexcept :
+        seqlock(T{})
+    {}
+
+    /**
+     * @brief Construct a new seqlock object holding the specified value.
+     *
+     * @param value The initial value.
+     */
+    explicit seqlock(const T& value) noexcept
+    {
+        write_words(value);
+    }
+
+    seqlock(const seqlock&) = delete;
+
+    seqlock&
+    operator=(const seqlock&) = delete;
+
+    /**
+     * @brief Get a consistent copy of the value.
+     *
+     * @return T
+     */
+    T
+    load() const noexcept
+    {
+        T value;
+        for (;;) {
+            const auto sequence = m_sequence.load(std::memory_order_acquire);
+            if ((sequence & 1U) != 0) {
+                continue;
+            }
+
+            read_words(value);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == sequence) {
+                return value;
+            }
+        }
+    }
+
+    /**
+     * @brief Replace the value.
+     *
+     * @param value The new value.
+     */
+    void
+    store(const T& value) noexcept
+    {
+        auto sequence = m_sequence.load(std::memory_order_relaxed);
+        for (;;) {
+            if ((sequence & 1U) != 0) {
+                sequence = m_sequence.load(std::memory_order_relaxed);
+            } else if (m_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+        write_words(value);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::size_t word_size = sizeof(uint64_t);
+    static constexpr std::size_t word_count = (sizeof(T) + word_size - 1) / word_size;
+
+    /**
+     * @brief Get the number of bytes of the value held in the specified word.
+     * Only the last word may be partially used.
+     *
+     * @param index The index of the word.
+     * @return constexpr std::size_t
+     */
+    static constexpr std::size_t
+    word_bytes(std::size_t index) noexcept
+    {
+        return (index + 1 < word_count) ? word_size : sizeof(T) - (index * word_size);
+    }
+
+    // The words are copied directly to and from the value, rather than
+    // through an intermediate array, to avoid store-forwarding stalls where
+    // the compiler would otherwise read back narrow stores with wider loads.
+    // The copies are expanded at compile-time since compilers do not unroll
+    // loops of atomic operations.
+
+    void
+    read_words(T& value) const noexcept
+    {
+        auto* bytes = reinterpret_cast<unsigned char*>(&value);
+        [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+            ((read_word<Index>(bytes)), ...);
+        }(std::make_index_sequence<word_count>{});
+    }
+
+    void
+    write_words(const T& value) noexcept
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+            ((write_word<Index>(bytes)), ...);
+        }(std::make_index_sequence<word_count>{});
+    }
+
+    template <std::size_t Index>
+    void
+    read_word(unsigned char* bytes) const noexcept
+    {
+        const auto word = m_words[Index].load(std::memory_order_relaxed);
+        std::memcpy(bytes + (Index * word_size), &word, word_bytes(Index));
+    }
+
+    template <std::size_t Index>
+    void
+    write_word(const unsigned char* bytes) noexcept
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + (Index * word_size), word_bytes(Index));
+        m_words[Index].store(word, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> m_sequence{ 0 };
+    std::array<std::atomic<uint64_t>, word_count> m_words{};
+};
+} // namespace notstd
+
+#endif // NOT_STD_SEQLOCK_HXX
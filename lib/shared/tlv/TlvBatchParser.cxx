@@ -0,0 +1,185 @@
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+#include <tlv/TlvBatchParser.hxx>
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+
+using namespace encoding;
+
+namespace detail
+{
+/**
+ * @brief Parse the header of the record at the start of the specified data
+ * and check that its value is entirely contained in it.
+ *
+ * @param encoding The encoding of the record.
+ * @param data The data starting with the record.
+ * @param tagSize The size of the tag.
+ * @param headerSize The size of the header (tag and length).
+ * @param valueLength The length of the value.
+ * @return true If a complete record header was parsed.
+ * @return false If the header is invalid or the record is truncated.
+ */
+bool
+ParseRecordHeader(TlvBatchParser::Encoding encoding, std::span<const uint8_t> data, std::size_t& tagSize, std::size_t& headerSize, std::size_t& valueLength)
+{
+    return TlvStreamDecoder::ParseHeader(encoding, data, tagSize, headerSize, valueLength) == TlvStreamDecoder::HeaderResult::Complete && data.size() - headerSize >= valueLength;
+}
+
+/**
+ * @brief Validate the nested structure of the value of a BER-TLV record.
+ * Primitive records have no nested structure and are always valid.
+ *
+ * @param record The record to validate.
+ * @return true If the record is primitive, or all its nested values are valid.
+ * @return false Otherwise.
+ */
+bool
+ValidateBerRecord(const TlvRecord& record)
+{
+    if (TlvBer::GetType(record.Tag.front()) != TlvBer::Type::Constructed) {
+        return true;
+    }
+
+    std::size_t bytesParsedValue = 0;
+    while (bytesParsedValue < record.Value.size()) {
+        TlvBerView child{};
+        std::size_t bytesParsed = 0;
+        if (TlvBer::ParseView(child, record.Value.subspan(bytesParsedValue), bytesParsed) != Tlv::ParseResult::Succeeded) {
+            return false;
+        }
+        bytesParsedValue += bytesParsed;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Walk the headers of all records in the specified data, appending a
+ * view of each to the output list.
+ *
+ * @param encoding The encoding of the records.
+ * @param data The data to parse.
+ * @param records The output list of records.
+ * @param validateValues Whether to validate the values of BER-TLV records as
+ * they are parsed.
+ * @return Tlv::ParseResult
+ */
+Tlv::ParseResult
+ParseRecords(TlvBatchParser::Encoding encoding, std::span<const uint8_t> data, std::vector<TlvRecord>& records, bool validateValues)
+{
+    const bool validateBer = validateValues && (encoding == TlvBatchParser::Encoding::Ber);
+
+    std::size_t offset = 0;
+    while (offset < data.size()) {
+        auto recordData = data.subspan(offset);
+        std::size_t tagSize = 0;
+        std::size_t headerSize = 0;
+        std::size_t valueLength = 0;
+        if (!ParseRecordHeader(encoding, recordData, tagSize, headerSize, valueLength)) {
+            return Tlv::ParseResult::Failed;
+        }
+
+        TlvRecord record{ recordData.first(tagSize), recordData.subspan(headerSize, valueLength), offset };
+        if (validateBer && !ValidateBerRecord(record)) {
+            return Tlv::ParseResult::Failed;
+        }
+
+        records.push_back(record);
+        offset += headerSize + valueLength;
+    }
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+/**
+ * @brief Validate the values of a run of BER-TLV records.
+ *
+ * @param records All parsed records.
+ * @param indexBegin The index of the first record of the run.
+ * @param indexEnd The index one past the last record of the run.
+ * @return std::size_t The index of the first invalid record, or indexEnd if
+ * all records in the run are valid.
+ */
+std::size_t
+ValidateBerRecords(const std::vector<TlvRecord>& records, std::size_t indexBegin, std::size_t indexEnd)
+{
+    for (auto index = indexBegin; index < indexEnd; index++) {
+        if (!ValidateBerRecord(records[index])) {
+            return index;
+        }
+    }
+
+    return indexEnd;
+}
+} // namespace detail
+
+std::size_t
+TlvRecord::EncodedSize() const noexcept
+{
+    return static_cast<std::size_t>(std::distance(std::data(Tag), std::data(Value))) + std::size(Value);
+}
+
+/* static */
+Tlv::ParseResult
+TlvBatchParser::Parse(Encoding encoding, std::span<const uint8_t> data, std::vector<TlvRecord>& records)
+{
+    records.clear();
+    return ::detail::ParseRecords(encoding, data, records, true);
+}
+
+/* static */
+Tlv::ParseResult
+TlvBatchParser::ParseParallel(Encoding encoding, std::span<const uint8_t> data, std::vector<TlvRecord>& records, std::size_t numThreads, std::size_t chunkSizeMinimum)
+{
+    if (numThreads == 0) {
+        numThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, std::max<std::size_t>(1, data.size() / std::max<std::size_t>(1, chunkSizeMinimum)));
+
+    if (encoding != Encoding::Ber || numThreads == 1) {
+        return Parse(encoding, data, records);
+    }
+
+    // Find the record boundaries. Records preceding a header failure are still
+    // validated so that the output has the same meaning as for Parse().
+    records.clear();
+    const auto parseResult = ::detail::ParseRecords(encoding, data, records, false);
+
+    // Split the records into runs of roughly equal encoded size.
+    std::vector<std::size_t> runBoundaries(numThreads + 1, records.size());
+    runBoundaries.front() = 0;
+    for (std::size_t run = 1; run < numThreads; run++) {
+        const auto offsetTarget = data.size() * run / numThreads;
+        auto boundary = std::partition_point(std::cbegin(records), std::cend(records), [&](const auto& record) {
+            return record.Offset < offsetTarget;
+        });
+        runBoundaries[run] = static_cast<std::size_t>(std::distance(std::cbegin(records), boundary));
+    }
+
+    std::vector<std::size_t> firstInvalidIndices(numThreads, records.size());
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(numThreads - 1);
+        for (std::size_t run = 1; run < numThreads; run++) {
+            threads.emplace_back([&, run]() {
+                firstInvalidIndices[run] = ::detail::ValidateBerRecords(records, runBoundaries[run], runBoundaries[run + 1]);
+            });
+        }
+        firstInvalidIndices[0] = ::detail::ValidateBerRecords(records, runBoundaries[0], runBoundaries[1]);
+    }
+
+    // Each run reports its own end when valid, so the smallest index that is
+    // not a run end identifies the first invalid record overall.
+    for (std::size_t run = 0; run < numThreads; run++) {
+        if (firstInvalidIndices[run] != runBoundaries[run + 1]) {
+            records.resize(firstInvalidIndices[run]);
+            return Tlv::ParseResult::Failed;
+        }
+    }
+
+    return parseResult;
+}
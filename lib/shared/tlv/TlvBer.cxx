@@ -1,37 +1,164 @@
 
 #include <algorithm>
-#include <bit>
-#include <cstring>
+#include <array>
 #include <iterator>
 #include <optional>
+#include <stdexcept>
 #include <utility>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
 
 using namespace encoding;
 
-TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, const std::vector<uint8_t>& value) :
+TlvBer::TlvBer(const allocator_type& allocator) noexcept :
+    m_value(allocator),
+    m_valuesConstructed(allocator),
+    m_encoding(allocator)
+{
+}
+
+TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::span<const uint8_t> value, const allocator_type& allocator) :
     m_class(tlvClass),
     m_type(tlvType),
     m_tagNumber(tagNumber),
     m_tag(tag),
-    m_value(value)
+    m_value(std::cbegin(value), std::cend(value), allocator),
+    m_valuesConstructed(allocator),
+    m_valueLength(std::size(m_value)),
+    m_encoding(allocator)
 {
-    ::Tlv::Tag = m_tag;
-    ::Tlv::Value = m_value;
+    UpdateTlvSpans();
 }
 
-TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, std::vector<TlvBer>& values) :
+TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::pmr::vector<TlvBer>& values, const allocator_type& allocator) :
     m_class(tlvClass),
     m_type(tlvType),
     m_tagNumber(tagNumber),
     m_tag(tag),
-    m_valuesConstructed(std::move(values))
+    m_value(allocator),
+    m_valuesConstructed(std::move(values), allocator),
+    m_encoding(allocator)
+{
+    UpdateTlvSpans();
+
+    for (const auto& tlv : m_valuesConstructed) {
+        m_valueLength += tlv.EncodedSize();
+    }
+}
+
+TlvBer::TlvBer(const TlvBer& other, const allocator_type& allocator) :
+    Tlv(),
+    m_class(other.m_class),
+    m_type(other.m_type),
+    m_tagNumber(other.m_tagNumber),
+    m_tag(other.m_tag),
+    m_value(other.m_value, allocator),
+    m_valuesConstructed(other.m_valuesConstructed, allocator),
+    m_valueLength(other.m_valueLength),
+    m_encoding(other.m_encoding, allocator),
+    m_canonical(other.m_canonical)
+{
+    UpdateTlvSpans();
+}
+
+TlvBer::TlvBer(TlvBer&& other) noexcept :
+    Tlv(),
+    m_class(other.m_class),
+    m_type(other.m_type),
+    m_tagNumber(other.m_tagNumber),
+    m_tag(other.m_tag),
+    m_value(std::move(other.m_value)),
+    m_valuesConstructed(std::move(other.m_valuesConstructed)),
+    m_valueLength(other.m_valueLength),
+    m_encoding(std::move(other.m_encoding)),
+    m_canonical(other.m_canonical),
+    m_tagIndex(other.m_tagIndex.exchange(nullptr))
+{
+    UpdateTlvSpans();
+    other.UpdateTlvSpans();
+}
+
+TlvBer::TlvBer(TlvBer&& other, const allocator_type& allocator) :
+    Tlv(),
+    m_class(other.m_class),
+    m_type(other.m_type),
+    m_tagNumber(other.m_tagNumber),
+    m_tag(other.m_tag),
+    m_value(std::move(other.m_value), allocator),
+    m_valuesConstructed(std::move(other.m_valuesConstructed), allocator),
+    m_valueLength(other.m_valueLength),
+    m_encoding(std::move(other.m_encoding), allocator),
+    m_canonical(other.m_canonical)
+{
+    UpdateTlvSpans();
+    other.UpdateTlvSpans();
+}
+
+TlvBer&
+TlvBer::operator=(const TlvBer& other)
+{
+    if (this != &other) {
+        m_class = other.m_class;
+        m_type = other.m_type;
+        m_tagNumber = other.m_tagNumber;
+        m_tag = other.m_tag;
+        m_value = other.m_value;
+        m_valuesConstructed = other.m_valuesConstructed;
+        m_valueLength = other.m_valueLength;
+        m_encoding = other.m_encoding;
+        m_canonical = other.m_canonical;
+        ResetTagIndex();
+        UpdateTlvSpans();
+    }
+
+    return *this;
+}
+
+TlvBer&
+TlvBer::operator=(TlvBer&& other)
+{
+    if (this != &other) {
+        m_class = other.m_class;
+        m_type = other.m_type;
+        m_tagNumber = other.m_tagNumber;
+        m_tag = other.m_tag;
+        m_value = std::move(other.m_value);
+        m_valuesConstructed = std::move(other.m_valuesConstructed);
+        m_valueLength = other.m_valueLength;
+        m_encoding = std::move(other.m_encoding);
+        m_canonical = other.m_canonical;
+        ResetTagIndex();
+        // The index of other refers to positions that are unchanged by the
+        // move, but may only be taken over if it was allocated compatibly.
+        if (get_allocator() == other.get_allocator()) {
+            m_tagIndex = other.m_tagIndex.exchange(nullptr);
+        }
+        UpdateTlvSpans();
+        other.UpdateTlvSpans();
+    }
+
+    return *this;
+}
+
+TlvBer::~TlvBer()
+{
+    ResetTagIndex();
+}
+
+TlvBer::allocator_type
+TlvBer::get_allocator() const noexcept
+{
+    return m_value.get_allocator();
+}
+
+void
+TlvBer::UpdateTlvSpans() noexcept
 {
     ::Tlv::Tag = m_tag;
-    ::Tlv::Value = std::span<const uint8_t>{};
+    ::Tlv::Value = IsPrimitive() ? std::span<const uint8_t>{ m_value } : std::span<const uint8_t>{};
 }
 
 /* static */
@@ -61,6 +188,58 @@ TlvBer::GetClass(uint8_t tag)
     }
 }
 
+/* static */
+Tlv::ParseResult
+TlvBer::ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, std::span<const uint8_t> data, std::size_t& bytesParsed)
+{
+    auto dataIt = std::cbegin(data);
+    auto dataEnd = std::cend(data);
+    if (dataIt == dataEnd) {
+        return Tlv::ParseResult::Failed;
+    }
+
+    bytesParsed = 0;
+    tlvClass = GetClass(*dataIt);
+    tlvType = GetType(*dataIt);
+
+    // Is tag short type?
+    if ((*dataIt & BitmaskTagFirstByte) != TagValueLongField) {
+        tagNumber = *dataIt & BitmaskTagShort;
+        bytesParsed++;
+        return Tlv::ParseResult::Succeeded;
+    }
+
+    // Tag is long-type, check the second byte.
+    std::advance(dataIt, 1);
+    if (dataIt == dataEnd || *dataIt < 0x1F) {
+        return Tlv::ParseResult::Failed;
+    }
+
+    tagNumber = *dataIt & BitmaskTagLong;
+
+    // check the third byte?
+    if ((*dataIt & BitmaskTagLastByte) == TagValueLastByte) {
+        std::advance(dataIt, 1);
+        if (dataIt == dataEnd) {
+            return Tlv::ParseResult::Failed;
+        }
+
+        // make sure there's no fourth byte
+        if ((*dataIt & BitmaskTagLastByte) == TagValueLastByte) {
+            return Tlv::ParseResult::Failed;
+        }
+
+        tagNumber <<= 8U;
+        tagNumber |= static_cast<uint32_t>(*dataIt) & BitmaskTagLong;
+    }
+
+    // advance the dataIt to once past the tag
+    std::advance(dataIt, 1);
+    bytesParsed = static_cast<std::size_t>(std::distance(std::cbegin(data), dataIt));
+
+    return Tlv::ParseResult::Succeeded;
+}
+
 /* static */
 Tlv::ParseResult
 TlvBer::ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, std::vector<uint8_t>& tag, uint8_t tagValue)
@@ -70,6 +249,15 @@ TlvBer::ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNu
     return ParseTag(tlvClass, tlvType, tagNumber, tag, tagArray, bytesParsed);
 }
 
+/* static */
+Tlv::ParseResult
+TlvBer::ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, TagEncoding& tag, uint8_t tagValue)
+{
+    std::size_t bytesParsed = 0;
+    const std::array<uint8_t, 1> tagArray{ tagValue };
+    return ParseTag(tlvClass, tlvType, tagNumber, tag, tagArray, bytesParsed);
+}
+
 TlvBer::Type
 TlvBer::GetType() const noexcept
 {
@@ -94,24 +282,118 @@ TlvBer::GetTag() const noexcept
     return m_tag;
 }
 
-const std::vector<uint8_t>&
+const std::pmr::vector<uint8_t>&
 TlvBer::GetValue() const noexcept
 {
     return m_value;
 }
 
-const std::vector<TlvBer>&
+const std::pmr::vector<TlvBer>&
 TlvBer::GetValues() const noexcept
 {
     return m_valuesConstructed;
 }
 
+const TlvBer*
+TlvBer::Find(uint32_t tag) const
+{
+    if (std::size(m_valuesConstructed) < TagIndexSizeMinimum) {
+        auto it = std::ranges::find_if(m_valuesConstructed, [&](const auto& value) {
+            return GetTagValue(value.GetTag()) == tag;
+        });
+        return (it != std::cend(m_valuesConstructed)) ? &(*it) : nullptr;
+    }
+
+    const auto& tagIndex = GetTagIndex();
+    auto it = std::ranges::lower_bound(tagIndex, tag, {}, &TagIndex::value_type::first);
+    return (it != std::cend(tagIndex) && it->first == tag) ? &m_valuesConstructed[it->second] : nullptr;
+}
+
+const TlvBer*
+TlvBer::Find(std::initializer_list<uint32_t> path) const
+{
+    if (std::empty(path) || GetTagValue(m_tag) != *std::cbegin(path)) {
+        return nullptr;
+    }
+
+    const TlvBer* tlv = this;
+    for (auto it = std::next(std::cbegin(path)); tlv != nullptr && it != std::cend(path); std::advance(it, 1)) {
+        tlv = tlv->Find(*it);
+    }
+
+    return tlv;
+}
+
+std::vector<const TlvBer*>
+TlvBer::FindAll(uint32_t tag) const
+{
+    std::vector<const TlvBer*> values{};
+    if (std::size(m_valuesConstructed) < TagIndexSizeMinimum) {
+        for (const auto& value : m_valuesConstructed) {
+            if (GetTagValue(value.GetTag()) == tag) {
+                values.push_back(&value);
+            }
+        }
+        return values;
+    }
+
+    const auto& tagIndex = GetTagIndex();
+    auto [first, last] = std::ranges::equal_range(tagIndex, tag, {}, &TagIndex::value_type::first);
+    values.reserve(static_cast<std::size_t>(std::distance(first, last)));
+    for (auto it = first; it != last; std::advance(it, 1)) {
+        values.push_back(&m_valuesConstructed[it->second]);
+    }
+
+    return values;
+}
+
+const TlvBer::TagIndex&
+TlvBer::GetTagIndex() const
+{
+    auto* tagIndex = m_tagIndex.load(std::memory_order_acquire);
+    if (tagIndex != nullptr) {
+        return *tagIndex;
+    }
+
+    auto allocator = get_allocator();
+    auto* tagIndexNew = allocator.new_object<TagIndex>();
+    tagIndexNew->reserve(std::size(m_valuesConstructed));
+    for (std::size_t i = 0; i < std::size(m_valuesConstructed); i++) {
+        tagIndexNew->emplace_back(GetTagValue(m_valuesConstructed[i].GetTag()), i);
+    }
+    std::ranges::sort(*tagIndexNew);
+
+    // Another thread may have published an index in the meantime, in which
+    // case that one is used and this one discarded.
+    if (!m_tagIndex.compare_exchange_strong(tagIndex, tagIndexNew, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        allocator.delete_object(tagIndexNew);
+        return *tagIndex;
+    }
+
+    return *tagIndexNew;
+}
+
+void
+TlvBer::ResetTagIndex() noexcept
+{
+    auto* tagIndex = m_tagIndex.exchange(nullptr);
+    if (tagIndex != nullptr) {
+        get_allocator().delete_object(tagIndex);
+    }
+}
+
 bool
 TlvBer::IsConstructed() const noexcept
 {
     return m_type == TlvBer::TlvBer::Type::Constructed;
 }
 
+bool
+TlvBer::IsCanonical() const noexcept
+{
+    return m_canonical;
+}
+
 bool
 TlvBer::IsPrimitive() const noexcept
 {
@@ -119,40 +401,154 @@ TlvBer::IsPrimitive() const noexcept
 }
 
 std::vector<uint8_t>
-// Static-analysis flags false positive as ToBytes() is called on another instance, thus is not actually recursive.
-// NOLINTNEXTLINE(misc-no-recursion)
 TlvBer::ToBytes() const
 {
-    std::vector<uint8_t> value;
+    std::vector<uint8_t> bytes;
+    AppendTo(bytes);
+    return bytes;
+}
 
-    if (IsPrimitive()) {
-        value = m_value;
+std::size_t
+TlvBer::EncodedSize() const noexcept
+{
+    return std::size(m_tag) + GetLengthEncodingSize(m_valueLength) + m_valueLength;
+}
+
+std::size_t
+TlvBer::WriteTo(std::span<uint8_t> buffer) const noexcept
+{
+    const auto encodedSize = EncodedSize();
+    if (std::size(buffer) < encodedSize) {
+        return 0;
+    }
+
+    WriteEncoding(std::data(buffer));
+    return encodedSize;
+}
+
+void
+TlvBer::AppendTo(std::vector<uint8_t>& buffer) const
+{
+    const auto offset = std::size(buffer);
+    buffer.resize(offset + EncodedSize());
+    WriteEncoding(std::data(buffer) + offset);
+}
+
+uint8_t*
+// Static-analysis flags false positive as WriteEncoding() is called on another instance, thus is not actually recursive.
+// NOLINTNEXTLINE(misc-no-recursion)
+TlvBer::WriteEncoding(uint8_t* output) const noexcept
+{
+    // Splice in the cached encoding of canonical TLVs.
+    if (!std::empty(m_encoding)) {
+        return std::copy(std::cbegin(m_encoding), std::cend(m_encoding), output);
+    }
+
+    output = std::copy(std::cbegin(m_tag), std::cend(m_tag), output);
+
+    // Write the length, short-form for values 0-127, otherwise long-form with
+    // big endian byte ordering.
+    const auto lengthEncodingSize = GetLengthEncodingSize(m_valueLength);
+    if (lengthEncodingSize == 1) {
+        *output++ = static_cast<uint8_t>(m_valueLength);
     } else {
-        for (const auto& tlv : m_valuesConstructed) {
-            auto data = tlv.ToBytes();
-            value.insert(std::cend(value), std::make_move_iterator(std::begin(data)), std::make_move_iterator(std::end(data)));
+        const auto numBytes = lengthEncodingSize - 1;
+        *output++ = static_cast<uint8_t>((numBytes & BitmaskLengthNumOctets) | LengthFormLong);
+        for (std::size_t i = numBytes; i > 0; i--) {
+            *output++ = static_cast<uint8_t>((m_valueLength >> (8U * (i - 1))) & 0xFFU);
         }
     }
 
-    const auto lengthEncoding = TlvBer::GetLengthEncoding(value.size());
+    if (IsPrimitive()) {
+        return std::copy(std::cbegin(m_value), std::cend(m_value), output);
+    }
+
+    for (const auto& tlv : m_valuesConstructed) {
+        output = tlv.WriteEncoding(output);
+    }
+
+    return output;
+}
+
+void
+TlvBer::CacheEncoding()
+{
+    if (!std::empty(m_encoding)) {
+        return;
+    }
+
+    // WriteEncoding() uses m_encoding once it is non-empty, so write to a
+    // separate buffer first.
+    std::pmr::vector<uint8_t> encoding(EncodedSize(), get_allocator());
+    WriteEncoding(std::data(encoding));
+    m_encoding = std::move(encoding);
+}
+
+void
+TlvBer::ReleaseEncoding() noexcept
+{
+    // Assigning an empty vector keeps the capacity, so swap the storage out.
+    std::pmr::vector<uint8_t>{ get_allocator() }.swap(m_encoding);
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void
+TlvBer::Canonicalize()
+{
+    if (m_canonical) {
+        return;
+    }
+
+    for (auto& tlv : m_valuesConstructed) {
+        tlv.Canonicalize();
+    }
+
+    if (IsUniversalSet()) {
+        for (auto& tlv : m_valuesConstructed) {
+            tlv.CacheEncoding();
+        }
+        SortCanonical(m_valuesConstructed);
+        for (auto& tlv : m_valuesConstructed) {
+            tlv.ReleaseEncoding();
+        }
+        ResetTagIndex();
+    }
+
+    m_canonical = true;
+}
+
+bool
+TlvBer::IsUniversalSet() const noexcept
+{
+    return IsConstructed() && m_class == TlvBer::Class::Universal && m_tagNumber == TagNumberUniversalSet;
+}
 
-    // Build the byte array.
-    std::vector<uint8_t> accumulate;
-    accumulate.insert(std::cend(accumulate), std::cbegin(m_tag), std::cend(m_tag));
-    accumulate.insert(std::cend(accumulate), std::cbegin(lengthEncoding), std::cend(lengthEncoding));
-    accumulate.insert(std::cend(accumulate), std::cbegin(value), std::cend(value));
-    return accumulate;
+/* static */
+void
+TlvBer::SortCanonical(std::pmr::vector<TlvBer>& values)
+{
+    // Class enumerators are declared in canonical order: universal,
+    // application, context-specific, then private (ITU-T X.680 section 8.6).
+    std::ranges::stable_sort(values, [](const TlvBer& lhs, const TlvBer& rhs) {
+        if (lhs.m_class != rhs.m_class) {
+            return lhs.m_class < rhs.m_class;
+        }
+        if (lhs.m_tagNumber != rhs.m_tagNumber) {
+            return lhs.m_tagNumber < rhs.m_tagNumber;
+        }
+        return std::ranges::lexicographical_compare(lhs.m_encoding, rhs.m_encoding);
+    });
 }
 
 Tlv::ParseResult
-TlvBer::ParseConstructedValue(std::vector<TlvBer>& valueOutput, std::size_t length, std::span<uint8_t> dataInput, std::size_t& bytesParsedOverall)
+TlvBer::ParseConstructedValue(std::pmr::vector<TlvBer>& valueOutput, std::size_t length, std::span<uint8_t> dataInput, std::size_t& bytesParsedOverall)
 {
     bytesParsedOverall = 0;
     std::size_t bytesParsed = 0;
     std::span<uint8_t> subspan = dataInput;
 
     while (bytesParsedOverall < length) {
-        TlvBer subtlv{};
+        TlvBer subtlv{ valueOutput.get_allocator() };
         auto parseResult = Parse(subtlv, subspan, bytesParsed);
         if (parseResult != Tlv::ParseResult::Succeeded) {
             return parseResult;
@@ -177,14 +573,16 @@ TlvBer::Parse(TlvBer& tlvOutput, std::span<uint8_t> dataInput, std::size_t& byte
     auto tlvClass = TlvBer::Class::Invalid;
     auto tlvType = TlvBer::Type::Primitive;
     uint32_t tagNumber = 0;
-    std::vector<uint8_t> tag;
     std::size_t offset = 0;
     std::size_t bytesParsed = 0;
-    auto parseResult = ParseTag(tlvClass, tlvType, tagNumber, tag, dataInput, bytesParsed);
+    auto parseResult = ParseTag(tlvClass, tlvType, tagNumber, std::span<const uint8_t>{ dataInput }, bytesParsed);
     if (parseResult != Tlv::ParseResult::Succeeded) {
         return parseResult;
     }
 
+    const auto tag = dataInput.first(bytesParsed);
+    const auto allocator = tlvOutput.get_allocator();
+
     // Parse length.
     offset += bytesParsed;
     std::size_t length = 0;
@@ -198,19 +596,18 @@ TlvBer::Parse(TlvBer& tlvOutput, std::span<uint8_t> dataInput, std::size_t& byte
     offset += bytesParsed;
     subspan = dataInput.subspan(offset);
     if (tlvType == Type::Constructed) {
-        std::vector<TlvBer> values;
+        std::pmr::vector<TlvBer> values{ allocator };
         parseResult = ParseConstructedValue(values, length, subspan, bytesParsed);
         if (parseResult != Tlv::ParseResult::Succeeded) {
             return parseResult;
         }
-        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, values);
+        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, values, allocator);
     } else {
-        std::vector<uint8_t> value;
-        parseResult = ParsePrimitiveValue(value, length, subspan, bytesParsed);
-        if (parseResult != Tlv::ParseResult::Succeeded) {
-            return parseResult;
+        if (std::size(subspan) < length) {
+            return Tlv::ParseResult::Failed;
         }
-        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, value);
+        bytesParsed = length;
+        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, subspan.first(length), allocator);
     }
 
     offset += bytesParsed;
@@ -219,16 +616,71 @@ TlvBer::Parse(TlvBer& tlvOutput, std::span<uint8_t> dataInput, std::size_t& byte
     return ParseResult::Succeeded;
 }
 
+/* static */
+Tlv::ParseResult
+TlvBer::ParseView(TlvBerView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall)
+{
+    // Parse tag.
+    auto tlvClass = TlvBer::Class::Invalid;
+    auto tlvType = TlvBer::Type::Primitive;
+    uint32_t tagNumber = 0;
+    std::size_t bytesParsed = 0;
+    auto parseResult = ParseTag(tlvClass, tlvType, tagNumber, dataInput, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded) {
+        return parseResult;
+    }
+
+    auto tag = dataInput.first(bytesParsed);
+    std::size_t offset = bytesParsed;
+
+    // Parse length.
+    std::size_t length = 0;
+    auto subspan = dataInput.subspan(offset);
+    parseResult = ParseLength(length, subspan, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded) {
+        return parseResult;
+    }
+
+    // Parse value.
+    offset += bytesParsed;
+    subspan = dataInput.subspan(offset);
+    if (std::size(subspan) < length) {
+        return Tlv::ParseResult::Failed;
+    }
+
+    auto value = subspan.first(length);
+
+    // Validate the structure of all nested values up-front so that later
+    // iteration over them cannot fail.
+    if (tlvType == Type::Constructed) {
+        std::size_t bytesParsedValue = 0;
+        while (bytesParsedValue < length) {
+            TlvBerView child{};
+            parseResult = ParseView(child, value.subspan(bytesParsedValue), bytesParsed);
+            if (parseResult != Tlv::ParseResult::Succeeded) {
+                return parseResult;
+            }
+            bytesParsedValue += bytesParsed;
+        }
+    }
+
+    tlvOutput = TlvBerView(tlvClass, tlvType, tagNumber, tag, value);
+    bytesParsedOverall = offset + length;
+
+    return Tlv::ParseResult::Succeeded;
+}
+
 void
 TlvBer::Builder::WriteLength(uint64_t length)
 {
     const auto lengthEncoding = TlvBer::GetLengthEncoding(length);
-    m_data.insert(std::cend(m_data), std::cbegin(lengthEncoding), std::cend(lengthEncoding));
+    WriteBytes(lengthEncoding);
 }
 
 TlvBer::Builder&
 TlvBer::Builder::SetTag(uint8_t tag)
 {
+    m_tag.clear();
     TlvBer::ParseTag(m_class, m_type, m_tagNumber, m_tag, tag);
     return *this;
 }
@@ -236,53 +688,54 @@ TlvBer::Builder::SetTag(uint8_t tag)
 TlvBer::Builder&
 TlvBer::Builder::SetTag(uint16_t tag)
 {
-    std::array<uint8_t, sizeof tag> tagData;
-    std::memcpy(&tagData, &tag, sizeof tag);
+    // Tags are always specified in big endian byte ordering.
+    const std::array<uint8_t, sizeof tag> tagData{ static_cast<uint8_t>(tag >> 8U), static_cast<uint8_t>(tag & 0xFFU) };
+    return SetTag(tagData);
+}
 
-    if (std::endian::native == std::endian::big) {
-        TlvBer::Builder::SetTag(tagData);
-        return *this;
-    } else {
-        std::array<uint8_t, sizeof tag> tagDataRev;
-        std::transform(std::rbegin(tagData), std::rend(tagData), std::begin(tagDataRev), [](auto&& b) {
-            return b;
-        });
-        TlvBer::Builder::SetTag(tagDataRev);
-        return *this;
+TlvBer::LengthEncoding
+TlvBer::GetLengthEncoding(std::size_t length)
+{
+    const auto lengthEncodingSize = GetLengthEncodingSize(length);
+    if (lengthEncodingSize > MaxNumOctetsInLengthEncoding) {
+        throw std::length_error("length exceeds the maximum BER-TLV length encoding");
+    }
+
+    // Short-form, values 0-127.
+    LengthEncoding encoding{};
+    if (lengthEncodingSize == 1) {
+        encoding.push_back(static_cast<uint8_t>(length));
+        return encoding;
     }
+
+    // Long-form, values 128+. Encode the long-format indicator and number of
+    // trailing bytes, followed by the length value with big endian byte ordering.
+    const auto numBytes = lengthEncodingSize - 1;
+    encoding.push_back(static_cast<uint8_t>((numBytes & BitmaskLengthNumOctets) | LengthFormLong));
+    for (std::size_t i = numBytes; i > 0; i--) {
+        encoding.push_back(static_cast<uint8_t>((length >> (8U * (i - 1))) & 0xFFU));
+    }
+
+    return encoding;
 }
 
-std::vector<uint8_t>
-TlvBer::GetLengthEncoding(std::size_t length)
+std::size_t
+TlvBer::GetLengthEncodingSize(std::size_t length) noexcept
 {
     // Short-form, values 0-127.
     if (length <= LengthFormShortMax) {
-        return { static_cast<uint8_t>(length) };
+        return 1;
     }
 
-    // Long-form, values 128+.
-    std::size_t numBytes = 0;
-    std::vector<uint8_t> encoding;
-
-    // Successively encode length value with big endian byte ordering.
+    // Long-form, values 128+, one octet for the number of trailing length
+    // octets followed by the length value itself.
+    std::size_t numBytes = 1;
     while (length > 0) {
-        encoding.push_back(length & 0xFFU);
         length >>= 8U;
         numBytes++;
     }
 
-    // Encode the long-format indicator and number of trailing bytes.
-    encoding.push_back((numBytes & BitmaskLengthNumOctets) | LengthFormLong);
-
-    // Ensure returned encoding is big-endian, accounting for host endianness.
-    if constexpr (std::endian::native == std::endian::big) {
-        return encoding;
-    } else {
-        return {
-            std::make_move_iterator(std::rbegin(encoding)),
-            std::make_move_iterator(std::rend(encoding))
-        };
-    }
+    return numBytes;
 }
 
 void
@@ -299,6 +752,12 @@ TlvBer::Builder::WriteLengthAndValue(uint8_t value)
     m_data.push_back(value);
 }
 
+TlvBer::Builder::Builder(std::pmr::memory_resource* resource) :
+    m_data(resource),
+    m_valuesConstructed(resource)
+{
+}
+
 TlvBer::Builder&
 TlvBer::Builder::SetValue(uint8_t value)
 {
@@ -307,7 +766,14 @@ TlvBer::Builder::SetValue(uint8_t value)
 }
 
 TlvBer::Builder&
-TlvBer::Builder::AddTlv(TlvBer tlv)
+TlvBer::Builder::AddTlv(const TlvBer& tlv)
+{
+    m_valuesConstructed.push_back(tlv);
+    return *this;
+}
+
+TlvBer::Builder&
+TlvBer::Builder::AddTlv(TlvBer&& tlv)
 {
     m_valuesConstructed.push_back(std::move(tlv));
     return *this;
@@ -328,7 +794,28 @@ TlvBer::Builder::SetAsCopyOfTlv(const TlvBer& tlv)
 TlvBer::Builder&
 TlvBer::Builder::Reset()
 {
-    *this = {};
+    // Clear the contents while retaining the memory resource.
+    m_class = TlvBer::Class::Invalid;
+    m_type = TlvBer::Type::Primitive;
+    m_tagNumber = 0;
+    m_tag.clear();
+    m_data.clear();
+    m_valuesConstructed.clear();
+    m_unordered = false;
+    return *this;
+}
+
+TlvBer::Builder&
+TlvBer::Builder::SetCanonical(bool canonical) noexcept
+{
+    m_canonical = canonical;
+    return *this;
+}
+
+TlvBer::Builder&
+TlvBer::Builder::SetUnordered(bool unordered) noexcept
+{
+    m_unordered = unordered;
     return *this;
 }
 
@@ -336,10 +823,42 @@ TlvBer
 TlvBer::Builder::Build()
 {
     ValidateTag();
+    const auto allocator = m_data.get_allocator();
     if (m_type == TlvBer::Type::Primitive) {
-        return TlvBer{ m_class, m_type, m_tagNumber, m_tag, m_data };
+        TlvBer tlv{ m_class, m_type, m_tagNumber, m_tag, m_data, allocator };
+        if (m_canonical) {
+            tlv.m_canonical = true;
+            tlv.CacheEncoding();
+        }
+        return tlv;
+    }
+
+    if (m_canonical) {
+        // Cache the encoding of each nested TLV first so they are compared,
+        // and later spliced into the parent encoding, without re-encoding.
+        for (auto& tlv : m_valuesConstructed) {
+            tlv.Canonicalize();
+            tlv.CacheEncoding();
+        }
+        if (m_unordered || (m_class == TlvBer::Class::Universal && m_tagNumber == TagNumberUniversalSet)) {
+            SortCanonical(m_valuesConstructed);
+        }
+    }
+
+    TlvBer tlv{ m_class, m_type, m_tagNumber, m_tag, m_valuesConstructed, allocator };
+    if (m_canonical) {
+        tlv.m_canonical = true;
+        tlv.CacheEncoding();
+        // The nested encodings are now part of the parent's, so free the
+        // caches of both the nested TLVs and the builder's copies of them.
+        for (auto& tlvNested : tlv.m_valuesConstructed) {
+            tlvNested.ReleaseEncoding();
+        }
+        for (auto& tlvNested : m_valuesConstructed) {
+            tlvNested.ReleaseEncoding();
+        }
     }
-    return TlvBer{ m_class, m_type, m_tagNumber, m_tag, m_valuesConstructed };
+    return tlv;
 }
 
 void
@@ -0,0 +1,155 @@
+
+#include <tlv/TlvBerView.hxx>
+
+using namespace encoding;
+
+TlvBerView::TlvBerView(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::span<const uint8_t> value) noexcept :
+    m_class(tlvClass),
+    m_type(tlvType),
+    m_tagNumber(tagNumber)
+{
+    ::Tlv::Tag = tag;
+    ::Tlv::Value = value;
+}
+
+bool
+TlvBerView::IsConstructed() const noexcept
+{
+    return m_type == TlvBer::Type::Constructed;
+}
+
+bool
+TlvBerView::IsPrimitive() const noexcept
+{
+    return m_type == TlvBer::Type::Primitive;
+}
+
+TlvBer::Type
+TlvBerView::GetType() const noexcept
+{
+    return m_type;
+}
+
+TlvBer::Class
+TlvBerView::GetClass() const noexcept
+{
+    return m_class;
+}
+
+uint32_t
+TlvBerView::GetTagNumber() const noexcept
+{
+    return m_tagNumber;
+}
+
+std::span<const uint8_t>
+TlvBerView::GetTag() const noexcept
+{
+    return Tag;
+}
+
+std::span<const uint8_t>
+TlvBerView::GetValue() const noexcept
+{
+    return Value;
+}
+
+notstd::iterator_range<TlvBerView::Iterator>
+TlvBerView::GetValues() const noexcept
+{
+    auto values = IsConstructed() ? Value : Value.last(0);
+    return notstd::make_range(Iterator{ values }, Iterator{ values.last(0) });
+}
+
+std::optional<TlvBerView>
+TlvBerView::Find(uint32_t tag) const noexcept
+{
+    for (const auto& value : GetValues()) {
+        if (TlvBer::GetTagValue(value.GetTag()) == tag) {
+            return value;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<TlvBerView>
+TlvBerView::Find(std::initializer_list<uint32_t> path) const noexcept
+{
+    if (std::empty(path) || TlvBer::GetTagValue(Tag) != *std::cbegin(path)) {
+        return std::nullopt;
+    }
+
+    std::optional<TlvBerView> tlv = *this;
+    for (auto it = std::next(std::cbegin(path)); tlv.has_value() && it != std::cend(path); std::advance(it, 1)) {
+        tlv = tlv->Find(*it);
+    }
+
+    return tlv;
+}
+
+TlvBerView::Iterator::Iterator(std::span<const uint8_t> data) noexcept :
+    m_remaining(data)
+{
+    ParseCurrent();
+}
+
+void
+TlvBerView::Iterator::ParseCurrent() noexcept
+{
+    m_currentSize = 0;
+    if (std::empty(m_remaining)) {
+        m_current = {};
+        return;
+    }
+
+    // The enclosing view was fully validated when it was parsed, so only the
+    // tag and length of this child need to be decoded to locate its value.
+    auto tlvClass = TlvBer::Class::Invalid;
+    auto tlvType = TlvBer::Type::Primitive;
+    uint32_t tagNumber = 0;
+    std::size_t tagSize = 0;
+    TlvBer::ParseTag(tlvClass, tlvType, tagNumber, m_remaining, tagSize);
+
+    std::size_t length = 0;
+    std::size_t lengthSize = 0;
+    auto lengthAndValue = m_remaining.subspan(tagSize);
+    TlvBer::ParseLength(length, lengthAndValue, lengthSize);
+
+    m_current = TlvBerView(tlvClass, tlvType, tagNumber, m_remaining.first(tagSize), lengthAndValue.subspan(lengthSize, length));
+    m_currentSize = tagSize + lengthSize + length;
+}
+
+TlvBerView::Iterator::reference
+TlvBerView::Iterator::operator*() const noexcept
+{
+    return m_current;
+}
+
+TlvBerView::Iterator::pointer
+TlvBerView::Iterator::operator->() const noexcept
+{
+    return &m_current;
+}
+
+TlvBerView::Iterator&
+TlvBerView::Iterator::operator++() noexcept
+{
+    m_remaining = m_remaining.subspan(m_currentSize);
+    ParseCurrent();
+    return *this;
+}
+
+TlvBerView::Iterator
+TlvBerView::Iterator::operator++(int) noexcept
+{
+    auto previous = *this;
+    ++(*this);
+    return previous;
+}
+
+bool
+TlvBerView::Iterator::operator==(const Iterator& other) const noexcept
+{
+    return std::data(m_remaining) == std::data(other.m_remaining);
+}
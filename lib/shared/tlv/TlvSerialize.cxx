@@ -1,7 +1,6 @@
 
 #include <bit>
 #include <climits>
-#include <iterator>
 #include <stdexcept>
 
 #include <tlv/TlvSerialize.hxx>
@@ -18,12 +17,10 @@ encoding::GetBitMaskFromBitIndex(std::size_t bitIndex)
 std::size_t
 encoding::GetBitIndexFromBitMask(std::size_t bitMask)
 {
-    for (std::size_t index = 0; index < (sizeof bitMask) * CHAR_BIT; index++) {
-        if (bitMask == GetBitMaskFromBitIndex(index)) {
-            return index;
-        }
+    if (!std::has_single_bit(bitMask)) {
+        throw std::runtime_error("bit index not found");
     }
-    throw std::runtime_error("bit index not found");
+    return static_cast<std::size_t>(std::countr_zero(bitMask));
 }
 
 std::vector<uint8_t>
@@ -33,20 +30,11 @@ encoding::GetBytesBigEndianFromBitMap(std::size_t value, std::size_t desiredLeng
         throw std::runtime_error("desired length exceeds std::size_t width, this is a bug!");
     }
 
-    std::vector<uint8_t> bytes;
-    bytes.reserve(desiredLength);
-
-    for (std::size_t i = 0; i < desiredLength; i++) {
-        const auto b = static_cast<uint8_t>(value & 0xFFU);
-        bytes.push_back(b);
-        value >>= 8U;
-    }
-
-    if constexpr (std::endian::native != std::endian::big) {
-        return {
-            std::make_move_iterator(std::rbegin(bytes)),
-            std::make_move_iterator(std::rend(bytes))
-        };
+    // Fill from the least significant byte at the back, so no reversal is needed.
+    std::vector<uint8_t> bytes(desiredLength);
+    for (auto byte = std::rbegin(bytes); byte != std::rend(bytes); byte++) {
+        *byte = static_cast<uint8_t>(value & 0xFFU);
+        value >>= CHAR_BIT;
     }
 
     return bytes;
@@ -0,0 +1,204 @@
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <tlv/TlvSimple.hxx>
+#include <tlv/TlvStreamDecoder.hxx>
+
+using namespace encoding;
+
+namespace detail
+{
+/**
+ * @brief The size of the header of a SIMPLE-TLV with a one-byte length.
+ */
+constexpr std::size_t SimpleHeaderSizeOneByteLength = 2;
+
+/**
+ * @brief The size of the header of a SIMPLE-TLV with a three-byte length.
+ */
+constexpr std::size_t SimpleHeaderSizeThreeByteLength = 4;
+} // namespace detail
+
+TlvStreamDecoder::TlvStreamDecoder(Encoding encoding, TlvCallback callback, std::size_t valueLengthMaximum) :
+    m_encoding(encoding),
+    m_callback(std::move(callback)),
+    m_valueLengthMaximum(valueLengthMaximum)
+{}
+
+TlvStreamDecoder::TlvStreamDecoder(TlvBerCallback callback, std::size_t valueLengthMaximum) :
+    m_encoding(Encoding::Ber),
+    m_berCallback(std::move(callback)),
+    m_valueLengthMaximum(valueLengthMaximum)
+{}
+
+Tlv::ParseResult
+TlvStreamDecoder::Push(std::span<const uint8_t> data)
+{
+    if (m_failed) {
+        return Tlv::ParseResult::Failed;
+    }
+
+    while (!data.empty()) {
+        // Fast path: report TLVs that are entirely contained in the chunk directly from it.
+        if (m_buffer.empty()) {
+            std::size_t tagSize = 0;
+            std::size_t headerSize = 0;
+            std::size_t valueLength = 0;
+            auto headerResult = ParseHeader(m_encoding, data, tagSize, headerSize, valueLength);
+            if (headerResult == HeaderResult::Invalid || (headerResult == HeaderResult::Complete && valueLength > m_valueLengthMaximum)) {
+                return Fail();
+            }
+            if (headerResult == HeaderResult::Complete && data.size() - headerSize >= valueLength) {
+                const auto tlvSize = headerSize + valueLength;
+                if (Emit(data.first(tlvSize), headerSize) != Tlv::ParseResult::Succeeded) {
+                    return Tlv::ParseResult::Failed;
+                }
+                data = data.subspan(tlvSize);
+                continue;
+            }
+        }
+
+        // Accumulate the header one byte at a time since it is at most a few bytes long.
+        if (m_headerSize == 0) {
+            m_buffer.push_back(data.front());
+            data = data.subspan(1);
+
+            std::size_t tagSize = 0;
+            std::size_t headerSize = 0;
+            std::size_t valueLength = 0;
+            auto headerResult = ParseHeader(m_encoding, m_buffer, tagSize, headerSize, valueLength);
+            if (headerResult == HeaderResult::Incomplete) {
+                continue;
+            } else if (headerResult == HeaderResult::Invalid || valueLength > m_valueLengthMaximum) {
+                return Fail();
+            }
+
+            m_headerSize = headerSize;
+            m_valueLength = valueLength;
+            m_buffer.reserve(m_headerSize + m_valueLength);
+        }
+
+        const auto tlvSize = m_headerSize + m_valueLength;
+        const auto numBytesToCopy = std::min(tlvSize - m_buffer.size(), data.size());
+        m_buffer.insert(std::cend(m_buffer), std::cbegin(data), std::next(std::cbegin(data), static_cast<std::ptrdiff_t>(numBytesToCopy)));
+        data = data.subspan(numBytesToCopy);
+
+        if (m_buffer.size() == tlvSize) {
+            auto result = Emit(m_buffer, m_headerSize);
+            m_buffer.clear();
+            m_headerSize = m_valueLength = 0;
+            if (result != Tlv::ParseResult::Succeeded) {
+                return Tlv::ParseResult::Failed;
+            }
+        }
+    }
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+void
+TlvStreamDecoder::Reset() noexcept
+{
+    m_failed = false;
+    m_buffer.clear();
+    m_headerSize = m_valueLength = 0;
+}
+
+bool
+TlvStreamDecoder::HasPartialTlv() const noexcept
+{
+    return !m_buffer.empty();
+}
+
+/* static */
+TlvStreamDecoder::HeaderResult
+TlvStreamDecoder::ParseHeader(Encoding encoding, std::span<const uint8_t> data, std::size_t& tagSize, std::size_t& headerSize, std::size_t& valueLength)
+{
+    switch (encoding) {
+    case Encoding::Ber: {
+        TlvBer::Class tlvClass;
+        TlvBer::Type tlvType;
+        uint32_t tagNumber;
+        // The tag and length parsers fail both on truncated and invalid
+        // encodings; the failure is only definitive once the maximum encoding
+        // size is available.
+        if (TlvBer::ParseTag(tlvClass, tlvType, tagNumber, data, tagSize) != Tlv::ParseResult::Succeeded) {
+            return (data.size() < TlvBer::MaxNumOctetsInTagEncoding) ? HeaderResult::Incomplete : HeaderResult::Invalid;
+        }
+
+        auto lengthData = data.subspan(tagSize);
+        std::size_t lengthSize = 0;
+        if (TlvBer::ParseLength(valueLength, lengthData, lengthSize) != Tlv::ParseResult::Succeeded) {
+            return (lengthData.size() < TlvBer::MaxNumOctetsInLengthEncoding) ? HeaderResult::Incomplete : HeaderResult::Invalid;
+        }
+
+        headerSize = tagSize + lengthSize;
+        return HeaderResult::Complete;
+    }
+    case Encoding::Simple: {
+        if (data.size() < ::detail::SimpleHeaderSizeOneByteLength) {
+            return HeaderResult::Incomplete;
+        }
+        tagSize = 1;
+        if (data[1] != TlvSimple::ThreeByteLengthIndicatorValue) {
+            headerSize = ::detail::SimpleHeaderSizeOneByteLength;
+            valueLength = data[1];
+            return HeaderResult::Complete;
+        }
+        if (data.size() < ::detail::SimpleHeaderSizeThreeByteLength) {
+            return HeaderResult::Incomplete;
+        }
+
+        headerSize = ::detail::SimpleHeaderSizeThreeByteLength;
+        valueLength = (static_cast<std::size_t>(data[2]) << 8U) | data[3]; // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+        return HeaderResult::Complete;
+    }
+    default:
+        return HeaderResult::Invalid;
+    }
+}
+
+Tlv::ParseResult
+TlvStreamDecoder::Emit(std::span<const uint8_t> data, std::size_t headerSize)
+{
+    switch (m_encoding) {
+    case Encoding::Ber: {
+        // Validate any nested TLVs before handing out a view.
+        TlvBerView tlv;
+        std::size_t bytesParsed = 0;
+        if (TlvBer::ParseView(tlv, data, bytesParsed) != Tlv::ParseResult::Succeeded || bytesParsed != data.size()) {
+            return Fail();
+        }
+        if (m_berCallback) {
+            m_berCallback(tlv);
+        } else if (m_callback) {
+            m_callback(tlv);
+        }
+        break;
+    }
+    case Encoding::Simple: {
+        Tlv tlv;
+        tlv.Tag = data.first(1);
+        tlv.Value = data.subspan(headerSize);
+        if (m_callback) {
+            m_callback(tlv);
+        }
+        break;
+    }
+    default:
+        return Fail();
+    }
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+Tlv::ParseResult
+TlvStreamDecoder::Fail() noexcept
+{
+    m_failed = true;
+    return Tlv::ParseResult::Failed;
+}
@@ -0,0 +1,142 @@
+
+#ifndef INLINE_OCTETS_HXX
+#define INLINE_OCTETS_HXX
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace encoding
+{
+/**
+ * @brief A sequence of at most Capacity octets, stored inline. This is used
+ * for small encodings such as BER-TLV tags and lengths so that producing them
+ * never requires a heap allocation.
+ *
+ * @tparam Capacity The maximum number of octets.
+ */
+template <std::size_t Capacity>
+class InlineOctets
+{
+public:
+    using value_type = uint8_t;
+    using size_type = std::size_t;
+    using iterator = uint8_t*;
+    using const_iterator = const uint8_t*;
+
+    constexpr InlineOctets() noexcept = default;
+
+    /**
+     * @brief Construct a new Inline Octets object holding a copy of the
+     * specified octets.
+     *
+     * @param octets The octets to copy. Throws std::length_error if there are
+     * more than Capacity octets.
+     */
+    constexpr explicit InlineOctets(std::span<const uint8_t> octets)
+    {
+        assign(octets);
+    }
+
+    static constexpr size_type
+    capacity() noexcept
+    {
+        return Capacity;
+    }
+
+    constexpr void
+    assign(std::span<const uint8_t> octets)
+    {
+        if (std::size(octets) > Capacity) {
+            throw std::length_error("too many octets for inline storage");
+        }
+        std::copy(std::cbegin(octets), std::cend(octets), std::begin(m_octets));
+        m_size = static_cast<uint8_t>(std::size(octets));
+    }
+
+    constexpr void
+    push_back(uint8_t octet)
+    {
+        if (m_size == Capacity) {
+            throw std::length_error("too many octets for inline storage");
+        }
+        m_octets[m_size++] = octet;
+    }
+
+    constexpr void
+    clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    constexpr size_type
+    size() const noexcept
+    {
+        return m_size;
+    }
+
+    constexpr bool
+    empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    constexpr uint8_t*
+    data() noexcept
+    {
+        return std::data(m_octets);
+    }
+
+    constexpr const uint8_t*
+    data() const noexcept
+    {
+        return std::data(m_octets);
+    }
+
+    constexpr iterator
+    begin() noexcept
+    {
+        return data();
+    }
+
+    constexpr const_iterator
+    begin() const noexcept
+    {
+        return data();
+    }
+
+    constexpr iterator
+    end() noexcept
+    {
+        return data() + m_size;
+    }
+
+    constexpr const_iterator
+    end() const noexcept
+    {
+        return data() + m_size;
+    }
+
+    constexpr uint8_t
+    operator[](size_type index) const noexcept
+    {
+        return m_octets[index];
+    }
+
+    constexpr bool
+    operator==(const InlineOctets& other) const noexcept
+    {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+private:
+    std::array<uint8_t, Capacity> m_octets{};
+    uint8_t m_size{ 0 };
+};
+
+} // namespace encoding
+
+#endif // INLINE_OCTETS_HXX
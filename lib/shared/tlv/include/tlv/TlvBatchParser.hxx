@@ -0,0 +1,107 @@
+
+#ifndef TLV_BATCH_PARSER_HXX
+#define TLV_BATCH_PARSER_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <tlv/Tlv.hxx>
+#include <tlv/TlvStreamDecoder.hxx>
+
+namespace encoding
+{
+/**
+ * @brief View of a single top-level TLV record within a contiguous buffer.
+ * The tag and value refer to the parsed buffer, which must outlive the record.
+ */
+struct TlvRecord
+{
+    std::span<const uint8_t> Tag;
+    std::span<const uint8_t> Value;
+    // Offset of the first octet of the record's tag within the parsed buffer.
+    std::size_t Offset{ 0 };
+
+    /**
+     * @brief The size of the complete encoding of the record (tag, length and
+     * value).
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    EncodedSize() const noexcept;
+};
+
+/**
+ * @brief Parser for a contiguous buffer holding a sequence of concatenated
+ * top-level TLVs, such as an archive of encoded session data blobs.
+ *
+ * Unlike TlvBer::Parse and TlvSimple::Parse, which decode exactly one TLV into
+ * an owning object, the batch parser walks the whole buffer in a single pass
+ * and produces a flat list of non-owning record views. Apart from growing the
+ * output list, parsing never allocates.
+ */
+class TlvBatchParser
+{
+public:
+    /**
+     * @brief The encoding of the records in the buffer.
+     */
+    using Encoding = TlvStreamDecoder::Encoding;
+
+    /**
+     * @brief The default minimum number of octets handed to each thread when
+     * parsing in parallel. Below this, the cost of starting a thread outweighs
+     * the work it would do.
+     */
+    static constexpr std::size_t ParallelChunkSizeMinimumDefault = 64 * 1024;
+
+    /**
+     * @brief Parse all records in the specified buffer.
+     *
+     * For Encoding::Ber, the structure of the values of constructed records
+     * is validated as done by TlvBer::ParseView, so views of their children
+     * may be obtained without further error handling.
+     *
+     * @param encoding The encoding of the records.
+     * @param data The buffer to parse. It must consist of whole records only.
+     * @param records The output list of records. It is cleared first, and its
+     * capacity is reused, so repeatedly parsing into the same list does not
+     * allocate once it is large enough. If parsing fails, it holds the records
+     * preceding the first invalid one.
+     * @return Tlv::ParseResult Succeeded if the entire buffer was parsed,
+     * Failed otherwise.
+     */
+    static Tlv::ParseResult
+    Parse(Encoding encoding, std::span<const uint8_t> data, std::vector<TlvRecord>& records);
+
+    /**
+     * @brief Parse all records in the specified buffer, distributing the work
+     * over multiple threads.
+     *
+     * The record boundaries can only be determined by walking the headers in
+     * order, so this is done first on the calling thread. The records are then
+     * split into contiguous runs of roughly equal encoded size, and the values
+     * of each run are validated on their own thread. This only pays off for
+     * Encoding::Ber with constructed records, whose validation dominates; for
+     * Encoding::Simple, or when the buffer is too small to split, it is
+     * equivalent to Parse().
+     *
+     * @param encoding The encoding of the records.
+     * @param data The buffer to parse. It must consist of whole records only.
+     * @param records The output list of records, with the same semantics as
+     * for Parse().
+     * @param numThreads The maximum number of threads to use. If 0, the
+     * hardware concurrency is used.
+     * @param chunkSizeMinimum The minimum number of octets handed to a thread.
+     * @return Tlv::ParseResult Succeeded if the entire buffer was parsed,
+     * Failed otherwise.
+     */
+    static Tlv::ParseResult
+    ParseParallel(Encoding encoding, std::span<const uint8_t> data, std::vector<TlvRecord>& records, std::size_t numThreads = 0, std::size_t chunkSizeMinimum = ParallelChunkSizeMinimumDefault);
+};
+
+} // namespace encoding
+
+#endif // TLV_BATCH_PARSER_HXX
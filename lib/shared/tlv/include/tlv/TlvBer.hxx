@@ -2,20 +2,27 @@
 #ifndef TLV_BER_HXX
 #define TLV_BER_HXX
 
+#include <tlv/InlineOctets.hxx>
 #include <tlv/Tlv.hxx>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
 #include <span>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
 
 namespace encoding
 {
+class TlvBerView;
+
 /**
  * @brief Validates the given type is the TlvBer data unit type.
  * 
@@ -31,6 +38,14 @@ concept IsTlvBerDataUnitType = std::is_same_v<T, uint8_t>;
 class TlvBer : public Tlv
 {
 public:
+    /**
+     * @brief The allocator used for the value and nested TLVs; the tag is
+     * stored inline. Declaring this allows TlvBer to participate in
+     * uses-allocator construction, so nested TLVs stored in a TlvBer share its
+     * memory resource.
+     */
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     /**
      * @brief See ISO/IEC 7816-4, 2005-01-15 section 5.2.2.1 'BER-TLV tag
      * fields', Table 7.
@@ -61,6 +76,28 @@ public:
     static constexpr uint8_t TagValueLastByte = 0b10000000;
 
     static constexpr uint8_t MaxNumOctetsInLengthEncoding = 5;
+    static constexpr uint8_t MaxNumOctetsInTagEncoding = 3;
+
+    /**
+     * @brief The tag number of the universal class SET and SET OF types.
+     */
+    static constexpr uint32_t TagNumberUniversalSet = 17;
+
+    /**
+     * @brief Inline storage for an encoded tag.
+     */
+    using TagEncoding = InlineOctets<MaxNumOctetsInTagEncoding>;
+
+    /**
+     * @brief Inline storage for an encoded length.
+     */
+    using LengthEncoding = InlineOctets<MaxNumOctetsInLengthEncoding>;
+
+    /**
+     * @brief The minimum number of nested TLVs for which a tag index is built
+     * on lookup. Smaller constructed TLVs are searched linearly.
+     */
+    static constexpr std::size_t TagIndexSizeMinimum = 8;
 
     /**
      * @brief The class of the TLV.
@@ -115,17 +152,55 @@ public:
      * See ISO/IEC 7816-4, 2005-01-15 section 5.2.2.2 'BER-TLV length fields',
      * Table 8.
      * 
-     * @param length The length value to get the encoding for.
-     * @return std::vector<uint8_t> 
+     * @param length The length value to get the encoding for. Throws
+     * std::length_error if it needs more than MaxNumOctetsInLengthEncoding
+     * octets.
+     * @return LengthEncoding
      */
-    static std::vector<uint8_t>
+    static LengthEncoding
     GetLengthEncoding(std::size_t length);
 
+    /**
+     * @brief Get the number of octets needed to encode the length value.
+     *
+     * @param length The length value to get the encoding size for.
+     * @return std::size_t
+     */
+    static std::size_t
+    GetLengthEncodingSize(std::size_t length) noexcept;
+
+    /**
+     * @brief Get the numeric value of an encoded tag, which is the tag octets
+     * interpreted as a big-endian unsigned integer (eg. 0xBF78). This is the
+     * form of tag accepted by the lookup functions.
+     *
+     * @param tag The encoded tag.
+     * @return uint32_t
+     */
+    static constexpr uint32_t
+    GetTagValue(std::span<const uint8_t> tag) noexcept
+    {
+        uint32_t tagValue = 0;
+        for (const auto octet : tag) {
+            tagValue = (tagValue << 8U) | octet;
+        }
+
+        return tagValue;
+    }
+
     /**
      * @brief Construct a new TlvBer object with no tag and no value.
      */
     TlvBer() = default;
 
+    /**
+     * @brief Construct a new TlvBer object with no tag and no value, whose
+     * storage is obtained from the specified allocator.
+     *
+     * @param allocator The allocator to use.
+     */
+    explicit TlvBer(const allocator_type& allocator) noexcept;
+
     /**
      * @brief Construct a new TlvBer with given tag and value.
      * 
@@ -134,16 +209,60 @@ public:
      * @param tagNumber 
      * @param tag
      * @param value 
+     * @param allocator The allocator to use.
      */
-    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, const std::vector<uint8_t>& value);
+    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::span<const uint8_t> value, const allocator_type& allocator = {});
 
     /**
      * @brief Construct a new constructed TlvBer object.
      * 
      * @param tag The tag to use.
      * @param values The constructed values.
+     * @param allocator The allocator to use.
+     */
+    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::pmr::vector<TlvBer>& values, const allocator_type& allocator = {});
+
+    /**
+     * @brief Construct a copy of another TlvBer, using the specified allocator.
+     *
+     * @param other The TlvBer to copy.
+     * @param allocator The allocator to use.
      */
-    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, std::vector<TlvBer>& value);
+    TlvBer(const TlvBer& other, const allocator_type& allocator = {});
+
+    /**
+     * @brief Move-construct a TlvBer. The new TlvBer uses the allocator of
+     * other.
+     *
+     * @param other The TlvBer to move from.
+     */
+    TlvBer(TlvBer&& other) noexcept;
+
+    /**
+     * @brief Move-construct a TlvBer, using the specified allocator. The
+     * storage of other is only taken if it uses an equal allocator, otherwise
+     * it is copied.
+     *
+     * @param other The TlvBer to move from.
+     * @param allocator The allocator to use.
+     */
+    TlvBer(TlvBer&& other, const allocator_type& allocator);
+
+    TlvBer&
+    operator=(const TlvBer& other);
+
+    TlvBer&
+    operator=(TlvBer&& other);
+
+    ~TlvBer();
+
+    /**
+     * @brief Get the allocator this TlvBer obtains its storage from.
+     *
+     * @return allocator_type
+     */
+    allocator_type
+    get_allocator() const noexcept;
 
     /**
      * @brief Returns whether this TLV contains a constructed value.
@@ -154,6 +273,16 @@ public:
     bool
     IsConstructed() const noexcept;
 
+    /**
+     * @brief Returns whether this TLV was built in canonical (DER) mode (see
+     * Builder::SetCanonical()).
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsCanonical() const noexcept;
+
     /**
      * @brief Returns whether this TLV contains a primitive value.
      * 
@@ -198,25 +327,61 @@ public:
     /**
      * @brief Get the primitive value buffer. Returns empty if this object is Constructed
      * 
-     * @return std::vector<uint8_t> 
+     * @return const std::pmr::vector<uint8_t>&
      */
-    const std::vector<uint8_t>&
+    const std::pmr::vector<uint8_t>&
     GetValue() const noexcept;
 
     /**
      * @brief Get the Values object. Returns empty if this object is Primitive
      * 
-     * @return const std::vector<TlvBer> 
+     * @return const std::pmr::vector<TlvBer>&
      */
-    const std::vector<TlvBer>&
+    const std::pmr::vector<TlvBer>&
     GetValues() const noexcept;
 
+    /**
+     * @brief Find the first nested TLV with the specified tag.
+     *
+     * For constructed TLVs with at least TagIndexSizeMinimum nested TLVs, an
+     * index of the nested tags is built on the first lookup and used for all
+     * subsequent lookups. Building the index is thread-safe.
+     *
+     * @param tag The numeric value of the tag to find (see GetTagValue()).
+     * @return const TlvBer* The nested TLV, or nullptr if none has the tag.
+     */
+    const TlvBer*
+    Find(uint32_t tag) const;
+
+    /**
+     * @brief Find the nested TLV at the specified tag path. The path starts
+     * with the tag of this TLV, followed by the tag of each successively
+     * nested TLV, eg. Find({ 0xBF78, 0xA3, 0x9A }) on a UWB session data
+     * object yields its ranging interval parameter.
+     *
+     * @param path The numeric tag values of the path to follow.
+     * @return const TlvBer* The TLV at the end of the path, or nullptr if the
+     * path does not exist.
+     */
+    const TlvBer*
+    Find(std::initializer_list<uint32_t> path) const;
+
+    /**
+     * @brief Find all nested TLVs with the specified tag, in encoding order.
+     *
+     * @param tag The numeric value of the tag to find (see GetTagValue()).
+     * @return std::vector<const TlvBer*>
+     */
+    std::vector<const TlvBer*>
+    FindAll(uint32_t tag) const;
+
     /**
      * @brief Parses the tag portion of a BER-TLV from the specified buffer.
      * 
      * Writes to tlvClass, tlvType, tagNumber, tag, and bytesParsed if a proper
      * tag was parsed.
      * 
+     * @tparam TagContainer The type of container to write the tag to.
      * @tparam Iterable 
      * @param tlvClass 
      * @param tlvType 
@@ -226,9 +391,9 @@ public:
      * @param bytesParsed 
      * @return Tlv::ParseResult 
      */
-    template <typename Iterable>
+    template <typename TagContainer, typename Iterable>
     static Tlv::ParseResult
-    ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, std::vector<uint8_t>& tag, Iterable& data, std::size_t& bytesParsed)
+    ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, TagContainer& tag, Iterable& data, std::size_t& bytesParsed)
     {
         auto dataIt = std::cbegin(data);
         auto dataEnd = std::cend(data);
@@ -284,6 +449,23 @@ public:
         return Tlv::ParseResult::Succeeded;
     }
 
+    /**
+     * @brief Parses the tag portion of a BER-TLV from the specified buffer
+     * without copying the tag octets.
+     *
+     * Writes to tlvClass, tlvType, tagNumber, and bytesParsed if a proper tag
+     * was parsed. The tag octets are the first bytesParsed bytes of data.
+     *
+     * @param tlvClass
+     * @param tlvType
+     * @param tagNumber
+     * @param data
+     * @param bytesParsed
+     * @return Tlv::ParseResult
+     */
+    static Tlv::ParseResult
+    ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, std::span<const uint8_t> data, std::size_t& bytesParsed);
+
     /**
      * @brief Parses the tag portion of a BER-TLV from the specified buffer.
      * 
@@ -297,6 +479,19 @@ public:
     static Tlv::ParseResult
     ParseTag(Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, std::vector<uint8_t>& tag, uint8_t tagValue);
 
+    /**
+     * @brief Parses the tag portion of a BER-TLV from the specified buffer.
+     *
+     * @param tlvClass
+     * @param tlvType
+     * @param tagNumber
+     * @param tag
+     * @param tagValue
+     * @return Tlv::ParseResult
+     */
+    static Tlv::ParseResult
+    ParseTag(Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, TagEncoding& tag, uint8_t tagValue);
+
     /**
      * @brief Parses the length portion of a BER-TLV from the specified buffer.
      * 
@@ -351,6 +546,7 @@ public:
      * 
      * Writes to valueOutput if a proper value was parsed.
      * 
+     * @tparam ValueContainer The type of container to write the value to.
      * @tparam Iterable 
      * @param valueOutput 
      * @param length 
@@ -358,15 +554,15 @@ public:
      * @param bytesParsed The number of bytes parsed.
      * @return Tlv::ParseResult 
      */
-    template <typename Iterable>
+    template <typename ValueContainer, typename Iterable>
     static Tlv::ParseResult
-    ParsePrimitiveValue(std::vector<uint8_t>& valueOutput, std::size_t length, Iterable& data, std::size_t& bytesParsed)
+    ParsePrimitiveValue(ValueContainer& valueOutput, std::size_t length, Iterable& data, std::size_t& bytesParsed)
     {
         if (std::size(data) < length) {
             return Tlv::ParseResult::Failed;
         }
 
-        valueOutput = { std::cbegin(data), std::cbegin(data) + static_cast<long>(length) };
+        valueOutput.assign(std::cbegin(data), std::cbegin(data) + static_cast<long>(length));
         bytesParsed = length;
 
         return Tlv::ParseResult::Succeeded;
@@ -384,11 +580,14 @@ public:
      * @return Tlv::ParseResult 
      */
     static Tlv::ParseResult
-    ParseConstructedValue(std::vector<TlvBer>& valueOutput, size_t length, std::span<uint8_t> dataInput, size_t& bytesParsedOverall);
+    ParseConstructedValue(std::pmr::vector<TlvBer>& valueOutput, size_t length, std::span<uint8_t> dataInput, size_t& bytesParsedOverall);
 
     /**
      * @brief Decode a Tlv from a blob of BER-TLV data.
      * 
+     * Storage for the decoded Tlv, including all of its nested values, is
+     * obtained from the allocator of tlvOutput.
+     * 
      * @param tlvOutput The decoded Tlv, if parsing was successful (ParseResult::Succeeded).
      * @param dataInput The data to parse a Tlv from.
      * @param bytesParsedOverall 
@@ -421,6 +620,23 @@ public:
         return parseResult;
     }
 
+    /**
+     * @brief Decode a non-owning view of a Tlv from a blob of BER-TLV data.
+     *
+     * Unlike Parse(), no data is copied: the tag and value of the resulting
+     * view, and of all nested views obtained through it, refer directly to
+     * dataInput, which must therefore outlive them. The full structure is
+     * validated, so iterating the children of a successfully parsed view
+     * cannot fail.
+     *
+     * @param tlvOutput The decoded view, if parsing was successful (ParseResult::Succeeded).
+     * @param dataInput The data to parse a Tlv from.
+     * @param bytesParsedOverall The number of bytes comprising the decoded Tlv.
+     * @return Tlv::ParseResult The result of the parsing operation.
+     */
+    static Tlv::ParseResult
+    ParseView(TlvBerView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall);
+
     /**
      * @brief Encode this TlvBer into binary and return a vector of bytes.
      * 
@@ -429,6 +645,39 @@ public:
     std::vector<uint8_t>
     ToBytes() const;
 
+    /**
+     * @brief Get the number of bytes needed to encode this TlvBer, including
+     * the tag, length and value of all nested TLVs.
+     *
+     * The size is computed once when the TlvBer is constructed, so this is
+     * constant-time.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    EncodedSize() const noexcept;
+
+    /**
+     * @brief Encode this TlvBer into the specified buffer in a single forward
+     * pass, without any intermediate allocations.
+     *
+     * @param buffer The buffer to write to. This must hold at least
+     * EncodedSize() bytes.
+     * @return std::size_t The number of bytes written, or 0 if the buffer is
+     * too small to hold the encoding, in which case nothing is written.
+     */
+    std::size_t
+    WriteTo(std::span<uint8_t> buffer) const noexcept;
+
+    /**
+     * @brief Append the encoding of this TlvBer to the end of the specified
+     * buffer. The buffer grows at most once.
+     *
+     * @param buffer The buffer to append to.
+     */
+    void
+    AppendTo(std::vector<uint8_t>& buffer) const;
+
     /**
      * @brief Helper class to iteratively build a TlvBer. This allows separating
      * the creation logic from the main class and enables it to be immutable.
@@ -444,9 +693,26 @@ public:
      *      .AddTlv(0x81, tag81Value)
      *      .AddTlv(tlv)
      *      .Build();
+     *
+     * A memory resource may be supplied to the builder, in which case the
+     * built TlvBer, and all TLVs added to it, obtain their storage from it.
      */
     class Builder
     {
+    public:
+        /**
+         * @brief Construct a new Builder that uses the default memory resource.
+         */
+        Builder() = default;
+
+        /**
+         * @brief Construct a new Builder that obtains all storage, including
+         * that of the built TlvBer, from the specified memory resource.
+         *
+         * @param resource The memory resource to use.
+         */
+        explicit Builder(std::pmr::memory_resource* resource);
+
     private:
         /**
          * @brief Write a fixed-length array of data to the tlv storage buffer.
@@ -519,6 +785,7 @@ public:
         SetTag(Iterable& tag)
         {
             std::size_t bytesParsed = 0;
+            m_tag.clear();
             ParseTag(m_class, m_type, m_tagNumber, m_tag, tag, bytesParsed);
             return *this;
         }
@@ -557,7 +824,16 @@ public:
          * @return Builder& 
          */
         Builder&
-        AddTlv(TlvBer tlv);
+        AddTlv(const TlvBer& tlv);
+
+        /**
+         * @brief Add a pre-existing tlv to this tlv. This makes it a constructed TlvBer.
+         *
+         * @param tlv
+         * @return Builder&
+         */
+        Builder&
+        AddTlv(TlvBer&& tlv);
 
         /**
          * @brief Set the field members of this builder so that when Build is called it will create a copy Of Tlv object
@@ -568,6 +844,42 @@ public:
         Builder&
         SetAsCopyOfTlv(const TlvBer& tlv);
 
+        /**
+         * @brief Enable or disable canonical (DER) mode. This setting is
+         * retained across Reset().
+         *
+         * In canonical mode, the nested TLVs of SET-like TlvBers (see
+         * SetUnordered()) are sorted by tag class, then tag number, then
+         * encoding, as ITU-T X.690 sections 10.3 and 11.6 require for SET and
+         * SET OF types, so the order they were added in does not affect the
+         * output. The nested TLVs of other TlvBers keep the order they were
+         * added in, since it may carry meaning. Nested TLVs that were not
+         * built in canonical mode are made canonical too, which sorts their
+         * nested universal SET TLVs. Lengths are always minimally encoded.
+         *
+         * Each built TlvBer also caches its encoding, which is then reused
+         * when encoding it, or any TLV it is added to, instead of re-encoding
+         * its subtree; nested TLVs drop their own cached encoding once it is
+         * part of their parent's.
+         *
+         * @param canonical Whether to enable canonical mode.
+         * @return Builder&
+         */
+        Builder&
+        SetCanonical(bool canonical = true) noexcept;
+
+        /**
+         * @brief Mark the constructed TlvBer being built as SET-like, meaning
+         * the order of its nested TLVs carries no meaning, so canonical mode
+         * sorts them. Universal class SET TlvBers are always SET-like. This
+         * setting is cleared by Reset().
+         *
+         * @param unordered Whether the nested TLVs are unordered.
+         * @return Builder&
+         */
+        Builder&
+        SetUnordered(bool unordered = true) noexcept;
+
         /**
          * @brief Build and return the TlvBer.
          * 
@@ -609,22 +921,114 @@ public:
         TlvBer::Class m_class{ TlvBer::Class::Invalid };
         TlvBer::Type m_type{ TlvBer::Type::Primitive };
         uint32_t m_tagNumber{ 0 };
-        std::vector<uint8_t> m_tag;
-        std::vector<uint8_t> m_data;
-        std::vector<TlvBer> m_valuesConstructed;
+        TagEncoding m_tag;
+        std::pmr::vector<uint8_t> m_data;
+        std::pmr::vector<TlvBer> m_valuesConstructed;
+        bool m_canonical{ false };
+        bool m_unordered{ false };
     };
 
 public:
     bool
     operator==(const TlvBer&) const;
 
+private:
+    /**
+     * @brief Point the Tag and Value spans of the Tlv base at the storage
+     * owned by this TlvBer.
+     */
+    void
+    UpdateTlvSpans() noexcept;
+
+    /**
+     * @brief Write the encoding of this TlvBer to the specified output, which
+     * must hold at least EncodedSize() bytes.
+     *
+     * @param output The position to start writing at.
+     * @return uint8_t* The position following the last byte written.
+     */
+    uint8_t*
+    WriteEncoding(uint8_t* output) const noexcept;
+
+    /**
+     * @brief Encode this TlvBer and keep the encoding, so that it is used by
+     * all subsequent encodings of this TlvBer and of its parents. Does nothing
+     * if the encoding is already cached.
+     */
+    void
+    CacheEncoding();
+
+    /**
+     * @brief Free the cached encoding of this TlvBer, if any, including its
+     * storage.
+     */
+    void
+    ReleaseEncoding() noexcept;
+
+    /**
+     * @brief Make this TlvBer and its nested TLVs canonical, as if they were
+     * built in canonical mode, sorting the nested TLVs of universal SET TLVs.
+     * Does nothing if this TlvBer is already canonical.
+     */
+    void
+    Canonicalize();
+
+    /**
+     * @brief Determine whether this TlvBer is a universal class SET or SET OF.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsUniversalSet() const noexcept;
+
+    /**
+     * @brief Sort TLVs into canonical SET order: by tag class, then tag
+     * number, then encoding. The encodings of the TLVs must be cached.
+     *
+     * @param values The TLVs to sort.
+     */
+    static void
+    SortCanonical(std::pmr::vector<TlvBer>& values);
+
+    /**
+     * @brief Index of the nested TLVs, as (tag value, position) pairs sorted
+     * by tag value, then by position.
+     */
+    using TagIndex = std::pmr::vector<std::pair<uint32_t, std::size_t>>;
+
+    /**
+     * @brief Get the tag index of the nested TLVs, building it if it does not
+     * exist yet.
+     *
+     * @return const TagIndex&
+     */
+    const TagIndex&
+    GetTagIndex() const;
+
+    /**
+     * @brief Destroy the tag index, if it exists.
+     */
+    void
+    ResetTagIndex() noexcept;
+
 private:
     TlvBer::Class m_class{ TlvBer::Class::Invalid };
     TlvBer::Type m_type{ TlvBer::Type::Primitive };
     uint32_t m_tagNumber{ 0 };
-    std::vector<uint8_t> m_tag;
-    std::vector<uint8_t> m_value;
-    std::vector<TlvBer> m_valuesConstructed;
+    TagEncoding m_tag;
+    std::pmr::vector<uint8_t> m_value;
+    std::pmr::vector<TlvBer> m_valuesConstructed;
+    // Length of the encoded value, which for constructed TLVs is the total
+    // encoded size of all nested TLVs.
+    std::size_t m_valueLength{ 0 };
+    // Complete encoding of this TLV, cached for canonical TLVs that are not
+    // nested in another canonical TLV.
+    std::pmr::vector<uint8_t> m_encoding;
+    bool m_canonical{ false };
+    // Lazily built by lookups; published atomically so concurrent readers of
+    // a const TlvBer may race to build it.
+    mutable std::atomic<TagIndex*> m_tagIndex{ nullptr };
 };
 
 } // namespace encoding
@@ -0,0 +1,200 @@
+
+#ifndef TLV_BER_VIEW_HXX
+#define TLV_BER_VIEW_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <span>
+
+#include <notstd/range.hxx>
+#include <tlv/Tlv.hxx>
+#include <tlv/TlvBer.hxx>
+
+namespace encoding
+{
+/**
+ * @brief Non-owning view of a Basic Encoding Rules (BER) Tag-Length-Value
+ * (TLV) structure, as defined by ISO/IEC 8825-1:2015.
+ *
+ * The tag and value of a view refer to the buffer it was parsed from, which
+ * must outlive the view. The children of a constructed view are not decoded
+ * up-front; they are parsed on demand while iterating GetValues(). Views are
+ * obtained through TlvBer::ParseView().
+ */
+class TlvBerView : public Tlv
+{
+public:
+    class Iterator;
+
+    /**
+     * @brief Construct a new empty TlvBerView object.
+     */
+    TlvBerView() = default;
+
+    /**
+     * @brief Construct a new TlvBerView with given tag and value.
+     *
+     * @param tlvClass
+     * @param tlvType
+     * @param tagNumber
+     * @param tag The encoded tag.
+     * @param value The encoded value. For constructed views, this is the
+     * concatenated encoding of all children.
+     */
+    TlvBerView(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::span<const uint8_t> value) noexcept;
+
+    /**
+     * @brief Returns whether this TLV contains a constructed value.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsConstructed() const noexcept;
+
+    /**
+     * @brief Returns whether this TLV contains a primitive value.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsPrimitive() const noexcept;
+
+    /**
+     * @brief Returns the type of this TLV.
+     *
+     * @return TlvBer::Type
+     */
+    TlvBer::Type
+    GetType() const noexcept;
+
+    /**
+     * @brief Returns the class of this TLV.
+     *
+     * @return TlvBer::Class
+     */
+    TlvBer::Class
+    GetClass() const noexcept;
+
+    /**
+     * @brief Get the tagNumber of the TLV.
+     *
+     * @return uint32_t
+     */
+    uint32_t
+    GetTagNumber() const noexcept;
+
+    /**
+     * @brief Get the tag of the TLV.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetTag() const noexcept;
+
+    /**
+     * @brief Get the value buffer. For constructed views, this is the encoding
+     * of all children.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetValue() const noexcept;
+
+    /**
+     * @brief Get a range over the children of this TLV. Returns an empty range
+     * if this view is Primitive.
+     *
+     * @return notstd::iterator_range<Iterator>
+     */
+    notstd::iterator_range<Iterator>
+    GetValues() const noexcept;
+
+    /**
+     * @brief Find the first child with the specified tag. The children are
+     * scanned without decoding any of their values.
+     *
+     * @param tag The numeric value of the tag to find (see TlvBer::GetTagValue()).
+     * @return std::optional<TlvBerView> The child, or std::nullopt if none has the tag.
+     */
+    std::optional<TlvBerView>
+    Find(uint32_t tag) const noexcept;
+
+    /**
+     * @brief Find the nested view at the specified tag path. The path starts
+     * with the tag of this view, followed by the tag of each successively
+     * nested TLV (see TlvBer::Find()).
+     *
+     * @param path The numeric tag values of the path to follow.
+     * @return std::optional<TlvBerView> The view at the end of the path, or
+     * std::nullopt if the path does not exist.
+     */
+    std::optional<TlvBerView>
+    Find(std::initializer_list<uint32_t> path) const noexcept;
+
+private:
+    TlvBer::Class m_class{ TlvBer::Class::Invalid };
+    TlvBer::Type m_type{ TlvBer::Type::Primitive };
+    uint32_t m_tagNumber{ 0 };
+};
+
+/**
+ * @brief Forward iterator over the children of a constructed view.
+ */
+class TlvBerView::Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = TlvBerView;
+    using pointer = const TlvBerView*;
+    using reference = const TlvBerView&;
+
+    /**
+     * @brief Construct a new Iterator object that points at nothing.
+     */
+    Iterator() = default;
+
+    /**
+     * @brief Construct a new Iterator object pointing at the first child
+     * encoded in the specified buffer.
+     *
+     * @param data The encoded children, which must have been validated.
+     */
+    explicit Iterator(std::span<const uint8_t> data) noexcept;
+
+    reference
+    operator*() const noexcept;
+
+    pointer
+    operator->() const noexcept;
+
+    Iterator&
+    operator++() noexcept;
+
+    Iterator
+    operator++(int) noexcept;
+
+    bool
+    operator==(const Iterator& other) const noexcept;
+
+private:
+    /**
+     * @brief Decodes the child at the front of the remaining data, if any.
+     */
+    void
+    ParseCurrent() noexcept;
+
+private:
+    std::span<const uint8_t> m_remaining;
+    std::size_t m_currentSize{ 0 };
+    TlvBerView m_current{};
+};
+
+} // namespace encoding
+
+#endif // TLV_BER_VIEW_HXX
@@ -0,0 +1,702 @@
+
+#ifndef TLV_SCHEMA_HXX
+#define TLV_SCHEMA_HXX
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvSerialize.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Compile-time description of a constructed BER-TLV data object whose
+ * nested primitive TLVs map one-to-one to members of a C++ type.
+ *
+ * A schema lists, for each nested TLV, its tag, the member it holds and the
+ * rule used to encode the member into the value. Encoders and decoders are
+ * instantiated from the description, so no per-field dispatch happens at
+ * runtime beyond comparing tags. For example:
+ *
+ * using Schema = encoding::schema::Schema<0xA4,
+ *     encoding::schema::Field<0x80, &Foo::VendorId, encoding::schema::UnsignedBigEndian<uint16_t>>,
+ *     encoding::schema::Field<0x81, &Foo::Iv, encoding::schema::FixedOctets<6>>>;
+ *
+ * TlvBer tlv = Schema::Encode(foo);
+ * bool allFieldsDecoded = Schema::Decode(tlv, foo);
+ *
+ * A rule is any type providing:
+ *  - static constexpr std::size_t BufferSize, the maximum encoded size of a
+ *    value that is not stored contiguously in the member itself;
+ *  - static std::span<const uint8_t> Encode(const T&, std::span<uint8_t, BufferSize>),
+ *    which returns the encoded value, either within the buffer or referring
+ *    directly to the member;
+ *  - static bool Decode(std::span<const uint8_t>, T&), which returns whether
+ *    the value was valid and assigned.
+ *
+ * A rule may additionally provide static bool IsPresent(const T&), making the
+ * fields using it optional: they are omitted when encoding a member for which
+ * it returns false, and need not be present when decoding.
+ *
+ * A nested TLV whose value combines several members is described with
+ * ObjectField, whose rule applies to the whole object instead of one member.
+ */
+namespace encoding::schema
+{
+/**
+ * @brief Describes the rule requirements documented above for member type T.
+ *
+ * @tparam RuleT The rule type.
+ * @tparam T The type of member the rule applies to.
+ */
+template <typename RuleT, typename T>
+concept IsRuleFor = requires(const T& value, T& output, std::span<uint8_t, RuleT::BufferSize> buffer, std::span<const uint8_t> data) {
+    { RuleT::Encode(value, buffer) } -> std::convertible_to<std::span<const uint8_t>>;
+    { RuleT::Decode(data, output) } -> std::same_as<bool>;
+};
+
+/**
+ * @brief Describes a rule for member type T that makes the fields using it
+ * optional, as documented above.
+ *
+ * @tparam RuleT The rule type.
+ * @tparam T The type of member the rule applies to.
+ */
+template <typename RuleT, typename T>
+concept IsOptionalRuleFor = IsRuleFor<RuleT, T> && requires(const T& value) {
+    { RuleT::IsPresent(value) } -> std::same_as<bool>;
+};
+
+/**
+ * @brief Encodes an unsigned integer as a big-endian value of sizeof(IntegerT)
+ * octets. Shorter values are accepted when decoding.
+ *
+ * @tparam IntegerT The type of integer.
+ */
+template <typename IntegerT>
+requires std::is_unsigned_v<IntegerT>
+struct UnsignedBigEndian
+{
+    static constexpr std::size_t BufferSize = sizeof(IntegerT);
+
+    static std::span<const uint8_t>
+    Encode(const IntegerT& value, std::span<uint8_t, BufferSize> buffer) noexcept
+    {
+        for (std::size_t i = 0; i < BufferSize; i++) {
+            buffer[BufferSize - 1 - i] = static_cast<uint8_t>(static_cast<std::size_t>(value) >> (8U * i));
+        }
+        return buffer;
+    }
+
+    static bool
+    Decode(std::span<const uint8_t> data, IntegerT& value) noexcept
+    {
+        if (std::empty(data) || std::size(data) > BufferSize) {
+            return false;
+        }
+
+        std::size_t valueDecoded = 0;
+        for (const auto octet : data) {
+            valueDecoded = (valueDecoded << 8U) | octet;
+        }
+        value = static_cast<IntegerT>(valueDecoded);
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes an enumeration as a single octet holding its underlying
+ * value. Decoding rejects values greater than ValueMaximum.
+ *
+ * @tparam EnumT The enumeration type.
+ * @tparam ValueMaximum The enumeration value with the largest underlying value.
+ */
+template <typename EnumT, EnumT ValueMaximum>
+requires std::is_enum_v<EnumT>
+struct Enumeration
+{
+    static constexpr std::size_t BufferSize = 1;
+
+    static std::span<const uint8_t>
+    Encode(const EnumT& value, std::span<uint8_t, BufferSize> buffer) noexcept
+    {
+        buffer[0] = static_cast<uint8_t>(value);
+        return buffer;
+    }
+
+    static bool
+    Decode(std::span<const uint8_t> data, EnumT& value) noexcept
+    {
+        if (std::size(data) != 1 || data.front() > static_cast<std::underlying_type_t<EnumT>>(ValueMaximum)) {
+            return false;
+        }
+
+        value = static_cast<EnumT>(data.front());
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes a boolean as a single octet; any non-zero octet decodes as
+ * true.
+ */
+struct Boolean
+{
+    static constexpr std::size_t BufferSize = 1;
+
+    static std::span<const uint8_t>
+    Encode(const bool& value, std::span<uint8_t, BufferSize> buffer) noexcept
+    {
+        buffer[0] = value ? 1 : 0;
+        return buffer;
+    }
+
+    static bool
+    Decode(std::span<const uint8_t> data, bool& value) noexcept
+    {
+        if (std::empty(data)) {
+            return false;
+        }
+
+        value = (data.front() != 0);
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes a fixed-size octet array as-is. Decoding rejects values whose
+ * length differs from the size of the array.
+ *
+ * @tparam Size The size of the array.
+ */
+template <std::size_t Size>
+struct FixedOctets
+{
+    static constexpr std::size_t BufferSize = 0;
+
+    static std::span<const uint8_t>
+    Encode(const std::array<uint8_t, Size>& value, std::span<uint8_t, BufferSize>) noexcept
+    {
+        return value;
+    }
+
+    static bool
+    Decode(std::span<const uint8_t> data, std::array<uint8_t, Size>& value) noexcept
+    {
+        if (std::size(data) != Size) {
+            return false;
+        }
+
+        std::ranges::copy(data, std::begin(value));
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes a set of flag enumeration values, such as
+ * std::unordered_set<EnumT>, as a big-endian bitmap of sizeof(EnumT) octets
+ * holding the bitwise OR of their underlying values. Decoding yields each of
+ * the specified flags whose bits are set; other bits are ignored.
+ *
+ * @tparam EnumT The flag enumeration type.
+ * @tparam Flags The flags the bitmap may hold.
+ */
+template <typename EnumT, EnumT... Flags>
+requires std::is_enum_v<EnumT> && (sizeof...(Flags) > 0)
+struct Bitmap
+{
+    using BitmapT = std::make_unsigned_t<std::underlying_type_t<EnumT>>;
+
+    static constexpr std::size_t BufferSize = sizeof(BitmapT);
+
+    template <typename SetT>
+    static std::span<const uint8_t>
+    Encode(const SetT& value, std::span<uint8_t, BufferSize> buffer) noexcept
+    {
+        BitmapT bitmap = 0;
+        for (const auto flag : value) {
+            bitmap = static_cast<BitmapT>(bitmap | static_cast<BitmapT>(flag));
+        }
+        return UnsignedBigEndian<BitmapT>::Encode(bitmap, buffer);
+    }
+
+    template <typename SetT>
+    static bool
+    Decode(std::span<const uint8_t> data, SetT& value)
+    {
+        BitmapT bitmap = 0;
+        if (std::size(data) != BufferSize || !UnsignedBigEndian<BitmapT>::Decode(data, bitmap)) {
+            return false;
+        }
+
+        value.clear();
+        for (const auto flag : { Flags... }) {
+            if ((bitmap & static_cast<BitmapT>(flag)) != 0) {
+                value.insert(flag);
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes a FlagSet as its big-endian bitmap of FlagSet::NumBytes
+ * octets. Decoding rejects values of any other length; bits not in the table
+ * are discarded.
+ *
+ * @tparam BitIndexMapT The table mapping values to bits.
+ */
+template <const auto& BitIndexMapT>
+struct FlagSetBitmap
+{
+    using SetT = FlagSet<BitIndexMapT>;
+
+    static constexpr std::size_t BufferSize = SetT::NumBytes;
+
+    static std::span<const uint8_t>
+    Encode(const SetT& value, std::span<uint8_t, BufferSize> buffer) noexcept
+    {
+        WriteBytesBigEndian<BufferSize>(value.GetBits(), buffer);
+        return buffer;
+    }
+
+    static bool
+    Decode(std::span<const uint8_t> data, SetT& value) noexcept
+    {
+        if (std::size(data) != BufferSize) {
+            return false;
+        }
+
+        value = SetT::FromBytesBigEndian(data);
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes a MAC address as its octets. The address type must provide
+ * GetValue(), returning a view of its octets, and be constructible from
+ * std::array<uint8_t, Length> for each accepted length. Decoding rejects
+ * values whose length is not one of the accepted lengths.
+ *
+ * @tparam AddressT The address type.
+ * @tparam Lengths The accepted address lengths, in octets.
+ */
+template <typename AddressT, std::size_t... Lengths>
+requires(sizeof...(Lengths) > 0)
+struct MacAddress
+{
+    static constexpr std::size_t BufferSize = 0;
+
+    static std::span<const uint8_t>
+    Encode(const AddressT& value, std::span<uint8_t, BufferSize>) noexcept
+    {
+        return value.GetValue();
+    }
+
+    static bool
+    Decode(std::span<const uint8_t> data, AddressT& value)
+    {
+        // Stops at the first length matching the value, if any.
+        return (DecodeWithLength<Lengths>(data, value) || ...);
+    }
+
+private:
+    template <std::size_t Length>
+    static bool
+    DecodeWithLength(std::span<const uint8_t> data, AddressT& value)
+    {
+        if (std::size(data) != Length) {
+            return false;
+        }
+
+        std::array<uint8_t, Length> octets{};
+        std::ranges::copy(data, std::begin(octets));
+        value = AddressT(octets);
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes a variable-length octet container, such as std::vector<uint8_t>,
+ * as-is. Empty values are allowed.
+ */
+struct Octets
+{
+    static constexpr std::size_t BufferSize = 0;
+
+    template <typename ContainerT>
+    static std::span<const uint8_t>
+    Encode(const ContainerT& value, std::span<uint8_t, BufferSize>) noexcept
+    {
+        return value;
+    }
+
+    template <typename ContainerT>
+    static bool
+    Decode(std::span<const uint8_t> data, ContainerT& value)
+    {
+        value.assign(std::cbegin(data), std::cend(data));
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes the entry with a specific key of an associative container
+ * member using another rule. Encoding requires the entry to exist.
+ *
+ * @tparam Key The key of the entry.
+ * @tparam ValueRuleT The rule used to encode the value of the entry.
+ */
+template <auto Key, typename ValueRuleT>
+struct MapValue
+{
+    static constexpr std::size_t BufferSize = ValueRuleT::BufferSize;
+
+    template <typename MapT>
+    static std::span<const uint8_t>
+    Encode(const MapT& value, std::span<uint8_t, BufferSize> buffer)
+    {
+        return ValueRuleT::Encode(value.at(Key), buffer);
+    }
+
+    template <typename MapT>
+    static bool
+    Decode(std::span<const uint8_t> data, MapT& value)
+    {
+        typename MapT::mapped_type valueDecoded{};
+        if (!ValueRuleT::Decode(data, valueDecoded)) {
+            return false;
+        }
+
+        value.insert_or_assign(Key, std::move(valueDecoded));
+        return true;
+    }
+};
+
+/**
+ * @brief Encodes the optional entry with a specific key of an associative
+ * container member whose values are std::variant, using another rule for the
+ * specified alternative. Fields using this rule are omitted when encoding if
+ * the entry is absent or holds another alternative, and are not required when
+ * decoding.
+ *
+ * @tparam Key The key of the entry.
+ * @tparam AlternativeT The variant alternative held by the entry.
+ * @tparam ValueRuleT The rule used to encode the alternative.
+ */
+template <auto Key, typename AlternativeT, typename ValueRuleT>
+struct VariantMapValue
+{
+    static constexpr std::size_t BufferSize = ValueRuleT::BufferSize;
+
+    template <typename MapT>
+    static bool
+    IsPresent(const MapT& value)
+    {
+        return value.contains(Key) && std::holds_alternative<AlternativeT>(value.at(Key));
+    }
+
+    template <typename MapT>
+    static std::span<const uint8_t>
+    Encode(const MapT& value, std::span<uint8_t, BufferSize> buffer)
+    {
+        return ValueRuleT::Encode(std::get<AlternativeT>(value.at(Key)), buffer);
+    }
+
+    template <typename MapT>
+    static bool
+    Decode(std::span<const uint8_t> data, MapT& value)
+    {
+        AlternativeT valueDecoded{};
+        if (!ValueRuleT::Decode(data, valueDecoded)) {
+            return false;
+        }
+
+        value.insert_or_assign(Key, std::move(valueDecoded));
+        return true;
+    }
+};
+
+namespace detail
+{
+/**
+ * @brief Compile-time decomposition of a numeric tag value (see
+ * TlvBer::GetTagValue()) into the properties TlvBer requires, matching what
+ * TlvBer::ParseTag() produces.
+ *
+ * @tparam TagValue The numeric tag value.
+ */
+template <uint32_t TagValue>
+struct TagTraits
+{
+    static constexpr std::size_t Size = (TagValue > 0xFFFFU) ? 3 : (TagValue > 0xFFU) ? 2 : 1;
+
+    static constexpr std::array<uint8_t, Size> Octets = [] {
+        std::array<uint8_t, Size> octets{};
+        for (std::size_t i = 0; i < Size; i++) {
+            octets[Size - 1 - i] = static_cast<uint8_t>(TagValue >> (8U * i));
+        }
+        return octets;
+    }();
+
+    static constexpr TlvBer::Class Class = [] {
+        switch (Octets[0] & TlvBer::BitmaskClass) {
+        case TlvBer::ClassUniversal:
+            return TlvBer::Class::Universal;
+        case TlvBer::ClassApplication:
+            return TlvBer::Class::Application;
+        case TlvBer::ClassContextSpecific:
+            return TlvBer::Class::ContextSpecific;
+        default:
+            return TlvBer::Class::Private;
+        }
+    }();
+
+    static constexpr TlvBer::Type Type = ((Octets[0] & TlvBer::BitmaskType) == TlvBer::TypeConstructed) ? TlvBer::Type::Constructed : TlvBer::Type::Primitive;
+
+    static constexpr uint32_t Number = [] {
+        if constexpr (Size == 1) {
+            return static_cast<uint32_t>(Octets[0] & TlvBer::BitmaskTagShort);
+        } else {
+            uint32_t number = 0;
+            for (std::size_t i = 1; i < Size; i++) {
+                number = (number << 8U) | (Octets[i] & TlvBer::BitmaskTagLong);
+            }
+            return number;
+        }
+    }();
+
+    static_assert(Size == 1 || (Octets[0] & TlvBer::BitmaskTagFirstByte) == TlvBer::TagValueLongField, "multi-octet tags must indicate a long tag field");
+};
+} // namespace detail
+
+/**
+ * @brief Describes a nested primitive TLV holding one member of ObjectT.
+ *
+ * @tparam TagValue The numeric tag value of the TLV.
+ * @tparam Member Pointer to the member holding the value.
+ * @tparam RuleT The rule used to encode the member.
+ */
+template <uint32_t TagValue, auto Member, typename RuleT>
+struct Field;
+
+template <uint32_t TagValue, typename ObjectT, typename MemberT, MemberT ObjectT::*Member, typename RuleT>
+requires IsRuleFor<RuleT, MemberT>
+struct Field<TagValue, Member, RuleT>
+{
+    using Object = ObjectT;
+    using TagTraits = detail::TagTraits<TagValue>;
+
+    static constexpr uint32_t Tag = TagValue;
+    static constexpr bool Optional = IsOptionalRuleFor<RuleT, MemberT>;
+
+    static_assert(TagTraits::Type == TlvBer::Type::Primitive, "fields must have a primitive tag");
+
+    /**
+     * @brief Append the TLV encoding the member of the specified object, unless
+     * the field is optional and the member holds no value.
+     *
+     * @param object The object to encode the member of.
+     * @param values The nested TLVs to append to.
+     */
+    static void
+    Encode(const ObjectT& object, std::pmr::vector<TlvBer>& values)
+    {
+        if constexpr (Optional) {
+            if (!RuleT::IsPresent(object.*Member)) {
+                return;
+            }
+        }
+
+        std::array<uint8_t, RuleT::BufferSize> buffer{};
+        auto value = RuleT::Encode(object.*Member, std::span<uint8_t, RuleT::BufferSize>{ buffer });
+        values.emplace_back(TagTraits::Class, TagTraits::Type, TagTraits::Number, std::span<const uint8_t>{ TagTraits::Octets }, value);
+    }
+
+    /**
+     * @brief Decode the value of a TLV into the member of the specified object.
+     *
+     * @param data The value of the TLV.
+     * @param object The object to decode the member into.
+     * @return true If the value was valid.
+     * @return false Otherwise.
+     */
+    static bool
+    Decode(std::span<const uint8_t> data, ObjectT& object)
+    {
+        return RuleT::Decode(data, object.*Member);
+    }
+};
+
+/**
+ * @brief Describes a nested primitive TLV whose value combines several members
+ * of ObjectT, encoded by a rule that applies to the whole object.
+ *
+ * @tparam TagValue The numeric tag value of the TLV.
+ * @tparam ObjectT The type holding the members.
+ * @tparam RuleT The rule used to encode the object.
+ */
+template <uint32_t TagValue, typename ObjectT, typename RuleT>
+requires IsRuleFor<RuleT, ObjectT>
+struct ObjectField
+{
+    using Object = ObjectT;
+    using TagTraits = detail::TagTraits<TagValue>;
+
+    static constexpr uint32_t Tag = TagValue;
+    static constexpr bool Optional = IsOptionalRuleFor<RuleT, ObjectT>;
+
+    static_assert(TagTraits::Type == TlvBer::Type::Primitive, "fields must have a primitive tag");
+
+    /**
+     * @brief Append the TLV encoding the specified object, unless the field is
+     * optional and the object holds no value for it.
+     *
+     * @param object The object to encode.
+     * @param values The nested TLVs to append to.
+     */
+    static void
+    Encode(const ObjectT& object, std::pmr::vector<TlvBer>& values)
+    {
+        if constexpr (Optional) {
+            if (!RuleT::IsPresent(object)) {
+                return;
+            }
+        }
+
+        std::array<uint8_t, RuleT::BufferSize> buffer{};
+        auto value = RuleT::Encode(object, std::span<uint8_t, RuleT::BufferSize>{ buffer });
+        values.emplace_back(TagTraits::Class, TagTraits::Type, TagTraits::Number, std::span<const uint8_t>{ TagTraits::Octets }, value);
+    }
+
+    /**
+     * @brief Decode the value of a TLV into the specified object.
+     *
+     * @param data The value of the TLV.
+     * @param object The object to decode into.
+     * @return true If the value was valid.
+     * @return false Otherwise.
+     */
+    static bool
+    Decode(std::span<const uint8_t> data, ObjectT& object)
+    {
+        return RuleT::Decode(data, object);
+    }
+};
+
+/**
+ * @brief Describes a constructed TLV whose nested TLVs are the specified fields.
+ *
+ * @tparam TagValue The numeric tag value of the constructed TLV.
+ * @tparam FieldTs The fields, in encoding order.
+ */
+template <uint32_t TagValue, typename FieldT, typename... FieldTs>
+struct Schema
+{
+    using Object = typename FieldT::Object;
+    using TagTraits = detail::TagTraits<TagValue>;
+
+    static constexpr uint32_t Tag = TagValue;
+    static constexpr std::size_t NumFields = 1 + sizeof...(FieldTs);
+
+    static_assert(TagTraits::Type == TlvBer::Type::Constructed, "schemas must have a constructed tag");
+    static_assert((std::is_same_v<Object, typename FieldTs::Object> && ...), "all fields must belong to the same type");
+    static_assert(
+        [] {
+            std::array<uint32_t, NumFields> tags{ FieldT::Tag, FieldTs::Tag... };
+            std::ranges::sort(tags);
+            return std::ranges::adjacent_find(tags) == std::cend(tags);
+        }(),
+        "field tags must be unique");
+
+    /**
+     * @brief Encode the specified object.
+     *
+     * @param object The object to encode.
+     * @param allocator The allocator to use for the resulting TlvBer.
+     * @return TlvBer
+     */
+    static TlvBer
+    Encode(const Object& object, const TlvBer::allocator_type& allocator = {})
+    {
+        std::pmr::vector<TlvBer> values(allocator);
+        values.reserve(NumFields);
+        FieldT::Encode(object, values);
+        (FieldTs::Encode(object, values), ...);
+        return TlvBer{ TagTraits::Class, TagTraits::Type, TagTraits::Number, std::span<const uint8_t>{ TagTraits::Octets }, values, allocator };
+    }
+
+    /**
+     * @brief Decode the nested TLVs of the specified TlvBer or TlvBerView into
+     * the specified object. Nested TLVs with unknown tags are ignored.
+     *
+     * @tparam TlvT The type of TLV to decode, TlvBer or TlvBerView.
+     * @param tlv The TLV to decode.
+     * @param object The object to decode into.
+     * @return true If every present field was decoded from a valid value and
+     * every non-optional field was present.
+     * @return false Otherwise.
+     */
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, Object& object)
+    {
+        std::bitset<NumFields> fieldsDecoded{};
+        std::bitset<NumFields> fieldsInvalid{};
+        for (const auto& value : tlv.GetValues()) {
+            DecodeField(TlvBer::GetTagValue(value.GetTag()), value.GetValue(), object, fieldsDecoded, fieldsInvalid, std::make_index_sequence<NumFields>{});
+        }
+
+        return fieldsInvalid.none() && AreRequiredFieldsDecoded(fieldsDecoded, std::make_index_sequence<NumFields>{});
+    }
+
+private:
+    template <std::size_t Index>
+    using FieldAt = std::tuple_element_t<Index, std::tuple<FieldT, FieldTs...>>;
+
+    template <std::size_t... Indices>
+    static void
+    DecodeField(uint32_t tag, std::span<const uint8_t> data, Object& object, std::bitset<NumFields>& fieldsDecoded, std::bitset<NumFields>& fieldsInvalid, std::index_sequence<Indices...>)
+    {
+        auto decodeFieldAt = [&]<std::size_t Index>() {
+            if (tag != FieldAt<Index>::Tag) {
+                return false;
+            }
+            if (FieldAt<Index>::Decode(data, object)) {
+                fieldsDecoded.set(Index);
+            } else {
+                fieldsInvalid.set(Index);
+            }
+            return true;
+        };
+
+        // Stops at the first field with a matching tag, if any.
+        (decodeFieldAt.template operator()<Indices>() || ...);
+    }
+
+    template <std::size_t... Indices>
+    static bool
+    AreRequiredFieldsDecoded(const std::bitset<NumFields>& fieldsDecoded, std::index_sequence<Indices...>) noexcept
+    {
+        return ((FieldAt<Indices>::Optional || fieldsDecoded.test(Indices)) && ...);
+    }
+};
+
+} // namespace encoding::schema
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+
+#endif // TLV_SCHEMA_HXX
@@ -1,114 +1,664 @@
-
-#ifndef TLV_SERIALIZE_HXX
-#define TLV_SERIALIZE_HXX
-
-#include <cstdint>
-#include <span>
-#include <type_traits>
-#include <unordered_map>
-#include <vector>
-
-namespace encoding
-{
-/**
- * @brief Get the Bit Mask From Bit Index object
- *
- * @param bitIndex
- * @return std::size_t
- */
-std::size_t
-GetBitMaskFromBitIndex(std::size_t bitIndex);
-
-/**
- * @brief Get the Bit Index From Bit Mask object.
- *
- * @param bitMask
- * @return std::size_t
- */
-std::size_t
-GetBitIndexFromBitMask(std::size_t bitMask);
-
-/**
- * @brief Get the Bytes Big Endian From std::size_t
- *
- * @param value the bitmap to encode
- * @param desiredLength the desired number of bytes in the encoding, padding with zeros if necessary.
- *                      If the value is too large, this will only encode the lowest desiredLength bytes
- * @return std::vector<uint8_t>
- */
-std::vector<uint8_t>
-GetBytesBigEndianFromBitMap(std::size_t value, std::size_t desiredLength);
-
-/**
- * @brief Parses a span of bytes as a std::size_t number encoded in big endian.
- *
- * @tparam IntegerT The type of output integer.
- * @param bytes The buffer to parse.
- * @return
- */
-template <typename IntegerT = std::size_t>
-// clang-format off
-requires std::is_unsigned_v<IntegerT>
-IntegerT
-// clang-format on
-ReadSizeTFromBytesBigEndian(std::span<const uint8_t> bytes)
-{
-    std::size_t rvalue = 0;
-
-    if (bytes.size() >= sizeof rvalue) {
-        return 0; // TODO throw error? this isn't really part of an interface so may not be necessary
-    }
-
-    for (std::size_t i = 0; i < bytes.size(); i++) {
-        rvalue *= 0x100;
-        rvalue += bytes[i];
-    }
-    return static_cast<IntegerT>(rvalue);
-}
-
-/**
- * @brief helper function that writes the bitset for a given valueSet according to bitIndexMap, using desiredLength bytes
- *
- * @tparam T
- * @param assignee the destination of the bitset
- * @param bitIndexMap
- * @param bytes
- */
-template <class T>
-std::vector<T>
-AssignValuesFromBytes(const std::unordered_map<T, std::size_t>& bitIndexMap, std::span<const uint8_t> bytes)
-{
-    std::vector<T> assignee;
-    auto bitmasks = ReadSizeTFromBytesBigEndian(bytes);
-    for (const auto& [key, value] : bitIndexMap) {
-        if (bitmasks & GetBitMaskFromBitIndex(value)) {
-            assignee.push_back(key);
-        }
-    }
-    return assignee;
-}
-
-/**
- * @brief helper function to encode a given valueSet into a bitset according to bitIndexMap, using desiredLength bytes
- *
- * @tparam T
- * @param valueSet
- * @param bitIndexMap
- * @param desiredLength
- * @return std::vector<uint8_t>
- */
-template <class T>
-std::vector<uint8_t>
-EncodeValuesAsBytes(const std::vector<T>& valueSet, const std::unordered_map<T, std::size_t>& bitIndexMap, std::size_t desiredLength)
-{
-    std::size_t valueSetEncoded = 0;
-    for (const auto& value : valueSet) {
-        auto bitIndex = bitIndexMap.at(value);
-        valueSetEncoded |= GetBitMaskFromBitIndex(bitIndex);
-    }
-    return encoding::GetBytesBigEndianFromBitMap(valueSetEncoded, desiredLength);
-}
-
-} // namespace encoding
-
-#endif // TLV_SERIALIZE_HXX
+
+#ifndef TLV_SERIALIZE_HXX
+#define TLV_SERIALIZE_HXX
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace encoding
+{
+/**
+ * @brief Get the Bit Mask From Bit Index object
+ *
+ * @param bitIndex
+ * @return std::size_t
+ */
+std::size_t
+GetBitMaskFromBitIndex(std::size_t bitIndex);
+
+/**
+ * @brief Get the Bit Index From Bit Mask object.
+ *
+ * @param bitMask A mask with exactly one bit set.
+ * @return std::size_t
+ */
+std::size_t
+GetBitIndexFromBitMask(std::size_t bitMask);
+
+/**
+ * @brief Get the Bytes Big Endian From std::size_t
+ *
+ * @param value the bitmap to encode
+ * @param desiredLength the desired number of bytes in the encoding, padding with zeros if necessary.
+ *                      If the value is too large, this will only encode the lowest desiredLength bytes
+ * @return std::vector<uint8_t>
+ */
+std::vector<uint8_t>
+GetBytesBigEndianFromBitMap(std::size_t value, std::size_t desiredLength);
+
+/**
+ * @brief Writes the lowest bytes of an unsigned integer to a fixed-size
+ * buffer in big endian order.
+ *
+ * @tparam NumBytes The number of bytes to write. If the value is too large,
+ * only its lowest NumBytes bytes are written.
+ * @tparam IntegerT The type of the integer to write.
+ * @param value The value to write.
+ * @param bytes The destination buffer.
+ */
+template <std::size_t NumBytes, typename IntegerT>
+// clang-format off
+requires std::is_unsigned_v<IntegerT> && (NumBytes <= sizeof(uint64_t))
+constexpr void
+// clang-format on
+WriteBytesBigEndian(IntegerT value, std::span<uint8_t, NumBytes> bytes) noexcept
+{
+    auto valueWide = static_cast<uint64_t>(value);
+    for (std::size_t i = NumBytes; i > 0; i--) {
+        bytes[i - 1] = static_cast<uint8_t>(valueWide & 0xFFU);
+        valueWide >>= CHAR_BIT;
+    }
+}
+
+/**
+ * @brief Get the big endian encoding of an unsigned integer in a fixed-size
+ * array.
+ *
+ * @tparam NumBytes The number of bytes in the encoding, padding with zeros if
+ * necessary. If the value is too large, only its lowest NumBytes bytes are
+ * encoded.
+ * @tparam IntegerT The type of the integer to encode.
+ * @param value The value to encode.
+ * @return std::array<uint8_t, NumBytes>
+ */
+template <std::size_t NumBytes, typename IntegerT>
+// clang-format off
+requires std::is_unsigned_v<IntegerT> && (NumBytes <= sizeof(uint64_t))
+constexpr std::array<uint8_t, NumBytes>
+// clang-format on
+GetBytesBigEndian(IntegerT value) noexcept
+{
+    std::array<uint8_t, NumBytes> bytes{};
+    WriteBytesBigEndian<NumBytes>(value, std::span<uint8_t, NumBytes>{ bytes });
+    return bytes;
+}
+
+/**
+ * @brief Parses a span of bytes as a std::size_t number encoded in big endian.
+ *
+ * @tparam IntegerT The type of output integer.
+ * @param bytes The buffer to parse.
+ * @return
+ */
+template <typename IntegerT = std::size_t>
+// clang-format off
+requires std::is_unsigned_v<IntegerT>
+IntegerT
+// clang-format on
+ReadSizeTFromBytesBigEndian(std::span<const uint8_t> bytes)
+{
+    std::size_t rvalue = 0;
+
+    if (bytes.size() >= sizeof rvalue) {
+        return 0; // TODO throw error? this isn't really part of an interface so may not be necessary
+    }
+
+    for (std::size_t i = 0; i < bytes.size(); i++) {
+        rvalue *= 0x100;
+        rvalue += bytes[i];
+    }
+    return static_cast<IntegerT>(rvalue);
+}
+
+/**
+ * @brief Parses a span of at most 8 bytes as an unsigned integer encoded in
+ * big endian.
+ *
+ * @tparam IntegerT The type of output integer.
+ * @param bytes The buffer to parse.
+ * @return IntegerT The parsed value, truncated to the width of IntegerT.
+ */
+template <typename IntegerT = uint64_t>
+// clang-format off
+requires std::is_unsigned_v<IntegerT>
+constexpr IntegerT
+// clang-format on
+ReadBytesBigEndian(std::span<const uint8_t> bytes)
+{
+    if (bytes.size() > sizeof(uint64_t)) {
+        throw std::length_error("big endian encoding exceeds 64 bits");
+    }
+
+    uint64_t value = 0;
+    for (const auto byte : bytes) {
+        value = (value << CHAR_BIT) | byte;
+    }
+    return static_cast<IntegerT>(value);
+}
+
+/**
+ * @brief Maps a value to a small, dense integer key that is used to index the
+ * value-to-bit lookup table of a BitIndexMap.
+ *
+ * Enumerations use their underlying value. Other types may specialize this
+ * template to provide their own key.
+ *
+ * @tparam T The type of value to map.
+ */
+template <typename T>
+struct BitIndexKey
+{
+    static constexpr std::size_t
+    Get(T value) noexcept
+    requires std::is_enum_v<T>
+    {
+        return static_cast<std::size_t>(value);
+    }
+};
+
+/**
+ * @brief A compile-time table that maps values to bit indices in a bitmap of
+ * at most 64 bits, and back.
+ *
+ * Both directions of the mapping are resolved by indexing an array, so
+ * encoding and decoding a bitmap is proportional to the number of values
+ * (bits) present rather than the number of values defined.
+ *
+ * @tparam T The type of value held in the bitmap.
+ * @tparam NumEntries The number of values defined in the table.
+ */
+template <typename T, std::size_t NumEntries>
+class BitIndexMap
+{
+public:
+    using ValueType = T;
+
+    /**
+     * @brief The maximum number of bits in a bitmap.
+     */
+    static constexpr std::size_t BitsMaximum = sizeof(uint64_t) * CHAR_BIT;
+
+    /**
+     * @brief The number of distinct keys supported in the value-to-bit lookup
+     * table. Keys (see BitIndexKey) must be smaller than this.
+     */
+    static constexpr std::size_t KeysMaximum = 64;
+
+    /**
+     * @brief Construct a new Bit Index Map object. When evaluated at compile
+     * time, an invalid table is a compile error.
+     *
+     * @param entries The values and their associated bit indices.
+     */
+    constexpr explicit BitIndexMap(const std::array<std::pair<T, std::size_t>, NumEntries>& entries)
+    {
+        m_bitIndexFromKey.fill(IndexInvalid);
+        m_entryFromBitIndex.fill(IndexInvalid);
+
+        for (std::size_t i = 0; i < NumEntries; i++) {
+            const auto& [value, bitIndex] = entries[i];
+            const auto key = BitIndexKey<T>::Get(value);
+            if (bitIndex >= BitsMaximum || key >= KeysMaximum) {
+                throw std::out_of_range("bit index map entry out of range");
+            }
+            if (m_bitIndexFromKey[key] != IndexInvalid || m_entryFromBitIndex[bitIndex] != IndexInvalid) {
+                throw std::invalid_argument("bit index map entries must be unique");
+            }
+
+            m_values[i] = value;
+            m_bitIndexFromKey[key] = static_cast<uint8_t>(bitIndex);
+            m_entryFromBitIndex[bitIndex] = static_cast<uint8_t>(i);
+            m_mask |= uint64_t{ 1 } << bitIndex;
+        }
+    }
+
+    /**
+     * @brief Get the bit index of the specified value.
+     *
+     * @param value The value to look up.
+     * @return std::optional<std::size_t> The bit index, if the value is in the table.
+     */
+    constexpr std::optional<std::size_t>
+    GetBitIndex(const T& value) const noexcept
+    {
+        const auto key = BitIndexKey<T>::Get(value);
+        if (key >= KeysMaximum || m_bitIndexFromKey[key] == IndexInvalid) {
+            return std::nullopt;
+        }
+        return m_bitIndexFromKey[key];
+    }
+
+    /**
+     * @brief Get the value associated with the specified bit index.
+     *
+     * @param bitIndex The bit index to look up.
+     * @return std::optional<T> The value, if the bit index is in the table.
+     */
+    constexpr std::optional<T>
+    GetValue(std::size_t bitIndex) const noexcept
+    {
+        if (bitIndex >= BitsMaximum || m_entryFromBitIndex[bitIndex] == IndexInvalid) {
+            return std::nullopt;
+        }
+        return m_values[m_entryFromBitIndex[bitIndex]];
+    }
+
+    /**
+     * @brief Get the mask of all bits defined in the table.
+     *
+     * @return uint64_t
+     */
+    constexpr uint64_t
+    GetMask() const noexcept
+    {
+        return m_mask;
+    }
+
+    /**
+     * @brief Get the values defined in the table, in the order they were
+     * specified.
+     *
+     * @return const std::array<T, NumEntries>&
+     */
+    constexpr const std::array<T, NumEntries>&
+    GetValues() const noexcept
+    {
+        return m_values;
+    }
+
+    /**
+     * @brief Encode a collection of values as a bitmap. Values not in the
+     * table are ignored.
+     *
+     * @tparam RangeT The type of collection.
+     * @param values The values to encode.
+     * @return uint64_t
+     */
+    template <typename RangeT>
+    constexpr uint64_t
+    Encode(const RangeT& values) const noexcept
+    {
+        uint64_t bits = 0;
+        for (const auto& value : values) {
+            if (const auto bitIndex = GetBitIndex(value)) {
+                bits |= uint64_t{ 1 } << *bitIndex;
+            }
+        }
+        return bits;
+    }
+
+    /**
+     * @brief Decode a bitmap to the values it holds, in bit index order. Bits
+     * not in the table are ignored.
+     *
+     * @param bits The bitmap to decode.
+     * @return std::vector<T>
+     */
+    std::vector<T>
+    Decode(uint64_t bits) const
+    {
+        std::vector<T> values;
+        bits &= m_mask;
+        values.reserve(static_cast<std::size_t>(std::popcount(bits)));
+        for (; bits != 0; bits &= bits - 1) {
+            values.push_back(m_values[m_entryFromBitIndex[static_cast<std::size_t>(std::countr_zero(bits))]]);
+        }
+        return values;
+    }
+
+private:
+    static constexpr uint8_t IndexInvalid = 0xFFU;
+
+    std::array<T, NumEntries> m_values{};
+    std::array<uint8_t, KeysMaximum> m_bitIndexFromKey{};
+    std::array<uint8_t, BitsMaximum> m_entryFromBitIndex{};
+    uint64_t m_mask{ 0 };
+};
+
+/**
+ * @brief Make a BitIndexMap from explicit value and bit index pairs.
+ *
+ * @tparam T The type of value held in the bitmap.
+ * @tparam NumEntries The number of values.
+ * @param entries The values and their associated bit indices.
+ * @return constexpr BitIndexMap<T, NumEntries>
+ */
+template <typename T, std::size_t NumEntries>
+constexpr BitIndexMap<T, NumEntries>
+MakeBitIndexMap(const std::pair<T, std::size_t> (&entries)[NumEntries])
+{
+    std::array<std::pair<T, std::size_t>, NumEntries> entriesArray{};
+    std::copy(std::begin(entries), std::end(entries), std::begin(entriesArray));
+    return BitIndexMap<T, NumEntries>{ entriesArray };
+}
+
+/**
+ * @brief Make a BitIndexMap where each value occupies the bit matching its
+ * position in the specified list.
+ *
+ * @tparam T The type of value held in the bitmap.
+ * @tparam NumEntries The number of values.
+ * @param values The values, in bit index order.
+ * @return constexpr BitIndexMap<T, NumEntries>
+ */
+template <typename T, std::size_t NumEntries>
+constexpr BitIndexMap<T, NumEntries>
+MakeBitIndexMapSequential(const T (&values)[NumEntries])
+{
+    std::array<std::pair<T, std::size_t>, NumEntries> entries{};
+    for (std::size_t i = 0; i < NumEntries; i++) {
+        entries[i] = { values[i], i };
+    }
+    return BitIndexMap<T, NumEntries>{ entries };
+}
+
+/**
+ * @brief Make a BitIndexMap for a contiguous range of enumeration values,
+ * where each value occupies the bit matching its offset from the first value.
+ *
+ * @tparam EnumT The enumeration type.
+ * @tparam First The first value in the range.
+ * @tparam Last The last value in the range, inclusive.
+ * @return constexpr auto
+ */
+template <typename EnumT, EnumT First, EnumT Last>
+// clang-format off
+requires std::is_enum_v<EnumT> && (static_cast<std::underlying_type_t<EnumT>>(First) <= static_cast<std::underlying_type_t<EnumT>>(Last))
+constexpr auto
+// clang-format on
+MakeBitIndexMapFromRange()
+{
+    using UnderlyingT = std::underlying_type_t<EnumT>;
+    constexpr auto NumEntries = static_cast<std::size_t>(static_cast<UnderlyingT>(Last) - static_cast<UnderlyingT>(First)) + 1;
+
+    std::array<std::pair<EnumT, std::size_t>, NumEntries> entries{};
+    for (std::size_t i = 0; i < NumEntries; i++) {
+        entries[i] = { static_cast<EnumT>(static_cast<UnderlyingT>(First) + static_cast<UnderlyingT>(i)), i };
+    }
+    return BitIndexMap<EnumT, NumEntries>{ entries };
+}
+
+/**
+ * @brief A set of values stored as a bitmap, with bit assignments given by a
+ * compile-time BitIndexMap.
+ *
+ * @tparam BitIndexMapT The table mapping values to bits. This must be an
+ * object with static storage duration.
+ */
+template <const auto& BitIndexMapT>
+class FlagSet
+{
+public:
+    using ValueType = typename std::remove_cvref_t<decltype(BitIndexMapT)>::ValueType;
+
+    /**
+     * @brief Iterator over the values held in the set, in bit index order.
+     */
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = ValueType;
+        using reference = ValueType;
+
+        constexpr ConstIterator() = default;
+
+        constexpr ValueType
+        operator*() const noexcept
+        {
+            return *BitIndexMapT.GetValue(static_cast<std::size_t>(std::countr_zero(m_remaining)));
+        }
+
+        constexpr ConstIterator&
+        operator++() noexcept
+        {
+            m_remaining &= m_remaining - 1;
+            return *this;
+        }
+
+        constexpr ConstIterator
+        operator++(int) noexcept
+        {
+            auto iterator = *this;
+            ++(*this);
+            return iterator;
+        }
+
+        constexpr bool
+        operator==(const ConstIterator&) const noexcept = default;
+
+    private:
+        friend class FlagSet;
+
+        constexpr explicit ConstIterator(uint64_t remaining) noexcept :
+            m_remaining(remaining)
+        {}
+
+        uint64_t m_remaining{ 0 };
+    };
+
+    /**
+     * @brief The number of bits needed to hold all values in the table.
+     */
+    static constexpr std::size_t NumBits = static_cast<std::size_t>(std::bit_width(BitIndexMapT.GetMask()));
+
+    /**
+     * @brief The number of bytes needed to hold all values in the table.
+     */
+    static constexpr std::size_t NumBytes = (NumBits + CHAR_BIT - 1) / CHAR_BIT;
+
+    constexpr FlagSet() = default;
+
+    constexpr FlagSet(std::initializer_list<ValueType> values) noexcept :
+        m_bits(BitIndexMapT.Encode(values))
+    {}
+
+    /**
+     * @brief Construct a new Flag Set object from a collection of values.
+     * Values not in the table are ignored.
+     *
+     * @tparam RangeT The type of collection.
+     * @param values
+     */
+    template <typename RangeT>
+    // clang-format off
+    requires std::convertible_to<typename RangeT::value_type, ValueType>
+    // clang-format on
+    constexpr explicit FlagSet(const RangeT& values) noexcept :
+        m_bits(BitIndexMapT.Encode(values))
+    {}
+
+    /**
+     * @brief Create a Flag Set from a raw bitmap. Bits not in the table are
+     * discarded.
+     *
+     * @param bits
+     * @return FlagSet
+     */
+    static constexpr FlagSet
+    FromBits(uint64_t bits) noexcept
+    {
+        FlagSet flagSet;
+        flagSet.m_bits = bits & BitIndexMapT.GetMask();
+        return flagSet;
+    }
+
+    /**
+     * @brief Create a Flag Set from a bitmap encoded in big endian order.
+     *
+     * @param bytes The encoded bitmap, at most 8 bytes.
+     * @return FlagSet
+     */
+    static constexpr FlagSet
+    FromBytesBigEndian(std::span<const uint8_t> bytes)
+    {
+        return FromBits(ReadBytesBigEndian(bytes));
+    }
+
+    /**
+     * @brief Get the raw bitmap.
+     *
+     * @return uint64_t
+     */
+    constexpr uint64_t
+    GetBits() const noexcept
+    {
+        return m_bits;
+    }
+
+    /**
+     * @brief Get the big endian encoding of the bitmap.
+     *
+     * @tparam NumBytesEncoded The number of bytes in the encoding.
+     * @return std::array<uint8_t, NumBytesEncoded>
+     */
+    template <std::size_t NumBytesEncoded = NumBytes>
+    constexpr std::array<uint8_t, NumBytesEncoded>
+    ToBytesBigEndian() const noexcept
+    {
+        return GetBytesBigEndian<NumBytesEncoded>(m_bits);
+    }
+
+    /**
+     * @brief Get the values held in the set, in bit index order.
+     *
+     * @return std::vector<ValueType>
+     */
+    std::vector<ValueType>
+    ToValues() const
+    {
+        return BitIndexMapT.Decode(m_bits);
+    }
+
+    constexpr bool
+    Contains(const ValueType& value) const noexcept
+    {
+        const auto bitIndex = BitIndexMapT.GetBitIndex(value);
+        return bitIndex.has_value() && (m_bits & (uint64_t{ 1 } << *bitIndex)) != 0;
+    }
+
+    /**
+     * @brief Add a value to the set.
+     *
+     * @param value The value to add.
+     * @return true If the value is in the table and was added.
+     * @return false Otherwise.
+     */
+    constexpr bool
+    Insert(const ValueType& value) noexcept
+    {
+        const auto bitIndex = BitIndexMapT.GetBitIndex(value);
+        if (!bitIndex.has_value()) {
+            return false;
+        }
+        m_bits |= uint64_t{ 1 } << *bitIndex;
+        return true;
+    }
+
+    constexpr void
+    Erase(const ValueType& value) noexcept
+    {
+        if (const auto bitIndex = BitIndexMapT.GetBitIndex(value)) {
+            m_bits &= ~(uint64_t{ 1 } << *bitIndex);
+        }
+    }
+
+    constexpr std::size_t
+    Size() const noexcept
+    {
+        return static_cast<std::size_t>(std::popcount(m_bits));
+    }
+
+    constexpr bool
+    Empty() const noexcept
+    {
+        return m_bits == 0;
+    }
+
+    /**
+     * @brief Get the values held in both this set and another.
+     *
+     * @param other The other set.
+     * @return FlagSet
+     */
+    constexpr FlagSet
+    Intersect(const FlagSet& other) const noexcept
+    {
+        return FromBits(m_bits & other.m_bits);
+    }
+
+    /**
+     * @brief Get the values held in either this set or another.
+     *
+     * @param other The other set.
+     * @return FlagSet
+     */
+    constexpr FlagSet
+    Union(const FlagSet& other) const noexcept
+    {
+        return FromBits(m_bits | other.m_bits);
+    }
+
+    /**
+     * @brief Determine whether every value in this set is also in another.
+     *
+     * @param other The other set.
+     * @return true If this set is a subset of the other set.
+     * @return false Otherwise.
+     */
+    constexpr bool
+    IsSubsetOf(const FlagSet& other) const noexcept
+    {
+        return (m_bits & ~other.m_bits) == 0;
+    }
+
+    constexpr ConstIterator
+    begin() const noexcept
+    {
+        return ConstIterator{ m_bits };
+    }
+
+    constexpr ConstIterator
+    end() const noexcept
+    {
+        return ConstIterator{};
+    }
+
+    constexpr bool
+    operator==(const FlagSet&) const noexcept = default;
+
+private:
+    uint64_t m_bits{ 0 };
+};
+
+} // namespace encoding
+
+namespace std
+{
+template <const auto& BitIndexMapT>
+struct hash<encoding::FlagSet<BitIndexMapT>>
+{
+    std::size_t
+    operator()(const encoding::FlagSet<BitIndexMapT>& flagSet) const noexcept
+    {
+        return std::hash<uint64_t>{}(flagSet.GetBits());
+    }
+};
+} // namespace std
+
+#endif // TLV_SERIALIZE_HXX
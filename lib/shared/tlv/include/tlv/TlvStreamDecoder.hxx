@@ -0,0 +1,163 @@
+
+#ifndef TLV_STREAM_DECODER_HXX
+#define TLV_STREAM_DECODER_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <tlv/Tlv.hxx>
+#include <tlv/TlvBerView.hxx>
+
+namespace encoding
+{
+/**
+ * @brief Resumable, push-style decoder for a stream of top-level TLVs that
+ * arrives in arbitrarily sized chunks (eg. from a transport that fragments
+ * its payloads).
+ *
+ * Each chunk is handed to Push(). The decoder tracks which part of the current
+ * TLV (tag, length, value) it is in across calls and invokes the callback once
+ * for every TLV that has been completely received. TLVs contained entirely
+ * within a single chunk are reported directly from that chunk without copying;
+ * only a TLV straddling chunk boundaries is buffered, so memory use is bounded
+ * by the largest single encoded TLV.
+ */
+class TlvStreamDecoder
+{
+public:
+    /**
+     * @brief The encoding of the TLVs in the stream.
+     */
+    enum class Encoding {
+        Ber,
+        Simple,
+    };
+
+    /**
+     * @brief Callback invoked for each complete top-level TLV of any encoding.
+     * SIMPLE-TLVs have no dedicated view type, so Tlv is their concrete type.
+     * The TLV refers to memory owned by either the decoder or the pushed
+     * chunk, so it is only valid for the duration of the callback.
+     */
+    using TlvCallback = std::function<void(const Tlv& tlv)>;
+
+    /**
+     * @brief Callback invoked for each complete top-level BER-TLV, whose
+     * children may be iterated. As for TlvCallback, the view is only valid for
+     * the duration of the callback.
+     */
+    using TlvBerCallback = std::function<void(const TlvBerView& tlv)>;
+
+    /**
+     * @brief The default maximum accepted length of a single value.
+     */
+    static constexpr std::size_t ValueLengthMaximumDefault = std::numeric_limits<uint16_t>::max();
+
+    /**
+     * @brief Construct a new TlvStreamDecoder object.
+     *
+     * @param encoding The encoding of the TLVs in the stream.
+     * @param callback The callback to invoke for each complete TLV.
+     * @param valueLengthMaximum The maximum length of a single value. A TLV
+     * announcing a longer value fails decoding instead of being buffered.
+     */
+    TlvStreamDecoder(Encoding encoding, TlvCallback callback, std::size_t valueLengthMaximum = ValueLengthMaximumDefault);
+
+    /**
+     * @brief Construct a new TlvStreamDecoder object for a stream of BER-TLVs.
+     *
+     * @param callback The callback to invoke for each complete TLV.
+     * @param valueLengthMaximum The maximum length of a single value. A TLV
+     * announcing a longer value fails decoding instead of being buffered.
+     */
+    explicit TlvStreamDecoder(TlvBerCallback callback, std::size_t valueLengthMaximum = ValueLengthMaximumDefault);
+
+    /**
+     * @brief Decode the next chunk of the stream.
+     *
+     * @param data The next chunk of data. It need not begin or end on a TLV
+     * boundary.
+     * @return Tlv::ParseResult Succeeded if the chunk was consumed, Failed if
+     * the stream contains an invalid encoding. Once failed, all further calls
+     * fail until Reset() is called.
+     */
+    Tlv::ParseResult
+    Push(std::span<const uint8_t> data);
+
+    /**
+     * @brief Discard any partially received TLV and clear a failure.
+     */
+    void
+    Reset() noexcept;
+
+    /**
+     * @brief Returns whether a TLV has been partially received.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    HasPartialTlv() const noexcept;
+
+    /**
+     * @brief Describes the result of decoding a TLV header (tag and length).
+     */
+    enum class HeaderResult {
+        Complete,
+        Incomplete,
+        Invalid,
+    };
+
+    /**
+     * @brief Decode the header of the TLV at the start of the specified data.
+     * The value itself need not be present.
+     *
+     * @param encoding The encoding of the TLV.
+     * @param data The data to decode the header from.
+     * @param tagSize The size of the tag, if complete.
+     * @param headerSize The size of the header, if complete.
+     * @param valueLength The length of the value, if complete.
+     * @return HeaderResult Incomplete if the data ends before the header does.
+     */
+    static HeaderResult
+    ParseHeader(Encoding encoding, std::span<const uint8_t> data, std::size_t& tagSize, std::size_t& headerSize, std::size_t& valueLength);
+
+private:
+    /**
+     * @brief Report a complete TLV to the callback.
+     *
+     * @param data The complete encoding of the TLV.
+     * @param headerSize The size of the header within the encoding.
+     * @return Tlv::ParseResult
+     */
+    Tlv::ParseResult
+    Emit(std::span<const uint8_t> data, std::size_t headerSize);
+
+    /**
+     * @brief Transition to the failed state.
+     *
+     * @return Tlv::ParseResult Always Failed.
+     */
+    Tlv::ParseResult
+    Fail() noexcept;
+
+private:
+    Encoding m_encoding;
+    TlvCallback m_callback;
+    TlvBerCallback m_berCallback;
+    std::size_t m_valueLengthMaximum;
+    bool m_failed{ false };
+    // Encoded header and (partial) value of a TLV that straddles chunks.
+    std::vector<uint8_t> m_buffer;
+    // Non-zero once the header of the buffered TLV has been decoded.
+    std::size_t m_headerSize{ 0 };
+    std::size_t m_valueLength{ 0 };
+};
+
+} // namespace encoding
+
+#endif // TLV_STREAM_DECODER_HXX
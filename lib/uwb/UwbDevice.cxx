@@ -107,6 +107,21 @@ UwbDevice::OnDeviceStatusChanged(UwbStatusDevice statusDevice)
     if (m_status.State != statusDevice.State) {
         PLOG_VERBOSE << "changed state: " << m_status.ToString() << " --> " << statusDevice.ToString();
         m_status = statusDevice;
+        if (m_status.State == UwbDeviceState::Error) {
+            ResetSessionApplicationConfigurations();
+        }
+    }
+}
+
+void
+UwbDevice::ResetSessionApplicationConfigurations()
+{
+    std::shared_lock sessionSharedLock{ m_sessionsGate };
+    for (const auto& [sessionId, sessionWeak] : m_sessions) {
+        auto session = sessionWeak.lock();
+        if (session != nullptr) {
+            session->ResetApplicationConfiguration();
+        }
     }
 }
 
@@ -148,6 +163,7 @@ UwbDevice::Reset()
 {
     PLOG_DEBUG << "Reset";
     ResetImpl();
+    ResetSessionApplicationConfigurations();
 }
 
 bool
@@ -157,6 +173,18 @@ UwbDevice::Initialize()
     return InitializeImpl();
 }
 
+UwbMacAddressAllocator&
+UwbDevice::GetMacAddressAllocator() noexcept
+{
+    return m_macAddressAllocator;
+}
+
+std::shared_ptr<UwbRangingHistoryBudget>
+UwbDevice::GetRangingHistoryBudget() const noexcept
+{
+    return m_rangingHistoryBudget;
+}
+
 bool
 UwbDevice::InitializeImpl()
 {
@@ -1,10 +1,16 @@
 
+#include <array>
+#include <bit>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <iomanip>
 #include <ios>
-#include <regex>
-#include <sstream>
+#include <limits>
+#include <optional>
+#include <random>
 #include <stdexcept>
+#include <string_view>
 
 #include <magic_enum.hpp>
 
@@ -12,6 +18,152 @@
 
 using namespace uwb;
 
+namespace detail
+{
+/**
+ * @brief Lowercase hexadecimal digits, indexed by value.
+ */
+constexpr std::string_view HexDigits{ "0123456789abcdef" };
+
+/**
+ * @brief Get the value of a single hexadecimal digit.
+ *
+ * @param c The character to convert.
+ * @return std::optional<uint8_t> The value of the digit, or std::nullopt if c
+ * is not a hexadecimal digit.
+ */
+constexpr std::optional<uint8_t>
+HexDigitValue(char c) noexcept
+{
+    if (c >= '0' && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+        return static_cast<uint8_t>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+        return static_cast<uint8_t>(c - 'A' + 10);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Parse a string of exactly Length colon-delimited, two digit
+ * hexadecimal octets, eg. "1a:2f".
+ *
+ * @tparam Length The number of octets to parse.
+ * @param addressString The string to parse.
+ * @return std::optional<std::array<uint8_t, Length>> The parsed octets, or
+ * std::nullopt if the string is not in the expected format.
+ */
+template <std::size_t Length>
+std::optional<std::array<uint8_t, Length>>
+ParseOctets(std::string_view addressString) noexcept
+{
+    static constexpr std::size_t StringLength = (Length * 3) - 1;
+    if (addressString.size() != StringLength) {
+        return std::nullopt;
+    }
+
+    std::array<uint8_t, Length> address{};
+    for (std::size_t i = 0; i < Length; i++) {
+        const auto offset = i * 3;
+        if (i > 0 && addressString[offset - 1] != ':') {
+            return std::nullopt;
+        }
+        const auto high = HexDigitValue(addressString[offset]);
+        const auto low = HexDigitValue(addressString[offset + 1]);
+        if (!high.has_value() || !low.has_value()) {
+            return std::nullopt;
+        }
+        address[i] = static_cast<uint8_t>((*high << 4U) | *low);
+    }
+
+    return address;
+}
+
+/**
+ * @brief The xoshiro256** pseudo-random number generator, by David Blackman
+ * and Sebastiano Vigna. This satisfies the UniformRandomBitGenerator
+ * requirements, and has 32 bytes of state compared to the ~5KB of
+ * std::mt19937, making it cheap to keep one per thread.
+ */
+class Xoshiro256StarStar
+{
+public:
+    using result_type = uint64_t;
+
+    /**
+     * @brief Construct a new Xoshiro256StarStar object, expanding the seed
+     * into the full generator state with splitmix64.
+     *
+     * @param seed The seed value.
+     */
+    explicit Xoshiro256StarStar(uint64_t seed) noexcept
+    {
+        for (auto& state : m_state) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            auto value = seed;
+            value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+            state = value ^ (value >> 31U);
+        }
+    }
+
+    static constexpr result_type
+    min() noexcept
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type
+    max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type
+    operator()() noexcept
+    {
+        const auto result = std::rotl(m_state[1] * 5, 7) * 9;
+        const auto t = m_state[1] << 17U;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = std::rotl(m_state[3], 45);
+
+        return result;
+    }
+
+private:
+    std::array<uint64_t, 4> m_state{};
+};
+
+/**
+ * @brief Get the random generator for the calling thread, seeding it on first
+ * use.
+ *
+ * The seed mixes std::random_device with the current time, so threads get
+ * distinct sequences even on platforms where std::random_device is
+ * deterministic.
+ *
+ * @return Xoshiro256StarStar&
+ */
+Xoshiro256StarStar&
+GetThreadRandomGenerator()
+{
+    thread_local Xoshiro256StarStar generator{ []() {
+        std::random_device randomDevice{};
+        const auto timeSinceEpoch = std::chrono::high_resolution_clock::now().time_since_epoch();
+        const auto seed = (static_cast<uint64_t>(randomDevice()) << 32U) | randomDevice();
+        return seed ^ static_cast<uint64_t>(timeSinceEpoch.count());
+    }() };
+
+    return generator;
+}
+} // namespace detail
+
 UwbMacAddressType
 UwbMacAddress::GetType() const noexcept
 {
@@ -27,7 +179,7 @@ UwbMacAddress::GetLength() const noexcept
 std::span<const uint8_t>
 UwbMacAddress::GetValue() const noexcept
 {
-    return m_view;
+    return { std::data(m_value), m_length };
 }
 
 std::optional<uint16_t>
@@ -38,48 +190,20 @@ UwbMacAddress::GetValueShort() const
     }
 
     // TODO: do we need to account for endianness? revisit
-    return (static_cast<uint16_t>(m_view[1]) << 8U) | m_view[0];
-}
-
-UwbMacAddress::UwbMacAddress(const std::string& addressString, UwbMacAddressType addressType)
-{
-    // TODO: Make the delimiter configurable
-
-    std::array<uint8_t, ShortLength> shortAddress{};
-    std::array<uint8_t, ExtendedLength> extendedAddress{};
-
-    std::stringstream ss(addressString);
-    for (auto i = 0; i < (addressType == UwbMacAddressType::Short ? ShortLength : ExtendedLength); i++) {
-        if (ss) {
-            std::string addressByte;
-            getline(ss, addressByte, ':');
-            const auto byteValue = static_cast<uint8_t>(std::stoi(addressByte, nullptr, 16));
-            if (addressType == UwbMacAddressType::Short) {
-                shortAddress[i] = byteValue;
-            } else {
-                extendedAddress[i] = byteValue;
-            }
-        } else {
-            throw std::invalid_argument("invalid mac address string");
-        }
-    }
-
-    if (addressType == UwbMacAddressType::Short) {
-        *this = UwbMacAddress(shortAddress);
-    } else {
-        *this = UwbMacAddress(extendedAddress);
-    }
+    return (static_cast<uint16_t>(m_value[1]) << 8U) | m_value[0];
 }
 
 /* static */
 UwbMacAddress
 UwbMacAddress::Random(UwbMacAddressType type)
 {
+    const auto value = std::bit_cast<ExtendedType>(::detail::GetThreadRandomGenerator()());
+
     switch (type) {
     case UwbMacAddressType::Short:
-        return Random<UwbMacAddressType::Short>();
+        return UwbMacAddress{ ShortType{ value[0], value[1] } };
     case UwbMacAddressType::Extended:
-        return Random<UwbMacAddressType::Extended>();
+        return UwbMacAddress{ value };
     default:
         throw std::runtime_error("unknown mac address type");
     }
@@ -89,47 +213,59 @@ UwbMacAddress::Random(UwbMacAddressType type)
 std::optional<UwbMacAddress>
 UwbMacAddress::FromString(const std::string& addressString, UwbMacAddressType addressType)
 {
-    const std::regex shortRegex("^([0-9A-Fa-f]{2}:){1}([0-9A-Fa-f]{2})$");
-    const std::regex extendedRegex("^(([0-9A-Fa-f]{2}:){7}[0-9A-Fa-f]{2})$");
-
-    if ((addressType == UwbMacAddressType::Short && !std::regex_match(addressString, shortRegex)) ||
-        (addressType == UwbMacAddressType::Extended && !std::regex_match(addressString, extendedRegex))) {
-        return std::nullopt;
+    switch (addressType) {
+    case UwbMacAddressType::Short:
+        if (const auto address = ::detail::ParseOctets<ShortLength>(addressString)) {
+            return UwbMacAddress{ *address };
+        }
+        break;
+    case UwbMacAddressType::Extended:
+        if (const auto address = ::detail::ParseOctets<ExtendedLength>(addressString)) {
+            return UwbMacAddress{ *address };
+        }
+        break;
     }
 
-    try {
-        return UwbMacAddress(addressString, addressType);
-    } catch (...) {
-        return std::nullopt;
-    }
+    return std::nullopt;
 }
 
 std::string
 UwbMacAddress::ToString() const
 {
-    std::ostringstream macString{};
+    std::string str((std::size_t{ m_length } * 3) - 1, ':');
 
-    for (const auto& b : m_view) {
-        macString << std::hex << std::setw(2) << std::setfill('0') << +b << ':';
+    for (std::size_t i = 0; i < m_length; i++) {
+        str[(i * 3)] = ::detail::HexDigits[m_value[i] >> 4U];
+        str[(i * 3) + 1] = ::detail::HexDigits[m_value[i] & 0x0FU];
     }
 
-    // Remove the trailing ':'.
-    auto str = macString.str();
-    str.pop_back();
-
     return str;
 }
 
+std::size_t
+UwbMacAddress::Hash() const noexcept
+{
+    // The unused trailing bytes of m_value are always zero, so the value can
+    // be mixed as a single word without regard to its length.
+    const auto value = std::bit_cast<uint64_t>(m_value);
+    auto hash = value * 0x9E3779B97F4A7C15ULL;
+    hash ^= (hash >> 32U);
+    return static_cast<std::size_t>(hash);
+}
+
 bool
 uwb::operator==(const UwbMacAddress& lhs, const UwbMacAddress& rhs) noexcept
 {
-    return (lhs.m_value == rhs.m_value);
+    return (lhs.m_type == rhs.m_type) && (std::bit_cast<uint64_t>(lhs.m_value) == std::bit_cast<uint64_t>(rhs.m_value));
 }
 
-auto
-uwb::UwbMacAddress::operator<=>(const UwbMacAddress& other) const noexcept
+std::strong_ordering
+UwbMacAddress::operator<=>(const UwbMacAddress& other) const noexcept
 {
-    return this->m_value <=> other.m_value;
+    if (const auto order = m_type <=> other.m_type; order != std::strong_ordering::equal) {
+        return order;
+    }
+    return m_value <=> other.m_value;
 }
 
 std::istream&
@@ -0,0 +1,96 @@
+
+#include <uwb/UwbMacAddressAllocator.hxx>
+
+using namespace uwb;
+
+std::optional<UwbMacAddress>
+UwbMacAddressAllocator::Allocate(UwbMacAddressType type)
+{
+    std::scoped_lock allocatedLock{ m_allocatedGate };
+    return AllocateLocked(type);
+}
+
+std::vector<UwbMacAddress>
+UwbMacAddressAllocator::Allocate(UwbMacAddressType type, std::size_t count)
+{
+    std::vector<UwbMacAddress> uwbMacAddresses{};
+    uwbMacAddresses.reserve(count);
+
+    std::scoped_lock allocatedLock{ m_allocatedGate };
+    m_allocated.reserve(m_allocated.size() + count);
+    while (uwbMacAddresses.size() < count) {
+        auto uwbMacAddress = AllocateLocked(type);
+        if (!uwbMacAddress.has_value()) {
+            break;
+        }
+        uwbMacAddresses.push_back(*uwbMacAddress);
+    }
+
+    return uwbMacAddresses;
+}
+
+bool
+UwbMacAddressAllocator::Reserve(const UwbMacAddress& uwbMacAddress)
+{
+    std::scoped_lock allocatedLock{ m_allocatedGate };
+    return InsertLocked(uwbMacAddress);
+}
+
+bool
+UwbMacAddressAllocator::Release(const UwbMacAddress& uwbMacAddress)
+{
+    std::scoped_lock allocatedLock{ m_allocatedGate };
+    if (m_allocated.erase(uwbMacAddress) == 0) {
+        return false;
+    }
+    if (uwbMacAddress.GetType() == UwbMacAddressType::Short) {
+        m_allocatedShortCount--;
+    }
+    return true;
+}
+
+bool
+UwbMacAddressAllocator::IsAllocated(const UwbMacAddress& uwbMacAddress) const
+{
+    std::scoped_lock allocatedLock{ m_allocatedGate };
+    return m_allocated.contains(uwbMacAddress);
+}
+
+std::size_t
+UwbMacAddressAllocator::GetAllocatedCount() const
+{
+    std::scoped_lock allocatedLock{ m_allocatedGate };
+    return m_allocated.size();
+}
+
+std::optional<UwbMacAddress>
+UwbMacAddressAllocator::AllocateLocked(UwbMacAddressType type)
+{
+    if (type == UwbMacAddressType::Short && m_allocatedShortCount == ShortAddressCount) {
+        return std::nullopt;
+    }
+
+    // Draw random addresses until a free one is found. The address space is
+    // known not to be full, and the expected number of draws is the inverse of
+    // the fraction of addresses that are free. Re-drawing is used instead of
+    // probing forward from a collision since that clusters allocated
+    // addresses, making collisions increasingly likely as the space fills.
+    auto uwbMacAddress = UwbMacAddress::Random(type);
+    while (!InsertLocked(uwbMacAddress)) {
+        uwbMacAddress = UwbMacAddress::Random(type);
+    }
+
+    return uwbMacAddress;
+}
+
+bool
+UwbMacAddressAllocator::InsertLocked(const UwbMacAddress& uwbMacAddress)
+{
+    if (!m_allocated.insert(uwbMacAddress).second) {
+        return false;
+    }
+    if (uwbMacAddress.GetType() == UwbMacAddressType::Short) {
+        m_allocatedShortCount++;
+    }
+    return true;
+}
@@ -39,12 +39,12 @@ UwbPeer::UwbPeer(UwbMacAddress address) :
 
 UwbPeer::UwbPeer(UwbMacAddress address, UwbPeerSpatialProperties spatialProperties) :
     m_address(std::move(address)),
-    m_spatialProperties(std::move(spatialProperties))
+    m_spatialProperties(spatialProperties)
 {}
 
 UwbPeer::UwbPeer(const uwb::protocol::fira::UwbRangingMeasurement& data) :
     m_address{ data.PeerMacAddress },
-    m_spatialProperties{
+    m_spatialProperties{ UwbPeerSpatialProperties{
         .Distance{ data.Distance },
         .AngleAzimuth{ uwb::protocol::fira::ConvertQ97FormatToIEEE(data.AoAAzimuth.Result) },
         .AngleElevation{ uwb::protocol::fira::ConvertQ97FormatToIEEE(data.AoAElevation.Result) },
@@ -52,21 +52,20 @@ UwbPeer::UwbPeer(const uwb::protocol::fira::UwbRangingMeasurement& data) :
 
         .AngleAzimuthFom{ data.AoAAzimuth.FigureOfMerit },
         .AngleElevationFom{ data.AoAElevation.FigureOfMerit },
-        .ElevationFom{ data.AoaDestinationElevation.FigureOfMerit }
-    }
+        .ElevationFom{ data.AoaDestinationElevation.FigureOfMerit } } }
 {
 }
 
 UwbPeer::UwbPeer(const UwbPeer& other) :
     m_address(other.m_address),
-    m_spatialProperties(other.m_spatialProperties)
+    m_spatialProperties(other.GetSpatialProperties())
 {}
 
-UwbPeer::UwbPeer(UwbPeer&& other) noexcept
-{
-    std::swap(m_address, other.m_address);
-    std::swap(m_spatialProperties, other.m_spatialProperties);
-}
+// Both the address and the spatial properties are trivially copyable, so a
+// move is simply a copy.
+UwbPeer::UwbPeer(UwbPeer&& other) noexcept :
+    UwbPeer(static_cast<const UwbPeer&>(other))
+{}
 
 UwbPeer&
 UwbPeer::operator=(const UwbPeer& other)
@@ -76,15 +75,21 @@ UwbPeer::operator=(const UwbPeer& other)
     }
 
     m_address = other.m_address;
-    m_spatialProperties = other.m_spatialProperties;
+    m_spatialProperties.store(other.GetSpatialProperties());
     return *this;
 }
 
+UwbPeer&
+UwbPeer::operator=(UwbPeer&& other) noexcept
+{
+    return *this = static_cast<const UwbPeer&>(other);
+}
+
 std::string
 UwbPeer::ToString() const
 {
     std::ostringstream ss;
-    ss << "[" << m_address << "] " << m_spatialProperties;
+    ss << "[" << m_address << "] " << GetSpatialProperties();
     return ss.str();
 }
 
@@ -97,8 +102,13 @@ UwbPeer::GetAddress() const noexcept
 UwbPeerSpatialProperties
 UwbPeer::GetSpatialProperties() const noexcept
 {
-    const auto lock = std::scoped_lock{ m_spatialPropertiesGate };
-    return m_spatialProperties;
+    return m_spatialProperties.load();
+}
+
+void
+UwbPeer::SetSpatialProperties(const UwbPeerSpatialProperties& spatialProperties) noexcept
+{
+    m_spatialProperties.store(spatialProperties);
 }
 
 bool
@@ -0,0 +1,266 @@
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <uwb/UwbPeerRangingHistory.hxx>
+
+using namespace uwb;
+using namespace uwb::protocol::fira;
+
+namespace detail
+{
+/**
+ * @brief Narrow an optional value to a float, using NaN if it is not present.
+ *
+ * @param value The value to narrow.
+ * @return float
+ */
+float
+ToFloatOrNaN(const std::optional<double>& value) noexcept
+{
+    return value.has_value() ? static_cast<float>(*value) : std::numeric_limits<float>::quiet_NaN();
+}
+
+/**
+ * @brief Widen a float to an optional value, using std::nullopt if it is NaN.
+ *
+ * @param value The value to widen.
+ * @return std::optional<double>
+ */
+std::optional<double>
+ToOptional(float value) noexcept
+{
+    return std::isnan(value) ? std::nullopt : std::optional<double>{ value };
+}
+
+/**
+ * @brief Widen a figure of merit to an optional value, using std::nullopt if
+ * it is 0.
+ *
+ * @param figureOfMerit The figure of merit to widen.
+ * @return std::optional<uint8_t>
+ */
+std::optional<uint8_t>
+ToOptional(uint8_t figureOfMerit) noexcept
+{
+    return (figureOfMerit == 0) ? std::nullopt : std::optional<uint8_t>{ figureOfMerit };
+}
+
+/**
+ * @brief Running statistics of a single value, ignoring NaN.
+ */
+struct RunningStatistics
+{
+    std::size_t Count{ 0 };
+    float Min{ std::numeric_limits<float>::infinity() };
+    float Max{ -std::numeric_limits<float>::infinity() };
+    double Sum{ 0 };
+
+    void
+    Add(float value) noexcept
+    {
+        if (std::isnan(value)) {
+            return;
+        }
+        Count++;
+        Min = std::min(Min, value);
+        Max = std::max(Max, value);
+        Sum += value;
+    }
+
+    std::optional<float>
+    GetMin() const noexcept
+    {
+        return (Count > 0) ? std::optional<float>{ Min } : std::nullopt;
+    }
+
+    std::optional<float>
+    GetMax() const noexcept
+    {
+        return (Count > 0) ? std::optional<float>{ Max } : std::nullopt;
+    }
+
+    std::optional<float>
+    GetMean() const noexcept
+    {
+        return (Count > 0) ? std::optional<float>{ static_cast<float>(Sum / static_cast<double>(Count)) } : std::nullopt;
+    }
+};
+} // namespace detail
+
+/* static */
+UwbPeerRangingSample
+UwbPeerRangingSample::FromPeer(const UwbPeer& peer, Clock::time_point timestamp) noexcept
+{
+    const auto spatialProperties = peer.GetSpatialProperties();
+
+    return UwbPeerRangingSample{
+        .Timestamp = timestamp,
+        .Distance = ::detail::ToFloatOrNaN(spatialProperties.Distance),
+        .AngleAzimuth = ::detail::ToFloatOrNaN(spatialProperties.AngleAzimuth),
+        .AngleElevation = ::detail::ToFloatOrNaN(spatialProperties.AngleElevation),
+        .Elevation = ::detail::ToFloatOrNaN(spatialProperties.Elevation),
+        .AngleAzimuthFom = spatialProperties.AngleAzimuthFom.value_or(0),
+        .AngleElevationFom = spatialProperties.AngleElevationFom.value_or(0),
+        .ElevationFom = spatialProperties.ElevationFom.value_or(0),
+        .Status = StatusCode::Ok,
+    };
+}
+
+/* static */
+UwbPeerRangingSample
+UwbPeerRangingSample::FromRangingMeasurement(const UwbRangingMeasurement& rangingMeasurement, Clock::time_point timestamp) noexcept
+{
+    auto sample = FromPeer(UwbPeer{ rangingMeasurement }, timestamp);
+    sample.Status = uci::ToStatusCode(rangingMeasurement.Status);
+    return sample;
+}
+
+UwbPeerSpatialProperties
+UwbPeerRangingSample::ToSpatialProperties() const noexcept
+{
+    return UwbPeerSpatialProperties{
+        .Distance = ::detail::ToOptional(Distance),
+        .AngleAzimuth = ::detail::ToOptional(AngleAzimuth),
+        .AngleElevation = ::detail::ToOptional(AngleElevation),
+        .Elevation = ::detail::ToOptional(Elevation),
+        .AngleAzimuthFom = ::detail::ToOptional(AngleAzimuthFom),
+        .AngleElevationFom = ::detail::ToOptional(AngleElevationFom),
+        .ElevationFom = ::detail::ToOptional(ElevationFom),
+    };
+}
+
+UwbPeerRangingHistory::UwbPeerRangingHistory(std::size_t capacity) :
+    m_blocks(GetStorageSize(std::max<std::size_t>(capacity, 1)) / CacheLineSize),
+    m_capacity(std::size(m_blocks) * SamplesPerBlock)
+{}
+
+void
+UwbPeerRangingHistory::Push(const UwbPeerRangingSample& sample) noexcept
+{
+    GetSample(m_next) = sample;
+    m_next = (m_next + 1 == m_capacity) ? 0 : m_next + 1;
+    m_size = std::min(m_size + 1, m_capacity);
+}
+
+void
+UwbPeerRangingHistory::Clear() noexcept
+{
+    m_next = 0;
+    m_size = 0;
+}
+
+std::size_t
+UwbPeerRangingHistory::GetCapacity() const noexcept
+{
+    return m_capacity;
+}
+
+std::size_t
+UwbPeerRangingHistory::GetSize() const noexcept
+{
+    return m_size;
+}
+
+std::optional<UwbPeerRangingSample>
+UwbPeerRangingHistory::GetLatest() const noexcept
+{
+    if (m_size == 0) {
+        return std::nullopt;
+    }
+
+    return GetSampleByAge(0);
+}
+
+std::size_t
+UwbPeerRangingHistory::CopyLast(std::span<UwbPeerRangingSample> samples) const noexcept
+{
+    const auto count = std::min(m_size, std::size(samples));
+    CopyNewest(count, samples);
+    return count;
+}
+
+std::size_t
+UwbPeerRangingHistory::CopySince(Clock::time_point since, std::span<UwbPeerRangingSample> samples) const noexcept
+{
+    const auto count = std::min(CountSince(since), std::size(samples));
+    CopyNewest(count, samples);
+    return count;
+}
+
+UwbPeerRangingAggregate
+UwbPeerRangingHistory::Aggregate(Clock::time_point since) const noexcept
+{
+    UwbPeerRangingAggregate aggregate{};
+    ::detail::RunningStatistics distance{};
+    ::detail::RunningStatistics angleAzimuth{};
+    ::detail::RunningStatistics angleElevation{};
+
+    for (std::size_t age = 0; age < m_size; age++) {
+        const auto& sample = GetSampleByAge(age);
+        if (sample.Timestamp < since) {
+            break;
+        }
+
+        aggregate.Count++;
+        if (sample.Status != UwbPeerRangingSample::StatusCode::Ok) {
+            continue;
+        }
+
+        aggregate.CountSuccessful++;
+        distance.Add(sample.Distance);
+        angleAzimuth.Add(sample.AngleAzimuth);
+        angleElevation.Add(sample.AngleElevation);
+    }
+
+    aggregate.DistanceMin = distance.GetMin();
+    aggregate.DistanceMax = distance.GetMax();
+    aggregate.DistanceMean = distance.GetMean();
+    aggregate.AngleAzimuthMean = angleAzimuth.GetMean();
+    aggregate.AngleElevationMean = angleElevation.GetMean();
+
+    return aggregate;
+}
+
+const UwbPeerRangingSample&
+UwbPeerRangingHistory::GetSampleByAge(std::size_t age) const noexcept
+{
+    const auto index = (m_next + m_capacity - 1 - age) % m_capacity;
+    return GetSample(index);
+}
+
+std::size_t
+UwbPeerRangingHistory::CountSince(Clock::time_point since) const noexcept
+{
+    // Samples are pushed in timestamp order, so the matching samples are
+    // exactly the newest ones.
+    std::size_t count = 0;
+    while (count < m_size && GetSampleByAge(count).Timestamp >= since) {
+        count++;
+    }
+
+    return count;
+}
+
+void
+UwbPeerRangingHistory::CopyNewest(std::size_t count, std::span<UwbPeerRangingSample> samples) const noexcept
+{
+    auto index = (m_next + m_capacity - count) % m_capacity;
+    for (std::size_t i = 0; i < count; i++) {
+        samples[i] = GetSample(index);
+        index = (index + 1 == m_capacity) ? 0 : index + 1;
+    }
+}
+
+UwbPeerRangingSample&
+UwbPeerRangingHistory::GetSample(std::size_t index) noexcept
+{
+    return m_blocks[index / SamplesPerBlock].Samples[index % SamplesPerBlock];
+}
+
+const UwbPeerRangingSample&
+UwbPeerRangingHistory::GetSample(std::size_t index) const noexcept
+{
+    return m_blocks[index / SamplesPerBlock].Samples[index % SamplesPerBlock];
+}
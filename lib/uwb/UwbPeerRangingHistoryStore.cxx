@@ -0,0 +1,120 @@
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+#include <uwb/UwbPeerRangingHistoryStore.hxx>
+
+using namespace uwb;
+using namespace uwb::protocol::fira;
+
+UwbPeerRangingHistoryStore::UwbPeerRangingHistoryStore(std::size_t capacity, std::shared_ptr<UwbRangingHistoryBudget> budget) :
+    m_capacity(UwbPeerRangingHistory::GetStorageSize(std::max<std::size_t>(capacity, 1)) / sizeof(UwbPeerRangingSample)),
+    m_peerMemoryUsage(UwbPeerRangingHistory::GetStorageSize(m_capacity) + sizeof(UwbMacAddress) + sizeof(UwbPeerRangingHistory)),
+    m_budget(std::move(budget))
+{}
+
+UwbPeerRangingHistoryStore::~UwbPeerRangingHistoryStore()
+{
+    Clear();
+}
+
+void
+UwbPeerRangingHistoryStore::Record(std::span<const UwbPeer> peers, Clock::time_point timestamp)
+{
+    std::unique_lock historiesLockExclusive{ m_historiesGate };
+    for (const auto& peer : peers) {
+        RecordLocked(peer.GetAddress(), UwbPeerRangingSample::FromPeer(peer, timestamp));
+    }
+}
+
+void
+UwbPeerRangingHistoryStore::Record(const UwbRangingData& rangingData, Clock::time_point timestamp)
+{
+    std::unique_lock historiesLockExclusive{ m_historiesGate };
+    for (const auto& rangingMeasurement : rangingData.RangingMeasurements) {
+        RecordLocked(rangingMeasurement.PeerMacAddress, UwbPeerRangingSample::FromRangingMeasurement(rangingMeasurement, timestamp));
+    }
+}
+
+void
+UwbPeerRangingHistoryStore::Remove(std::span<const UwbPeer> peers)
+{
+    std::unique_lock historiesLockExclusive{ m_historiesGate };
+    for (const auto& peer : peers) {
+        if (m_histories.erase(peer.GetAddress()) > 0 && m_budget != nullptr) {
+            m_budget->Release(m_peerMemoryUsage);
+        }
+    }
+}
+
+void
+UwbPeerRangingHistoryStore::Clear()
+{
+    std::unique_lock historiesLockExclusive{ m_historiesGate };
+    if (m_budget != nullptr) {
+        m_budget->Release(std::size(m_histories) * m_peerMemoryUsage);
+    }
+    m_histories.clear();
+}
+
+std::size_t
+UwbPeerRangingHistoryStore::CopyLast(const UwbMacAddress& address, std::span<UwbPeerRangingSample> samples) const
+{
+    std::shared_lock historiesLockShared{ m_historiesGate };
+    const auto historyIt = m_histories.find(address);
+    return (historyIt != std::cend(m_histories)) ? historyIt->second.CopyLast(samples) : 0;
+}
+
+std::size_t
+UwbPeerRangingHistoryStore::CopySince(const UwbMacAddress& address, Clock::time_point since, std::span<UwbPeerRangingSample> samples) const
+{
+    std::shared_lock historiesLockShared{ m_historiesGate };
+    const auto historyIt = m_histories.find(address);
+    return (historyIt != std::cend(m_histories)) ? historyIt->second.CopySince(since, samples) : 0;
+}
+
+std::optional<UwbPeerRangingAggregate>
+UwbPeerRangingHistoryStore::Aggregate(const UwbMacAddress& address, Clock::time_point since) const
+{
+    std::shared_lock historiesLockShared{ m_historiesGate };
+    const auto historyIt = m_histories.find(address);
+    if (historyIt == std::cend(m_histories)) {
+        return std::nullopt;
+    }
+
+    return historyIt->second.Aggregate(since);
+}
+
+std::size_t
+UwbPeerRangingHistoryStore::GetCapacity() const noexcept
+{
+    return m_capacity;
+}
+
+std::size_t
+UwbPeerRangingHistoryStore::GetPeerCount() const
+{
+    std::shared_lock historiesLockShared{ m_historiesGate };
+    return std::size(m_histories);
+}
+
+std::size_t
+UwbPeerRangingHistoryStore::GetPeerMemoryUsage() const noexcept
+{
+    return m_peerMemoryUsage;
+}
+
+void
+UwbPeerRangingHistoryStore::RecordLocked(const UwbMacAddress& address, const UwbPeerRangingSample& sample)
+{
+    auto historyIt = m_histories.find(address);
+    if (historyIt == std::end(m_histories)) {
+        if (m_budget != nullptr && !m_budget->TryAcquire(m_peerMemoryUsage)) {
+            return;
+        }
+        historyIt = m_histories.try_emplace(address, m_capacity).first;
+    }
+
+    historyIt->second.Push(sample);
+}
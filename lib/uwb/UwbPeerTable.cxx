@@ -0,0 +1,143 @@
+
+#include <utility>
+
+#include <uwb/UwbPeerTable.hxx>
+
+using namespace uwb;
+using namespace uwb::protocol::fira;
+
+UwbPeer
+UwbPeerTable::Entry::ToPeer() const
+{
+    return UwbPeer{ Address, SpatialProperties };
+}
+
+uint64_t
+UwbPeerTable::Update(const UwbRangingData& rangingData)
+{
+    std::vector<UwbPeer> peers{};
+    peers.reserve(std::size(rangingData.RangingMeasurements));
+    for (const auto& rangingMeasurement : rangingData.RangingMeasurements) {
+        peers.emplace_back(rangingMeasurement);
+    }
+
+    return Update(peers);
+}
+
+uint64_t
+UwbPeerTable::Update(std::span<const UwbPeer> peers)
+{
+    std::scoped_lock writerLock{ m_writerGate };
+
+    const auto sequenceNumber = m_sequenceNumber.load(std::memory_order_relaxed) + 1;
+    const auto timestamp = Clock::now();
+    const auto index = m_index.load(std::memory_order_acquire);
+
+    // Only allocated if a peer not already in the table is encountered.
+    std::shared_ptr<Index> indexUpdated{};
+
+    for (const auto& peer : peers) {
+        const Entry entry{
+            .Address = peer.GetAddress(),
+            .SpatialProperties = peer.GetSpatialProperties(),
+            .Timestamp = timestamp,
+            .SequenceNumber = sequenceNumber,
+        };
+
+        const Index& indexCurrent = (indexUpdated != nullptr) ? *indexUpdated : *index;
+        const auto entryIt = indexCurrent.find(entry.Address);
+        if (entryIt != std::cend(indexCurrent)) {
+            entryIt->second->store(entry);
+            continue;
+        }
+
+        if (indexUpdated == nullptr) {
+            indexUpdated = std::make_shared<Index>(*index);
+        }
+        indexUpdated->emplace(entry.Address, std::make_shared<EntryState>(entry));
+    }
+
+    if (indexUpdated != nullptr) {
+        PublishLocked(std::move(indexUpdated));
+    }
+
+    m_sequenceNumber.store(sequenceNumber, std::memory_order_release);
+    return sequenceNumber;
+}
+
+void
+UwbPeerTable::Remove(std::span<const UwbPeer> peers)
+{
+    std::scoped_lock writerLock{ m_writerGate };
+
+    const auto index = m_index.load(std::memory_order_acquire);
+    std::shared_ptr<Index> indexUpdated{};
+
+    for (const auto& peer : peers) {
+        const Index& indexCurrent = (indexUpdated != nullptr) ? *indexUpdated : *index;
+        if (!indexCurrent.contains(peer.GetAddress())) {
+            continue;
+        }
+
+        if (indexUpdated == nullptr) {
+            indexUpdated = std::make_shared<Index>(*index);
+        }
+        indexUpdated->erase(peer.GetAddress());
+    }
+
+    if (indexUpdated != nullptr) {
+        PublishLocked(std::move(indexUpdated));
+    }
+}
+
+void
+UwbPeerTable::Clear()
+{
+    std::scoped_lock writerLock{ m_writerGate };
+    PublishLocked(std::make_shared<const Index>());
+}
+
+std::vector<UwbPeerTable::Entry>
+UwbPeerTable::GetPeers() const
+{
+    const auto index = m_index.load(std::memory_order_acquire);
+
+    std::vector<Entry> entries{};
+    entries.reserve(std::size(*index));
+    for (const auto& [address, entryState] : *index) {
+        entries.push_back(entryState->load());
+    }
+
+    return entries;
+}
+
+std::optional<UwbPeerTable::Entry>
+UwbPeerTable::GetPeer(const UwbMacAddress& address) const
+{
+    const auto index = m_index.load(std::memory_order_acquire);
+
+    const auto entryIt = index->find(address);
+    if (entryIt == std::cend(*index)) {
+        return std::nullopt;
+    }
+
+    return entryIt->second->load();
+}
+
+std::size_t
+UwbPeerTable::GetPeerCount() const
+{
+    return std::size(*m_index.load(std::memory_order_acquire));
+}
+
+uint64_t
+UwbPeerTable::GetSequenceNumber() const noexcept
+{
+    return m_sequenceNumber.load(std::memory_order_acquire);
+}
+
+void
+UwbPeerTable::PublishLocked(std::shared_ptr<const Index> index)
+{
+    m_index.store(std::move(index), std::memory_order_release);
+}
@@ -0,0 +1,428 @@
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include <uwb/UwbRangingDataBatch.hxx>
+
+using namespace uwb;
+using namespace uwb::protocol::fira;
+
+namespace detail
+{
+/**
+ * @brief The number of fractional bits of a Q9.7 fixed-point value.
+ */
+constexpr double Q97Scale = 128.0;
+
+/**
+ * @brief Convert a floating point angle to Q9.7 format, the inverse of
+ * ConvertQ97FormatToIEEE().
+ *
+ * @param value The angle to convert.
+ * @return uint16_t
+ */
+uint16_t
+ConvertIEEEToQ97Format(double value) noexcept
+{
+    const auto fixed = std::lround(value * Q97Scale);
+    return static_cast<uint16_t>(static_cast<int16_t>(fixed));
+}
+
+/**
+ * @brief Convert a floating point distance to its unsigned 16-bit measurement
+ * representation, saturating out of range values.
+ *
+ * @param value The distance to convert.
+ * @return uint16_t
+ */
+uint16_t
+ConvertDistance(double value) noexcept
+{
+    const auto distance = std::lround(value);
+    if (distance < 0) {
+        return 0;
+    }
+    if (distance > std::numeric_limits<uint16_t>::max()) {
+        return std::numeric_limits<uint16_t>::max();
+    }
+    return static_cast<uint16_t>(distance);
+}
+
+/**
+ * @brief Get the presence bit of a field if it holds a value.
+ *
+ * @param value The optional field value.
+ * @param bit The presence bit of the field.
+ * @return uint16_t The bit if the field holds a value, 0 otherwise.
+ */
+template <typename T>
+uint16_t
+GetPresenceBit(const std::optional<T>& value, uint16_t bit) noexcept
+{
+    return value.has_value() ? bit : uint16_t{ 0 };
+}
+
+/**
+ * @brief Get an optional field value from its column value and presence.
+ *
+ * @param value The column value of the field.
+ * @param presence The presence of the measurement.
+ * @param bit The presence bit of the field.
+ * @return std::optional<T>
+ */
+template <typename T>
+std::optional<T>
+GetIfPresent(T value, uint16_t presence, uint16_t bit) noexcept
+{
+    return ((presence & bit) != 0) ? std::optional<T>{ value } : std::nullopt;
+}
+} // namespace detail
+
+UwbRangingDataBatch::UwbRangingDataBatch() :
+    m_roundOffsets{ 0 }
+{}
+
+void
+UwbRangingDataBatch::Reserve(std::size_t numRounds, std::size_t numMeasurements)
+{
+    m_sessionIds.reserve(numRounds);
+    m_sequenceNumbers.reserve(numRounds);
+    m_currentRangingIntervals.reserve(numRounds);
+    m_rangingMeasurementTypes.reserve(numRounds);
+    m_roundOffsets.reserve(numRounds + 1);
+
+    m_distances.reserve(numMeasurements);
+    m_aoaAzimuths.reserve(numMeasurements);
+    m_aoaElevations.reserve(numMeasurements);
+    m_aoaDestinationAzimuths.reserve(numMeasurements);
+    m_aoaDestinationElevations.reserve(numMeasurements);
+    m_aoaAzimuthFoms.reserve(numMeasurements);
+    m_aoaElevationFoms.reserve(numMeasurements);
+    m_aoaDestinationAzimuthFoms.reserve(numMeasurements);
+    m_aoaDestinationElevationFoms.reserve(numMeasurements);
+    m_statusCodes.reserve(numMeasurements);
+    m_lineOfSightIndicators.reserve(numMeasurements);
+    m_slotIndices.reserve(numMeasurements);
+    m_peerIndices.reserve(numMeasurements);
+    m_presence.reserve(numMeasurements);
+}
+
+void
+UwbRangingDataBatch::Clear() noexcept
+{
+    m_sessionIds.clear();
+    m_sequenceNumbers.clear();
+    m_currentRangingIntervals.clear();
+    m_rangingMeasurementTypes.clear();
+    m_roundOffsets.resize(1);
+
+    m_distances.clear();
+    m_aoaAzimuths.clear();
+    m_aoaElevations.clear();
+    m_aoaDestinationAzimuths.clear();
+    m_aoaDestinationElevations.clear();
+    m_aoaAzimuthFoms.clear();
+    m_aoaElevationFoms.clear();
+    m_aoaDestinationAzimuthFoms.clear();
+    m_aoaDestinationElevationFoms.clear();
+    m_statusCodes.clear();
+    m_lineOfSightIndicators.clear();
+    m_slotIndices.clear();
+    m_peerIndices.clear();
+    m_presence.clear();
+
+    m_peerAddresses.clear();
+    m_peerAddressIndices.clear();
+}
+
+uint32_t
+UwbRangingDataBatch::GetOrAddPeerIndex(const UwbMacAddress& address)
+{
+    const auto [it, inserted] = m_peerAddressIndices.try_emplace(address, static_cast<uint32_t>(std::size(m_peerAddresses)));
+    if (inserted) {
+        m_peerAddresses.push_back(address);
+    }
+    return it->second;
+}
+
+void
+UwbRangingDataBatch::BeginRound(uint32_t sessionId, uint32_t sequenceNumber, uint32_t currentRangingInterval, UwbRangingMeasurementType rangingMeasurementType)
+{
+    m_sessionIds.push_back(sessionId);
+    m_sequenceNumbers.push_back(sequenceNumber);
+    m_currentRangingIntervals.push_back(currentRangingInterval);
+    m_rangingMeasurementTypes.push_back(rangingMeasurementType);
+}
+
+void
+UwbRangingDataBatch::Append(const UwbRangingData& rangingData)
+{
+    BeginRound(rangingData.SessionId, rangingData.SequenceNumber, rangingData.CurrentRangingInterval, rangingData.RangingMeasurementType);
+
+    // Measurement values are always present on the wire; only the figures of merit are optional.
+    constexpr uint16_t presenceValues = Presence::Distance | Presence::AoAAzimuth | Presence::AoAElevation | Presence::AoADestinationAzimuth | Presence::AoADestinationElevation;
+
+    for (const auto& measurement : rangingData.RangingMeasurements) {
+        m_distances.push_back(measurement.Distance);
+        m_aoaAzimuths.push_back(measurement.AoAAzimuth.Result);
+        m_aoaElevations.push_back(measurement.AoAElevation.Result);
+        m_aoaDestinationAzimuths.push_back(measurement.AoaDestinationAzimuth.Result);
+        m_aoaDestinationElevations.push_back(measurement.AoaDestinationElevation.Result);
+        m_aoaAzimuthFoms.push_back(measurement.AoAAzimuth.FigureOfMerit.value_or(0));
+        m_aoaElevationFoms.push_back(measurement.AoAElevation.FigureOfMerit.value_or(0));
+        m_aoaDestinationAzimuthFoms.push_back(measurement.AoaDestinationAzimuth.FigureOfMerit.value_or(0));
+        m_aoaDestinationElevationFoms.push_back(measurement.AoaDestinationElevation.FigureOfMerit.value_or(0));
+        m_statusCodes.push_back(uci::ToStatusCode(measurement.Status));
+        m_lineOfSightIndicators.push_back(measurement.LineOfSightIndicator);
+        m_slotIndices.push_back(measurement.SlotIndex);
+        m_peerIndices.push_back(GetOrAddPeerIndex(measurement.PeerMacAddress));
+        m_presence.push_back(presenceValues |
+            ::detail::GetPresenceBit(measurement.AoAAzimuth.FigureOfMerit, Presence::AoAAzimuthFom) |
+            ::detail::GetPresenceBit(measurement.AoAElevation.FigureOfMerit, Presence::AoAElevationFom) |
+            ::detail::GetPresenceBit(measurement.AoaDestinationAzimuth.FigureOfMerit, Presence::AoADestinationAzimuthFom) |
+            ::detail::GetPresenceBit(measurement.AoaDestinationElevation.FigureOfMerit, Presence::AoADestinationElevationFom));
+    }
+
+    m_roundOffsets.push_back(std::size(m_distances));
+}
+
+void
+UwbRangingDataBatch::Append(const std::vector<UwbPeer>& peers, uint32_t sessionId, uint32_t sequenceNumber)
+{
+    BeginRound(sessionId, sequenceNumber, 0, UwbRangingMeasurementType::TwoWay);
+
+    for (const auto& peer : peers) {
+        const auto spatialProperties = peer.GetSpatialProperties();
+        m_distances.push_back(::detail::ConvertDistance(spatialProperties.Distance.value_or(0)));
+        m_aoaAzimuths.push_back(::detail::ConvertIEEEToQ97Format(spatialProperties.AngleAzimuth.value_or(0)));
+        m_aoaElevations.push_back(::detail::ConvertIEEEToQ97Format(spatialProperties.AngleElevation.value_or(0)));
+        m_aoaDestinationAzimuths.push_back(0);
+        m_aoaDestinationElevations.push_back(::detail::ConvertIEEEToQ97Format(spatialProperties.Elevation.value_or(0)));
+        m_aoaAzimuthFoms.push_back(spatialProperties.AngleAzimuthFom.value_or(0));
+        m_aoaElevationFoms.push_back(spatialProperties.AngleElevationFom.value_or(0));
+        m_aoaDestinationAzimuthFoms.push_back(0);
+        m_aoaDestinationElevationFoms.push_back(spatialProperties.ElevationFom.value_or(0));
+        m_statusCodes.push_back(StatusCode::Ok);
+        m_lineOfSightIndicators.push_back(UwbLineOfSightIndicator::Indeterminant);
+        m_slotIndices.push_back(0);
+        m_peerIndices.push_back(GetOrAddPeerIndex(peer.GetAddress()));
+        m_presence.push_back(
+            ::detail::GetPresenceBit(spatialProperties.Distance, Presence::Distance) |
+            ::detail::GetPresenceBit(spatialProperties.AngleAzimuth, Presence::AoAAzimuth) |
+            ::detail::GetPresenceBit(spatialProperties.AngleElevation, Presence::AoAElevation) |
+            ::detail::GetPresenceBit(spatialProperties.Elevation, Presence::AoADestinationElevation) |
+            ::detail::GetPresenceBit(spatialProperties.AngleAzimuthFom, Presence::AoAAzimuthFom) |
+            ::detail::GetPresenceBit(spatialProperties.AngleElevationFom, Presence::AoAElevationFom) |
+            ::detail::GetPresenceBit(spatialProperties.ElevationFom, Presence::AoADestinationElevationFom));
+    }
+
+    m_roundOffsets.push_back(std::size(m_distances));
+}
+
+std::size_t
+UwbRangingDataBatch::GetNumRounds() const noexcept
+{
+    return std::size(m_sessionIds);
+}
+
+std::size_t
+UwbRangingDataBatch::GetNumMeasurements() const noexcept
+{
+    return std::size(m_distances);
+}
+
+void
+UwbRangingDataBatch::ValidateRoundIndex(std::size_t roundIndex) const
+{
+    if (roundIndex >= GetNumRounds()) {
+        throw std::out_of_range("ranging data batch round index out of range");
+    }
+}
+
+void
+UwbRangingDataBatch::GetRangingData(std::size_t roundIndex, UwbRangingData& rangingData) const
+{
+    ValidateRoundIndex(roundIndex);
+
+    rangingData.SequenceNumber = m_sequenceNumbers[roundIndex];
+    rangingData.SessionId = m_sessionIds[roundIndex];
+    rangingData.CurrentRangingInterval = m_currentRangingIntervals[roundIndex];
+    rangingData.RangingMeasurementType = m_rangingMeasurementTypes[roundIndex];
+
+    const auto begin = m_roundOffsets[roundIndex];
+    const auto end = m_roundOffsets[roundIndex + 1];
+    rangingData.RangingMeasurements.clear();
+    rangingData.RangingMeasurements.reserve(end - begin);
+    for (auto i = begin; i < end; i++) {
+        const auto presence = m_presence[i];
+        rangingData.RangingMeasurements.push_back(UwbRangingMeasurement{
+            .SlotIndex = m_slotIndices[i],
+            .Distance = m_distances[i],
+            .Status = uci::ToUwbStatus(m_statusCodes[i]).value_or(UwbStatusGeneric::Failed),
+            .PeerMacAddress = m_peerAddresses[m_peerIndices[i]],
+            .LineOfSightIndicator = m_lineOfSightIndicators[i],
+            .AoAAzimuth = { .Result = m_aoaAzimuths[i], .FigureOfMerit = ::detail::GetIfPresent(m_aoaAzimuthFoms[i], presence, Presence::AoAAzimuthFom) },
+            .AoAElevation = { .Result = m_aoaElevations[i], .FigureOfMerit = ::detail::GetIfPresent(m_aoaElevationFoms[i], presence, Presence::AoAElevationFom) },
+            .AoaDestinationAzimuth = { .Result = m_aoaDestinationAzimuths[i], .FigureOfMerit = ::detail::GetIfPresent(m_aoaDestinationAzimuthFoms[i], presence, Presence::AoADestinationAzimuthFom) },
+            .AoaDestinationElevation = { .Result = m_aoaDestinationElevations[i], .FigureOfMerit = ::detail::GetIfPresent(m_aoaDestinationElevationFoms[i], presence, Presence::AoADestinationElevationFom) },
+        });
+    }
+}
+
+UwbRangingData
+UwbRangingDataBatch::GetRangingData(std::size_t roundIndex) const
+{
+    UwbRangingData rangingData{};
+    GetRangingData(roundIndex, rangingData);
+    return rangingData;
+}
+
+std::vector<UwbPeer>
+UwbRangingDataBatch::GetPeers(std::size_t roundIndex) const
+{
+    ValidateRoundIndex(roundIndex);
+
+    const auto begin = m_roundOffsets[roundIndex];
+    const auto end = m_roundOffsets[roundIndex + 1];
+    std::vector<UwbPeer> peers;
+    peers.reserve(end - begin);
+    for (auto i = begin; i < end; i++) {
+        const auto presence = m_presence[i];
+        const auto toAngle = [&](uint16_t q97, uint16_t bit) {
+            return ::detail::GetIfPresent(ConvertQ97FormatToIEEE(q97), presence, bit);
+        };
+        peers.emplace_back(m_peerAddresses[m_peerIndices[i]], UwbPeerSpatialProperties{
+            .Distance = ::detail::GetIfPresent(static_cast<double>(m_distances[i]), presence, Presence::Distance),
+            .AngleAzimuth = toAngle(m_aoaAzimuths[i], Presence::AoAAzimuth),
+            .AngleElevation = toAngle(m_aoaElevations[i], Presence::AoAElevation),
+            .Elevation = toAngle(m_aoaDestinationElevations[i], Presence::AoADestinationElevation),
+            .AngleAzimuthFom = ::detail::GetIfPresent(m_aoaAzimuthFoms[i], presence, Presence::AoAAzimuthFom),
+            .AngleElevationFom = ::detail::GetIfPresent(m_aoaElevationFoms[i], presence, Presence::AoAElevationFom),
+            .ElevationFom = ::detail::GetIfPresent(m_aoaDestinationElevationFoms[i], presence, Presence::AoADestinationElevationFom),
+        });
+    }
+
+    return peers;
+}
+
+std::span<const uint32_t>
+UwbRangingDataBatch::GetSessionIds() const noexcept
+{
+    return m_sessionIds;
+}
+
+std::span<const uint32_t>
+UwbRangingDataBatch::GetSequenceNumbers() const noexcept
+{
+    return m_sequenceNumbers;
+}
+
+std::span<const uint32_t>
+UwbRangingDataBatch::GetCurrentRangingIntervals() const noexcept
+{
+    return m_currentRangingIntervals;
+}
+
+std::span<const UwbRangingMeasurementType>
+UwbRangingDataBatch::GetRangingMeasurementTypes() const noexcept
+{
+    return m_rangingMeasurementTypes;
+}
+
+std::span<const std::size_t>
+UwbRangingDataBatch::GetRoundOffsets() const noexcept
+{
+    return m_roundOffsets;
+}
+
+std::span<const uint16_t>
+UwbRangingDataBatch::GetDistances() const noexcept
+{
+    return m_distances;
+}
+
+std::span<const uint16_t>
+UwbRangingDataBatch::GetAoAAzimuths() const noexcept
+{
+    return m_aoaAzimuths;
+}
+
+std::span<const uint16_t>
+UwbRangingDataBatch::GetAoAElevations() const noexcept
+{
+    return m_aoaElevations;
+}
+
+std::span<const uint16_t>
+UwbRangingDataBatch::GetAoADestinationAzimuths() const noexcept
+{
+    return m_aoaDestinationAzimuths;
+}
+
+std::span<const uint16_t>
+UwbRangingDataBatch::GetAoADestinationElevations() const noexcept
+{
+    return m_aoaDestinationElevations;
+}
+
+std::span<const uint8_t>
+UwbRangingDataBatch::GetAoAAzimuthFoms() const noexcept
+{
+    return m_aoaAzimuthFoms;
+}
+
+std::span<const uint8_t>
+UwbRangingDataBatch::GetAoAElevationFoms() const noexcept
+{
+    return m_aoaElevationFoms;
+}
+
+std::span<const uint8_t>
+UwbRangingDataBatch::GetAoADestinationAzimuthFoms() const noexcept
+{
+    return m_aoaDestinationAzimuthFoms;
+}
+
+std::span<const uint8_t>
+UwbRangingDataBatch::GetAoADestinationElevationFoms() const noexcept
+{
+    return m_aoaDestinationElevationFoms;
+}
+
+std::span<const UwbRangingDataBatch::StatusCode>
+UwbRangingDataBatch::GetStatusCodes() const noexcept
+{
+    return m_statusCodes;
+}
+
+std::span<const UwbLineOfSightIndicator>
+UwbRangingDataBatch::GetLineOfSightIndicators() const noexcept
+{
+    return m_lineOfSightIndicators;
+}
+
+std::span<const uint8_t>
+UwbRangingDataBatch::GetSlotIndices() const noexcept
+{
+    return m_slotIndices;
+}
+
+std::span<const uint32_t>
+UwbRangingDataBatch::GetPeerIndices() const noexcept
+{
+    return m_peerIndices;
+}
+
+std::span<const uint16_t>
+UwbRangingDataBatch::GetPresence() const noexcept
+{
+    return m_presence;
+}
+
+std::span<const UwbMacAddress>
+UwbRangingDataBatch::GetPeerAddresses() const noexcept
+{
+    return m_peerAddresses;
+}
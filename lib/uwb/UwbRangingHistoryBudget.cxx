@@ -0,0 +1,46 @@
+
+#include <uwb/UwbRangingHistoryBudget.hxx>
+
+using namespace uwb;
+
+UwbRangingHistoryBudget::UwbRangingHistoryBudget(std::size_t limit) noexcept :
+    m_limit(limit)
+{}
+
+bool
+UwbRangingHistoryBudget::TryAcquire(std::size_t size) noexcept
+{
+    const auto limit = m_limit.load(std::memory_order_relaxed);
+    auto usage = m_usage.load(std::memory_order_relaxed);
+    do {
+        if (usage > limit || size > limit - usage) {
+            return false;
+        }
+    } while (!m_usage.compare_exchange_weak(usage, usage + size, std::memory_order_relaxed));
+
+    return true;
+}
+
+void
+UwbRangingHistoryBudget::Release(std::size_t size) noexcept
+{
+    m_usage.fetch_sub(size, std::memory_order_relaxed);
+}
+
+std::size_t
+UwbRangingHistoryBudget::GetLimit() const noexcept
+{
+    return m_limit.load(std::memory_order_relaxed);
+}
+
+void
+UwbRangingHistoryBudget::SetLimit(std::size_t limit) noexcept
+{
+    m_limit.store(limit, std::memory_order_relaxed);
+}
+
+std::size_t
+UwbRangingHistoryBudget::GetUsage() const noexcept
+{
+    return m_usage.load(std::memory_order_relaxed);
+}
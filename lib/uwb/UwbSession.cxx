@@ -1,10 +1,12 @@
 
 #include <cstdint>
+#include <optional>
 #include <stdexcept>
 
 #include <magic_enum.hpp>
 #include <plog/Log.h>
 
+#include <uwb/UwbDevice.hxx>
 #include <uwb/UwbSession.hxx>
 #include <uwb/UwbSessionEventCallbacks.hxx>
 #include <uwb/protocols/fira/UwbException.hxx>
@@ -12,21 +14,64 @@
 using namespace uwb;
 using namespace uwb::protocol::fira;
 
+namespace detail
+{
+/**
+ * @brief Get the ranging history budget of a device.
+ *
+ * @param device The device to get the budget of.
+ * @return std::shared_ptr<UwbRangingHistoryBudget> The budget, or nullptr if
+ * the device no longer exists.
+ */
+std::shared_ptr<UwbRangingHistoryBudget>
+GetRangingHistoryBudget(const std::weak_ptr<UwbDevice>& device)
+{
+    auto deviceShared = device.lock();
+    return (deviceShared != nullptr) ? deviceShared->GetRangingHistoryBudget() : nullptr;
+}
+} // namespace detail
+
 /* static */
 const std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameterType> UwbSession::AllParameters = {};
 
 UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<UwbDevice> device, std::weak_ptr<UwbSessionEventCallbacks> callbacks, DeviceType deviceType) :
     m_deviceType{ deviceType },
     m_sessionId(sessionId),
-    m_uwbMacAddressSelf(UwbMacAddress::Random<UwbMacAddressType::Extended>()),
     m_callbacks(std::move(callbacks)),
-    m_device(std::move(device))
-{}
+    m_device(std::move(device)),
+    m_rangingHistory(UwbPeerRangingHistoryStore::CapacityDefault, ::detail::GetRangingHistoryBudget(m_device))
+{
+    // Allocate the address from the parent device so that it is unique amongst
+    // its sessions. Sessions without a device fall back to a random address.
+    auto deviceShared = m_device.lock();
+    if (deviceShared != nullptr) {
+        auto uwbMacAddressSelf = deviceShared->GetMacAddressAllocator().Allocate(m_uwbMacAddressType);
+        if (uwbMacAddressSelf.has_value()) {
+            m_uwbMacAddressSelf = *uwbMacAddressSelf;
+            m_uwbMacAddressSelfAllocated = true;
+            return;
+        }
+    }
+
+    m_uwbMacAddressSelf = UwbMacAddress::Random(m_uwbMacAddressType);
+}
 
 UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<UwbDevice> device, DeviceType deviceType) :
     UwbSession(sessionId, std::move(device), std::weak_ptr<UwbSessionEventCallbacks>{}, deviceType)
 {}
 
+UwbSession::~UwbSession()
+{
+    if (!m_uwbMacAddressSelfAllocated) {
+        return;
+    }
+
+    auto deviceShared = m_device.lock();
+    if (deviceShared != nullptr) {
+        deviceShared->GetMacAddressAllocator().Release(m_uwbMacAddressSelf);
+    }
+}
+
 std::weak_ptr<UwbSessionEventCallbacks>
 UwbSession::GetEventCallbacks() noexcept
 {
@@ -96,6 +141,17 @@ UwbSession::Configure(const std::vector<protocol::fira::UwbApplicationConfigurat
         PLOG_ERROR << "error configuring session " << m_sessionId << ", unexpected exception status=" << e.what();
         throw e;
     }
+
+    std::scoped_lock applicationConfigurationLock{ m_applicationConfigurationGate };
+    m_applicationConfigurationTracker.Reset();
+    m_applicationConfigurationResetCount++;
+    try {
+        const ApplicationConfigurationSet applicationConfiguration{ configParams };
+        m_applicationConfigurationTracker.Commit(m_applicationConfigurationTracker.Plan(applicationConfiguration, false));
+    } catch (const std::exception& e) {
+        PLOG_WARNING << "session " << m_sessionId << " configuration cannot be tracked, all parameters will be sent on the next update, " << e.what();
+        m_applicationConfigurationTracker.Reset();
+    }
 }
 
 void
@@ -138,7 +194,86 @@ void
 UwbSession::SetApplicationConfigurationParameters(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters)
 {
     PLOG_VERBOSE << "session " << m_sessionId << " set application configuration parameters";
-    return SetApplicationConfigurationParametersImpl(std::move(uwbApplicationConfigurationParameters));
+
+    std::optional<ApplicationConfigurationSet> applicationConfiguration;
+    try {
+        applicationConfiguration.emplace(uwbApplicationConfigurationParameters);
+    } catch (const std::exception& e) {
+        PLOG_WARNING << "session " << m_sessionId << " application configuration parameters cannot be tracked, sending all, " << e.what();
+        ResetApplicationConfiguration();
+        SetApplicationConfigurationParametersImpl(std::move(uwbApplicationConfigurationParameters));
+        return;
+    }
+
+    // The UWBS is updated without holding the lock since it may deliver
+    // notifications, which reset the tracker, synchronously. The plan is only
+    // committed if no reset happened in the meantime.
+    ApplicationConfigurationUpdatePlan plan;
+    uint64_t resetCount = 0;
+    {
+        std::scoped_lock applicationConfigurationLock{ m_applicationConfigurationGate };
+        plan = m_applicationConfigurationTracker.Plan(*applicationConfiguration, m_rangingActive);
+        resetCount = m_applicationConfigurationResetCount;
+    }
+
+    if (plan.IsEmpty()) {
+        PLOG_VERBOSE << "session " << m_sessionId << " application configuration parameters unchanged, skipping update";
+    } else if (plan.RequiresRestart) {
+        PLOG_VERBOSE << "session " << m_sessionId << " application configuration parameters not changeable while active, restarting ranging";
+        StopRanging();
+        try {
+            SetApplicationConfigurationParametersImpl(plan.Parameters);
+        } catch (...) {
+            StartRanging();
+            throw;
+        }
+        StartRanging();
+    } else {
+        SetApplicationConfigurationParametersImpl(plan.Parameters);
+    }
+
+    PLOG_VERBOSE << "session " << m_sessionId << " sent " << std::size(plan.Parameters) << " of " << std::size(uwbApplicationConfigurationParameters) << " application configuration parameters (" << plan.NumBytes << " of " << plan.NumBytesFull << " bytes)";
+
+    std::scoped_lock applicationConfigurationLock{ m_applicationConfigurationGate };
+    if (resetCount != m_applicationConfigurationResetCount) {
+        PLOG_VERBOSE << "session " << m_sessionId << " application configuration reset during update, not tracking it";
+        return;
+    }
+    m_applicationConfigurationTracker.Commit(plan);
+}
+
+ApplicationConfigurationMetrics
+UwbSession::GetApplicationConfigurationMetrics()
+{
+    std::scoped_lock applicationConfigurationLock{ m_applicationConfigurationGate };
+    return m_applicationConfigurationTracker.GetMetrics();
+}
+
+void
+UwbSession::ResetApplicationConfiguration() noexcept
+{
+    PLOG_VERBOSE << "session " << m_sessionId << " application configuration reset, all parameters will be sent on the next update";
+    std::scoped_lock applicationConfigurationLock{ m_applicationConfigurationGate };
+    m_applicationConfigurationTracker.Reset();
+    m_applicationConfigurationResetCount++;
+}
+
+std::vector<UwbPeerTable::Entry>
+UwbSession::GetPeers() const
+{
+    return m_peerTable.GetPeers();
+}
+
+std::optional<UwbPeerTable::Entry>
+UwbSession::GetPeer(const UwbMacAddress& address) const
+{
+    return m_peerTable.GetPeer(address);
+}
+
+const UwbPeerRangingHistoryStore&
+UwbSession::GetRangingHistory() const noexcept
+{
+    return m_rangingHistory;
 }
 
 UwbSessionState
@@ -152,6 +287,7 @@ void
 UwbSession::Destroy()
 {
     PLOG_VERBOSE << "session " << m_sessionId << " destroy";
+    ResetApplicationConfiguration();
     DestroyImpl();
 }
 
@@ -169,6 +305,17 @@ UwbSession::OnSessionStateChanged(std::shared_ptr<uwb::UwbSessionEventCallbacks>
 
     PLOG_VERBOSE << "session " << m_sessionId << " changed state: " << magic_enum::enum_name(stateOld) << " --> " << magic_enum::enum_name(state);
 
+    // The UWBS discards the application configuration and peers of a
+    // deinitialized session.
+    if (state == UwbSessionState::Deinitialized) {
+        ResetApplicationConfiguration();
+        m_rangingHistory.Clear();
+    }
+
+    if (callbacks == nullptr) {
+        return;
+    }
+
     // Check if the session transitioned into the ranging state.
     if (stateOld != UwbSessionState::Active && state == UwbSessionState::Active) {
         callbacks->OnRangingStarted(this);
@@ -182,19 +329,32 @@ void
 UwbSession::OnSessionEnded(std::shared_ptr<uwb::UwbSessionEventCallbacks> callbacks, ::uwb::UwbSessionEndReason reason)
 {
     PLOG_VERBOSE << "session " << m_sessionId << " ended";
-    callbacks->OnSessionEnded(this, reason);
+    ResetApplicationConfiguration();
+    // Return the memory of the ranging histories to the device budget.
+    m_rangingHistory.Clear();
+    if (callbacks != nullptr) {
+        callbacks->OnSessionEnded(this, reason);
+    }
 }
 
 void
 UwbSession::OnPeerPropertiesChanged(std::shared_ptr<uwb::UwbSessionEventCallbacks> callbacks, std::vector<::uwb::UwbPeer> peersChanged)
 {
     PLOG_VERBOSE << "session " << m_sessionId << " peer properties changed";
-    callbacks->OnPeerPropertiesChanged(this, std::move(peersChanged));
+    m_peerTable.Update(peersChanged);
+    m_rangingHistory.Record(peersChanged, UwbPeerRangingHistoryStore::Clock::now());
+    if (callbacks != nullptr) {
+        callbacks->OnPeerPropertiesChanged(this, std::move(peersChanged));
+    }
 }
 
 void
 UwbSession::OnSessionMembershipChanged(std::shared_ptr<uwb::UwbSessionEventCallbacks> callbacks, std::vector<::uwb::UwbPeer> peersAdded, std::vector<::uwb::UwbPeer> peersRemoved)
 {
     PLOG_VERBOSE << "session " << m_sessionId << " session membership changed";
-    callbacks->OnSessionMembershipChanged(this, std::move(peersAdded), std::move(peersRemoved));
+    m_peerTable.Remove(peersRemoved);
+    m_rangingHistory.Remove(peersRemoved);
+    if (callbacks != nullptr) {
+        callbacks->OnSessionMembershipChanged(this, std::move(peersAdded), std::move(peersRemoved));
+    }
 }
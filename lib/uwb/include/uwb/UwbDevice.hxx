@@ -7,6 +7,8 @@
 #include <unordered_map>
 
 #include <uwb/UwbDeviceEventCallbacks.hxx>
+#include <uwb/UwbMacAddressAllocator.hxx>
+#include <uwb/UwbRangingHistoryBudget.hxx>
 #include <uwb/UwbSession.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
 #include <uwb/protocols/fira/UwbCapability.hxx>
@@ -85,6 +87,24 @@ public:
     bool
     Initialize();
 
+    /**
+     * @brief Get the allocator for MAC addresses used by sessions on this
+     * device.
+     *
+     * @return UwbMacAddressAllocator&
+     */
+    UwbMacAddressAllocator&
+    GetMacAddressAllocator() noexcept;
+
+    /**
+     * @brief Get the budget limiting the memory used by the peer ranging
+     * histories of all sessions on this device.
+     *
+     * @return std::shared_ptr<UwbRangingHistoryBudget>
+     */
+    std::shared_ptr<UwbRangingHistoryBudget>
+    GetRangingHistoryBudget() const noexcept;
+
     /**
      * @brief Determine if this device is the same as another.
      *
@@ -200,11 +220,21 @@ protected:
     void
     OnDeviceStatusChanged(::uwb::protocol::fira::UwbStatusDevice statusDevice);
 
+private:
+    /**
+     * @brief Forget the application configuration last applied to each cached
+     * session, for when the UWBS may have discarded all session state.
+     */
+    void
+    ResetSessionApplicationConfigurations();
+
 private:
     ::uwb::protocol::fira::UwbStatusDevice m_status{ .State = ::uwb::protocol::fira::UwbDeviceState::Uninitialized };
     ::uwb::protocol::fira::UwbStatus m_lastError{ ::uwb::protocol::fira::UwbStatusGeneric::Ok };
     std::shared_mutex m_sessionsGate;
     std::unordered_map<uint32_t, std::weak_ptr<uwb::UwbSession>> m_sessions{};
+    UwbMacAddressAllocator m_macAddressAllocator{};
+    std::shared_ptr<UwbRangingHistoryBudget> m_rangingHistoryBudget{ std::make_shared<UwbRangingHistoryBudget>() };
 };
 
 bool
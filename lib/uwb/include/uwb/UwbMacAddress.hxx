@@ -4,19 +4,14 @@
 
 #include <algorithm>
 #include <array>
-#include <chrono>
-#include <climits>
+#include <compare>
 #include <cstdint>
 #include <istream>
 #include <optional>
-#include <random>
 #include <span>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
-#include <variant>
-
-#include <notstd/hash.hxx>
 
 namespace uwb
 {
@@ -200,11 +195,10 @@ public:
     static constexpr auto ExtendedLength = UwbMacAddressLength::Extended;
 
     /**
-     * @brief C++ types for each address type and aggregate value type.
+     * @brief C++ types for each address type.
      */
     using ShortType = std::array<uint8_t, ShortLength>;
     using ExtendedType = std::array<uint8_t, ExtendedLength>;
-    using ValueType = std::variant<ShortType, ExtendedType>;
 
     /**
      * @brief Get the address type.
@@ -252,36 +246,6 @@ public:
     ToString() const;
 
 private:
-    /**
-     * @brief Compile-time helper to retrieve a reference to the active value of
-     * the variant holding the mac address.
-     *
-     * @tparam Length
-     * @param uwbMacAddress
-     * @return std::array<uint8_t, Length>&
-     */
-    template <size_t Length>
-    constexpr std::array<uint8_t, Length>&
-    UwbMacAddressValue(UwbMacAddress& uwbMacAddress)
-    {
-        return std::get<std::array<uint8_t, Length>>(uwbMacAddress.m_value);
-    }
-
-    /**
-     * @brief Compile-time helper to generate a view of the address based on the
-     * selected type.
-     *
-     * @tparam Length
-     * @param uwbMacAddress
-     * @return std::span<const uint8_t>
-     */
-    template <size_t Length>
-    std::span<const uint8_t> constexpr UwbMacAddressView(UwbMacAddress& uwbMacAddress)
-    {
-        auto& value = UwbMacAddressValue<Length>(uwbMacAddress);
-        return { std::begin(value), std::end(value) };
-    }
-
     /**
      * @brief Construct a new UwbMacAddress object based on compile-time deduced
      * arguments from a value wrapper.
@@ -291,11 +255,11 @@ private:
      */
     template <size_t Length>
     constexpr UwbMacAddress(detail::UwbMacAddressValueWrapper<Length> value) :
-        m_length{ value.length },
-        m_type{ value.address_type },
-        m_value{ value.address },
-        m_view{ UwbMacAddressView<Length>(*this) }
-    {}
+        m_length{ static_cast<uint8_t>(value.length) },
+        m_type{ value.address_type }
+    {
+        std::copy(std::cbegin(value.address), std::cend(value.address), std::begin(m_value));
+    }
 
 public:
     /**
@@ -323,26 +287,19 @@ public:
     static UwbMacAddress
     Random()
     {
-        using byte_generator = std::independent_bits_engine<std::mt19937, CHAR_BIT * sizeof(uint8_t), uint16_t>;
-
-        // Create a new bit engine seeded with the current time. Note that this
-        // could be predictable for a motivated attacker so should not be relied
-        // upon if security is a concern.
-        const auto timeSinceEpoch = std::chrono::system_clock::now().time_since_epoch();
-        byte_generator byteGenerator(static_cast<byte_generator::result_type>(timeSinceEpoch.count()));
-
-        std::array<uint8_t, detail::UwbMacAddressSizeV<AddressType>> address{};
-        std::generate(std::begin(address), std::end(address), [&byteGenerator]() {
-            return static_cast<uint8_t>(byteGenerator());
-        });
-
-        return UwbMacAddress{ address };
+        return Random(AddressType);
     }
 
     /**
      * @brief Construct a new, randomly generated UwbMacAddress object based on
      * runtime provided arguments.
      *
+     * Addresses are drawn from a per-thread generator that is seeded once,
+     * from std::random_device, on first use by each thread. The generator is
+     * not cryptographically secure, so generated addresses should not be
+     * relied upon to be unpredictable. Use UwbMacAddressAllocator where
+     * addresses must also be unique.
+     *
      * @param type The type of random address to generate.
      * @return UwbMacAddress The randomly generated address value.
      */
@@ -366,95 +323,27 @@ public:
         UwbMacAddress(ShortType{ 0x00, 0x00 })
     {}
 
-    /**
-     * @brief Copy constructor.
-     *
-     * @param other
-     */
-    constexpr UwbMacAddress(const UwbMacAddress& other) :
-        m_length(other.m_length),
-        m_type(other.m_type),
-        m_value(other.m_value)
-    {
-        // Note that the view span (m_view) cannot be directly copied from the other
-        // instance because that view refers to its own address storage. Hence, the
-        // view is explicitly initialized here.
-        InitializeView();
-    }
-
-    /**
-     * @brief Copy assignment operator.
-     *
-     * @param other
-     * @return UwbMacAddress&
-     */
-    constexpr UwbMacAddress&
-    operator=(UwbMacAddress other)
-    {
-        // Note that this implementation of operator= uses a copy of another
-        // instance, whereas the typical implementation takes a const reference.
-        // This value-based version is used to ensure copy-elision occurs, avoiding
-        // the need to create a temporary when using the standard copy-and-swap
-        // idiom.
-        Swap(other);
-        return *this;
-    }
-
     /**
      * @brief Three-way comparison operator.
-     */
-    auto
-    operator<=>(const UwbMacAddress& other) const noexcept;
-
-private:
-    /**
-     * @brief Construct a new UwbMacAddress object given an input string of
-     * semicolon-delimited bytes.
      *
-     * @param addressString The semicolon-delimited address string.
-     * @param addressType The type of mac address that addressString represents.
+     * Short addresses order before extended addresses; addresses of the same
+     * type are ordered lexicographically by value.
      */
-    UwbMacAddress(const std::string& addressString, UwbMacAddressType addressType);
-
-    /**
-     * @brief Swap the data members of this instance with another one.
-     *
-     * @param other The other instance to swap with.
-     */
-    constexpr void
-    Swap(UwbMacAddress& other) noexcept
-    {
-        std::swap(this->m_type, other.m_type);
-        std::swap(this->m_length, other.m_length);
-        auto tmpValue = std::move(other.m_value);
-        other.m_value = std::move(this->m_value);
-        this->m_value = std::move(tmpValue);
-        InitializeView();
-        other.InitializeView();
-    }
+    std::strong_ordering
+    operator<=>(const UwbMacAddress& other) const noexcept;
 
     /**
-     * @brief Initialize the address view.
+     * @brief Get a hash of the address.
      *
-     * This is the runtime version that must be used for the copy-constructor,
-     * since the other object being copied does not have compile-time address
-     * length information available.
+     * The zero-padded address value is mixed as a single 64-bit word rather
+     * than byte-by-byte.
      *
-     * Note that the assigned view will reflect whatever is in the m_value
-     * variant at the time of the call. Thus, m_value must be appropriately
-     * initialized prior to invoking this function for the view to be assigned
-     * coherently.
+     * @return std::size_t
      */
-    constexpr void
-    InitializeView()
-    {
-        // clang-format off
-        std::visit([&](auto&& value) {
-            m_view = { std::begin(value), std::end(value) };
-        }, m_value);
-        // clang-format on
-    }
+    std::size_t
+    Hash() const noexcept;
 
+private:
     /**
      * @brief Allow global equality function to access private members.
      *
@@ -466,28 +355,18 @@ private:
 
 private:
     /**
-     * @brief Note: the order of variable declarations here is critical. The
-     * m_view member must be declared after m_value since it is a read-only view
-     * of its contents.
+     * @brief The address value. Only the first 'm_length' bytes are
+     * significant; the remaining bytes are always zero so that the whole array
+     * may be compared and hashed as a single word.
      */
-    std::size_t m_length{ UwbMacAddressLength::Short };
+    ExtendedType m_value{};
+    uint8_t m_length{ UwbMacAddressLength::Short };
     UwbMacAddressType m_type{ UwbMacAddressType::Short };
-
-    /**
-     * @brief The address value, which depends on the 'm_type' field.
-     *
-     * Despite the 'm_type' field driving this value, the std::variant is the
-     * ultimate ground-truth for the value, and the appropriate methods from
-     * that class should be used to obtain it.
-     */
-    std::variant<ShortType, ExtendedType> m_value{ ShortType{ 0xBE, 0xEF } };
-
-    /**
-     * @brief Read-only view of the address data.
-     */
-    std::span<const uint8_t> m_view;
 };
 
+static_assert(std::is_trivially_copyable_v<UwbMacAddress>);
+static_assert(sizeof(UwbMacAddress) == UwbMacAddressLength::Extended + 2);
+
 bool
 operator==(const UwbMacAddress&, const UwbMacAddress&) noexcept;
 
@@ -504,8 +383,7 @@ struct hash<uwb::UwbMacAddress>
     size_t
     operator()(const uwb::UwbMacAddress& uwbMacAddress) const noexcept
     {
-        const auto& value = uwbMacAddress.GetValue();
-        return notstd::hash_range(std::cbegin(value), std::cend(value));
+        return uwbMacAddress.Hash();
     }
 };
 } // namespace std
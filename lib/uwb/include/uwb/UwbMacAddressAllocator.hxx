@@ -0,0 +1,121 @@
+
+#ifndef UWB_MAC_ADDRESS_ALLOCATOR_HXX
+#define UWB_MAC_ADDRESS_ALLOCATOR_HXX
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include <uwb/UwbMacAddress.hxx>
+
+namespace uwb
+{
+/**
+ * @brief Allocates random UWB MAC addresses that are unique amongst all
+ * addresses currently allocated from the same instance.
+ *
+ * Each UwbDevice owns an instance so that no two sessions on a device are
+ * assigned the same address. All member functions are thread-safe.
+ */
+class UwbMacAddressAllocator
+{
+public:
+    /**
+     * @brief The number of distinct short addresses.
+     */
+    static constexpr std::size_t ShortAddressCount = 1U << (UwbMacAddressLength::Short * 8U);
+
+    /**
+     * @brief Allocate a new, unique address.
+     *
+     * @param type The type of address to allocate.
+     * @return std::optional<UwbMacAddress> The allocated address, or
+     * std::nullopt if every address of the requested type is already
+     * allocated.
+     */
+    std::optional<UwbMacAddress>
+    Allocate(UwbMacAddressType type);
+
+    /**
+     * @brief Allocate a batch of new, unique addresses.
+     *
+     * @param type The type of addresses to allocate.
+     * @param count The number of addresses to allocate.
+     * @return std::vector<UwbMacAddress> The allocated addresses. This holds
+     * fewer than count addresses only if the address space was exhausted.
+     */
+    std::vector<UwbMacAddress>
+    Allocate(UwbMacAddressType type, std::size_t count);
+
+    /**
+     * @brief Mark an address that was obtained elsewhere as allocated, so it
+     * is never handed out by this allocator.
+     *
+     * @param uwbMacAddress The address to reserve.
+     * @return true If the address was reserved.
+     * @return false If the address was already allocated.
+     */
+    bool
+    Reserve(const UwbMacAddress& uwbMacAddress);
+
+    /**
+     * @brief Release a previously allocated address, allowing it to be
+     * allocated again.
+     *
+     * @param uwbMacAddress The address to release.
+     * @return true If the address was released.
+     * @return false If the address was not allocated.
+     */
+    bool
+    Release(const UwbMacAddress& uwbMacAddress);
+
+    /**
+     * @brief Determine whether an address is currently allocated.
+     *
+     * @param uwbMacAddress The address to check.
+     * @return true If the address is allocated.
+     * @return false Otherwise.
+     */
+    bool
+    IsAllocated(const UwbMacAddress& uwbMacAddress) const;
+
+    /**
+     * @brief Get the number of addresses currently allocated.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetAllocatedCount() const;
+
+private:
+    /**
+     * @brief Allocate a new, unique address. The caller must hold
+     * m_allocatedGate.
+     *
+     * @param type The type of address to allocate.
+     * @return std::optional<UwbMacAddress>
+     */
+    std::optional<UwbMacAddress>
+    AllocateLocked(UwbMacAddressType type);
+
+    /**
+     * @brief Record an address as allocated. The caller must hold
+     * m_allocatedGate.
+     *
+     * @param uwbMacAddress The address to record.
+     * @return true If the address was not previously allocated.
+     * @return false Otherwise.
+     */
+    bool
+    InsertLocked(const UwbMacAddress& uwbMacAddress);
+
+private:
+    mutable std::mutex m_allocatedGate;
+    std::unordered_set<UwbMacAddress> m_allocated;
+    std::size_t m_allocatedShortCount{ 0 };
+};
+} // namespace uwb
+
+#endif // UWB_MAC_ADDRESS_ALLOCATOR_HXX
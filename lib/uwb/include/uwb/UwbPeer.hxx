@@ -2,9 +2,10 @@
 #ifndef UWB_PEER_HXX
 #define UWB_PEER_HXX
 
-#include <mutex>
 #include <optional>
+#include <type_traits>
 
+#include <notstd/seqlock.hxx>
 #include <uwb/UwbMacAddress.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
 
@@ -31,8 +32,13 @@ struct UwbPeerSpatialProperties
     operator<=>(const UwbPeerSpatialProperties& other) const = default;
 };
 
+static_assert(std::is_trivially_copyable_v<UwbPeerSpatialProperties>);
+
 /**
  * @brief Represents a UWB peer device.
+ *
+ * The spatial properties may be updated by one thread while being read by
+ * others. Reads never block; see GetSpatialProperties().
  */
 class UwbPeer
 {
@@ -87,6 +93,15 @@ public:
     UwbPeer&
     operator=(const UwbPeer& other);
 
+    /**
+     * @brief Move-assignment operator.
+     *
+     * @param other
+     * @return UwbPeer&
+     */
+    UwbPeer&
+    operator=(UwbPeer&& other) noexcept;
+
     /**
      * @brief Get the peer's mac address.
      *
@@ -98,11 +113,25 @@ public:
     /**
      * @brief Retrieves the latest spatial properties for this peer.
      *
+     * This never blocks, and always returns properties from a single update,
+     * even when called concurrently with SetSpatialProperties().
+     *
      * @return UwbPeerSpatialProperties
      */
     UwbPeerSpatialProperties
     GetSpatialProperties() const noexcept;
 
+    /**
+     * @brief Updates the spatial properties for this peer.
+     *
+     * This is intended to be called from a single thread, typically the one
+     * processing ranging notifications.
+     *
+     * @param spatialProperties The new spatial properties.
+     */
+    void
+    SetSpatialProperties(const UwbPeerSpatialProperties& spatialProperties) noexcept;
+
     /**
      * @brief Returns a string representation of the object.
      *
@@ -113,8 +142,7 @@ public:
 
 private:
     UwbMacAddress m_address;
-    UwbPeerSpatialProperties m_spatialProperties{};
-    mutable std::mutex m_spatialPropertiesGate;
+    notstd::seqlock<UwbPeerSpatialProperties> m_spatialProperties{};
 };
 
 bool
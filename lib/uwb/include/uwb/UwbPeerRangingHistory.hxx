@@ -0,0 +1,250 @@
+
+#ifndef UWB_PEER_RANGING_HISTORY_HXX
+#define UWB_PEER_RANGING_HISTORY_HXX
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <uwb/UwbPeer.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/uci/StatusCodes.hxx>
+
+namespace uwb
+{
+/**
+ * @brief A single ranging measurement of a peer, as retained in its history.
+ *
+ * Values are narrowed to single precision so that two samples fit in a cache
+ * line. Values that were not measured are NaN, and figures of merit that
+ * were not reported are 0.
+ */
+struct UwbPeerRangingSample
+{
+    using Clock = std::chrono::steady_clock;
+    using StatusCode = uwb::protocol::fira::uci::StatusCode;
+
+    Clock::time_point Timestamp;
+    float Distance;
+    float AngleAzimuth;
+    float AngleElevation;
+    float Elevation;
+    uint8_t AngleAzimuthFom{ 0 };
+    uint8_t AngleElevationFom{ 0 };
+    uint8_t ElevationFom{ 0 };
+    StatusCode Status{ StatusCode::Ok };
+
+    /**
+     * @brief Create a sample from a peer. Peers only carry the properties of
+     * successful measurements, so the status is always StatusCode::Ok.
+     *
+     * @param peer The peer to create the sample from.
+     * @param timestamp The time of the measurement.
+     * @return UwbPeerRangingSample
+     */
+    static UwbPeerRangingSample
+    FromPeer(const UwbPeer& peer, Clock::time_point timestamp) noexcept;
+
+    /**
+     * @brief Create a sample from a ranging measurement.
+     *
+     * @param rangingMeasurement The ranging measurement to create the sample from.
+     * @param timestamp The time of the measurement.
+     * @return UwbPeerRangingSample
+     */
+    static UwbPeerRangingSample
+    FromRangingMeasurement(const uwb::protocol::fira::UwbRangingMeasurement& rangingMeasurement, Clock::time_point timestamp) noexcept;
+
+    /**
+     * @brief Convert the sample to peer spatial properties.
+     *
+     * @return UwbPeerSpatialProperties
+     */
+    UwbPeerSpatialProperties
+    ToSpatialProperties() const noexcept;
+};
+
+static_assert(std::is_trivially_copyable_v<UwbPeerRangingSample>);
+static_assert(sizeof(UwbPeerRangingSample) == 32);
+
+/**
+ * @brief Aggregate statistics over a window of a peer's ranging history.
+ * Statistics of a value are only present if at least one successful sample
+ * in the window measured it.
+ */
+struct UwbPeerRangingAggregate
+{
+    std::size_t Count{ 0 };
+    std::size_t CountSuccessful{ 0 };
+    std::optional<float> DistanceMin;
+    std::optional<float> DistanceMax;
+    std::optional<float> DistanceMean;
+    std::optional<float> AngleAzimuthMean;
+    std::optional<float> AngleElevationMean;
+};
+
+/**
+ * @brief Fixed-capacity history of the most recent ranging samples of a peer.
+ *
+ * Storage is allocated once, in cache-line aligned blocks, when the history
+ * is created. Pushing a sample overwrites the oldest one once the history is
+ * full, and queries copy into caller-provided storage, so neither allocates.
+ * Samples must be pushed in timestamp order.
+ *
+ * This class is not thread-safe; see UwbPeerRangingHistoryStore.
+ */
+class UwbPeerRangingHistory
+{
+public:
+    using Clock = UwbPeerRangingSample::Clock;
+
+    static constexpr std::size_t CacheLineSize = 64;
+    static constexpr std::size_t SamplesPerBlock = CacheLineSize / sizeof(UwbPeerRangingSample);
+
+    /**
+     * @brief Construct a new UwbPeerRangingHistory object.
+     *
+     * @param capacity The maximum number of samples retained. This is rounded
+     * up to a whole, non-zero number of cache lines.
+     */
+    explicit UwbPeerRangingHistory(std::size_t capacity);
+
+    /**
+     * @brief Get the number of bytes of sample storage used by a history of
+     * the specified capacity.
+     *
+     * @param capacity The requested capacity.
+     * @return std::size_t
+     */
+    static constexpr std::size_t
+    GetStorageSize(std::size_t capacity) noexcept
+    {
+        return ((capacity + SamplesPerBlock - 1) / SamplesPerBlock) * CacheLineSize;
+    }
+
+    /**
+     * @brief Add a sample, replacing the oldest sample if the history is full.
+     *
+     * @param sample The sample to add.
+     */
+    void
+    Push(const UwbPeerRangingSample& sample) noexcept;
+
+    /**
+     * @brief Remove all samples.
+     */
+    void
+    Clear() noexcept;
+
+    /**
+     * @brief Get the maximum number of samples retained.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetCapacity() const noexcept;
+
+    /**
+     * @brief Get the number of samples retained.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetSize() const noexcept;
+
+    /**
+     * @brief Get the most recent sample.
+     *
+     * @return std::optional<UwbPeerRangingSample> The sample, or std::nullopt
+     * if the history is empty.
+     */
+    std::optional<UwbPeerRangingSample>
+    GetLatest() const noexcept;
+
+    /**
+     * @brief Copy the most recent samples, oldest first.
+     *
+     * @param samples The destination. At most samples.size() samples are copied.
+     * @return std::size_t The number of samples copied.
+     */
+    std::size_t
+    CopyLast(std::span<UwbPeerRangingSample> samples) const noexcept;
+
+    /**
+     * @brief Copy the most recent samples taken at or after a point in time,
+     * oldest first.
+     *
+     * @param since The earliest timestamp to include.
+     * @param samples The destination. If more samples match than fit, only
+     * the most recent are copied.
+     * @return std::size_t The number of samples copied.
+     */
+    std::size_t
+    CopySince(Clock::time_point since, std::span<UwbPeerRangingSample> samples) const noexcept;
+
+    /**
+     * @brief Aggregate the samples taken at or after a point in time.
+     *
+     * @param since The earliest timestamp to include.
+     * @return UwbPeerRangingAggregate
+     */
+    UwbPeerRangingAggregate
+    Aggregate(Clock::time_point since) const noexcept;
+
+private:
+    struct alignas(CacheLineSize) SampleBlock
+    {
+        std::array<UwbPeerRangingSample, SamplesPerBlock> Samples;
+    };
+
+    static_assert(sizeof(SampleBlock) == CacheLineSize);
+
+    /**
+     * @brief Get the sample at the specified age, where 0 is the most recent.
+     *
+     * @param age The age of the sample. This must be less than GetSize().
+     * @return const UwbPeerRangingSample&
+     */
+    const UwbPeerRangingSample&
+    GetSampleByAge(std::size_t age) const noexcept;
+
+    /**
+     * @brief Get the number of most recent samples taken at or after a point
+     * in time.
+     *
+     * @param since The earliest timestamp to include.
+     * @return std::size_t
+     */
+    std::size_t
+    CountSince(Clock::time_point since) const noexcept;
+
+    /**
+     * @brief Copy the specified number of most recent samples, oldest first.
+     *
+     * @param count The number of samples to copy. This must not exceed
+     * GetSize() nor samples.size().
+     * @param samples The destination.
+     */
+    void
+    CopyNewest(std::size_t count, std::span<UwbPeerRangingSample> samples) const noexcept;
+
+    UwbPeerRangingSample&
+    GetSample(std::size_t index) noexcept;
+
+    const UwbPeerRangingSample&
+    GetSample(std::size_t index) const noexcept;
+
+private:
+    std::vector<SampleBlock> m_blocks;
+    std::size_t m_capacity{ 0 };
+    std::size_t m_next{ 0 };
+    std::size_t m_size{ 0 };
+};
+} // namespace uwb
+
+#endif // UWB_PEER_RANGING_HISTORY_HXX
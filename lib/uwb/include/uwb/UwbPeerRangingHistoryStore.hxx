@@ -0,0 +1,171 @@
+
+#ifndef UWB_PEER_RANGING_HISTORY_STORE_HXX
+#define UWB_PEER_RANGING_HISTORY_STORE_HXX
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbPeerRangingHistory.hxx>
+#include <uwb/UwbRangingHistoryBudget.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb
+{
+/**
+ * @brief The ranging histories of the peers in a session.
+ *
+ * A history is created the first time a peer is recorded, provided its
+ * memory can be acquired from the budget; peers whose history cannot be
+ * created are not tracked until memory becomes available. Once a peer is
+ * tracked, recording and querying it does not allocate. All member functions
+ * are thread-safe.
+ */
+class UwbPeerRangingHistoryStore
+{
+public:
+    using Clock = UwbPeerRangingHistory::Clock;
+
+    /**
+     * @brief The default number of samples retained per peer.
+     */
+    static constexpr std::size_t CapacityDefault = 64;
+
+    /**
+     * @brief Construct a new UwbPeerRangingHistoryStore object.
+     *
+     * @param capacity The number of samples retained per peer.
+     * @param budget The budget to acquire history memory from. If nullptr,
+     * memory is not limited.
+     */
+    explicit UwbPeerRangingHistoryStore(std::size_t capacity = CapacityDefault, std::shared_ptr<UwbRangingHistoryBudget> budget = nullptr);
+
+    /**
+     * @brief Destroy the UwbPeerRangingHistoryStore object, returning its
+     * memory to the budget.
+     */
+    ~UwbPeerRangingHistoryStore();
+
+    UwbPeerRangingHistoryStore(const UwbPeerRangingHistoryStore&) = delete;
+
+    UwbPeerRangingHistoryStore&
+    operator=(const UwbPeerRangingHistoryStore&) = delete;
+
+    /**
+     * @brief Record a sample for each of a set of peers.
+     *
+     * @param peers The peers to record.
+     * @param timestamp The time the peers were measured.
+     */
+    void
+    Record(std::span<const UwbPeer> peers, Clock::time_point timestamp);
+
+    /**
+     * @brief Record a sample for each measurement in a ranging round,
+     * including its status.
+     *
+     * @param rangingData The ranging data to record.
+     * @param timestamp The time the ranging data was received.
+     */
+    void
+    Record(const ::uwb::protocol::fira::UwbRangingData& rangingData, Clock::time_point timestamp);
+
+    /**
+     * @brief Remove the histories of a set of peers.
+     *
+     * @param peers The peers to remove.
+     */
+    void
+    Remove(std::span<const UwbPeer> peers);
+
+    /**
+     * @brief Remove all histories.
+     */
+    void
+    Clear();
+
+    /**
+     * @brief Copy the most recent samples of a peer, oldest first.
+     *
+     * @param address The mac address of the peer.
+     * @param samples The destination. At most samples.size() samples are copied.
+     * @return std::size_t The number of samples copied; 0 if the peer is not tracked.
+     */
+    std::size_t
+    CopyLast(const UwbMacAddress& address, std::span<UwbPeerRangingSample> samples) const;
+
+    /**
+     * @brief Copy the most recent samples of a peer taken at or after a point
+     * in time, oldest first.
+     *
+     * @param address The mac address of the peer.
+     * @param since The earliest timestamp to include.
+     * @param samples The destination. If more samples match than fit, only
+     * the most recent are copied.
+     * @return std::size_t The number of samples copied; 0 if the peer is not tracked.
+     */
+    std::size_t
+    CopySince(const UwbMacAddress& address, Clock::time_point since, std::span<UwbPeerRangingSample> samples) const;
+
+    /**
+     * @brief Aggregate the samples of a peer taken at or after a point in time.
+     *
+     * @param address The mac address of the peer.
+     * @param since The earliest timestamp to include.
+     * @return std::optional<UwbPeerRangingAggregate> The aggregate, or
+     * std::nullopt if the peer is not tracked.
+     */
+    std::optional<UwbPeerRangingAggregate>
+    Aggregate(const UwbMacAddress& address, Clock::time_point since) const;
+
+    /**
+     * @brief Get the number of samples retained per peer.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetCapacity() const noexcept;
+
+    /**
+     * @brief Get the number of peers tracked.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetPeerCount() const;
+
+    /**
+     * @brief Get the number of bytes of memory acquired for the history of
+     * each peer.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetPeerMemoryUsage() const noexcept;
+
+private:
+    /**
+     * @brief Record a sample for a peer. The caller must hold m_historiesGate
+     * exclusively.
+     *
+     * @param address The mac address of the peer.
+     * @param sample The sample to record.
+     */
+    void
+    RecordLocked(const UwbMacAddress& address, const UwbPeerRangingSample& sample);
+
+private:
+    std::size_t m_capacity;
+    std::size_t m_peerMemoryUsage;
+    std::shared_ptr<UwbRangingHistoryBudget> m_budget;
+    mutable std::shared_mutex m_historiesGate;
+    std::unordered_map<UwbMacAddress, UwbPeerRangingHistory> m_histories{};
+};
+} // namespace uwb
+
+#endif // UWB_PEER_RANGING_HISTORY_STORE_HXX
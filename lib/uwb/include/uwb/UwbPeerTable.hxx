@@ -0,0 +1,159 @@
+
+#ifndef UWB_PEER_TABLE_HXX
+#define UWB_PEER_TABLE_HXX
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <notstd/seqlock.hxx>
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb
+{
+/**
+ * @brief Table of the latest known state of each peer in a session, keyed by
+ * mac address.
+ *
+ * The table is updated from ranging notifications by a single writer while
+ * any number of readers take snapshots. Readers never take a lock and never
+ * block the writer:
+ *
+ *  - Each entry is held in a notstd::seqlock, so updating a known peer is done
+ *    in place without allocating.
+ *  - The index from mac address to entry is immutable once published. Adding
+ *    or removing peers, which is rare compared to updating them, publishes a
+ *    new copy of the index.
+ */
+class UwbPeerTable
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The state of a peer as of a particular update.
+     */
+    struct Entry
+    {
+        UwbMacAddress Address;
+        UwbPeerSpatialProperties SpatialProperties;
+
+        /**
+         * @brief The time of the update that produced this state.
+         */
+        Clock::time_point Timestamp;
+
+        /**
+         * @brief The table sequence number of the update that produced this
+         * state. Comparing this with UwbPeerTable::GetSequenceNumber() gives
+         * the number of updates the peer has been absent from.
+         */
+        uint64_t SequenceNumber{ 0 };
+
+        /**
+         * @brief Convert the entry to a UwbPeer.
+         *
+         * @return UwbPeer
+         */
+        UwbPeer
+        ToPeer() const;
+    };
+
+    /**
+     * @brief Update the table from ranging data. Peers not yet in the table
+     * are added.
+     *
+     * @param rangingData The ranging data to update from.
+     * @return uint64_t The sequence number assigned to the update.
+     */
+    uint64_t
+    Update(const ::uwb::protocol::fira::UwbRangingData& rangingData);
+
+    /**
+     * @brief Update the table from a set of peers whose properties changed.
+     * Peers not yet in the table are added.
+     *
+     * @param peers The peers to update from.
+     * @return uint64_t The sequence number assigned to the update.
+     */
+    uint64_t
+    Update(std::span<const UwbPeer> peers);
+
+    /**
+     * @brief Remove peers from the table.
+     *
+     * @param peers The peers to remove.
+     */
+    void
+    Remove(std::span<const UwbPeer> peers);
+
+    /**
+     * @brief Remove all peers from the table.
+     */
+    void
+    Clear();
+
+    /**
+     * @brief Get a snapshot of all peers in the table.
+     *
+     * @return std::vector<Entry>
+     */
+    std::vector<Entry>
+    GetPeers() const;
+
+    /**
+     * @brief Get a snapshot of a single peer.
+     *
+     * @param address The mac address of the peer.
+     * @return std::optional<Entry> The peer entry, or std::nullopt if the
+     * peer is not in the table.
+     */
+    std::optional<Entry>
+    GetPeer(const UwbMacAddress& address) const;
+
+    /**
+     * @brief Get the number of peers in the table.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetPeerCount() const;
+
+    /**
+     * @brief Get the sequence number of the most recent update, or 0 if the
+     * table has never been updated.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetSequenceNumber() const noexcept;
+
+private:
+    using EntryState = notstd::seqlock<Entry>;
+    using Index = std::unordered_map<UwbMacAddress, std::shared_ptr<EntryState>>;
+
+    /**
+     * @brief Publish a new index. The caller must hold m_writerGate.
+     *
+     * @param index The index to publish.
+     */
+    void
+    PublishLocked(std::shared_ptr<const Index> index);
+
+private:
+    std::mutex m_writerGate;
+    std::atomic<std::shared_ptr<const Index>> m_index{ std::make_shared<const Index>() };
+    std::atomic<uint64_t> m_sequenceNumber{ 0 };
+};
+} // namespace uwb
+
+#endif // UWB_PEER_TABLE_HXX
@@ -0,0 +1,249 @@
+
+#ifndef UWB_RANGING_DATA_BATCH_HXX
+#define UWB_RANGING_DATA_BATCH_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/uci/StatusCodes.hxx>
+
+namespace uwb
+{
+/**
+ * @brief Ranging measurements of many rounds, possibly from many sessions,
+ * stored as parallel arrays (struct-of-arrays).
+ *
+ * Each measurement field is held in its own contiguous array, indexed by
+ * measurement, so post-processing filters can run as tight loops over a
+ * single field without chasing pointers or testing optionals. Fields are kept
+ * in their wire representation: angles of arrival are Q9.7 fixed-point
+ * values. Fields without a value are stored as 0, and whether each field holds
+ * a value is recorded in a per-measurement presence column (see Presence).
+ * Peers are referenced by index into a de-duplicated address table.
+ *
+ * Measurements are grouped into rounds; the measurements of round i are those
+ * in the index range [GetRoundOffsets()[i], GetRoundOffsets()[i + 1]).
+ */
+class UwbRangingDataBatch
+{
+public:
+    using StatusCode = uwb::protocol::fira::uci::StatusCode;
+
+    /**
+     * @brief Bits of the per-measurement presence column, each set when the
+     * corresponding field holds a value.
+     */
+    struct Presence
+    {
+        static constexpr uint16_t Distance = 1U << 0U;
+        static constexpr uint16_t AoAAzimuth = 1U << 1U;
+        static constexpr uint16_t AoAElevation = 1U << 2U;
+        static constexpr uint16_t AoADestinationAzimuth = 1U << 3U;
+        static constexpr uint16_t AoADestinationElevation = 1U << 4U;
+        static constexpr uint16_t AoAAzimuthFom = 1U << 5U;
+        static constexpr uint16_t AoAElevationFom = 1U << 6U;
+        static constexpr uint16_t AoADestinationAzimuthFom = 1U << 7U;
+        static constexpr uint16_t AoADestinationElevationFom = 1U << 8U;
+    };
+
+    /**
+     * @brief Construct a new, empty UwbRangingDataBatch object.
+     */
+    UwbRangingDataBatch();
+
+    /**
+     * @brief Reserve storage.
+     *
+     * @param numRounds The number of rounds to reserve storage for.
+     * @param numMeasurements The total number of measurements to reserve
+     * storage for.
+     */
+    void
+    Reserve(std::size_t numRounds, std::size_t numMeasurements);
+
+    /**
+     * @brief Remove all rounds and peers, retaining the allocated storage.
+     */
+    void
+    Clear() noexcept;
+
+    /**
+     * @brief Append the measurements of a ranging round.
+     *
+     * @param rangingData The ranging data of the round.
+     */
+    void
+    Append(const uwb::protocol::fira::UwbRangingData& rangingData);
+
+    /**
+     * @brief Append a two-way ranging round made of the current state of the
+     * specified peers. Missing spatial properties are stored as absent. Each
+     * measurement has status Ok and an indeterminate line of sight.
+     *
+     * @param peers The peers to append.
+     * @param sessionId The session identifier to record for the round.
+     * @param sequenceNumber The sequence number to record for the round.
+     */
+    void
+    Append(const std::vector<UwbPeer>& peers, uint32_t sessionId = 0, uint32_t sequenceNumber = 0);
+
+    /**
+     * @brief Get the number of rounds.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumRounds() const noexcept;
+
+    /**
+     * @brief Get the total number of measurements of all rounds.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumMeasurements() const noexcept;
+
+    /**
+     * @brief Convert a round back to ranging data.
+     *
+     * @param roundIndex The index of the round. Throws std::out_of_range if
+     * there is no such round.
+     * @param rangingData The ranging data to write to. Its measurement list
+     * storage is reused.
+     */
+    void
+    GetRangingData(std::size_t roundIndex, uwb::protocol::fira::UwbRangingData& rangingData) const;
+
+    /**
+     * @brief Convert a round back to ranging data.
+     *
+     * @param roundIndex The index of the round. Throws std::out_of_range if
+     * there is no such round.
+     * @return uwb::protocol::fira::UwbRangingData
+     */
+    uwb::protocol::fira::UwbRangingData
+    GetRangingData(std::size_t roundIndex) const;
+
+    /**
+     * @brief Convert the measurements of a round to peers, as done by the
+     * UwbPeer constructor taking a ranging measurement.
+     *
+     * @param roundIndex The index of the round. Throws std::out_of_range if
+     * there is no such round.
+     * @return std::vector<UwbPeer>
+     */
+    std::vector<UwbPeer>
+    GetPeers(std::size_t roundIndex) const;
+
+    /**
+     * @brief Per-round columns.
+     */
+    std::span<const uint32_t>
+    GetSessionIds() const noexcept;
+    std::span<const uint32_t>
+    GetSequenceNumbers() const noexcept;
+    std::span<const uint32_t>
+    GetCurrentRangingIntervals() const noexcept;
+    std::span<const uwb::protocol::fira::UwbRangingMeasurementType>
+    GetRangingMeasurementTypes() const noexcept;
+    std::span<const std::size_t>
+    GetRoundOffsets() const noexcept;
+
+    /**
+     * @brief Per-measurement columns.
+     */
+    std::span<const uint16_t>
+    GetDistances() const noexcept;
+    std::span<const uint16_t>
+    GetAoAAzimuths() const noexcept;
+    std::span<const uint16_t>
+    GetAoAElevations() const noexcept;
+    std::span<const uint16_t>
+    GetAoADestinationAzimuths() const noexcept;
+    std::span<const uint16_t>
+    GetAoADestinationElevations() const noexcept;
+    std::span<const uint8_t>
+    GetAoAAzimuthFoms() const noexcept;
+    std::span<const uint8_t>
+    GetAoAElevationFoms() const noexcept;
+    std::span<const uint8_t>
+    GetAoADestinationAzimuthFoms() const noexcept;
+    std::span<const uint8_t>
+    GetAoADestinationElevationFoms() const noexcept;
+    std::span<const StatusCode>
+    GetStatusCodes() const noexcept;
+    std::span<const uwb::protocol::fira::UwbLineOfSightIndicator>
+    GetLineOfSightIndicators() const noexcept;
+    std::span<const uint8_t>
+    GetSlotIndices() const noexcept;
+    std::span<const uint32_t>
+    GetPeerIndices() const noexcept;
+    std::span<const uint16_t>
+    GetPresence() const noexcept;
+
+    /**
+     * @brief Get the table of peer addresses referenced by GetPeerIndices().
+     *
+     * @return std::span<const UwbMacAddress>
+     */
+    std::span<const UwbMacAddress>
+    GetPeerAddresses() const noexcept;
+
+private:
+    /**
+     * @brief Get the index of the specified peer in the address table, adding
+     * it if not yet present.
+     *
+     * @param address The address of the peer.
+     * @return uint32_t
+     */
+    uint32_t
+    GetOrAddPeerIndex(const UwbMacAddress& address);
+
+    /**
+     * @brief Start a new round, whose measurements are appended next.
+     */
+    void
+    BeginRound(uint32_t sessionId, uint32_t sequenceNumber, uint32_t currentRangingInterval, uwb::protocol::fira::UwbRangingMeasurementType rangingMeasurementType);
+
+    /**
+     * @brief Validate a round index, throwing std::out_of_range if invalid.
+     */
+    void
+    ValidateRoundIndex(std::size_t roundIndex) const;
+
+private:
+    std::vector<uint32_t> m_sessionIds;
+    std::vector<uint32_t> m_sequenceNumbers;
+    std::vector<uint32_t> m_currentRangingIntervals;
+    std::vector<uwb::protocol::fira::UwbRangingMeasurementType> m_rangingMeasurementTypes;
+    std::vector<std::size_t> m_roundOffsets;
+
+    std::vector<uint16_t> m_distances;
+    std::vector<uint16_t> m_aoaAzimuths;
+    std::vector<uint16_t> m_aoaElevations;
+    std::vector<uint16_t> m_aoaDestinationAzimuths;
+    std::vector<uint16_t> m_aoaDestinationElevations;
+    std::vector<uint8_t> m_aoaAzimuthFoms;
+    std::vector<uint8_t> m_aoaElevationFoms;
+    std::vector<uint8_t> m_aoaDestinationAzimuthFoms;
+    std::vector<uint8_t> m_aoaDestinationElevationFoms;
+    std::vector<StatusCode> m_statusCodes;
+    std::vector<uwb::protocol::fira::UwbLineOfSightIndicator> m_lineOfSightIndicators;
+    std::vector<uint8_t> m_slotIndices;
+    std::vector<uint32_t> m_peerIndices;
+    std::vector<uint16_t> m_presence;
+
+    std::vector<UwbMacAddress> m_peerAddresses;
+    std::unordered_map<UwbMacAddress, uint32_t> m_peerAddressIndices;
+};
+
+} // namespace uwb
+
+#endif // UWB_RANGING_DATA_BATCH_HXX
@@ -0,0 +1,82 @@
+
+#ifndef UWB_RANGING_HISTORY_BUDGET_HXX
+#define UWB_RANGING_HISTORY_BUDGET_HXX
+
+#include <atomic>
+#include <cstddef>
+
+namespace uwb
+{
+/**
+ * @brief Limits the memory used by the ranging histories of all sessions
+ * sharing an instance.
+ *
+ * Each UwbDevice owns an instance that its sessions draw from; the limit may
+ * be changed at any time and applies to subsequent acquisitions. All member
+ * functions are thread-safe.
+ */
+class UwbRangingHistoryBudget
+{
+public:
+    /**
+     * @brief The default limit, in bytes.
+     */
+    static constexpr std::size_t LimitDefault = 1U << 20U;
+
+    /**
+     * @brief Construct a new UwbRangingHistoryBudget object.
+     *
+     * @param limit The maximum number of bytes that may be acquired.
+     */
+    explicit UwbRangingHistoryBudget(std::size_t limit = LimitDefault) noexcept;
+
+    /**
+     * @brief Acquire memory from the budget.
+     *
+     * @param size The number of bytes to acquire.
+     * @return true If the memory was acquired.
+     * @return false If acquiring the memory would exceed the limit.
+     */
+    bool
+    TryAcquire(std::size_t size) noexcept;
+
+    /**
+     * @brief Return memory previously acquired with TryAcquire().
+     *
+     * @param size The number of bytes to return.
+     */
+    void
+    Release(std::size_t size) noexcept;
+
+    /**
+     * @brief Get the maximum number of bytes that may be acquired.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetLimit() const noexcept;
+
+    /**
+     * @brief Set the maximum number of bytes that may be acquired. Lowering
+     * the limit below the current usage does not reclaim memory.
+     *
+     * @param limit The new limit.
+     */
+    void
+    SetLimit(std::size_t limit) noexcept;
+
+    /**
+     * @brief Get the number of bytes currently acquired.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetUsage() const noexcept;
+
+private:
+    std::atomic<std::size_t> m_limit;
+    std::atomic<std::size_t> m_usage{ 0 };
+};
+} // namespace uwb
+
+#endif // UWB_RANGING_HISTORY_BUDGET_HXX
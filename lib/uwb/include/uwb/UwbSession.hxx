@@ -6,13 +6,17 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <type_traits>
 #include <unordered_set>
 
 #include <uwb/UwbMacAddress.hxx>
 #include <uwb/UwbPeer.hxx>
+#include <uwb/UwbPeerRangingHistoryStore.hxx>
+#include <uwb/UwbPeerTable.hxx>
 #include <uwb/UwbSessionEventCallbacks.hxx>
+#include <uwb/protocols/fira/ApplicationConfigurationTracker.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
 #include <uwb/protocols/fira/UwbSessionData.hxx>
 
@@ -49,9 +53,10 @@ public:
     UwbSession(uint32_t sessionId, std::weak_ptr<UwbDevice> device, std::weak_ptr<UwbSessionEventCallbacks> callbacks, uwb::protocol::fira::DeviceType deviceType = DeviceTypeDefault);
 
     /**
-     * @brief Destroy the UwbSession object.
+     * @brief Destroy the UwbSession object, releasing its MAC address back to
+     * the parent device.
      */
-    virtual ~UwbSession() = default;
+    virtual ~UwbSession();
 
     /**
      * @brief Get a weak reference to the event callbacks instance.
@@ -145,11 +150,71 @@ public:
     /**
      * @brief Set the application configuration parameters for this session.
      *
+     * Only parameters whose values differ from those last applied are sent to
+     * the UWBS. If the session is ranging and any of those parameters cannot
+     * be changed while active, ranging is stopped, the parameters are applied,
+     * then ranging is started again. No lock is held while the UWBS is
+     * updated, so notifications may be delivered on the calling thread.
+     *
      * @param uwbApplicationConfigurationParameters
      */
     void
     SetApplicationConfigurationParameters(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters);
 
+    /**
+     * @brief Get the cumulative savings of sending only changed application
+     * configuration parameters to the UWBS.
+     *
+     * @return ::uwb::protocol::fira::ApplicationConfigurationMetrics
+     */
+    ::uwb::protocol::fira::ApplicationConfigurationMetrics
+    GetApplicationConfigurationMetrics();
+
+    /**
+     * @brief Forget the application configuration last applied to the UWBS,
+     * so that the next update sends all parameters.
+     *
+     * This must be called whenever the UWBS may have discarded the session
+     * configuration, such as when the device is reset. It is called
+     * automatically when the session is destroyed, deinitialized, or ended.
+     */
+    void
+    ResetApplicationConfiguration() noexcept;
+
+    /**
+     * @brief Get a snapshot of the latest known state of each peer in the
+     * session.
+     *
+     * This neither blocks nor is blocked by the processing of ranging
+     * notifications.
+     *
+     * @return std::vector<UwbPeerTable::Entry>
+     */
+    std::vector<UwbPeerTable::Entry>
+    GetPeers() const;
+
+    /**
+     * @brief Get a snapshot of the latest known state of a single peer in the
+     * session.
+     *
+     * @param address The mac address of the peer.
+     * @return std::optional<UwbPeerTable::Entry> The peer state, or
+     * std::nullopt if nothing is known about the peer.
+     */
+    std::optional<UwbPeerTable::Entry>
+    GetPeer(const UwbMacAddress& address) const;
+
+    /**
+     * @brief Get the ranging history of the peers in the session.
+     *
+     * The history retains the most recent UwbPeerRangingHistoryStore::CapacityDefault
+     * rounds of each peer, within the ranging history budget of the device.
+     *
+     * @return const UwbPeerRangingHistoryStore&
+     */
+    const UwbPeerRangingHistoryStore&
+    GetRangingHistory() const noexcept;
+
     /**
      * @brief Get the current state for this session.
      *
@@ -207,18 +272,20 @@ protected:
     }
 
     /**
-     * @brief Invoked when the session ends.
+     * @brief Invoked when the session ends. The ranging histories of all
+     * peers are cleared.
      * 
-     * @param callbacks A resolved session event callback instance.
+     * @param callbacks A resolved session event callback instance, or nullptr.
      * @param reason The reason the session ended.
      */
     virtual void
     OnSessionEnded(std::shared_ptr<uwb::UwbSessionEventCallbacks> callbacks, ::uwb::UwbSessionEndReason reason);
 
     /**
-     * @brief Invoked when the session state changes. 
+     * @brief Invoked when the session state changes. The ranging histories of
+     * all peers are cleared when the session is deinitialized.
      * 
-     * @param callbacks A resolved session event callback instance.
+     * @param callbacks A resolved session event callback instance, or nullptr.
      * @param state The new state of the session.
      * @param reasonCode The reason the session changed state. Optional.
      */
@@ -228,8 +295,11 @@ protected:
     /**
      * @brief Invoked when the properties of a peer involved in the session
      * changes. This includes the spatial properties of the peer(s).
+     *
+     * The peer table and ranging history are updated whether or not
+     * callbacks are available.
      * 
-     * @param callbacks A resolved session event callback instance.
+     * @param callbacks A resolved session event callback instance, or nullptr.
      * @param peersChanged A list of peers whose properties changed.
      */
     virtual void
@@ -238,9 +308,11 @@ protected:
     /**
      * @brief Invoked when membership of one or more near peers involved in
      * the session is changed. This can occur when peer members are either
-     * added to or removed from the session.
+     * added to or removed from the session. Peers removed from the session
+     * are removed from the peer table and ranging history whether or not
+     * callbacks are available.
      * 
-     * @param callbacks A resolved session event callback instance.
+     * @param callbacks A resolved session event callback instance, or nullptr.
      * @param peersAdded A list of peers that were added to the session.
      * @param peersRemoved A list of peers that were removed from the session.
      */
@@ -332,12 +404,18 @@ protected:
     std::atomic<uwb::protocol::fira::UwbSessionState> m_state{ uwb::protocol::fira::UwbSessionState::Deinitialized };
     UwbMacAddressType m_uwbMacAddressType{ UwbMacAddressType::Extended };
     UwbMacAddress m_uwbMacAddressSelf;
+    bool m_uwbMacAddressSelfAllocated{ false };
     std::atomic<bool> m_rangingActive{ false };
     std::mutex m_peerGate;
     std::unordered_set<UwbMacAddress> m_peers{};
+    UwbPeerTable m_peerTable{};
     std::shared_mutex m_callbacksGate;
     std::weak_ptr<UwbSessionEventCallbacks> m_callbacks;
     std::weak_ptr<UwbDevice> m_device;
+    UwbPeerRangingHistoryStore m_rangingHistory;
+    std::mutex m_applicationConfigurationGate;
+    ::uwb::protocol::fira::ApplicationConfigurationTracker m_applicationConfigurationTracker{};
+    uint64_t m_applicationConfigurationResetCount{ 0 };
 };
 
 } // namespace uwb
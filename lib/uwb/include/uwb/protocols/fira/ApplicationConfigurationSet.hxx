@@ -0,0 +1,293 @@
+
+#ifndef FIRA_APPLICATION_CONFIGURATION_SET_HXX
+#define FIRA_APPLICATION_CONFIGURATION_SET_HXX
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb::protocol::fira
+{
+namespace detail
+{
+/**
+ * @brief Get the index of the specified alternative in a variant type.
+ *
+ * @tparam T The alternative to find.
+ * @tparam VariantT The variant type.
+ */
+template <typename T, typename VariantT>
+struct VariantAlternativeIndex;
+
+template <typename T, typename... Ts>
+struct VariantAlternativeIndex<T, std::variant<Ts...>>
+{
+    static constexpr std::size_t value = []() {
+        constexpr std::array<bool, sizeof...(Ts)> matches{ std::is_same_v<T, Ts>... };
+        for (std::size_t i = 0; i < std::size(matches); i++) {
+            if (matches[i]) {
+                return i;
+            }
+        }
+        return std::variant_npos;
+    }();
+};
+
+template <typename T>
+constexpr std::size_t UwbApplicationConfigurationParameterValueIndexV = VariantAlternativeIndex<T, UwbApplicationConfigurationParameterValue>::value;
+} // namespace detail
+
+/**
+ * @brief A set of application configuration parameters, with at most one
+ * value per parameter type, stored in fixed slots indexed by type.
+ *
+ * Unlike a std::vector<UwbApplicationConfigurationParameter>, whose values may
+ * each own heap-allocated sets, all values are stored inline: scalar values in
+ * a per-type slot, result report configurations as a bitmask, the static STS
+ * initialization vector and device MAC address in dedicated members, and
+ * destination MAC addresses in a fixed-capacity array sized for the largest
+ * multicast session. Presence is tracked with a bitmask. Lookup and update are
+ * O(1), and copying the set never allocates.
+ *
+ * Each slot remembers which value alternative it was set with, so converting
+ * back to parameters reproduces the original values exactly.
+ */
+class ApplicationConfigurationSet
+{
+public:
+    /**
+     * @brief The number of parameter type slots. All parameter type values
+     * must be less than this.
+     */
+    static constexpr std::size_t NumParameterTypeSlots = 64;
+
+    /**
+     * @brief The maximum number of destination MAC addresses that can be held.
+     */
+    static constexpr std::size_t DestinationMacAddressesMaximum = MaximumNumberOfControleesInMulticastSession;
+
+    /**
+     * @brief Construct a new, empty ApplicationConfigurationSet object.
+     */
+    ApplicationConfigurationSet() = default;
+
+    /**
+     * @brief Construct a new ApplicationConfigurationSet object holding the
+     * specified parameters. Later parameters replace earlier parameters of the
+     * same type.
+     *
+     * @param parameters The parameters to add.
+     */
+    explicit ApplicationConfigurationSet(std::span<const UwbApplicationConfigurationParameter> parameters);
+
+    /**
+     * @brief Set the value of a parameter, replacing any existing value for its
+     * type.
+     *
+     * Throws std::invalid_argument if the value cannot be held for the
+     * parameter type, and std::length_error if there are more destination MAC
+     * addresses than DestinationMacAddressesMaximum.
+     *
+     * @param parameter The parameter to set.
+     */
+    void
+    Set(const UwbApplicationConfigurationParameter& parameter);
+
+    /**
+     * @brief Set the value of a parameter, replacing any existing value for its
+     * type.
+     *
+     * @param type The type of the parameter.
+     * @param value The value of the parameter.
+     */
+    void
+    Set(UwbApplicationConfigurationParameterType type, const UwbApplicationConfigurationParameterValue& value);
+
+    /**
+     * @brief Remove the value of a parameter, if present.
+     *
+     * @param type The type of the parameter to remove.
+     */
+    void
+    Erase(UwbApplicationConfigurationParameterType type) noexcept;
+
+    /**
+     * @brief Remove all parameters.
+     */
+    void
+    Clear() noexcept;
+
+    /**
+     * @brief Determine whether a value is present for the specified parameter
+     * type.
+     *
+     * @param type The type of the parameter.
+     * @return true If a value is present.
+     * @return false Otherwise.
+     */
+    bool
+    Contains(UwbApplicationConfigurationParameterType type) const noexcept;
+
+    /**
+     * @brief Determine whether a parameter has the same value in this and
+     * another set, comparing the stored representation without constructing
+     * values.
+     *
+     * @param other The set to compare with.
+     * @param type The type of the parameter.
+     * @return true If the parameter is absent from both sets, or present in
+     * both with the same value.
+     * @return false Otherwise.
+     */
+    bool
+    IsValueEqual(const ApplicationConfigurationSet& other, UwbApplicationConfigurationParameterType type) const noexcept;
+
+    /**
+     * @brief Get the number of parameters present.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    Size() const noexcept;
+
+    /**
+     * @brief Determine whether there are no parameters present.
+     *
+     * @return true If the set is empty.
+     * @return false Otherwise.
+     */
+    bool
+    Empty() const noexcept;
+
+    /**
+     * @brief Get the bitmask of parameter types present, indexed by parameter
+     * type value.
+     *
+     * @return const std::bitset<NumParameterTypeSlots>&
+     */
+    const std::bitset<NumParameterTypeSlots>&
+    GetPresence() const noexcept;
+
+    /**
+     * @brief Get the value of a parameter as the specified alternative, without
+     * constructing a variant.
+     *
+     * Valid for every alternative except the std::unordered_set ones; see
+     * GetResultReportConfigurationMask() and GetDestinationMacAddresses() for
+     * those.
+     *
+     * @tparam ValueT The value alternative.
+     * @param type The type of the parameter.
+     * @return std::optional<ValueT> The value, or std::nullopt if the
+     * parameter is not present or was set with a different alternative.
+     */
+    template <typename ValueT>
+    std::optional<ValueT>
+    Get(UwbApplicationConfigurationParameterType type) const noexcept
+    {
+        constexpr auto valueIndex = detail::UwbApplicationConfigurationParameterValueIndexV<ValueT>;
+        static_assert(valueIndex != std::variant_npos, "type is not an application configuration parameter value alternative");
+        static_assert(valueIndex != IndexResultReportConfigurations && valueIndex != IndexMacAddresses, "set alternatives must be obtained with their dedicated accessors");
+
+        if (!Contains(type) || m_valueIndices[ToSlot(type)] != valueIndex) {
+            return std::nullopt;
+        }
+
+        const auto slot = ToSlot(type);
+        if constexpr (valueIndex == IndexMacAddress) {
+            return (type == UwbApplicationConfigurationParameterType::DestinationMacAddresses) ? m_destinationMacAddresses[0] : m_deviceMacAddress;
+        } else if constexpr (valueIndex == IndexStaticStsInitializationVector) {
+            return m_staticStsInitializationVector;
+        } else {
+            return static_cast<ValueT>(m_scalars[slot]);
+        }
+    }
+
+    /**
+     * @brief Get the value of a parameter.
+     *
+     * @param type The type of the parameter.
+     * @return std::optional<UwbApplicationConfigurationParameterValue> The
+     * value, or std::nullopt if the parameter is not present.
+     */
+    std::optional<UwbApplicationConfigurationParameterValue>
+    GetValue(UwbApplicationConfigurationParameterType type) const;
+
+    /**
+     * @brief Get the result report configurations as a bitmask of
+     * ResultReportConfiguration values.
+     *
+     * @return std::optional<uint8_t> The bitmask, or std::nullopt if the
+     * parameter is not present.
+     */
+    std::optional<uint8_t>
+    GetResultReportConfigurationMask() const noexcept;
+
+    /**
+     * @brief Get the destination MAC addresses, in ascending order.
+     *
+     * @return std::span<const UwbMacAddress> The addresses, which is empty if
+     * the parameter is not present.
+     */
+    std::span<const UwbMacAddress>
+    GetDestinationMacAddresses() const noexcept;
+
+    /**
+     * @brief Convert the set to a list of parameters, in ascending parameter
+     * type order.
+     *
+     * @return std::vector<UwbApplicationConfigurationParameter>
+     */
+    std::vector<UwbApplicationConfigurationParameter>
+    ToParameters() const;
+
+    bool
+    operator==(const ApplicationConfigurationSet&) const noexcept = default;
+
+private:
+    static constexpr std::size_t IndexResultReportConfigurations = detail::UwbApplicationConfigurationParameterValueIndexV<std::unordered_set<ResultReportConfiguration>>;
+    static constexpr std::size_t IndexMacAddress = detail::UwbApplicationConfigurationParameterValueIndexV<::uwb::UwbMacAddress>;
+    static constexpr std::size_t IndexMacAddresses = detail::UwbApplicationConfigurationParameterValueIndexV<std::unordered_set<::uwb::UwbMacAddress>>;
+    static constexpr std::size_t IndexStaticStsInitializationVector = detail::UwbApplicationConfigurationParameterValueIndexV<StaticStsInitializationVector>;
+
+    /**
+     * @brief Get the slot of the specified parameter type.
+     *
+     * @param type The type of the parameter.
+     * @return std::size_t
+     */
+    static constexpr std::size_t
+    ToSlot(UwbApplicationConfigurationParameterType type) noexcept
+    {
+        return static_cast<std::size_t>(type);
+    }
+
+    /**
+     * @brief Reset the destination MAC addresses to their default state.
+     */
+    void
+    ResetDestinationMacAddresses() noexcept;
+
+private:
+    std::bitset<NumParameterTypeSlots> m_presence{};
+    std::array<uint8_t, NumParameterTypeSlots> m_valueIndices{};
+    std::array<uint32_t, NumParameterTypeSlots> m_scalars{};
+    StaticStsInitializationVector m_staticStsInitializationVector{};
+    ::uwb::UwbMacAddress m_deviceMacAddress{};
+    uint8_t m_numDestinationMacAddresses{ 0 };
+    std::array<::uwb::UwbMacAddress, DestinationMacAddressesMaximum> m_destinationMacAddresses{};
+};
+
+} // namespace uwb::protocol::fira
+
+#endif // FIRA_APPLICATION_CONFIGURATION_SET_HXX
@@ -0,0 +1,141 @@
+
+#ifndef FIRA_APPLICATION_CONFIGURATION_TRACKER_HXX
+#define FIRA_APPLICATION_CONFIGURATION_TRACKER_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <uwb/protocols/fira/ApplicationConfigurationSet.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb::protocol::fira
+{
+/**
+ * @brief The commands needed to bring a session from its last-applied
+ * application configuration to a desired one.
+ */
+struct ApplicationConfigurationUpdatePlan
+{
+    /**
+     * @brief The parameters whose values differ from those last applied; the
+     * payload of the SESSION_SET_APP_CONFIG command.
+     */
+    std::vector<UwbApplicationConfigurationParameter> Parameters;
+
+    /**
+     * @brief Whether the session is active and at least one of the parameters
+     * cannot be changed while active, requiring the session to be stopped,
+     * reconfigured, then started again.
+     */
+    bool RequiresRestart{ false };
+
+    /**
+     * @brief The number of commands and their encoded size in octets, for this
+     * plan and for sending all desired parameters instead.
+     */
+    std::size_t NumCommands{ 0 };
+    std::size_t NumBytes{ 0 };
+    std::size_t NumCommandsFull{ 0 };
+    std::size_t NumBytesFull{ 0 };
+
+    /**
+     * @brief Determine whether the plan has no parameters to send.
+     *
+     * @return true If the desired configuration is already applied.
+     * @return false Otherwise.
+     */
+    bool
+    IsEmpty() const noexcept;
+};
+
+/**
+ * @brief Cumulative savings of sending configuration deltas instead of full
+ * parameter lists.
+ */
+struct ApplicationConfigurationMetrics
+{
+    uint64_t NumCommandsSent{ 0 };
+    uint64_t NumCommandsSaved{ 0 };
+    uint64_t NumBytesSent{ 0 };
+    uint64_t NumBytesSaved{ 0 };
+
+    bool
+    operator==(const ApplicationConfigurationMetrics&) const noexcept = default;
+};
+
+/**
+ * @brief Tracks the application configuration last applied to a session and
+ * plans the minimal commands to apply a new configuration.
+ *
+ * Parameters absent from a desired configuration are left unchanged, since
+ * the UWBS retains the values it was last given.
+ */
+class ApplicationConfigurationTracker
+{
+public:
+    /**
+     * @brief The encoded size of a SESSION_START or SESSION_STOP command.
+     */
+    static constexpr std::size_t SessionControlCommandSize = 8;
+
+    /**
+     * @brief Plan the commands to apply the desired configuration.
+     *
+     * @param desired The desired configuration.
+     * @param isSessionActive Whether the session is currently ranging.
+     * @return ApplicationConfigurationUpdatePlan
+     */
+    ApplicationConfigurationUpdatePlan
+    Plan(const ApplicationConfigurationSet& desired, bool isSessionActive) const;
+
+    /**
+     * @brief Record that a plan was successfully applied, updating the
+     * last-applied configuration and the metrics.
+     *
+     * @param plan The plan that was applied.
+     */
+    void
+    Commit(const ApplicationConfigurationUpdatePlan& plan);
+
+    /**
+     * @brief Forget the last-applied configuration, for example when the
+     * session is initialized again. Metrics are retained.
+     */
+    void
+    Reset() noexcept;
+
+    /**
+     * @brief Get the last-applied configuration.
+     *
+     * @return const ApplicationConfigurationSet&
+     */
+    const ApplicationConfigurationSet&
+    GetApplied() const noexcept;
+
+    /**
+     * @brief Get the cumulative metrics of all committed plans.
+     *
+     * @return const ApplicationConfigurationMetrics&
+     */
+    const ApplicationConfigurationMetrics&
+    GetMetrics() const noexcept;
+
+    /**
+     * @brief Get the encoded size of a SESSION_SET_APP_CONFIG command carrying
+     * the specified parameters, including packet headers.
+     *
+     * @param parameters The parameters of the command.
+     * @return std::size_t
+     */
+    static std::size_t
+    GetSetApplicationConfigurationCommandSize(const std::vector<UwbApplicationConfigurationParameter>& parameters);
+
+private:
+    ApplicationConfigurationSet m_applied{};
+    ApplicationConfigurationMetrics m_metrics{};
+};
+
+} // namespace uwb::protocol::fira
+
+#endif // FIRA_APPLICATION_CONFIGURATION_TRACKER_HXX
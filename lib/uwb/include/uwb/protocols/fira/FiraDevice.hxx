@@ -48,13 +48,58 @@ StringToVersion(const std::string& input) noexcept;
  * Assuming the Arm definition of Qm.n formatting, the most significant bit is the sign, the next
  * (m-1) bits are an integer, and the next n bits is the number to be multiplied by pow(2,n)
  * The double equivalent will be the sum of those two results
- * TODO write unit tests
  *
  * @param q97 a number in Q9.7 format
  * @return double
  */
-double
-ConvertQ97FormatToIEEE(uint16_t q97);
+constexpr double
+ConvertQ97FormatToIEEE(uint16_t q97) noexcept
+{
+    constexpr double scale = 128.0;
+    constexpr uint16_t signMask = 0b1000'0000'0000'0000U;
+    constexpr uint16_t unsignedIntegerMask = 0b0111'1111'1000'0000U;
+    constexpr uint16_t fractionMask = static_cast<uint16_t>(~(signMask | unsignedIntegerMask));
+    constexpr uint16_t integerMask = 0x00FFU;
+    constexpr uint16_t fractionBits = 7U;
+
+    const bool sign = (q97 & signMask) != 0;
+    uint16_t unsignedIntegerPart = (q97 & unsignedIntegerMask) >> fractionBits;
+    if (sign) {
+        unsignedIntegerPart = (~unsignedIntegerPart + 1U) & integerMask;
+    }
+
+    // Both parts are exactly representable, so scaling once is exact.
+    const double unsignedNumber = static_cast<double>((unsignedIntegerPart << fractionBits) | (q97 & fractionMask)) / scale;
+    return sign ? -unsignedNumber : unsignedNumber;
+}
+
+/**
+ * @brief Converts a sequence of Q9.7-formatted values to IEEE 754 floating
+ * point values, producing the same results as the scalar
+ * ConvertQ97FormatToIEEE().
+ *
+ * The conversion uses the widest vector instructions supported by the
+ * processor (AVX2 or SSE2 on x86-64), selected once at runtime, and falls back
+ * to scalar code on other architectures.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The output values. Must hold at least as many elements as q97,
+ * otherwise std::invalid_argument is thrown.
+ */
+void
+ConvertQ97FormatToIEEE(std::span<const uint16_t> q97, std::span<double> values);
+
+/**
+ * @brief Converts a sequence of Q9.7-formatted values to IEEE 754 single
+ * precision floating point values. Every Q9.7 value is exactly representable
+ * in single precision.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The output values. Must hold at least as many elements as q97,
+ * otherwise std::invalid_argument is thrown.
+ */
+void
+ConvertQ97FormatToIEEE(std::span<const uint16_t> q97, std::span<float> values);
 
 /**
  * @brief See FiRa Consortium MAC Technical Requirements v1.3.0,
@@ -416,7 +461,7 @@ enum class UwbSessionReasonCode {
     ErrorInvalidStsConfiguration,
     ErrorInvalidRFrameConfiguration,
 };
-enum class UwbLineOfSightIndicator {
+enum class UwbLineOfSightIndicator : uint8_t {
     LineOfSight,
     NonLineOfSight,
     Indeterminant,
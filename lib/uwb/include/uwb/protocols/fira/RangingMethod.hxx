@@ -7,6 +7,7 @@
 #include <notstd/hash.hxx>
 #include <notstd/utility.hxx>
 
+#include <tlv/TlvSerialize.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
 
 namespace uwb::protocol::fira
@@ -50,4 +51,21 @@ struct hash<::uwb::protocol::fira::RangingMethod>
 };
 } // namespace std
 
+namespace encoding
+{
+/**
+ * @brief Allows RangingMethod to be used as the value of a BitIndexMap.
+ */
+template <>
+struct BitIndexKey<::uwb::protocol::fira::RangingMethod>
+{
+    static constexpr std::size_t
+    Get(const ::uwb::protocol::fira::RangingMethod& rangingMethod) noexcept
+    {
+        constexpr std::size_t NumMeasurementReportModes = 3;
+        return (static_cast<std::size_t>(notstd::to_underlying(rangingMethod.Method)) * NumMeasurementReportModes) + static_cast<std::size_t>(notstd::to_underlying(rangingMethod.ReportMode));
+    }
+};
+} // namespace encoding
+
 #endif // FIRA_RANGING_CONFIGURATION_HXX
\ No newline at end of file
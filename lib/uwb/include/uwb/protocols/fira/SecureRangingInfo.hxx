@@ -9,6 +9,7 @@
 #include <notstd/hash.hxx>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 namespace uwb::protocol::fira
 {
@@ -49,6 +50,15 @@ struct SecureRangingInfo
     static SecureRangingInfo
     FromDataObject(const encoding::TlvBer& tlv);
 
+    /**
+     * @brief Attempt to create a SecureRangingInfo object from a TlvBerView.
+     *
+     * @param tlv
+     * @return SecureRangingInfo
+     */
+    static SecureRangingInfo
+    FromDataObject(const encoding::TlvBerView& tlv);
+
     std::vector<uint8_t> UwbSessionKeyInfo;
     std::vector<uint8_t> ResponderSpecificSubSessionKeyInfo;
     std::vector<uint8_t> SusAdditionalParameters;
@@ -9,6 +9,7 @@
 
 #include <notstd/hash.hxx>
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 namespace uwb::protocol::fira
 {
@@ -60,6 +61,15 @@ struct StaticRangingInfo
     static StaticRangingInfo
     FromDataObject(const encoding::TlvBer& tlv);
 
+    /**
+     * @brief Attempt to create a StaticRangingInfo object from a TlvBerView.
+     *
+     * @param tlv
+     * @return StaticRangingInfo
+     */
+    static StaticRangingInfo
+    FromDataObject(const encoding::TlvBerView& tlv);
+
     uint16_t VendorId;
     std::array<uint8_t, InitializationVectorLength> InitializationVector;
 };
@@ -6,15 +6,17 @@
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <optional>
 #include <string>
-#include <unordered_map>
-#include <vector>
 
 #include <notstd/hash.hxx>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <tlv/TlvSerialize.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
 #include <uwb/protocols/fira/RangingMethod.hxx>
+#include <uwb/protocols/fira/UwbConfiguration.hxx>
 
 namespace uwb::protocol::fira
 {
@@ -183,22 +185,68 @@ struct UwbCapability
 
     static const std::initializer_list<RangingMethod> RangingMethodsDefault;
 
-    static const std::unordered_map<MultiNodeMode, std::size_t> MultiNodeModeBit;
-    static const std::unordered_map<DeviceRole, std::size_t> DeviceRoleBit;
-    static const std::unordered_map<StsConfiguration, std::size_t> StsConfigurationBit;
-    static const std::unordered_map<StsPacketConfiguration, std::size_t> RFrameConfigurationBit;
-    static const std::unordered_map<AngleOfArrival, std::size_t> AngleOfArrivalBit;
-    static const std::unordered_map<SchedulingMode, std::size_t> SchedulingModeBit;
-    static const std::unordered_map<RangingMode, std::size_t> RangingModeBit;
-    static const std::unordered_map<RangingMethod, std::size_t> RangingMethodBit;
-    static const std::unordered_map<ConvolutionalCodeConstraintLength, std::size_t> ConvolutionalCodeConstraintLengthsBit;
-    static const std::unordered_map<Channel, std::size_t> ChannelsBit;
-    static const std::unordered_map<BprfParameter, std::size_t> BprfParameterSetsBit;
-    static const std::unordered_map<HprfParameter, std::size_t> HprfParameterSetsBit;
+    /**
+     * @brief Bit positions of each supported value in the capability bitmaps.
+     * See FiRa Consortium Common Service Management Layer Technical
+     * Specification v1.0.0, Section 7.5.3.2, 'UWB Controlee Info', Table 52,
+     * pages 96-99.
+     */
+    static constexpr auto MultiNodeModeBit = encoding::MakeBitIndexMapFromRange<MultiNodeMode, MultiNodeMode::Unicast, MultiNodeMode::ManyToMany>();
+    static constexpr auto DeviceRoleBit = encoding::MakeBitIndexMapFromRange<DeviceRole, DeviceRole::Responder, DeviceRole::Initiator>();
+    static constexpr auto StsConfigurationBit = encoding::MakeBitIndexMapFromRange<StsConfiguration, StsConfiguration::Static, StsConfiguration::DynamicWithResponderSubSessionKey>();
+    static constexpr auto RFrameConfigurationBit = encoding::MakeBitIndexMap<StsPacketConfiguration>({
+        { StsPacketConfiguration::SP0, 0 },
+        { StsPacketConfiguration::SP1, 1 },
+        { StsPacketConfiguration::SP3, 3 },
+    });
+    static constexpr auto AngleOfArrivalBit = encoding::MakeBitIndexMapFromRange<AngleOfArrival, AngleOfArrival::Azimuth90, AngleOfArrival::Elevation>();
+    static constexpr auto SchedulingModeBit = encoding::MakeBitIndexMapFromRange<SchedulingMode, SchedulingMode::Contention, SchedulingMode::Time>();
+    static constexpr auto RangingModeBit = encoding::MakeBitIndexMapSequential<RangingMode>({
+        RangingMode::Block,
+        RangingMode::Interval,
+    });
+    static constexpr auto RangingMethodBit = encoding::MakeBitIndexMapSequential<RangingMethod>({
+        RangingMethod{ RangingDirection::OneWay, MeasurementReportMode::None },
+        RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::Deferred },
+        RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::Deferred },
+        RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred },
+        RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::NonDeferred },
+    });
+    static constexpr auto ConvolutionalCodeConstraintLengthsBit = encoding::MakeBitIndexMapFromRange<ConvolutionalCodeConstraintLength, ConvolutionalCodeConstraintLength::K3, ConvolutionalCodeConstraintLength::K7>();
+    static constexpr auto ChannelsBit = encoding::MakeBitIndexMapSequential<Channel>({
+        Channel::C5,
+        Channel::C6,
+        Channel::C8,
+        Channel::C9,
+        Channel::C10,
+        Channel::C12,
+        Channel::C13,
+        Channel::C14,
+    });
+    static constexpr auto BprfParameterSetsBit = encoding::MakeBitIndexMapFromRange<BprfParameter, BprfParameter::Set1, BprfParameter::Set6>();
+    static constexpr auto HprfParameterSetsBit = encoding::MakeBitIndexMapFromRange<HprfParameter, HprfParameter::Set1, HprfParameter::Set35>();
     static constexpr std::size_t AngleOfArrivalFomBit = 3;
     static constexpr std::size_t BlockStridingBit = 0;
     static constexpr std::size_t HoppingModeBit = 0;
 
+    /**
+     * @brief Sets of supported values, each stored as a bitmap using the bit
+     * positions above. Membership tests, intersections and subset checks are
+     * single bitwise operations.
+     */
+    using MultiNodeModeSet = encoding::FlagSet<MultiNodeModeBit>;
+    using DeviceRoleSet = encoding::FlagSet<DeviceRoleBit>;
+    using StsConfigurationSet = encoding::FlagSet<StsConfigurationBit>;
+    using RFrameConfigurationSet = encoding::FlagSet<RFrameConfigurationBit>;
+    using AngleOfArrivalSet = encoding::FlagSet<AngleOfArrivalBit>;
+    using SchedulingModeSet = encoding::FlagSet<SchedulingModeBit>;
+    using RangingModeSet = encoding::FlagSet<RangingModeBit>;
+    using RangingMethodSet = encoding::FlagSet<RangingMethodBit>;
+    using ConvolutionalCodeConstraintLengthSet = encoding::FlagSet<ConvolutionalCodeConstraintLengthsBit>;
+    using ChannelSet = encoding::FlagSet<ChannelsBit>;
+    using BprfParameterSet = encoding::FlagSet<BprfParameterSetsBit>;
+    using HprfParameterSet = encoding::FlagSet<HprfParameterSetsBit>;
+
     uint32_t FiraPhyVersionRange{ 0 };
     uint32_t FiraMacVersionRange{ 0 };
     bool ExtendedMacAddress{ false };
@@ -206,18 +254,18 @@ struct UwbCapability
     bool AngleOfArrivalFom{ false };
     bool BlockStriding{ true };
     bool HoppingMode{ true };
-    std::vector<MultiNodeMode> MultiNodeModes{ MultiNodeModesDefault };
-    std::vector<DeviceRole> DeviceRoles{ DeviceRolesDefault };
-    std::vector<StsConfiguration> StsConfigurations{ StsConfigurationsDefault };
-    std::vector<StsPacketConfiguration> RFrameConfigurations{ RFrameConfigurationsDefault };
-    std::vector<AngleOfArrival> AngleOfArrivalTypes{ AngleOfArrivalTypesDefault };
-    std::vector<SchedulingMode> SchedulingModes{ SchedulingModeTypesDefault };
-    std::vector<RangingMode> RangingTimeStructs{ RangingTimeStructsDefault };
-    std::vector<RangingMethod> RangingMethods{ RangingMethodsDefault };
-    std::vector<ConvolutionalCodeConstraintLength> ConvolutionalCodeConstraintLengths{ ConvolutionalCodeConstraintLengthsDefault };
-    std::vector<Channel> Channels{ ChannelsDefault };
-    std::vector<BprfParameter> BprfParameterSets{ BprfParameterSetsDefault };
-    std::vector<HprfParameter> HprfParameterSets{ HprfParameterSetsDefault };
+    MultiNodeModeSet MultiNodeModes{ MultiNodeModesDefault };
+    DeviceRoleSet DeviceRoles{ DeviceRolesDefault };
+    StsConfigurationSet StsConfigurations{ StsConfigurationsDefault };
+    RFrameConfigurationSet RFrameConfigurations{ RFrameConfigurationsDefault };
+    AngleOfArrivalSet AngleOfArrivalTypes{ AngleOfArrivalTypesDefault };
+    SchedulingModeSet SchedulingModes{ SchedulingModeTypesDefault };
+    RangingModeSet RangingTimeStructs{ RangingTimeStructsDefault };
+    RangingMethodSet RangingMethods{ RangingMethodsDefault };
+    ConvolutionalCodeConstraintLengthSet ConvolutionalCodeConstraintLengths{ ConvolutionalCodeConstraintLengthsDefault };
+    ChannelSet Channels{ ChannelsDefault };
+    BprfParameterSet BprfParameterSets{ BprfParameterSetsDefault };
+    HprfParameterSet HprfParameterSets{ HprfParameterSetsDefault };
 
     /**
      * @brief Return a string representation of the object.
@@ -242,6 +290,60 @@ struct UwbCapability
      */
     static UwbCapability
     FromOobDataObject(const encoding::TlvBer& tlv);
+
+    /**
+     * @brief Decodes a UwbCapability from a non-owning view of a FiRa Data
+     * Object (DO), without copying any of its values.
+     *
+     * @param tlv
+     * @return UwbCapability
+     */
+    static UwbCapability
+    FromOobDataObject(const encoding::TlvBerView& tlv);
+
+    /**
+     * @brief Get the capabilities supported by both this object and another.
+     * Sets of supported values are intersected and optional features are kept
+     * only when both support them. Version ranges are narrowed to their
+     * overlap, or cleared if either range is unspecified or they do not
+     * overlap.
+     *
+     * @param other The other capabilities.
+     * @return UwbCapability
+     */
+    UwbCapability
+    Intersect(const UwbCapability& other) const noexcept;
+
+    /**
+     * @brief Determine whether every capability of this object is also
+     * supported by another.
+     *
+     * @param other The other capabilities.
+     * @return true If this object's capabilities are a subset of the other's.
+     * @return false Otherwise.
+     */
+    bool
+    IsSubsetOf(const UwbCapability& other) const noexcept;
+
+    /**
+     * @brief Negotiate the configuration a controller should use to range with
+     * a controlee, given the capabilities of each.
+     *
+     * The device role in the configuration is the controller's; the controlee
+     * takes the opposite role. Where both devices support more than one value
+     * for a parameter, the most widely interoperable value is chosen, with
+     * the FiRa default values preferred. Optional features such as hopping and
+     * block striding are left disabled. The configuration holds only the
+     * parameters described by capabilities; addressing and timing parameters
+     * must be added separately.
+     *
+     * @param controller The capabilities of the controller.
+     * @param controlee The capabilities of the controlee.
+     * @return std::optional<UwbConfiguration> The configuration, or
+     * std::nullopt if the devices have no common configuration.
+     */
+    static std::optional<UwbConfiguration>
+    Negotiate(const UwbCapability& controller, const UwbCapability& controlee);
 };
 
 bool
@@ -269,18 +371,18 @@ struct hash<uwb::protocol::fira::UwbCapability>
             uwbCapability.AngleOfArrivalFom,
             uwbCapability.BlockStriding,
             uwbCapability.HoppingMode,
-            notstd::hash_range(std::cbegin(uwbCapability.RangingMethods), std::cend(uwbCapability.RangingMethods)),
-            notstd::hash_range(std::cbegin(uwbCapability.MultiNodeModes), std::cend(uwbCapability.MultiNodeModes)),
-            notstd::hash_range(std::cbegin(uwbCapability.DeviceRoles), std::cend(uwbCapability.DeviceRoles)),
-            notstd::hash_range(std::cbegin(uwbCapability.StsConfigurations), std::cend(uwbCapability.StsConfigurations)),
-            notstd::hash_range(std::cbegin(uwbCapability.RFrameConfigurations), std::cend(uwbCapability.RFrameConfigurations)),
-            notstd::hash_range(std::cbegin(uwbCapability.AngleOfArrivalTypes), std::cend(uwbCapability.AngleOfArrivalTypes)),
-            notstd::hash_range(std::cbegin(uwbCapability.SchedulingModes), std::cend(uwbCapability.SchedulingModes)),
-            notstd::hash_range(std::cbegin(uwbCapability.RangingTimeStructs), std::cend(uwbCapability.RangingTimeStructs)),
-            notstd::hash_range(std::cbegin(uwbCapability.ConvolutionalCodeConstraintLengths), std::cend(uwbCapability.ConvolutionalCodeConstraintLengths)),
-            notstd::hash_range(std::cbegin(uwbCapability.Channels), std::cend(uwbCapability.Channels)),
-            notstd::hash_range(std::cbegin(uwbCapability.BprfParameterSets), std::cend(uwbCapability.BprfParameterSets)),
-            notstd::hash_range(std::cbegin(uwbCapability.HprfParameterSets), std::cend(uwbCapability.HprfParameterSets)));
+            uwbCapability.RangingMethods.GetBits(),
+            uwbCapability.MultiNodeModes.GetBits(),
+            uwbCapability.DeviceRoles.GetBits(),
+            uwbCapability.StsConfigurations.GetBits(),
+            uwbCapability.RFrameConfigurations.GetBits(),
+            uwbCapability.AngleOfArrivalTypes.GetBits(),
+            uwbCapability.SchedulingModes.GetBits(),
+            uwbCapability.RangingTimeStructs.GetBits(),
+            uwbCapability.ConvolutionalCodeConstraintLengths.GetBits(),
+            uwbCapability.Channels.GetBits(),
+            uwbCapability.BprfParameterSets.GetBits(),
+            uwbCapability.HprfParameterSets.GetBits());
         return value;
     }
 };
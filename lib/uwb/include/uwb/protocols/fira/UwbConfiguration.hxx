@@ -10,8 +10,11 @@
 #include <unordered_set>
 #include <variant>
 
+#include <notstd/enum_map.hxx>
 #include <notstd/hash.hxx>
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <tlv/TlvSerialize.hxx>
 
 #include <uwb/UwbMacAddress.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
@@ -105,6 +108,19 @@ struct UwbConfiguration
     static constexpr auto MaxRrRetryDefault = 0U;
     static const std::unordered_set<ResultReportConfiguration> ResultReportConfigurationsDefault;
 
+    /**
+     * @brief Bit assignments of the RESULT_REPORT_CONFIG bitmap, where each
+     * value occupies the bit matching its underlying value.
+     */
+    static constexpr auto ResultReportConfigurationBit = encoding::MakeBitIndexMapSequential<ResultReportConfiguration>({
+        ResultReportConfiguration::TofReport,
+        ResultReportConfiguration::AoAAzimuthReport,
+        ResultReportConfiguration::AoAElevationReport,
+        ResultReportConfiguration::AoAFoMReport,
+    });
+
+    using ResultReportConfigurationSet = encoding::FlagSet<ResultReportConfigurationBit>;
+
     /**
      * @brief Variant for all possible property types.
      */
@@ -126,7 +142,13 @@ struct UwbConfiguration
         ::uwb::UwbMacAddress,
         ::uwb::UwbMacAddressFcsType,
         ::uwb::UwbMacAddressType,
-        std::unordered_set<::uwb::protocol::fira::ResultReportConfiguration>>;
+        ResultReportConfigurationSet>;
+
+    /**
+     * @brief The values of the parameters present in a configuration, stored
+     * in a fixed slot per parameter tag.
+     */
+    using ParameterValues = notstd::enum_map<ParameterTag, ParameterTypesVariant, ParameterTag::FiraPhyVersion, ParameterTag::MaxRrRetry>;
 
     /**
      * @brief Creates a new UwbConfiguration builder object.
@@ -137,7 +159,9 @@ struct UwbConfiguration
     Create() noexcept;
 
     /**
-     * @brief Default equality operator.
+     * @brief Default equality operator. Compares the parameter presence masks
+     * and value slots, which does not depend on the order parameters were set
+     * in.
      *
      * @param other
      * @return true
@@ -164,12 +188,23 @@ struct UwbConfiguration
     FromDataObject(const encoding::TlvBer& tlv);
 
     /**
-     * @brief The map of parameter tags and their values from the configuration object.
+     * @brief Attempt to create a UwbConfiguration object from a TlvBerView.
+     * Values are decoded directly from the viewed buffer.
      *
-     * @return const std::unordered_map<::uwb::protocol::fira::UwbConfiguration::ParameterTag, ParameterTypesVariant>&
+     * @param tlv
+     * @return UwbConfiguration
      */
-    const std::unordered_map<::uwb::protocol::fira::UwbConfiguration::ParameterTag, ParameterTypesVariant>&
-    GetValueMap() const noexcept;
+    static UwbConfiguration
+    FromDataObject(const encoding::TlvBerView& tlv);
+
+    /**
+     * @brief The parameter tags and values present in the configuration
+     * object. Iterating visits each present parameter in ascending tag order.
+     *
+     * @return const ParameterValues&
+     */
+    const ParameterValues&
+    GetValues() const noexcept;
 
     std::optional<uint16_t>
     GetFiraPhyVersion() const noexcept;
@@ -275,14 +310,32 @@ private:
     std::optional<T>
     GetValue(ParameterTag tag) const noexcept
     {
-        auto it = m_values.find(tag);
-        return (it != std::cend(m_values))
-            ? std::optional<T>(std::get<T>(it->second))
+        const auto* value = m_values.get(tag);
+        return (value != nullptr)
+            ? std::optional<T>(std::get<T>(*value))
             : std::nullopt;
     }
 
 private:
-    std::unordered_map<ParameterTag, ParameterTypesVariant> m_values{};
+    /**
+     * @brief Schema of the FiRa data object, see ToDataObject().
+     */
+    struct DataObjectSchema;
+
+    /**
+     * @brief Decodes a UwbConfiguration from either an owning TlvBer or a
+     * non-owning TlvBerView. Parameters with invalid values are logged and
+     * ignored.
+     *
+     * @tparam TlvT The type of tlv to decode from.
+     * @param tlvBer
+     * @return UwbConfiguration
+     */
+    template <typename TlvT>
+    static UwbConfiguration
+    FromDataObjectImpl(const TlvT& tlvBer);
+
+    ParameterValues m_values{};
 };
 
 } // namespace uwb::protocol::fira
@@ -295,39 +348,14 @@ struct hash<::uwb::protocol::fira::UwbConfiguration>
     std::size_t
     operator()(const ::uwb::protocol::fira::UwbConfiguration& uwbConfiguration) const noexcept
     {
+        // Hash the presence mask and the present value slots directly; absent
+        // slots always hold the same value, so they need not be visited.
+        const auto& values = uwbConfiguration.GetValues();
         std::size_t value = 0;
-        auto resultReportConfigurations = uwbConfiguration.GetResultReportConfigurations();
-        notstd::hash_combine(value,
-            uwbConfiguration.GetFiraPhyVersion(),
-            uwbConfiguration.GetFiraMacVersion(),
-            uwbConfiguration.GetDeviceRole(),
-            uwbConfiguration.GetRangingMethod(),
-            uwbConfiguration.GetStsConfiguration(),
-            uwbConfiguration.GetMultiNodeMode(),
-            uwbConfiguration.GetRangingTimeStruct(),
-            uwbConfiguration.GetSchedulingMode(),
-            uwbConfiguration.GetHoppingMode(),
-            uwbConfiguration.GetBlockStriding(),
-            uwbConfiguration.GetUwbInitiationTime(),
-            uwbConfiguration.GetChannel(),
-            uwbConfiguration.GetRFrameConfig(),
-            uwbConfiguration.GetConvolutionalCodeConstraintLength(),
-            uwbConfiguration.GetPrfMode(),
-            uwbConfiguration.GetSp0PhySetNumber(),
-            uwbConfiguration.GetSp1PhySetNumber(),
-            uwbConfiguration.GetSp3PhySetNumber(),
-            uwbConfiguration.GetPreambleCodeIndex(),
-            notstd::hash_range(std::cbegin(resultReportConfigurations), std::cend(resultReportConfigurations)),
-            uwbConfiguration.GetMacAddressMode(),
-            uwbConfiguration.GetControleeShortMacAddress(),
-            uwbConfiguration.GetControllerMacAddress(),
-            uwbConfiguration.GetSlotsPerRangingRound(),
-            uwbConfiguration.GetMaxContentionPhaseLength(),
-            uwbConfiguration.GetSlotDuration(),
-            uwbConfiguration.GetRangingInterval(),
-            uwbConfiguration.GetKeyRotationRate(),
-            uwbConfiguration.GetMacAddressFcsType(),
-            uwbConfiguration.GetMaxRangingRoundRetry());
+        notstd::hash_combine(value, values.presence());
+        for (const auto& [parameterTag, parameterValue] : values) {
+            notstd::hash_combine(value, parameterValue);
+        }
         return value;
     }
 };
@@ -15,6 +15,14 @@ class UwbConfiguration::Builder
 public:
     Builder();
 
+    /**
+     * @brief Construct a new Builder object whose initial state is a copy of
+     * an existing configuration, allowing it to be modified.
+     *
+     * @param uwbConfiguration The configuration to start from.
+     */
+    explicit Builder(UwbConfiguration uwbConfiguration);
+
     /**
      * @brief Operator which returns the built UwbConfiguration object as an
      * implicit conversion. Following invocation, the state is reset and the
@@ -248,7 +256,7 @@ public:
 
 private:
     UwbConfiguration m_uwbConfiguration;
-    std::unordered_map<uwb::protocol::fira::UwbConfiguration::ParameterTag, uwb::protocol::fira::UwbConfiguration::ParameterTypesVariant>& m_values;
+    uwb::protocol::fira::UwbConfiguration::ParameterValues& m_values;
 };
 
 } // namespace uwb::protocol::fira
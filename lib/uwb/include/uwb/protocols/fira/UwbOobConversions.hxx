@@ -10,6 +10,9 @@ namespace uwb::protocol::fira
 /**
  * @brief Converts the config params given by OOB to config params that UCI needs
  *
+ * Results for recently converted configurations are cached, so repeatedly
+ * starting sessions from the same OOB configuration skips the conversion.
+ *
  * @param uwbConfiguration The UWB configuration data used to generate the UCI configuration parameter list
  * @param deviceType The type of device (Controller/Controlee)
  * @return std::vector<UwbApplicationConfigurationParameter>
@@ -5,11 +5,12 @@
 #include <bitset>
 #include <cstdint>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
+#include <notstd/enum_map.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 namespace uwb::protocol::fira
 {
@@ -54,6 +55,12 @@ struct UwbRegulatoryInformation
         OtherFiraDevice,
     };
 
+    /**
+     * @brief Maximum transmission power per channel, stored in a fixed slot
+     * per channel.
+     */
+    using ChannelTransmissionPowers = notstd::enum_map<Channel, uint8_t, Channel::C5, Channel::C14>;
+
     /**
      * @brief Convert this object into a FiRa Data Object (DO).
      *
@@ -71,11 +78,20 @@ struct UwbRegulatoryInformation
     static UwbRegulatoryInformation
     FromDataObject(const encoding::TlvBer& tlv);
 
+    /**
+     * @brief Attempt to create a UwbRegulatoryInformation object from a TlvBerView.
+     *
+     * @param tlv
+     * @return UwbRegulatoryInformation
+     */
+    static UwbRegulatoryInformation
+    FromDataObject(const encoding::TlvBerView& tlv);
+
     InformationSource Source{ InformationSource::UserDefined };
     bool OutdoorPermitted{ true };
     uint16_t CountryCode{ 0x0000U };
     uint32_t Timestamp{ 0x00000000U };
-    std::unordered_map<Channel, uint8_t> MaximumTransmissionPower;
+    ChannelTransmissionPowers MaximumTransmissionPower;
 };
 } // namespace uwb::protocol::fira
 
@@ -8,6 +8,7 @@
 
 #include <notstd/hash.hxx>
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 #include <uwb/protocols/fira/SecureRangingInfo.hxx>
 #include <uwb/protocols/fira/StaticRangingInfo.hxx>
@@ -69,6 +70,18 @@ struct UwbSessionData
     static UwbSessionData
     FromDataObject(const encoding::TlvBer& tlv);
 
+    /**
+     * @brief Attempt to create a UwbSessionData object from a TlvBerView.
+     *
+     * This decodes directly from the buffer the view refers to, without
+     * materializing an intermediate TlvBer tree.
+     *
+     * @param tlv
+     * @return UwbSessionData
+     */
+    static UwbSessionData
+    FromDataObject(const encoding::TlvBerView& tlv);
+
     /**
      * @brief Attempt to create a UwbSessionData object from a MsgPack.
      *
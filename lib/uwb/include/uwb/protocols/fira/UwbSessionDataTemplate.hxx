@@ -0,0 +1,124 @@
+
+#ifndef UWB_SESSION_DATA_TEMPLATE_HXX
+#define UWB_SESSION_DATA_TEMPLATE_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/UwbSessionData.hxx>
+
+namespace uwb::protocol::fira
+{
+/**
+ * @brief A UwbSessionData object encoded once, from which per-session FiRa
+ * data objects are produced by copying the encoding and patching the fields
+ * that vary between sessions in place.
+ *
+ * A full re-encode is only done when a patched field would change length,
+ * such as replacing a short MAC address with an extended one, or when the
+ * field is absent from the template.
+ */
+class UwbSessionDataTemplate
+{
+public:
+    /**
+     * @brief The fields that vary between sessions. MAC addresses that are
+     * not specified keep the value from the template.
+     */
+    struct Fields
+    {
+        uint32_t SessionId{ 0 };
+        uint32_t SubSessionId{ 0 };
+        std::optional<::uwb::UwbMacAddress> ControllerMacAddress;
+        std::optional<::uwb::UwbMacAddress> ControleeShortMacAddress;
+    };
+
+    /**
+     * @brief Construct a new UwbSessionDataTemplate object, encoding the
+     * specified session data.
+     *
+     * @param uwbSessionData The session data to use as the template.
+     */
+    explicit UwbSessionDataTemplate(UwbSessionData uwbSessionData);
+
+    /**
+     * @brief Get the session data the template was created from.
+     *
+     * @return const UwbSessionData&
+     */
+    const UwbSessionData&
+    GetSessionData() const noexcept;
+
+    /**
+     * @brief Get the encoding of the session data the template was created from.
+     *
+     * @return const std::vector<uint8_t>&
+     */
+    const std::vector<uint8_t>&
+    GetEncoding() const noexcept;
+
+    /**
+     * @brief Determine whether the specified fields can be patched into the
+     * template encoding without re-encoding.
+     *
+     * @param fields The fields to check.
+     * @return true If every field can be patched in place.
+     * @return false If a full re-encode is required.
+     */
+    bool
+    CanPatch(const Fields& fields) const noexcept;
+
+    /**
+     * @brief Generate the encoded FiRa data object for a session.
+     *
+     * @param fields The per-session fields.
+     * @return std::vector<uint8_t>
+     */
+    std::vector<uint8_t>
+    Generate(const Fields& fields) const;
+
+    /**
+     * @brief Generate the encoded FiRa data object for a session into an
+     * existing buffer, reusing its storage.
+     *
+     * @param fields The per-session fields.
+     * @param encoded Output argument to hold the encoded data object.
+     */
+    void
+    Generate(const Fields& fields, std::vector<uint8_t>& encoded) const;
+
+private:
+    /**
+     * @brief The location of a field's value within the template encoding.
+     */
+    struct FieldLocation
+    {
+        std::size_t Offset{ 0 };
+        std::size_t Length{ 0 };
+    };
+
+    /**
+     * @brief Encode the template session data with the specified fields
+     * applied, without using the template encoding.
+     *
+     * @param fields The per-session fields.
+     * @param encoded Output argument to hold the encoded data object.
+     */
+    void
+    Encode(const Fields& fields, std::vector<uint8_t>& encoded) const;
+
+private:
+    UwbSessionData m_uwbSessionData;
+    std::vector<uint8_t> m_encoding;
+    std::optional<FieldLocation> m_sessionIdLocation;
+    std::optional<FieldLocation> m_subSessionIdLocation;
+    std::optional<FieldLocation> m_controllerMacAddressLocation;
+    std::optional<FieldLocation> m_controleeShortMacAddressLocation;
+};
+
+} // namespace uwb::protocol::fira
+
+#endif // UWB_SESSION_DATA_TEMPLATE_HXX
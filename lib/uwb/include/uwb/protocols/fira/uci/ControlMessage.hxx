@@ -2,10 +2,295 @@
 #ifndef FIRA_UCI_CONTROL_MESSAGE_HXX
 #define FIRA_UCI_CONTROL_MESSAGE_HXX
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <uwb/protocols/fira/uci/ControlPacket.hxx>
+#include <uwb/protocols/fira/uci/StatusCodes.hxx>
+
 namespace uwb::protocol::fira::uci
 {
+/**
+ * @brief Opcode identifiers of the UCI core group.
+ */
+enum class OidCore : uint8_t {
+    DeviceReset = 0x00,
+    DeviceStatus = 0x01,
+    GetDeviceInfo = 0x02,
+    GetCapsInfo = 0x03,
+    SetConfig = 0x04,
+    GetConfig = 0x05,
+    GenericError = 0x07,
+};
+
+/**
+ * @brief Opcode identifiers of the UWB session configuration group.
+ */
+enum class OidSessionConfig : uint8_t {
+    Init = 0x00,
+    Deinit = 0x01,
+    Status = 0x02,
+    SetAppConfig = 0x03,
+    GetAppConfig = 0x04,
+    GetCount = 0x05,
+    GetState = 0x06,
+    UpdateControllerMulticastList = 0x07,
+};
+
+/**
+ * @brief Opcode identifiers of the UWB ranging session control group. Start
+ * is shared by the RANGE_START command and the RANGE_DATA_NTF notification.
+ */
+enum class OidSessionControl : uint8_t {
+    Start = 0x00,
+    Stop = 0x01,
+    GetRangingCount = 0x03,
+};
+
+/**
+ * @brief Opcode identifiers of the test group.
+ */
+enum class OidTest : uint8_t {
+    ConfigSet = 0x00,
+    ConfigGet = 0x01,
+    PeriodicTx = 0x02,
+    PerRx = 0x03,
+    Rx = 0x05,
+    Loopback = 0x06,
+    StopSession = 0x07,
+};
+
+/**
+ * @brief Describes a message defined by the UCI specification.
+ */
+struct MessageDescriptor
+{
+    GroupId Gid;
+    uint8_t Oid;
+    std::string_view Name;
+    // Whether the message exists as a command and response pair.
+    bool HasCommand;
+    // Whether the message exists as a notification.
+    bool HasNotification;
+
+    /**
+     * @brief Determine whether the message exists with the specified type.
+     *
+     * @param messageType The message type to check.
+     * @return true
+     * @return false
+     */
+    constexpr bool
+    Supports(MessageType messageType) const noexcept
+    {
+        switch (messageType) {
+        case MessageType::Command:
+        case MessageType::Response:
+            return HasCommand;
+        case MessageType::Notification:
+            return HasNotification;
+        default:
+            return false;
+        }
+    }
+};
+
+/**
+ * @brief All messages defined by the UCI specification.
+ */
+inline constexpr std::array MessageDescriptors{
+    MessageDescriptor{ GroupId::Core, static_cast<uint8_t>(OidCore::DeviceReset), "CORE_DEVICE_RESET", true, false },
+    MessageDescriptor{ GroupId::Core, static_cast<uint8_t>(OidCore::DeviceStatus), "CORE_DEVICE_STATUS", false, true },
+    MessageDescriptor{ GroupId::Core, static_cast<uint8_t>(OidCore::GetDeviceInfo), "CORE_GET_DEVICE_INFO", true, false },
+    MessageDescriptor{ GroupId::Core, static_cast<uint8_t>(OidCore::GetCapsInfo), "CORE_GET_CAPS_INFO", true, false },
+    MessageDescriptor{ GroupId::Core, static_cast<uint8_t>(OidCore::SetConfig), "CORE_SET_CONFIG", true, false },
+    MessageDescriptor{ GroupId::Core, static_cast<uint8_t>(OidCore::GetConfig), "CORE_GET_CONFIG", true, false },
+    MessageDescriptor{ GroupId::Core, static_cast<uint8_t>(OidCore::GenericError), "CORE_GENERIC_ERROR", false, true },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::Init), "SESSION_INIT", true, false },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::Deinit), "SESSION_DEINIT", true, false },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::Status), "SESSION_STATUS", false, true },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::SetAppConfig), "SESSION_SET_APP_CONFIG", true, false },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::GetAppConfig), "SESSION_GET_APP_CONFIG", true, false },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::GetCount), "SESSION_GET_COUNT", true, false },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::GetState), "SESSION_GET_STATE", true, false },
+    MessageDescriptor{ GroupId::SessionConfig, static_cast<uint8_t>(OidSessionConfig::UpdateControllerMulticastList), "SESSION_UPDATE_CONTROLLER_MULTICAST_LIST", true, true },
+    MessageDescriptor{ GroupId::SessionControl, static_cast<uint8_t>(OidSessionControl::Start), "RANGE_START", true, true },
+    MessageDescriptor{ GroupId::SessionControl, static_cast<uint8_t>(OidSessionControl::Stop), "RANGE_STOP", true, false },
+    MessageDescriptor{ GroupId::SessionControl, static_cast<uint8_t>(OidSessionControl::GetRangingCount), "RANGE_GET_RANGING_COUNT", true, false },
+    MessageDescriptor{ GroupId::Test, static_cast<uint8_t>(OidTest::ConfigSet), "TEST_CONFIG_SET", true, false },
+    MessageDescriptor{ GroupId::Test, static_cast<uint8_t>(OidTest::ConfigGet), "TEST_CONFIG_GET", true, false },
+    MessageDescriptor{ GroupId::Test, static_cast<uint8_t>(OidTest::PeriodicTx), "TEST_PERIODIC_TX", true, true },
+    MessageDescriptor{ GroupId::Test, static_cast<uint8_t>(OidTest::PerRx), "TEST_PER_RX", true, true },
+    MessageDescriptor{ GroupId::Test, static_cast<uint8_t>(OidTest::Rx), "TEST_RX", true, true },
+    MessageDescriptor{ GroupId::Test, static_cast<uint8_t>(OidTest::Loopback), "TEST_LOOPBACK", true, true },
+    MessageDescriptor{ GroupId::Test, static_cast<uint8_t>(OidTest::StopSession), "TEST_STOP_SESSION", true, false },
+};
+
+namespace detail
+{
+constexpr std::size_t NumGroupIds = ControlPacket::BitmaskGroupId + 1;
+constexpr std::size_t NumOpcodeIds = ControlPacket::BitmaskOpcodeId + 1;
+constexpr uint8_t MessageDescriptorIndexInvalid = 0xFF;
+
+static_assert(std::size(MessageDescriptors) < MessageDescriptorIndexInvalid);
+
+/**
+ * @brief Table mapping each (GID, OID) pair to the index of its descriptor,
+ * so lookups are a single indexed load.
+ */
+inline constexpr auto MessageDescriptorIndices = [] {
+    std::array<uint8_t, NumGroupIds * NumOpcodeIds> indices{};
+    indices.fill(MessageDescriptorIndexInvalid);
+    for (std::size_t i = 0; i < std::size(MessageDescriptors); i++) {
+        const auto& descriptor = MessageDescriptors[i];
+        indices[static_cast<std::size_t>(descriptor.Gid) * NumOpcodeIds + descriptor.Oid] = static_cast<uint8_t>(i);
+    }
+    return indices;
+}();
+} // namespace detail
+
+/**
+ * @brief Look up the descriptor of the specified message.
+ *
+ * @param gid The group identifier of the message.
+ * @param oid The opcode identifier of the message.
+ * @return constexpr const MessageDescriptor* The descriptor, or nullptr if the
+ * message is not defined by the specification.
+ */
+constexpr const MessageDescriptor*
+LookupMessageDescriptor(GroupId gid, uint8_t oid) noexcept
+{
+    const auto gidValue = static_cast<std::size_t>(gid);
+    if (gidValue >= detail::NumGroupIds || oid >= detail::NumOpcodeIds) {
+        return nullptr;
+    }
+
+    const auto index = detail::MessageDescriptorIndices[gidValue * detail::NumOpcodeIds + oid];
+    return (index == detail::MessageDescriptorIndexInvalid) ? nullptr : &MessageDescriptors[index];
+}
+
+/**
+ * @brief A complete UCI control message, possibly spanning several packets.
+ * The payload is a view; when decoded, it refers either to the receive buffer
+ * (single packet messages) or to the buffer of the reassembler that produced
+ * it.
+ */
 struct ControlMessage
 {
+    MessageType Type{ MessageType::Command };
+    GroupId Gid{ GroupId::Core };
+    uint8_t Oid{ 0 };
+    std::span<const uint8_t> Payload{};
+
+    /**
+     * @brief Get the descriptor of this message.
+     *
+     * @return const MessageDescriptor* The descriptor, or nullptr if the
+     * message is not defined by the specification (eg. proprietary).
+     */
+    const MessageDescriptor*
+    GetDescriptor() const noexcept;
+
+    /**
+     * @brief Get the status of a response message, which is the first octet of
+     * its payload.
+     *
+     * @return std::optional<StatusCode> The status, or std::nullopt if this is
+     * not a response or its payload is empty.
+     */
+    std::optional<StatusCode>
+    GetStatus() const noexcept;
+
+    /**
+     * @brief Get the number of packets needed to encode this message.
+     *
+     * @param payloadSizeMaximum The maximum payload size of a single packet.
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumPackets(std::size_t payloadSizeMaximum = ControlPacket::PayloadSizeMaximum) const noexcept;
+
+    /**
+     * @brief Append the encoded packets of this message to the specified
+     * buffer, segmenting the payload as needed.
+     *
+     * @param output The buffer to append to.
+     * @param payloadSizeMaximum The maximum payload size of a single packet,
+     * eg. as negotiated with the device. Must be between 1 and
+     * ControlPacket::PayloadSizeMaximum, otherwise std::invalid_argument is
+     * thrown.
+     */
+    void
+    Encode(std::vector<uint8_t>& output, std::size_t payloadSizeMaximum = ControlPacket::PayloadSizeMaximum) const;
+};
+
+/**
+ * @brief Reassembles control messages from their (possibly segmented)
+ * packets, in the order received.
+ *
+ * Unsegmented messages are passed through without copying. The payloads of
+ * segmented messages are accumulated in a buffer that is reused across
+ * messages, so steady-state reassembly does not allocate.
+ */
+class ControlMessageReassembler
+{
+public:
+    /**
+     * @brief The default maximum accepted payload size of a reassembled
+     * message.
+     */
+    static constexpr std::size_t PayloadSizeMaximumDefault = 64 * 1024;
+
+    /**
+     * @brief Construct a new ControlMessageReassembler object.
+     *
+     * @param payloadSizeMaximum The maximum payload size of a reassembled
+     * message.
+     */
+    explicit ControlMessageReassembler(std::size_t payloadSizeMaximum = PayloadSizeMaximumDefault);
+
+    /**
+     * @brief Process the next received packet.
+     *
+     * A packet whose type, GID or OID differ from a partially reassembled
+     * message implies the remainder of that message was lost; the partial
+     * message is discarded and reassembly restarts with the new packet. A
+     * message exceeding the maximum payload size is discarded and
+     * std::length_error is thrown.
+     *
+     * @param packet The received packet.
+     * @return std::optional<ControlMessage> The message completed by this
+     * packet, if any. It is valid until the next call to Push() or Reset(),
+     * and for as long as the packet's payload is.
+     */
+    std::optional<ControlMessage>
+    Push(const ControlPacket& packet);
+
+    /**
+     * @brief Discard any partially reassembled message.
+     */
+    void
+    Reset() noexcept;
+
+    /**
+     * @brief Returns whether a message has been partially reassembled.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    HasPartialMessage() const noexcept;
+
+private:
+    std::size_t m_payloadSizeMaximum;
+    // Header of the partially reassembled message, if any.
+    std::optional<ControlMessage> m_message;
+    std::vector<uint8_t> m_payload;
 };
 
 } // namespace uwb::protocol::fira::uci
@@ -2,10 +2,102 @@
 #ifndef FIRA_UCI_CONTROL_PACKET_HXX
 #define FIRA_UCI_CONTROL_PACKET_HXX
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
 namespace uwb::protocol::fira::uci
 {
+/**
+ * @brief See FiRa Consortium - UCI Generic Specification v1.1.0, Section 4.3.
+ */
+enum class MessageType : uint8_t {
+    Data = 0b000,
+    Command = 0b001,
+    Response = 0b010,
+    Notification = 0b011,
+};
+
+/**
+ * @brief See FiRa Consortium - UCI Generic Specification v1.1.0, Section 8.
+ * The group identifier is 4 bits wide; values not listed here are reserved or
+ * proprietary.
+ */
+enum class GroupId : uint8_t {
+    Core = 0x0,
+    SessionConfig = 0x1,
+    SessionControl = 0x2,
+    DataControl = 0x3,
+    Test = 0xD,
+};
+
+/**
+ * @brief A single UCI control packet: the 4 octet header and a view of its
+ * payload. Messages whose payload exceeds PayloadSizeMaximum are split into
+ * several packets, all but the last of which have the packet boundary flag
+ * (PBF) set.
+ *
+ * See FiRa Consortium - UCI Generic Specification v1.1.0, Section 4.4.
+ */
 struct ControlPacket
 {
+    static constexpr std::size_t HeaderSize = 4;
+    static constexpr std::size_t PayloadSizeMaximum = 255;
+
+    static constexpr uint8_t BitmaskMessageType = 0b11100000;
+    static constexpr uint8_t BitmaskPacketBoundaryFlag = 0b00010000;
+    static constexpr uint8_t BitmaskGroupId = 0b00001111;
+    static constexpr uint8_t BitmaskOpcodeId = 0b00111111;
+    static constexpr uint8_t BitShiftMessageType = 5;
+
+    MessageType Type{ MessageType::Command };
+    // Set if more packets of the same message follow this one.
+    bool PacketBoundaryFlag{ false };
+    GroupId Gid{ GroupId::Core };
+    uint8_t Oid{ 0 };
+    std::span<const uint8_t> Payload{};
+
+    /**
+     * @brief Encode the packet header. The payload length is truncated to 8
+     * bits; Encode() validates it.
+     *
+     * @return constexpr std::array<uint8_t, HeaderSize>
+     */
+    constexpr std::array<uint8_t, HeaderSize>
+    EncodeHeader() const noexcept
+    {
+        return {
+            static_cast<uint8_t>((static_cast<uint8_t>(Type) << BitShiftMessageType) | (PacketBoundaryFlag ? BitmaskPacketBoundaryFlag : 0U) | (static_cast<uint8_t>(Gid) & BitmaskGroupId)),
+            static_cast<uint8_t>(Oid & BitmaskOpcodeId),
+            0x00,
+            static_cast<uint8_t>(std::size(Payload)),
+        };
+    }
+
+    /**
+     * @brief Append the encoded packet (header and payload) to the specified
+     * buffer.
+     *
+     * @param output The buffer to append to. Throws std::length_error if the
+     * payload exceeds PayloadSizeMaximum.
+     */
+    void
+    Encode(std::vector<uint8_t>& output) const;
+
+    /**
+     * @brief Decode the control packet at the start of the specified data. The
+     * decoded payload refers to the input data, which must outlive it.
+     *
+     * @param data The data to decode from.
+     * @param bytesParsed The size of the decoded packet, if successful.
+     * @return std::optional<ControlPacket> The decoded packet, or
+     * std::nullopt if the data does not start with a complete control packet.
+     */
+    static std::optional<ControlPacket>
+    Decode(std::span<const uint8_t> data, std::size_t& bytesParsed) noexcept;
 };
 
 } // namespace uwb::protocol::fira::uci
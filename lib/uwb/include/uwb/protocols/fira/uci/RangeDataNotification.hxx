@@ -0,0 +1,67 @@
+
+#ifndef FIRA_UCI_RANGE_DATA_NOTIFICATION_HXX
+#define FIRA_UCI_RANGE_DATA_NOTIFICATION_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb::protocol::fira::uci
+{
+/**
+ * @brief Codec for the payload of the RANGE_DATA_NTF notification, carrying
+ * the results of one two-way ranging round.
+ *
+ * See FiRa Consortium - UCI Generic Specification v1.1.0, Section 7.2.2,
+ * Tables 37 and 38.
+ */
+struct RangeDataNotification
+{
+    /**
+     * @brief The size of the fixed part of the payload, preceding the
+     * measurements.
+     */
+    static constexpr std::size_t HeaderSize = 25;
+
+    /**
+     * @brief The size of a single two-way ranging measurement, for both short
+     * and extended MAC addresses.
+     */
+    static constexpr std::size_t MeasurementSize = 31;
+
+    /**
+     * @brief Decode a RANGE_DATA_NTF payload into the specified ranging data.
+     *
+     * The existing storage of the output is reused: measurements are converted
+     * in place, and the capacity of its measurement list is retained, so
+     * decoding a stream of notifications into the same object does not
+     * allocate once the capacity has reached the largest number of
+     * measurements in a round.
+     *
+     * @param payload The notification payload.
+     * @param rangingData The ranging data to decode into. Its content is
+     * unspecified if decoding fails.
+     * @return true If the payload was decoded.
+     * @return false If the payload is malformed or is not for two-way ranging.
+     */
+    static bool
+    Decode(std::span<const uint8_t> payload, UwbRangingData& rangingData);
+
+    /**
+     * @brief Append the RANGE_DATA_NTF payload for the specified ranging data
+     * to a buffer.
+     *
+     * @param rangingData The ranging data to encode. All peer addresses must
+     * be of the same type, otherwise std::invalid_argument is thrown.
+     * @param payload The buffer to append to.
+     */
+    static void
+    Encode(const UwbRangingData& rangingData, std::vector<uint8_t>& payload);
+};
+
+} // namespace uwb::protocol::fira::uci
+
+#endif // FIRA_UCI_RANGE_DATA_NOTIFICATION_HXX
@@ -3,6 +3,9 @@
 #define FIRA_UCI_STATUS_CODES_HXX
 
 #include <cstdint>
+#include <optional>
+
+#include <uwb/protocols/fira/FiraDevice.hxx>
 
 namespace uwb::protocol::fira::uci
 {
@@ -48,6 +51,55 @@ enum class StatusCode : uint8_t {
     // Vendor Specific = 0x50-0xFF
 };
 
+// The UwbStatus enumerations list their values in the same order as the
+// corresponding contiguous status code ranges, which ToUwbStatus relies on.
+static_assert(static_cast<uint8_t>(StatusCode::CommandRetry) - static_cast<uint8_t>(StatusCode::Ok) == static_cast<uint8_t>(UwbStatusGeneric::CommandRetry));
+static_assert(static_cast<uint8_t>(StatusCode::UwbSessionAddressAlreadyPresent) - static_cast<uint8_t>(StatusCode::UwbSessionNotExist) == static_cast<uint8_t>(UwbStatusSession::AddressAlreadyPresent));
+static_assert(static_cast<uint8_t>(StatusCode::RangingRxMaxIeMissing) - static_cast<uint8_t>(StatusCode::RangingTxFailed) == static_cast<uint8_t>(UwbStatusRanging::RxMacIeMissing));
+
+/**
+ * @brief Convert a UCI status code to the corresponding UwbStatus.
+ *
+ * @param statusCode The status code to convert.
+ * @return constexpr std::optional<UwbStatus> The corresponding status, or
+ * std::nullopt for reserved and vendor specific status codes.
+ */
+constexpr std::optional<UwbStatus>
+ToUwbStatus(StatusCode statusCode) noexcept
+{
+    const auto value = static_cast<uint8_t>(statusCode);
+    if (value <= static_cast<uint8_t>(StatusCode::CommandRetry)) {
+        return static_cast<UwbStatusGeneric>(value);
+    }
+    if (value >= static_cast<uint8_t>(StatusCode::UwbSessionNotExist) && value <= static_cast<uint8_t>(StatusCode::UwbSessionAddressAlreadyPresent)) {
+        return static_cast<UwbStatusSession>(value - static_cast<uint8_t>(StatusCode::UwbSessionNotExist));
+    }
+    if (value >= static_cast<uint8_t>(StatusCode::RangingTxFailed) && value <= static_cast<uint8_t>(StatusCode::RangingRxMaxIeMissing)) {
+        return static_cast<UwbStatusRanging>(value - static_cast<uint8_t>(StatusCode::RangingTxFailed));
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Convert a UwbStatus to the corresponding UCI status code.
+ *
+ * @param uwbStatus The status to convert.
+ * @return constexpr StatusCode
+ */
+constexpr StatusCode
+ToStatusCode(const UwbStatus& uwbStatus) noexcept
+{
+    if (const auto* status = std::get_if<UwbStatusSession>(&uwbStatus)) {
+        return static_cast<StatusCode>(static_cast<uint8_t>(StatusCode::UwbSessionNotExist) + static_cast<uint8_t>(*status));
+    }
+    if (const auto* status = std::get_if<UwbStatusRanging>(&uwbStatus)) {
+        return static_cast<StatusCode>(static_cast<uint8_t>(StatusCode::RangingTxFailed) + static_cast<uint8_t>(*status));
+    }
+
+    return static_cast<StatusCode>(std::get<UwbStatusGeneric>(uwbStatus));
+}
+
 } // namespace uwb::protocol::fira::uci
 
 #endif // FIRA_UCI_STATUS_CODES_HXX
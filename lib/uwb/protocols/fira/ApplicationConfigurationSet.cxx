@@ -0,0 +1,294 @@
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <uwb/protocols/fira/ApplicationConfigurationSet.hxx>
+
+using namespace uwb::protocol::fira;
+
+namespace detail
+{
+/**
+ * @brief Assign a scalar value held in a slot to the specified variant
+ * alternative. Does nothing for non-scalar alternatives.
+ *
+ * @tparam Index The index of the variant alternative.
+ * @param value The value to assign to.
+ * @param scalar The scalar value from the slot.
+ */
+template <std::size_t Index>
+void
+AssignScalar(UwbApplicationConfigurationParameterValue& value, uint32_t scalar)
+{
+    using ValueT = std::variant_alternative_t<Index, UwbApplicationConfigurationParameterValue>;
+    if constexpr (std::is_integral_v<ValueT> || std::is_enum_v<ValueT>) {
+        value.emplace<Index>(static_cast<ValueT>(scalar));
+    }
+}
+
+/**
+ * @brief Make a variant holding a scalar value held in a slot.
+ *
+ * @param index The index of the variant alternative.
+ * @param scalar The scalar value from the slot.
+ * @return UwbApplicationConfigurationParameterValue
+ */
+template <std::size_t... Indices>
+UwbApplicationConfigurationParameterValue
+MakeScalarValue(std::size_t index, uint32_t scalar, std::index_sequence<Indices...> /* indices */)
+{
+    UwbApplicationConfigurationParameterValue value{};
+    static_cast<void>(((index == Indices ? (AssignScalar<Indices>(value, scalar), true) : false) || ...));
+    return value;
+}
+
+/**
+ * @brief Order MAC addresses by type, then by value.
+ *
+ * @param lhs The left-hand address.
+ * @param rhs The right-hand address.
+ * @return true If lhs is ordered before rhs.
+ * @return false Otherwise.
+ */
+bool
+MacAddressLess(const uwb::UwbMacAddress& lhs, const uwb::UwbMacAddress& rhs) noexcept
+{
+    if (lhs.GetType() != rhs.GetType()) {
+        return lhs.GetType() < rhs.GetType();
+    }
+
+    const auto lhsValue = lhs.GetValue();
+    const auto rhsValue = rhs.GetValue();
+    return std::lexicographical_compare(std::cbegin(lhsValue), std::cend(lhsValue), std::cbegin(rhsValue), std::cend(rhsValue));
+}
+} // namespace detail
+
+ApplicationConfigurationSet::ApplicationConfigurationSet(std::span<const UwbApplicationConfigurationParameter> parameters)
+{
+    for (const auto& parameter : parameters) {
+        Set(parameter);
+    }
+}
+
+void
+ApplicationConfigurationSet::Set(const UwbApplicationConfigurationParameter& parameter)
+{
+    Set(parameter.Type, parameter.Value);
+}
+
+void
+ApplicationConfigurationSet::Set(UwbApplicationConfigurationParameterType type, const UwbApplicationConfigurationParameterValue& value)
+{
+    const auto slot = ToSlot(type);
+    if (slot >= NumParameterTypeSlots) {
+        throw std::invalid_argument("application configuration parameter type out of range");
+    }
+
+    // Each alternative is validated before the existing value is erased, so a
+    // failed update leaves the set unchanged.
+    std::visit([&](const auto& valueAlternative) {
+        using ValueT = std::decay_t<decltype(valueAlternative)>;
+        if constexpr (std::is_same_v<ValueT, std::unordered_set<ResultReportConfiguration>>) {
+            uint32_t mask = 0;
+            for (const auto resultReportConfiguration : valueAlternative) {
+                mask |= static_cast<uint32_t>(resultReportConfiguration);
+            }
+            Erase(type);
+            m_scalars[slot] = mask;
+        } else if constexpr (std::is_same_v<ValueT, std::unordered_set<::uwb::UwbMacAddress>>) {
+            if (type != UwbApplicationConfigurationParameterType::DestinationMacAddresses) {
+                throw std::invalid_argument("mac address list is only valid for the destination mac addresses parameter");
+            }
+            if (std::size(valueAlternative) > DestinationMacAddressesMaximum) {
+                throw std::length_error("too many destination mac addresses");
+            }
+            Erase(type);
+            // Sorting gives equal sets the same representation regardless of
+            // their iteration order.
+            const auto end = std::copy(std::cbegin(valueAlternative), std::cend(valueAlternative), std::begin(m_destinationMacAddresses));
+            std::sort(std::begin(m_destinationMacAddresses), end, ::detail::MacAddressLess);
+            m_numDestinationMacAddresses = static_cast<uint8_t>(std::size(valueAlternative));
+        } else if constexpr (std::is_same_v<ValueT, ::uwb::UwbMacAddress>) {
+            if (type == UwbApplicationConfigurationParameterType::DeviceMacAddress) {
+                Erase(type);
+                m_deviceMacAddress = valueAlternative;
+            } else if (type == UwbApplicationConfigurationParameterType::DestinationMacAddresses) {
+                Erase(type);
+                m_destinationMacAddresses[0] = valueAlternative;
+                m_numDestinationMacAddresses = 1;
+            } else {
+                throw std::invalid_argument("mac address is only valid for mac address parameters");
+            }
+        } else if constexpr (std::is_same_v<ValueT, StaticStsInitializationVector>) {
+            if (type != UwbApplicationConfigurationParameterType::StaticStsIv) {
+                throw std::invalid_argument("static sts initialization vector is only valid for the static sts iv parameter");
+            }
+            Erase(type);
+            m_staticStsInitializationVector = valueAlternative;
+        } else {
+            Erase(type);
+            m_scalars[slot] = static_cast<uint32_t>(valueAlternative);
+        }
+    },
+        value);
+
+    m_valueIndices[slot] = static_cast<uint8_t>(value.index());
+    m_presence.set(slot);
+}
+
+void
+ApplicationConfigurationSet::Erase(UwbApplicationConfigurationParameterType type) noexcept
+{
+    if (!Contains(type)) {
+        return;
+    }
+
+    const auto slot = ToSlot(type);
+    m_scalars[slot] = 0;
+    m_valueIndices[slot] = 0;
+    m_presence.reset(slot);
+
+    switch (type) {
+    case UwbApplicationConfigurationParameterType::DeviceMacAddress:
+        m_deviceMacAddress = {};
+        break;
+    case UwbApplicationConfigurationParameterType::DestinationMacAddresses:
+        ResetDestinationMacAddresses();
+        break;
+    case UwbApplicationConfigurationParameterType::StaticStsIv:
+        m_staticStsInitializationVector = {};
+        break;
+    default:
+        break;
+    }
+}
+
+void
+ApplicationConfigurationSet::Clear() noexcept
+{
+    *this = ApplicationConfigurationSet{};
+}
+
+void
+ApplicationConfigurationSet::ResetDestinationMacAddresses() noexcept
+{
+    std::fill_n(std::begin(m_destinationMacAddresses), m_numDestinationMacAddresses, ::uwb::UwbMacAddress{});
+    m_numDestinationMacAddresses = 0;
+}
+
+bool
+ApplicationConfigurationSet::Contains(UwbApplicationConfigurationParameterType type) const noexcept
+{
+    const auto slot = ToSlot(type);
+    return (slot < NumParameterTypeSlots) && m_presence.test(slot);
+}
+
+bool
+ApplicationConfigurationSet::IsValueEqual(const ApplicationConfigurationSet& other, UwbApplicationConfigurationParameterType type) const noexcept
+{
+    const bool contains = Contains(type);
+    if (contains != other.Contains(type)) {
+        return false;
+    } else if (!contains) {
+        return true;
+    }
+
+    const auto slot = ToSlot(type);
+    if (m_valueIndices[slot] != other.m_valueIndices[slot] || m_scalars[slot] != other.m_scalars[slot]) {
+        return false;
+    }
+
+    switch (type) {
+    case UwbApplicationConfigurationParameterType::DeviceMacAddress:
+        return m_deviceMacAddress == other.m_deviceMacAddress;
+    case UwbApplicationConfigurationParameterType::DestinationMacAddresses:
+        return std::ranges::equal(GetDestinationMacAddresses(), other.GetDestinationMacAddresses());
+    case UwbApplicationConfigurationParameterType::StaticStsIv:
+        return m_staticStsInitializationVector == other.m_staticStsInitializationVector;
+    default:
+        return true;
+    }
+}
+
+std::size_t
+ApplicationConfigurationSet::Size() const noexcept
+{
+    return m_presence.count();
+}
+
+bool
+ApplicationConfigurationSet::Empty() const noexcept
+{
+    return m_presence.none();
+}
+
+const std::bitset<ApplicationConfigurationSet::NumParameterTypeSlots>&
+ApplicationConfigurationSet::GetPresence() const noexcept
+{
+    return m_presence;
+}
+
+std::optional<UwbApplicationConfigurationParameterValue>
+ApplicationConfigurationSet::GetValue(UwbApplicationConfigurationParameterType type) const
+{
+    if (!Contains(type)) {
+        return std::nullopt;
+    }
+
+    const auto slot = ToSlot(type);
+    switch (m_valueIndices[slot]) {
+    case IndexResultReportConfigurations: {
+        std::unordered_set<ResultReportConfiguration> resultReportConfigurations;
+        for (uint32_t bit = 1; bit <= UINT8_MAX; bit <<= 1U) {
+            if ((m_scalars[slot] & bit) != 0) {
+                resultReportConfigurations.insert(static_cast<ResultReportConfiguration>(bit));
+            }
+        }
+        return resultReportConfigurations;
+    }
+    case IndexMacAddresses: {
+        const auto macAddresses = GetDestinationMacAddresses();
+        return std::unordered_set<::uwb::UwbMacAddress>(std::cbegin(macAddresses), std::cend(macAddresses));
+    }
+    case IndexMacAddress:
+        return *Get<::uwb::UwbMacAddress>(type);
+    case IndexStaticStsInitializationVector:
+        return m_staticStsInitializationVector;
+    default:
+        return ::detail::MakeScalarValue(m_valueIndices[slot], m_scalars[slot], std::make_index_sequence<std::variant_size_v<UwbApplicationConfigurationParameterValue>>{});
+    }
+}
+
+std::optional<uint8_t>
+ApplicationConfigurationSet::GetResultReportConfigurationMask() const noexcept
+{
+    const auto type = UwbApplicationConfigurationParameterType::ResultReportConfig;
+    if (!Contains(type) || m_valueIndices[ToSlot(type)] != IndexResultReportConfigurations) {
+        return std::nullopt;
+    }
+
+    return static_cast<uint8_t>(m_scalars[ToSlot(type)]);
+}
+
+std::span<const uwb::UwbMacAddress>
+ApplicationConfigurationSet::GetDestinationMacAddresses() const noexcept
+{
+    return { std::data(m_destinationMacAddresses), m_numDestinationMacAddresses };
+}
+
+std::vector<UwbApplicationConfigurationParameter>
+ApplicationConfigurationSet::ToParameters() const
+{
+    std::vector<UwbApplicationConfigurationParameter> parameters;
+    parameters.reserve(Size());
+    for (std::size_t slot = 0; slot < NumParameterTypeSlots; slot++) {
+        if (m_presence.test(slot)) {
+            const auto type = static_cast<UwbApplicationConfigurationParameterType>(slot);
+            parameters.push_back(UwbApplicationConfigurationParameter{ .Type = type, .Value = *GetValue(type) });
+        }
+    }
+
+    return parameters;
+}
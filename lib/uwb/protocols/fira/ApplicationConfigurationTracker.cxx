@@ -0,0 +1,155 @@
+
+#include <algorithm>
+#include <type_traits>
+#include <variant>
+
+#include <uwb/protocols/fira/ApplicationConfigurationTracker.hxx>
+#include <uwb/protocols/fira/uci/ControlPacket.hxx>
+
+using namespace uwb::protocol::fira;
+
+namespace detail
+{
+/**
+ * @brief The size of the fixed part of the SESSION_SET_APP_CONFIG command
+ * payload: the session id and the number of parameters.
+ */
+constexpr std::size_t SetApplicationConfigurationPayloadHeaderSize = 5;
+
+/**
+ * @brief The size of the tag and length preceding each parameter value.
+ */
+constexpr std::size_t ParameterHeaderSize = 2;
+
+/**
+ * @brief Get the encoded size of a parameter value.
+ *
+ * @param value The parameter value.
+ * @return std::size_t
+ */
+std::size_t
+GetEncodedValueSize(const UwbApplicationConfigurationParameterValue& value)
+{
+    return std::visit([](const auto& valueAlternative) -> std::size_t {
+        using ValueT = std::decay_t<decltype(valueAlternative)>;
+        if constexpr (std::is_same_v<ValueT, std::unordered_set<::uwb::UwbMacAddress>>) {
+            std::size_t size = 0;
+            for (const auto& macAddress : valueAlternative) {
+                size += std::size(macAddress.GetValue());
+            }
+            return size;
+        } else if constexpr (std::is_same_v<ValueT, ::uwb::UwbMacAddress>) {
+            return std::size(valueAlternative.GetValue());
+        } else if constexpr (std::is_same_v<ValueT, StaticStsInitializationVector>) {
+            return std::size(valueAlternative);
+        } else if constexpr (std::is_integral_v<ValueT>) {
+            return sizeof(ValueT);
+        } else {
+            // Enumerations and the result report configuration bitmask.
+            return 1;
+        }
+    },
+        value);
+}
+
+/**
+ * @brief Get the cost of applying the specified parameters.
+ *
+ * @param parameters The parameters to apply.
+ * @param isSessionActive Whether the session is currently ranging.
+ * @param numCommands Receives the number of commands.
+ * @param numBytes Receives the encoded size of the commands.
+ * @return true If the session must be restarted to apply the parameters.
+ * @return false Otherwise.
+ */
+bool
+GetCost(const std::vector<UwbApplicationConfigurationParameter>& parameters, bool isSessionActive, std::size_t& numCommands, std::size_t& numBytes)
+{
+    if (std::empty(parameters)) {
+        numCommands = 0;
+        numBytes = 0;
+        return false;
+    }
+
+    const bool requiresRestart = isSessionActive && !std::ranges::all_of(parameters, [](const auto& parameter) {
+        return IsApplicationConfigurationChangeableWhileActive(parameter);
+    });
+
+    numCommands = 1;
+    numBytes = ApplicationConfigurationTracker::GetSetApplicationConfigurationCommandSize(parameters);
+    if (requiresRestart) {
+        numCommands += 2;
+        numBytes += 2 * ApplicationConfigurationTracker::SessionControlCommandSize;
+    }
+
+    return requiresRestart;
+}
+} // namespace detail
+
+bool
+ApplicationConfigurationUpdatePlan::IsEmpty() const noexcept
+{
+    return std::empty(Parameters);
+}
+
+/* static */
+std::size_t
+ApplicationConfigurationTracker::GetSetApplicationConfigurationCommandSize(const std::vector<UwbApplicationConfigurationParameter>& parameters)
+{
+    std::size_t payloadSize = ::detail::SetApplicationConfigurationPayloadHeaderSize;
+    for (const auto& parameter : parameters) {
+        payloadSize += ::detail::ParameterHeaderSize + ::detail::GetEncodedValueSize(parameter.Value);
+    }
+
+    const auto numPackets = (payloadSize + uci::ControlPacket::PayloadSizeMaximum - 1) / uci::ControlPacket::PayloadSizeMaximum;
+    return (numPackets * uci::ControlPacket::HeaderSize) + payloadSize;
+}
+
+ApplicationConfigurationUpdatePlan
+ApplicationConfigurationTracker::Plan(const ApplicationConfigurationSet& desired, bool isSessionActive) const
+{
+    ApplicationConfigurationUpdatePlan plan{};
+
+    const auto parametersDesired = desired.ToParameters();
+    for (const auto& parameter : parametersDesired) {
+        if (!desired.IsValueEqual(m_applied, parameter.Type)) {
+            plan.Parameters.push_back(parameter);
+        }
+    }
+
+    plan.RequiresRestart = ::detail::GetCost(plan.Parameters, isSessionActive, plan.NumCommands, plan.NumBytes);
+    ::detail::GetCost(parametersDesired, isSessionActive, plan.NumCommandsFull, plan.NumBytesFull);
+
+    return plan;
+}
+
+void
+ApplicationConfigurationTracker::Commit(const ApplicationConfigurationUpdatePlan& plan)
+{
+    for (const auto& parameter : plan.Parameters) {
+        m_applied.Set(parameter);
+    }
+
+    m_metrics.NumCommandsSent += plan.NumCommands;
+    m_metrics.NumCommandsSaved += plan.NumCommandsFull - plan.NumCommands;
+    m_metrics.NumBytesSent += plan.NumBytes;
+    m_metrics.NumBytesSaved += plan.NumBytesFull - plan.NumBytes;
+}
+
+void
+ApplicationConfigurationTracker::Reset() noexcept
+{
+    m_applied.Clear();
+}
+
+const ApplicationConfigurationSet&
+ApplicationConfigurationTracker::GetApplied() const noexcept
+{
+    return m_applied;
+}
+
+const ApplicationConfigurationMetrics&
+ApplicationConfigurationTracker::GetMetrics() const noexcept
+{
+    return m_metrics;
+}
@@ -3,6 +3,7 @@
 
 #include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <string_view>
 #include <typeindex>
 #include <typeinfo>
@@ -11,6 +12,13 @@
 #include <magic_enum.hpp>
 #include <notstd/tostring.hxx>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
 using namespace uwb::protocol::fira;
 using namespace strings::ostream_operators;
 
@@ -69,25 +77,241 @@ uwb::protocol::fira::StringToVersion(const std::string& input) noexcept
     return (first_byte << 8) | second_byte;
 }
 
-double
-uwb::protocol::fira::ConvertQ97FormatToIEEE(uint16_t q97)
+namespace detail
+{
+/**
+ * @brief Converts a sequence of Q9.7-formatted values one at a time.
+ *
+ * @tparam FloatT The floating point output type.
+ * @param q97 The values in Q9.7 format.
+ * @param values The output values, holding at least as many elements as q97.
+ */
+template <typename FloatT>
+void
+ConvertQ97FormatToIEEEScalar(std::span<const uint16_t> q97, std::span<FloatT> values) noexcept
+{
+    for (std::size_t i = 0; i < std::size(q97); i++) {
+        values[i] = static_cast<FloatT>(uwb::protocol::fira::ConvertQ97FormatToIEEE(q97[i]));
+    }
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define UWB_FIRA_Q97_X86_64
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UWB_FIRA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define UWB_FIRA_TARGET_AVX2
+#endif
+
+/**
+ * @brief The number of Q9.7 values converted per vector iteration.
+ */
+constexpr std::size_t Q97VectorWidth = 8;
+
+/**
+ * @brief Splits 8 Q9.7 values into their magnitudes in units of 2^-7 and their
+ * sign bits, matching the integer part handling of the scalar conversion.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param magnitude Receives the non-negative magnitudes, as 16-bit integers.
+ * @param sign Receives the sign bits, in bit 15 of each 16-bit lane.
+ */
+inline void
+SplitQ97Format(__m128i q97, __m128i& magnitude, __m128i& sign) noexcept
+{
+    const __m128i integerMask = _mm_set1_epi16(0x00FF);
+    const __m128i fractionMask = _mm_set1_epi16(0x007F);
+    const __m128i isNegative = _mm_srai_epi16(q97, 15);
+
+    const __m128i integerPart = _mm_and_si128(_mm_srli_epi16(q97, 7), integerMask);
+    const __m128i integerPartNegated = _mm_and_si128(_mm_sub_epi16(_mm_setzero_si128(), integerPart), integerMask);
+    const __m128i integerPartUnsigned = _mm_or_si128(_mm_and_si128(isNegative, integerPartNegated), _mm_andnot_si128(isNegative, integerPart));
+
+    magnitude = _mm_or_si128(_mm_slli_epi16(integerPartUnsigned, 7), _mm_and_si128(q97, fractionMask));
+    sign = _mm_slli_epi16(isNegative, 15);
+}
+
+/**
+ * @brief Converts 4 split Q9.7 values to double precision and stores them.
+ *
+ * @param magnitudes The magnitudes in units of 2^-7, as 32-bit integers.
+ * @param signs The sign bits, in bit 31 of each 32-bit lane.
+ * @param values The destination for the 4 converted values.
+ */
+inline void
+StoreQ97FormatAsIEEESse2(__m128i magnitudes, __m128i signs, double* values) noexcept
+{
+    const __m128d scale = _mm_set1_pd(1.0 / 128.0);
+    const __m128i zero = _mm_setzero_si128();
+
+    // Move the sign from bit 31 of each 32-bit lane to bit 63 of each 64-bit lane.
+    const __m128d low = _mm_mul_pd(_mm_cvtepi32_pd(magnitudes), scale);
+    const __m128d high = _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(magnitudes, 8)), scale);
+    _mm_storeu_pd(values, _mm_or_pd(low, _mm_castsi128_pd(_mm_unpacklo_epi32(zero, signs))));
+    _mm_storeu_pd(values + 2, _mm_or_pd(high, _mm_castsi128_pd(_mm_unpackhi_epi32(zero, signs))));
+}
+
+/**
+ * @brief Converts a sequence of Q9.7-formatted values to double precision using
+ * SSE2 instructions.
+ */
+void
+ConvertQ97FormatToIEEESse2(std::span<const uint16_t> q97, std::span<double> values) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + Q97VectorWidth <= std::size(q97); i += Q97VectorWidth) {
+        __m128i magnitude;
+        __m128i sign;
+        SplitQ97Format(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&q97[i])), magnitude, sign);
+
+        StoreQ97FormatAsIEEESse2(_mm_unpacklo_epi16(magnitude, zero), _mm_unpacklo_epi16(zero, sign), &values[i]);
+        StoreQ97FormatAsIEEESse2(_mm_unpackhi_epi16(magnitude, zero), _mm_unpackhi_epi16(zero, sign), &values[i + 4]);
+    }
+
+    ConvertQ97FormatToIEEEScalar(q97.subspan(i), values.subspan(i));
+}
+
+/**
+ * @brief Converts a sequence of Q9.7-formatted values to single precision using
+ * SSE2 instructions.
+ */
+void
+ConvertQ97FormatToIEEESse2(std::span<const uint16_t> q97, std::span<float> values) noexcept
 {
-    static const double pow2 = std::pow(2, -7);
-    static const uint16_t signMask = 0b1000'0000'0000'0000U;
-    static const uint16_t unsignedIntegerMask = 0b0111'1111'1000'0000U;
-    static const uint16_t fractionMask = ~(signMask | unsignedIntegerMask);
+    const __m128 scale = _mm_set1_ps(1.0F / 128.0F);
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + Q97VectorWidth <= std::size(q97); i += Q97VectorWidth) {
+        __m128i magnitude;
+        __m128i sign;
+        SplitQ97Format(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&q97[i])), magnitude, sign);
+
+        const __m128 low = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(magnitude, zero)), scale);
+        const __m128 high = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(magnitude, zero)), scale);
+        _mm_storeu_ps(&values[i], _mm_or_ps(low, _mm_castsi128_ps(_mm_unpacklo_epi16(zero, sign))));
+        _mm_storeu_ps(&values[i + 4], _mm_or_ps(high, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, sign))));
+    }
 
-    bool sign = q97 & signMask;
-    uint16_t unsignedIntegerPart = (q97 & unsignedIntegerMask) >> 7U;
-    uint16_t fractionPart = q97 & fractionMask;
+    ConvertQ97FormatToIEEEScalar(q97.subspan(i), values.subspan(i));
+}
 
-    if (sign) {
-        unsignedIntegerPart = (~unsignedIntegerPart + 1U) & 0x00FF;
+/**
+ * @brief Converts a sequence of Q9.7-formatted values to double precision using
+ * AVX2 instructions.
+ */
+UWB_FIRA_TARGET_AVX2 void
+ConvertQ97FormatToIEEEAvx2(std::span<const uint16_t> q97, std::span<double> values) noexcept
+{
+    const __m256d scale = _mm256_set1_pd(1.0 / 128.0);
+
+    std::size_t i = 0;
+    for (; i + Q97VectorWidth <= std::size(q97); i += Q97VectorWidth) {
+        __m128i magnitude;
+        __m128i sign;
+        SplitQ97Format(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&q97[i])), magnitude, sign);
+
+        const __m256i magnitudes = _mm256_cvtepu16_epi32(magnitude);
+        const __m256d low = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(magnitudes)), scale);
+        const __m256d high = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(magnitudes, 1)), scale);
+        const __m256i signLow = _mm256_slli_epi64(_mm256_cvtepu16_epi64(sign), 48);
+        const __m256i signHigh = _mm256_slli_epi64(_mm256_cvtepu16_epi64(_mm_srli_si128(sign, 8)), 48);
+        _mm256_storeu_pd(&values[i], _mm256_or_pd(low, _mm256_castsi256_pd(signLow)));
+        _mm256_storeu_pd(&values[i + 4], _mm256_or_pd(high, _mm256_castsi256_pd(signHigh)));
     }
 
-    double unsignedNumber = static_cast<double>(unsignedIntegerPart + (fractionPart * pow2));
+    ConvertQ97FormatToIEEEScalar(q97.subspan(i), values.subspan(i));
+}
 
-    return (sign ? -1 : 1) * unsignedNumber;
+/**
+ * @brief Converts a sequence of Q9.7-formatted values to single precision using
+ * AVX2 instructions.
+ */
+UWB_FIRA_TARGET_AVX2 void
+ConvertQ97FormatToIEEEAvx2(std::span<const uint16_t> q97, std::span<float> values) noexcept
+{
+    const __m256 scale = _mm256_set1_ps(1.0F / 128.0F);
+
+    std::size_t i = 0;
+    for (; i + Q97VectorWidth <= std::size(q97); i += Q97VectorWidth) {
+        __m128i magnitude;
+        __m128i sign;
+        SplitQ97Format(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&q97[i])), magnitude, sign);
+
+        const __m256 value = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(magnitude)), scale);
+        const __m256i signs = _mm256_slli_epi32(_mm256_cvtepu16_epi32(sign), 16);
+        _mm256_storeu_ps(&values[i], _mm256_or_ps(value, _mm256_castsi256_ps(signs)));
+    }
+
+    ConvertQ97FormatToIEEEScalar(q97.subspan(i), values.subspan(i));
+}
+
+/**
+ * @brief Determines whether the processor and operating system support AVX2.
+ *
+ * @return true If AVX2 instructions may be used.
+ * @return false Otherwise.
+ */
+bool
+IsAvx2Supported() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    constexpr int OsXsaveBit = 1 << 27;
+    constexpr int Avx2Bit = 1 << 5;
+    constexpr unsigned long long XmmYmmStateMask = 0x6;
+
+    std::array<int, 4> info{};
+    __cpuid(info.data(), 1);
+    if ((info[2] & OsXsaveBit) == 0 || (_xgetbv(0) & XmmYmmStateMask) != XmmYmmStateMask) {
+        return false;
+    }
+    __cpuidex(info.data(), 7, 0);
+    return (info[1] & Avx2Bit) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif // defined(__x86_64__) || defined(_M_X64)
+
+/**
+ * @brief Converts a sequence of Q9.7-formatted values with the best kernel
+ * supported by the processor.
+ *
+ * @tparam FloatT The floating point output type.
+ * @param q97 The values in Q9.7 format.
+ * @param values The output values.
+ */
+template <typename FloatT>
+void
+ConvertQ97FormatToIEEEBatch(std::span<const uint16_t> q97, std::span<FloatT> values)
+{
+    if (std::size(values) < std::size(q97)) {
+        throw std::invalid_argument("output is smaller than the Q9.7 input");
+    }
+
+#ifdef UWB_FIRA_Q97_X86_64
+    using ConvertFunction = void (*)(std::span<const uint16_t>, std::span<FloatT>) noexcept;
+    static const ConvertFunction convert = IsAvx2Supported() ? static_cast<ConvertFunction>(ConvertQ97FormatToIEEEAvx2) : static_cast<ConvertFunction>(ConvertQ97FormatToIEEESse2);
+    convert(q97, values);
+#else
+    ConvertQ97FormatToIEEEScalar(q97, values);
+#endif
+}
+} // namespace detail
+
+void
+uwb::protocol::fira::ConvertQ97FormatToIEEE(std::span<const uint16_t> q97, std::span<double> values)
+{
+    ::detail::ConvertQ97FormatToIEEEBatch(q97, values);
+}
+
+void
+uwb::protocol::fira::ConvertQ97FormatToIEEE(std::span<const uint16_t> q97, std::span<float> values)
+{
+    ::detail::ConvertQ97FormatToIEEEBatch(q97, values);
 }
 
 std::string
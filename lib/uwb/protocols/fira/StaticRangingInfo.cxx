@@ -1,15 +1,9 @@
 
-#include <algorithm>
-#include <array>
-#include <cstring>
 #include <iomanip>
 #include <sstream>
-#include <unordered_set>
-#include <vector>
 
-#include <magic_enum.hpp>
 #include <notstd/utility.hxx>
-#include <tlv/TlvSerialize.hxx>
+#include <tlv/TlvSchema.hxx>
 #include <uwb/protocols/fira/StaticRangingInfo.hxx>
 #include <uwb/protocols/fira/UwbException.hxx>
 
@@ -29,84 +23,56 @@ StaticRangingInfo::ToString() const
     return staticRangingInfoString.str();
 }
 
-std::unique_ptr<encoding::TlvBer>
-StaticRangingInfo::ToDataObject() const
+namespace detail
+{
+using encoding::schema::Field, encoding::schema::FixedOctets, encoding::schema::Schema, encoding::schema::UnsignedBigEndian;
+
+/**
+ * @brief Schema of the StaticRangingInfo data object.
+ */
+using StaticRangingInfoSchema = Schema<StaticRangingInfo::Tag,
+    // VENDOR_ID
+    Field<notstd::to_underlying(StaticRangingInfo::ParameterTag::VendorId), &StaticRangingInfo::VendorId, UnsignedBigEndian<uint16_t>>,
+    // STATIC_STS_IV
+    Field<notstd::to_underlying(StaticRangingInfo::ParameterTag::StaticStsIv), &StaticRangingInfo::InitializationVector, FixedOctets<StaticRangingInfo::InitializationVectorLength>>>;
+
+/**
+ * @brief Decodes a StaticRangingInfo object from either an owning TlvBer or a
+ * non-owning TlvBerView.
+ *
+ * @tparam TlvT The type of tlv to decode from.
+ * @param tlvBer
+ * @return StaticRangingInfo
+ */
+template <typename TlvT>
+StaticRangingInfo
+FromDataObject(const TlvT& tlvBer)
 {
-    using encoding::TlvBer, encoding::GetBytesBigEndianFromBitMap;
+    StaticRangingInfo staticRangingInfo{};
+    if (!StaticRangingInfoSchema::Decode(tlvBer, staticRangingInfo)) {
+        throw UwbException(UwbStatusGeneric::SyntaxError);
+    }
 
-    auto tlvBerResult = std::make_unique<TlvBer>();
-    *tlvBerResult = TlvBer::Builder()
-        .SetTag(Tag)
-        // VENDOR_ID
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::VendorId))
-                .SetValue(GetBytesBigEndianFromBitMap(VendorId, sizeof VendorId))
-                .Build())
-        // STATIC_STS_IV 
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::StaticStsIv))
-                .SetValue(InitializationVector)
-                .Build())
-        .Build();
+    return staticRangingInfo;
+}
+} // namespace detail
 
-    return tlvBerResult;
+std::unique_ptr<encoding::TlvBer>
+StaticRangingInfo::ToDataObject() const
+{
+    return std::make_unique<encoding::TlvBer>(::detail::StaticRangingInfoSchema::Encode(*this));
 }
 
 /* static */
 StaticRangingInfo
 StaticRangingInfo::FromDataObject(const encoding::TlvBer& tlvBer)
 {
-    using encoding::ReadSizeTFromBytesBigEndian;
-
-    StaticRangingInfo staticRangingInfo{};
-    std::unordered_set<ParameterTag> parameterTagsDecoded{};
-    std::vector<encoding::TlvBer> tlvBerValues = tlvBer.GetValues();
-
-    for (const auto &tlvBerValue : tlvBerValues) {
-        auto tagValue = tlvBerValue.GetTag();
-        // All tags for StaticRangingInfo are 1-byte long, so ignore all others.
-        if (std::size(tagValue) != 1) {
-            continue;
-        }
-
-        // Ensure the tag has a corresponding enumeration value.
-        auto parameterTag = magic_enum::enum_cast<ParameterTag>(tagValue.front());
-        if (!parameterTag.has_value()) {
-            continue;
-        }
-
-        // Ensure all values have non-zero payload.
-        bool parameterValueWasDecoded = true;
-        auto& parameterValue = tlvBerValue.GetValue();
-        if (std::empty(parameterValue)) {
-            continue;
-        }
-
-        switch (*parameterTag) {
-        case ParameterTag::VendorId: {
-            staticRangingInfo.VendorId = ReadSizeTFromBytesBigEndian<decltype(staticRangingInfo.VendorId)>(parameterValue);
-            break;
-        }
-        case ParameterTag::StaticStsIv: {
-            std::memcpy(std::data(staticRangingInfo.InitializationVector), std::data(parameterValue), std::min(std::size(parameterValue), std::size(staticRangingInfo.InitializationVector)));
-            break;
-        }
-        default: {
-            parameterValueWasDecoded = false;
-            break;
-        }
-        }
-
-        if (parameterValueWasDecoded) {
-            parameterTagsDecoded.insert(*parameterTag);
-        }
-    }
-
-    if (std::size(parameterTagsDecoded) < magic_enum::enum_count<ParameterTag>()) {
-        throw UwbException(UwbStatusGeneric::SyntaxError);
-    }
+    return ::detail::FromDataObject(tlvBer);
+}
 
-    return staticRangingInfo;
+/* static */
+StaticRangingInfo
+StaticRangingInfo::FromDataObject(const encoding::TlvBerView& tlvBer)
+{
+    return ::detail::FromDataObject(tlvBer);
 }
@@ -1,15 +1,21 @@
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <span>
 #include <sstream>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <notstd/utility.hxx>
 
+#include <tlv/TlvSchema.hxx>
 #include <tlv/TlvSerialize.hxx>
 #include <tlv/TlvSimple.hxx>
 #include <uwb/protocols/fira/UwbCapability.hxx>
+#include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 
 using namespace uwb::protocol::fira;
 
@@ -21,129 +27,6 @@ const std::initializer_list<RangingMethod> UwbCapability::RangingMethodsDefault
     RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::NonDeferred },
 };
 
-const std::unordered_map<MultiNodeMode, std::size_t> UwbCapability::MultiNodeModeBit = {
-    { MultiNodeMode::Unicast, 0 },
-    { MultiNodeMode::OneToMany, 1 },
-    { MultiNodeMode::ManyToMany, 2 },
-};
-
-const std::unordered_map<DeviceRole, std::size_t> UwbCapability::DeviceRoleBit = {
-    { DeviceRole::Responder, 0 },
-    { DeviceRole::Initiator, 1 },
-};
-
-const std::unordered_map<StsConfiguration, std::size_t> UwbCapability::StsConfigurationBit = {
-    { StsConfiguration::Static, 0 },
-    { StsConfiguration::Dynamic, 1 },
-    { StsConfiguration::DynamicWithResponderSubSessionKey, 2 },
-};
-
-const std::unordered_map<StsPacketConfiguration, std::size_t> UwbCapability::RFrameConfigurationBit = {
-    { StsPacketConfiguration::SP0, 0 },
-    { StsPacketConfiguration::SP1, 1 },
-    { StsPacketConfiguration::SP3, 3 },
-};
-
-const std::unordered_map<AngleOfArrival, std::size_t> UwbCapability::AngleOfArrivalBit = {
-    { AngleOfArrival::Azimuth90, 0 },
-    { AngleOfArrival::Azimuth180, 1 },
-    { AngleOfArrival::Elevation, 2 },
-};
-
-const std::unordered_map<SchedulingMode, std::size_t> UwbCapability::SchedulingModeBit = {
-    { SchedulingMode::Contention, 0 },
-    { SchedulingMode::Time, 1 },
-};
-
-const std::unordered_map<RangingMode, std::size_t> UwbCapability::RangingModeBit = {
-    { RangingMode::Block, 0 },
-    { RangingMode::Interval, 1 },
-};
-
-const std::unordered_map<RangingMethod, std::size_t> UwbCapability::RangingMethodBit = {
-    { { RangingDirection::OneWay, MeasurementReportMode::None }, 0 },
-    { { RangingDirection::SingleSidedTwoWay, MeasurementReportMode::Deferred }, 1 },
-    { { RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::Deferred }, 2 },
-    { { RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred }, 3 },
-    { { RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::NonDeferred }, 4 },
-};
-
-const std::unordered_map<ConvolutionalCodeConstraintLength, std::size_t> UwbCapability::ConvolutionalCodeConstraintLengthsBit = {
-    { ConvolutionalCodeConstraintLength::K3, 0 },
-    { ConvolutionalCodeConstraintLength::K7, 1 },
-};
-
-const std::unordered_map<Channel, std::size_t> UwbCapability::ChannelsBit = {
-    { Channel::C5, 0 },
-    { Channel::C6, 1 },
-    { Channel::C8, 2 },
-    { Channel::C9, 3 },
-    { Channel::C10, 4 },
-    { Channel::C12, 5 },
-    { Channel::C13, 6 },
-    { Channel::C14, 7 },
-};
-
-const std::unordered_map<BprfParameter, std::size_t> UwbCapability::BprfParameterSetsBit = {
-    { BprfParameter::Set1, 0 },
-    { BprfParameter::Set2, 1 },
-    { BprfParameter::Set3, 2 },
-    { BprfParameter::Set4, 3 },
-    { BprfParameter::Set5, 4 },
-    { BprfParameter::Set6, 5 },
-};
-
-const std::unordered_map<HprfParameter, std::size_t> UwbCapability::HprfParameterSetsBit = {
-    { HprfParameter::Set1, 0 },
-    { HprfParameter::Set2, 1 },
-    { HprfParameter::Set3, 2 },
-    { HprfParameter::Set4, 3 },
-    { HprfParameter::Set5, 4 },
-    { HprfParameter::Set6, 5 },
-    { HprfParameter::Set7, 6 },
-    { HprfParameter::Set8, 7 },
-    { HprfParameter::Set9, 8 },
-    { HprfParameter::Set10, 9 },
-    { HprfParameter::Set11, 10 },
-    { HprfParameter::Set12, 11 },
-    { HprfParameter::Set13, 12 },
-    { HprfParameter::Set14, 13 },
-    { HprfParameter::Set15, 14 },
-    { HprfParameter::Set16, 15 },
-    { HprfParameter::Set17, 16 },
-    { HprfParameter::Set18, 17 },
-    { HprfParameter::Set19, 18 },
-    { HprfParameter::Set20, 19 },
-    { HprfParameter::Set21, 20 },
-    { HprfParameter::Set22, 21 },
-    { HprfParameter::Set23, 22 },
-    { HprfParameter::Set24, 23 },
-    { HprfParameter::Set25, 24 },
-    { HprfParameter::Set26, 25 },
-    { HprfParameter::Set27, 26 },
-    { HprfParameter::Set28, 27 },
-    { HprfParameter::Set29, 28 },
-    { HprfParameter::Set30, 29 },
-    { HprfParameter::Set31, 30 },
-    { HprfParameter::Set32, 31 },
-    { HprfParameter::Set33, 32 },
-    { HprfParameter::Set34, 33 },
-    { HprfParameter::Set35, 34 },
-};
-
-// TODO find a better place for this function
-template <class T>
-void
-ToOobDataObjectHelper(encoding::TlvBer::Builder& builder, encoding::TlvBer::Builder& childbuilder, uint8_t tag, const std::vector<T>& valueSet, const std::unordered_map<T, std::size_t>& bitIndexMap, std::size_t desiredLength)
-{
-    auto bytes = encoding::EncodeValuesAsBytes(valueSet, bitIndexMap, desiredLength);
-    auto tlv = childbuilder.Reset()
-                   .SetTag(tag)
-                   .SetValue(bytes)
-                   .Build();
-    builder.AddTlv(tlv);
-}
-
 std::string
 UwbCapability::ToString() const
 {
@@ -152,300 +35,394 @@ UwbCapability::ToString() const
     return ss.str();
 }
 
-std::unique_ptr<encoding::TlvBer>
-UwbCapability::ToOobDataObject() const
+namespace detail
 {
-    using encoding::GetBitMaskFromBitIndex, encoding::GetBytesBigEndianFromBitMap;
-
-    auto returnTlvBer = std::make_unique<encoding::TlvBer>();
-    auto builder = encoding::TlvBer::Builder();
-    builder.SetTag(UwbCapability::Tag);
-    auto childbuilder = encoding::TlvBer::Builder();
+using encoding::schema::Boolean, encoding::schema::FlagSetBitmap, encoding::schema::UnsignedBigEndian;
+
+/**
+ * @brief Applies another rule to a UWB capability parameter. Parameters are
+ * always encoded, but may be omitted from a data object, in which case they
+ * keep their default value. Decoding rejects values whose length differs from
+ * the encoded length.
+ *
+ * @tparam RuleT The rule used to encode the parameter.
+ */
+template <typename RuleT>
+struct CapabilityParameter
+{
+    static constexpr std::size_t BufferSize = RuleT::BufferSize;
 
-    // Encode FiraPhyVersionRange
+    template <typename T>
+    static bool
+    IsPresent(const T& /* value */) noexcept
     {
-        auto phyRange = GetBytesBigEndianFromBitMap(FiraPhyVersionRange, 4);
-        auto phyRangeTlv = childbuilder.Reset()
-                               .SetTag(notstd::to_underlying(ParameterTag::FiraPhyVersionRange))
-                               .SetValue(phyRange)
-                               .Build();
-        builder.AddTlv(phyRangeTlv);
+        return true;
     }
 
+    template <typename T>
+    static std::span<const uint8_t>
+    Encode(const T& value, std::span<uint8_t, BufferSize> buffer)
     {
-        auto macRange = GetBytesBigEndianFromBitMap(FiraMacVersionRange, 4);
-        auto macRangeTlv = childbuilder.Reset()
-                               .SetTag(notstd::to_underlying(ParameterTag::FiraMacVersionRange))
-                               .SetValue(macRange)
-                               .Build();
-        builder.AddTlv(macRangeTlv);
+        return RuleT::Encode(value, buffer);
     }
 
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::DeviceRoles), DeviceRoles, UwbCapability::DeviceRoleBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::RangingMethod), RangingMethods, UwbCapability::RangingMethodBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::StsConfig), StsConfigurations, UwbCapability::StsConfigurationBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::MultiNodeMode), MultiNodeModes, UwbCapability::MultiNodeModeBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::RangingMode), RangingTimeStructs, UwbCapability::RangingModeBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::ScheduledMode), SchedulingModes, UwbCapability::SchedulingModeBit, 1);
+    template <typename T>
+    static bool
+    Decode(std::span<const uint8_t> data, T& value)
     {
-        auto hoppingtlv = childbuilder.Reset()
-                              .SetTag(notstd::to_underlying(ParameterTag::HoppingMode))
-                              .SetValue(HoppingMode)
-                              .Build();
-        builder.AddTlv(hoppingtlv);
+        return std::size(data) == BufferSize && RuleT::Decode(data, value);
     }
+};
 
-    {
-        auto blocktlv = childbuilder.Reset()
-                            .SetTag(notstd::to_underlying(ParameterTag::BlockStriding))
-                            .SetValue(BlockStriding)
-                            .Build();
-        builder.AddTlv(blocktlv);
-    }
+/**
+ * @brief Encodes the supported angle of arrival types together with the
+ * figure of merit support bit as the single octet of the AOA_SUPPORT
+ * parameter.
+ */
+struct AngleOfArrivalSupport
+{
+    static constexpr std::size_t BufferSize = 1;
 
+    static std::span<const uint8_t>
+    Encode(const UwbCapability& value, std::span<uint8_t, BufferSize> buffer) noexcept
     {
-        auto uwbtlv = childbuilder.Reset()
-                          .SetTag(notstd::to_underlying(ParameterTag::UwbInitiationTime))
-                          .SetValue(UwbInitiationTime)
-                          .Build();
-        builder.AddTlv(uwbtlv);
-    }
+        auto aoaEncoded = value.AngleOfArrivalTypes.GetBits();
+        if (value.AngleOfArrivalFom) {
+            aoaEncoded |= uint64_t{ 1 } << UwbCapability::AngleOfArrivalFomBit;
+        }
 
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::Channels), Channels, UwbCapability::ChannelsBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::RFrameConfig), RFrameConfigurations, UwbCapability::RFrameConfigurationBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::CcConstraintLength), ConvolutionalCodeConstraintLengths, UwbCapability::ConvolutionalCodeConstraintLengthsBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::BprfParameterSets), BprfParameterSets, UwbCapability::BprfParameterSetsBit, 1);
-    ToOobDataObjectHelper(builder, childbuilder, notstd::to_underlying(ParameterTag::HprfParameterSets), HprfParameterSets, UwbCapability::HprfParameterSetsBit, 5);
+        encoding::WriteBytesBigEndian<BufferSize>(aoaEncoded, buffer);
+        return buffer;
+    }
 
+    static bool
+    Decode(std::span<const uint8_t> data, UwbCapability& value) noexcept
     {
-        std::size_t aoaEncoded = 0;
-        for (const auto& value : AngleOfArrivalTypes) {
-            auto bitIndex = AngleOfArrivalBit.at(value);
-            aoaEncoded |= GetBitMaskFromBitIndex(bitIndex);
-        }
-        if (AngleOfArrivalFom) {
-            aoaEncoded |= GetBitMaskFromBitIndex(UwbCapability::AngleOfArrivalFomBit);
+        if (std::size(data) != BufferSize) {
+            return false;
         }
 
-        auto aoaByte = GetBytesBigEndianFromBitMap(aoaEncoded, 1);
-        auto aoatlv = childbuilder.Reset()
-                          .SetTag(notstd::to_underlying(ParameterTag::AoaSupport))
-                          .SetValue(aoaByte)
-                          .Build();
-        builder.AddTlv(aoatlv);
+        const auto aoaEncoded = data.front();
+        value.AngleOfArrivalTypes = UwbCapability::AngleOfArrivalSet::FromBits(aoaEncoded);
+        value.AngleOfArrivalFom = (aoaEncoded & (1U << UwbCapability::AngleOfArrivalFomBit)) != 0;
+        return true;
     }
+};
 
-    {
-        auto mactlv = childbuilder.Reset()
-                          .SetTag(notstd::to_underlying(ParameterTag::ExtendedMacAddress))
-                          .SetValue(ExtendedMacAddress)
-                          .Build();
-        builder.AddTlv(mactlv);
+template <UwbCapability::ParameterTag Tag, auto Member, typename RuleT>
+using ParameterField = encoding::schema::Field<notstd::to_underlying(Tag), Member, CapabilityParameter<RuleT>>;
+
+template <UwbCapability::ParameterTag Tag, auto Member, const auto& BitIndexMapT>
+using FlagSetField = ParameterField<Tag, Member, FlagSetBitmap<BitIndexMapT>>;
+
+/**
+ * @brief Schema of the UWB capability data object. See FiRa Consortium Common
+ * Service Management Layer Technical Specification v1.0.0, Section 7.5.3.2,
+ * 'UWB Controlee Info', Table 52, pages 96-99.
+ */
+using UwbCapabilitySchema = encoding::schema::Schema<UwbCapability::Tag,
+    ParameterField<UwbCapability::ParameterTag::FiraPhyVersionRange, &UwbCapability::FiraPhyVersionRange, UnsignedBigEndian<uint32_t>>,
+    ParameterField<UwbCapability::ParameterTag::FiraMacVersionRange, &UwbCapability::FiraMacVersionRange, UnsignedBigEndian<uint32_t>>,
+    FlagSetField<UwbCapability::ParameterTag::DeviceRoles, &UwbCapability::DeviceRoles, UwbCapability::DeviceRoleBit>,
+    FlagSetField<UwbCapability::ParameterTag::RangingMethod, &UwbCapability::RangingMethods, UwbCapability::RangingMethodBit>,
+    FlagSetField<UwbCapability::ParameterTag::StsConfig, &UwbCapability::StsConfigurations, UwbCapability::StsConfigurationBit>,
+    FlagSetField<UwbCapability::ParameterTag::MultiNodeMode, &UwbCapability::MultiNodeModes, UwbCapability::MultiNodeModeBit>,
+    FlagSetField<UwbCapability::ParameterTag::RangingMode, &UwbCapability::RangingTimeStructs, UwbCapability::RangingModeBit>,
+    FlagSetField<UwbCapability::ParameterTag::ScheduledMode, &UwbCapability::SchedulingModes, UwbCapability::SchedulingModeBit>,
+    ParameterField<UwbCapability::ParameterTag::HoppingMode, &UwbCapability::HoppingMode, Boolean>,
+    ParameterField<UwbCapability::ParameterTag::BlockStriding, &UwbCapability::BlockStriding, Boolean>,
+    ParameterField<UwbCapability::ParameterTag::UwbInitiationTime, &UwbCapability::UwbInitiationTime, Boolean>,
+    FlagSetField<UwbCapability::ParameterTag::Channels, &UwbCapability::Channels, UwbCapability::ChannelsBit>,
+    FlagSetField<UwbCapability::ParameterTag::RFrameConfig, &UwbCapability::RFrameConfigurations, UwbCapability::RFrameConfigurationBit>,
+    FlagSetField<UwbCapability::ParameterTag::CcConstraintLength, &UwbCapability::ConvolutionalCodeConstraintLengths, UwbCapability::ConvolutionalCodeConstraintLengthsBit>,
+    FlagSetField<UwbCapability::ParameterTag::BprfParameterSets, &UwbCapability::BprfParameterSets, UwbCapability::BprfParameterSetsBit>,
+    FlagSetField<UwbCapability::ParameterTag::HprfParameterSets, &UwbCapability::HprfParameterSets, UwbCapability::HprfParameterSetsBit>,
+    encoding::schema::ObjectField<notstd::to_underlying(UwbCapability::ParameterTag::AoaSupport), UwbCapability, CapabilityParameter<AngleOfArrivalSupport>>,
+    ParameterField<UwbCapability::ParameterTag::ExtendedMacAddress, &UwbCapability::ExtendedMacAddress, Boolean>>;
+
+/**
+ * @brief Decodes a UwbCapability object from either an owning TlvBer or a
+ * non-owning TlvBerView.
+ *
+ * @tparam TlvT The type of tlv to decode from.
+ * @param tlv
+ * @return UwbCapability
+ */
+template <typename TlvT>
+UwbCapability
+FromOobDataObject(const TlvT& tlv)
+{
+    if (tlv.GetTag().size() != 1 || tlv.GetTag()[0] != UwbCapability::Tag) {
+        throw UwbCapability::IncorrectTlvTag();
+    }
+
+    // Every rule only rejects values with an unexpected length.
+    UwbCapability uwbCapability;
+    if (!UwbCapabilitySchema::Decode(tlv, uwbCapability)) {
+        throw UwbCapability::IncorrectNumberOfBytesInValueError();
     }
 
-    *returnTlvBer = builder.Build();
-    return returnTlvBer;
+    return uwbCapability;
+}
+} // namespace detail
+
+std::unique_ptr<encoding::TlvBer>
+UwbCapability::ToOobDataObject() const
+{
+    return std::make_unique<encoding::TlvBer>(::detail::UwbCapabilitySchema::Encode(*this));
 }
 
 /* static */
 UwbCapability
 UwbCapability::FromOobDataObject(const encoding::TlvBer& tlv)
 {
-    using encoding::ReadSizeTFromBytesBigEndian, encoding::AssignValuesFromBytes, encoding::GetBitMaskFromBitIndex;
+    return ::detail::FromOobDataObject(tlv);
+}
 
-    UwbCapability uwbCapability;
-    if (tlv.GetTag().size() != 1 || tlv.GetTag()[0] != UwbCapability::Tag) {
-        throw UwbCapability::IncorrectTlvTag();
-    }
-    for (const auto& object : tlv.GetValues()) {
-        if (object.GetTag().size() != 1) {
-            throw UwbCapability::IncorrectNumberOfBytesInTagError();
-        }
-        switch (ParameterTag(object.GetTag()[0])) {
-        case ParameterTag::FiraPhyVersionRange: {
-            if (object.GetValue().size() != 4) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.FiraPhyVersionRange = ReadSizeTFromBytesBigEndian<uint32_t>(object.GetValue()); // TODO verify that the bytes are indeed big endian
-            break;
-        }
-        case ParameterTag::FiraMacVersionRange: {
-            if (object.GetValue().size() != 4) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.FiraMacVersionRange = ReadSizeTFromBytesBigEndian<uint32_t>(object.GetValue());
-            break;
-        }
-        case ParameterTag::DeviceRoles: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.DeviceRoles = AssignValuesFromBytes(UwbCapability::DeviceRoleBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::RangingMethod: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.RangingMethods = AssignValuesFromBytes(UwbCapability::RangingMethodBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::StsConfig: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.StsConfigurations = AssignValuesFromBytes(UwbCapability::StsConfigurationBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::MultiNodeMode: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.MultiNodeModes = AssignValuesFromBytes(UwbCapability::MultiNodeModeBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::RangingMode: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.RangingTimeStructs = AssignValuesFromBytes(UwbCapability::RangingModeBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::ScheduledMode: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.SchedulingModes = AssignValuesFromBytes(UwbCapability::SchedulingModeBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::HoppingMode: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.HoppingMode = object.GetValue()[0];
-            break;
-        }
-        case ParameterTag::BlockStriding: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.BlockStriding = object.GetValue()[0];
-            break;
-        }
-        case ParameterTag::UwbInitiationTime: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.UwbInitiationTime = object.GetValue()[0];
-            break;
-        }
-        case ParameterTag::Channels: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.Channels = AssignValuesFromBytes(UwbCapability::ChannelsBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::RFrameConfig: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.RFrameConfigurations = AssignValuesFromBytes(UwbCapability::RFrameConfigurationBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::CcConstraintLength: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.ConvolutionalCodeConstraintLengths = AssignValuesFromBytes(UwbCapability::ConvolutionalCodeConstraintLengthsBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::BprfParameterSets: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.BprfParameterSets = AssignValuesFromBytes(UwbCapability::BprfParameterSetsBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::HprfParameterSets: {
-            if (object.GetValue().size() != 5) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.HprfParameterSets = AssignValuesFromBytes(UwbCapability::HprfParameterSetsBit, object.GetValue());
-            break;
-        }
-        case ParameterTag::AoaSupport: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-
-            uwbCapability.AngleOfArrivalTypes = AssignValuesFromBytes(UwbCapability::AngleOfArrivalBit, object.GetValue());
-            uwbCapability.AngleOfArrivalFom = (object.GetValue()[0] & GetBitMaskFromBitIndex(UwbCapability::AngleOfArrivalFomBit));
-            break;
-        }
-        case ParameterTag::ExtendedMacAddress: {
-            if (object.GetValue().size() != 1) {
-                throw UwbCapability::IncorrectNumberOfBytesInValueError();
-            }
-            uwbCapability.ExtendedMacAddress = object.GetValue()[0];
-            break;
-        }
+/* static */
+UwbCapability
+UwbCapability::FromOobDataObject(const encoding::TlvBerView& tlv)
+{
+    return ::detail::FromOobDataObject(tlv);
+}
+
+namespace detail
+{
+/**
+ * @brief Values in order of preference when negotiating a configuration. The
+ * first of each is the FiRa default.
+ */
+constexpr std::array RangingMethodPreference{
+    RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::Deferred },
+    RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::NonDeferred },
+    RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::Deferred },
+    RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred },
+    RangingMethod{ RangingDirection::OneWay, MeasurementReportMode::None },
+};
+constexpr std::array StsConfigurationPreference{ StsConfiguration::Static, StsConfiguration::Dynamic, StsConfiguration::DynamicWithResponderSubSessionKey };
+constexpr std::array MultiNodeModePreference{ MultiNodeMode::Unicast, MultiNodeMode::OneToMany, MultiNodeMode::ManyToMany };
+constexpr std::array RangingModePreference{ RangingMode::Block, RangingMode::Interval };
+constexpr std::array SchedulingModePreference{ SchedulingMode::Time, SchedulingMode::Contention };
+constexpr std::array ChannelPreference{ Channel::C9, Channel::C5, Channel::C6, Channel::C8, Channel::C10, Channel::C12, Channel::C13, Channel::C14 };
+constexpr std::array RFrameConfigurationPreference{ StsPacketConfiguration::SP3, StsPacketConfiguration::SP1, StsPacketConfiguration::SP0 };
+constexpr std::array ConvolutionalCodeConstraintLengthPreference{ ConvolutionalCodeConstraintLength::K3, ConvolutionalCodeConstraintLength::K7 };
+
+/**
+ * @brief Select the most preferred value held in a set.
+ *
+ * @tparam FlagSetT The type of set.
+ * @tparam NumPreferences The number of preferred values.
+ * @param values The set to select from.
+ * @param preferences The values, most preferred first.
+ * @return std::optional<typename FlagSetT::ValueType>
+ */
+template <typename FlagSetT, std::size_t NumPreferences>
+constexpr std::optional<typename FlagSetT::ValueType>
+SelectPreferred(const FlagSetT& values, const std::array<typename FlagSetT::ValueType, NumPreferences>& preferences) noexcept
+{
+    for (const auto& value : preferences) {
+        if (values.Contains(value)) {
+            return value;
         }
     }
-
-    return uwbCapability;
+    return std::nullopt;
 }
 
-namespace detail
+/**
+ * @brief Version ranges are encoded as the minimum version in the upper 16
+ * bits and the maximum version in the lower 16 bits, each as major then minor.
+ */
+constexpr uint32_t VersionRangeShift = 16U;
+constexpr uint32_t VersionMask = 0xFFFFU;
+
+/**
+ * @brief Get the overlap of two version ranges.
+ *
+ * @param lhs The first version range.
+ * @param rhs The second version range.
+ * @return uint32_t The overlapping range, or 0 if either range is unspecified
+ * or the ranges do not overlap.
+ */
+constexpr uint32_t
+IntersectVersionRange(uint32_t lhs, uint32_t rhs) noexcept
 {
-// TODO: move these to common utility code, possibly notstd lib
-template <class T>
-bool
-leftIsSubset(const std::vector<T>& lhs, const std::vector<T>& rhs)
+    if (lhs == 0 || rhs == 0) {
+        return 0;
+    }
+    const auto minimum = std::max(lhs >> VersionRangeShift, rhs >> VersionRangeShift);
+    const auto maximum = std::min(lhs & VersionMask, rhs & VersionMask);
+    return (minimum <= maximum) ? ((minimum << VersionRangeShift) | maximum) : 0;
+}
+
+/**
+ * @brief Determine whether a version range lies within another.
+ *
+ * @param lhs The version range to check.
+ * @param rhs The version range to check against.
+ * @return true If lhs is unspecified or lies within rhs.
+ * @return false Otherwise.
+ */
+constexpr bool
+IsVersionRangeSubset(uint32_t lhs, uint32_t rhs) noexcept
 {
-    return std::ranges::all_of(lhs, [&rhs](const auto& elem) {
-        return std::ranges::any_of(rhs, [&elem](const auto& elem2) {
-            return elem == elem2;
-        });
-    });
+    return (lhs == 0) || (rhs != 0 && IntersectVersionRange(lhs, rhs) == lhs);
 }
 
-template <class T>
-bool
-leftUnorderedEquals(const std::vector<T>& lhs, const std::vector<T>& rhs)
+/**
+ * @brief Negotiate the highest version supported by both devices.
+ *
+ * @param lhs The version range of the first device.
+ * @param rhs The version range of the second device.
+ * @param version Output argument to hold the negotiated version, if any.
+ * @return true If the ranges overlap or either is unspecified.
+ * @return false If the ranges do not overlap.
+ */
+constexpr bool
+NegotiateVersion(uint32_t lhs, uint32_t rhs, std::optional<uint16_t>& version) noexcept
 {
-    return leftIsSubset(lhs, rhs) and leftIsSubset(rhs, lhs);
+    version.reset();
+    if (lhs == 0 || rhs == 0) {
+        return true;
+    }
+    const auto range = IntersectVersionRange(lhs, rhs);
+    if (range == 0) {
+        return false;
+    }
+    version = static_cast<uint16_t>(range & VersionMask);
+    return true;
 }
 } // namespace detail
 
+UwbCapability
+UwbCapability::Intersect(const UwbCapability& other) const noexcept
+{
+    UwbCapability uwbCapability;
+    uwbCapability.FiraPhyVersionRange = ::detail::IntersectVersionRange(FiraPhyVersionRange, other.FiraPhyVersionRange);
+    uwbCapability.FiraMacVersionRange = ::detail::IntersectVersionRange(FiraMacVersionRange, other.FiraMacVersionRange);
+    uwbCapability.ExtendedMacAddress = ExtendedMacAddress && other.ExtendedMacAddress;
+    uwbCapability.UwbInitiationTime = UwbInitiationTime && other.UwbInitiationTime;
+    uwbCapability.AngleOfArrivalFom = AngleOfArrivalFom && other.AngleOfArrivalFom;
+    uwbCapability.BlockStriding = BlockStriding && other.BlockStriding;
+    uwbCapability.HoppingMode = HoppingMode && other.HoppingMode;
+    uwbCapability.MultiNodeModes = MultiNodeModes.Intersect(other.MultiNodeModes);
+    uwbCapability.DeviceRoles = DeviceRoles.Intersect(other.DeviceRoles);
+    uwbCapability.StsConfigurations = StsConfigurations.Intersect(other.StsConfigurations);
+    uwbCapability.RFrameConfigurations = RFrameConfigurations.Intersect(other.RFrameConfigurations);
+    uwbCapability.AngleOfArrivalTypes = AngleOfArrivalTypes.Intersect(other.AngleOfArrivalTypes);
+    uwbCapability.SchedulingModes = SchedulingModes.Intersect(other.SchedulingModes);
+    uwbCapability.RangingTimeStructs = RangingTimeStructs.Intersect(other.RangingTimeStructs);
+    uwbCapability.RangingMethods = RangingMethods.Intersect(other.RangingMethods);
+    uwbCapability.ConvolutionalCodeConstraintLengths = ConvolutionalCodeConstraintLengths.Intersect(other.ConvolutionalCodeConstraintLengths);
+    uwbCapability.Channels = Channels.Intersect(other.Channels);
+    uwbCapability.BprfParameterSets = BprfParameterSets.Intersect(other.BprfParameterSets);
+    uwbCapability.HprfParameterSets = HprfParameterSets.Intersect(other.HprfParameterSets);
+    return uwbCapability;
+}
+
 bool
-uwb::protocol::fira::operator==(const UwbCapability& lhs, const UwbCapability& rhs) noexcept
+UwbCapability::IsSubsetOf(const UwbCapability& other) const noexcept
 {
-    const auto haveSameContents = [&](const auto& v1, const auto& v2) -> bool {
-        return ::detail::leftUnorderedEquals(v1, v2);
+    const auto implies = [](bool lhs, bool rhs) {
+        return !lhs || rhs;
     };
 
-    const bool basicFieldsEqual =
-        std::tie(lhs.FiraPhyVersionRange, lhs.FiraMacVersionRange, lhs.ExtendedMacAddress, lhs.UwbInitiationTime, lhs.AngleOfArrivalFom, lhs.BlockStriding, lhs.HoppingMode) ==
-        std::tie(rhs.FiraPhyVersionRange, rhs.FiraMacVersionRange, rhs.ExtendedMacAddress, rhs.UwbInitiationTime, rhs.AngleOfArrivalFom, rhs.BlockStriding, rhs.HoppingMode);
-
     // clang-format off
-    return basicFieldsEqual
-        && haveSameContents(lhs.MultiNodeModes, rhs.MultiNodeModes)
-        && haveSameContents(lhs.DeviceRoles, rhs.DeviceRoles)
-        && haveSameContents(lhs.StsConfigurations, rhs.StsConfigurations)
-        && haveSameContents(lhs.RFrameConfigurations, rhs.RFrameConfigurations)
-        && haveSameContents(lhs.AngleOfArrivalTypes, rhs.AngleOfArrivalTypes)
-        && haveSameContents(lhs.SchedulingModes, rhs.SchedulingModes)
-        && haveSameContents(lhs.RangingTimeStructs, rhs.RangingTimeStructs)
-        && haveSameContents(lhs.RangingMethods, rhs.RangingMethods)
-        && haveSameContents(lhs.ConvolutionalCodeConstraintLengths, rhs.ConvolutionalCodeConstraintLengths)
-        && haveSameContents(lhs.Channels, rhs.Channels)
-        && haveSameContents(lhs.BprfParameterSets, rhs.BprfParameterSets)
-        && haveSameContents(lhs.HprfParameterSets, rhs.HprfParameterSets);
+    return ::detail::IsVersionRangeSubset(FiraPhyVersionRange, other.FiraPhyVersionRange)
+        && ::detail::IsVersionRangeSubset(FiraMacVersionRange, other.FiraMacVersionRange)
+        && implies(ExtendedMacAddress, other.ExtendedMacAddress)
+        && implies(UwbInitiationTime, other.UwbInitiationTime)
+        && implies(AngleOfArrivalFom, other.AngleOfArrivalFom)
+        && implies(BlockStriding, other.BlockStriding)
+        && implies(HoppingMode, other.HoppingMode)
+        && MultiNodeModes.IsSubsetOf(other.MultiNodeModes)
+        && DeviceRoles.IsSubsetOf(other.DeviceRoles)
+        && StsConfigurations.IsSubsetOf(other.StsConfigurations)
+        && RFrameConfigurations.IsSubsetOf(other.RFrameConfigurations)
+        && AngleOfArrivalTypes.IsSubsetOf(other.AngleOfArrivalTypes)
+        && SchedulingModes.IsSubsetOf(other.SchedulingModes)
+        && RangingTimeStructs.IsSubsetOf(other.RangingTimeStructs)
+        && RangingMethods.IsSubsetOf(other.RangingMethods)
+        && ConvolutionalCodeConstraintLengths.IsSubsetOf(other.ConvolutionalCodeConstraintLengths)
+        && Channels.IsSubsetOf(other.Channels)
+        && BprfParameterSets.IsSubsetOf(other.BprfParameterSets)
+        && HprfParameterSets.IsSubsetOf(other.HprfParameterSets);
     // clang-format on
 }
 
+/* static */
+std::optional<UwbConfiguration>
+UwbCapability::Negotiate(const UwbCapability& controller, const UwbCapability& controlee)
+{
+    // The controller may only take a role for which the controlee supports the opposite role.
+    DeviceRole deviceRole;
+    if (controller.DeviceRoles.Contains(DeviceRole::Initiator) && controlee.DeviceRoles.Contains(DeviceRole::Responder)) {
+        deviceRole = DeviceRole::Initiator;
+    } else if (controller.DeviceRoles.Contains(DeviceRole::Responder) && controlee.DeviceRoles.Contains(DeviceRole::Initiator)) {
+        deviceRole = DeviceRole::Responder;
+    } else {
+        return std::nullopt;
+    }
+
+    PrfMode prfMode;
+    if (!controller.BprfParameterSets.Intersect(controlee.BprfParameterSets).Empty()) {
+        prfMode = PrfMode::Bprf;
+    } else if (!controller.HprfParameterSets.Intersect(controlee.HprfParameterSets).Empty()) {
+        prfMode = PrfMode::Hprf;
+    } else {
+        return std::nullopt;
+    }
+
+    const auto rangingMethod = ::detail::SelectPreferred(controller.RangingMethods.Intersect(controlee.RangingMethods), ::detail::RangingMethodPreference);
+    const auto stsConfiguration = ::detail::SelectPreferred(controller.StsConfigurations.Intersect(controlee.StsConfigurations), ::detail::StsConfigurationPreference);
+    const auto multiNodeMode = ::detail::SelectPreferred(controller.MultiNodeModes.Intersect(controlee.MultiNodeModes), ::detail::MultiNodeModePreference);
+    const auto rangingTimeStruct = ::detail::SelectPreferred(controller.RangingTimeStructs.Intersect(controlee.RangingTimeStructs), ::detail::RangingModePreference);
+    const auto schedulingMode = ::detail::SelectPreferred(controller.SchedulingModes.Intersect(controlee.SchedulingModes), ::detail::SchedulingModePreference);
+    const auto channel = ::detail::SelectPreferred(controller.Channels.Intersect(controlee.Channels), ::detail::ChannelPreference);
+    const auto rframeConfiguration = ::detail::SelectPreferred(controller.RFrameConfigurations.Intersect(controlee.RFrameConfigurations), ::detail::RFrameConfigurationPreference);
+    if (!rangingMethod || !stsConfiguration || !multiNodeMode || !rangingTimeStruct || !schedulingMode || !channel || !rframeConfiguration) {
+        return std::nullopt;
+    }
+
+    std::optional<uint16_t> firaPhyVersion;
+    std::optional<uint16_t> firaMacVersion;
+    if (!::detail::NegotiateVersion(controller.FiraPhyVersionRange, controlee.FiraPhyVersionRange, firaPhyVersion) ||
+        !::detail::NegotiateVersion(controller.FiraMacVersionRange, controlee.FiraMacVersionRange, firaMacVersion)) {
+        return std::nullopt;
+    }
+
+    UwbConfiguration::Builder builder{};
+    builder.SetDeviceRole(deviceRole);
+    builder.SetPrfMode(prfMode);
+    builder.SetRangingMethod(*rangingMethod);
+    builder.SetStsConfiguration(*stsConfiguration);
+    builder.SetMultiNodeMode(*multiNodeMode);
+    builder.SetRangingTimeStruct(*rangingTimeStruct);
+    builder.SetSchedulingMode(*schedulingMode);
+    builder.SetChannel(*channel);
+    builder.SetStsPacketConfiguration(*rframeConfiguration);
+    if (const auto convolutionalCodeConstraintLength = ::detail::SelectPreferred(controller.ConvolutionalCodeConstraintLengths.Intersect(controlee.ConvolutionalCodeConstraintLengths), ::detail::ConvolutionalCodeConstraintLengthPreference)) {
+        builder.SetConvolutionalCodeConstraintLength(*convolutionalCodeConstraintLength);
+    }
+    if (firaPhyVersion.has_value()) {
+        builder.SetFiraVersionPhy(*firaPhyVersion);
+    }
+    if (firaMacVersion.has_value()) {
+        builder.SetFiraVersionMac(*firaMacVersion);
+    }
+
+    return builder;
+}
+
+bool
+uwb::protocol::fira::operator==(const UwbCapability& lhs, const UwbCapability& rhs) noexcept
+{
+    const auto tie = [](const UwbCapability& uwbCapability) {
+        return std::tie(uwbCapability.FiraPhyVersionRange, uwbCapability.FiraMacVersionRange, uwbCapability.ExtendedMacAddress, uwbCapability.UwbInitiationTime, uwbCapability.AngleOfArrivalFom, uwbCapability.BlockStriding, uwbCapability.HoppingMode, uwbCapability.MultiNodeModes, uwbCapability.DeviceRoles, uwbCapability.StsConfigurations, uwbCapability.RFrameConfigurations, uwbCapability.AngleOfArrivalTypes, uwbCapability.SchedulingModes, uwbCapability.RangingTimeStructs, uwbCapability.RangingMethods, uwbCapability.ConvolutionalCodeConstraintLengths, uwbCapability.Channels, uwbCapability.BprfParameterSets, uwbCapability.HprfParameterSets);
+    };
+
+    return tie(lhs) == tie(rhs);
+}
+
 bool
 uwb::protocol::fira::operator!=(const UwbCapability& lhs, const UwbCapability& rhs) noexcept
 {
@@ -1,16 +1,15 @@
 
-#include <cstring>
-#include <functional>
-#include <ranges>
-#include <stdexcept>
-#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <variant>
 
 #include <magic_enum.hpp>
-#include <notstd/type_traits.hxx>
+#include <notstd/utility.hxx>
+#include <plog/Log.h>
 
 #include <tlv/TlvBer.hxx>
-#include <tlv/TlvSerialize.hxx>
+#include <tlv/TlvSchema.hxx>
 #include <uwb/protocols/fira/UwbConfiguration.hxx>
 #include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 
@@ -28,306 +27,177 @@ const std::unordered_set<ResultReportConfiguration> UwbConfiguration::ResultRepo
     ResultReportConfiguration::AoAAzimuthReport
 };
 
-std::unique_ptr<encoding::TlvBer>
-UwbConfiguration::ToDataObject() const
-{
-    using encoding::TlvBer, encoding::GetBytesBigEndianFromBitMap;
-
-    auto builder = TlvBer::Builder().SetTag(Tag);
-
-    for (const auto& [parameterTag, parameterValueVariant] : m_values) {
-        auto valueBuilder = TlvBer::Builder().SetTag(notstd::to_underlying(parameterTag));
-        std::visit([&valueBuilder, &parameterTag](auto&& parameterValue) {
-            using ParameterValueT = std::decay_t<decltype(parameterValue)>;
-            if constexpr (std::is_enum_v<ParameterValueT>) {
-                valueBuilder.SetValue(notstd::to_underlying(parameterValue));
-            } else if constexpr (std::is_same_v<ParameterValueT, uint8_t> || std::is_same_v<ParameterValueT, std::array<uint8_t, StaticStsInitializationVectorLength>>) {
-                valueBuilder.SetValue(parameterValue);
-            } else if constexpr (std::is_unsigned_v<ParameterValueT>) {
-                auto valueBytes = GetBytesBigEndianFromBitMap(parameterValue, sizeof parameterValue);
-                valueBuilder.SetValue(valueBytes);
-            } else if constexpr (std::is_same_v<ParameterValueT, ::uwb::UwbMacAddress>) {
-                auto valueBytes = parameterValue.GetValue();
-                valueBuilder.SetValue(valueBytes);
-            } else if constexpr (std::is_same_v<ParameterValueT, std::unordered_set<::uwb::UwbMacAddress>>) {
-                std::vector<uint8_t> valueBytes{};
-                for (const auto& uwbMacAddress : parameterValue) {
-                    auto value = parameterValue.GetValue();
-                    std::ranges::copy(valueBytes, std::back_inserter(value));
-                }
-                valueBuilder.SetValue(valueBytes);
-            } else if constexpr (std::is_same_v<ParameterValueT, std::unordered_set<ResultReportConfiguration>>) {
-                uint8_t value = 0;
-                for (const auto& resultReportConfiguration : parameterValue) {
-                    value |= notstd::to_underlying(resultReportConfiguration);
-                }
-                valueBuilder.SetValue(value);
-            }
-        },
-            parameterValueVariant);
-        builder.AddTlv(valueBuilder.Build());
-    }
-
-    auto tlvBerResult = std::make_unique<TlvBer>();
-    *tlvBerResult = builder.Build();
-
-    return tlvBerResult;
-}
-
 namespace detail
 {
+/**
+ * @brief Encodes an enumeration as a single octet holding its underlying
+ * value. Decoding rejects values that do not name an enumerator.
+ *
+ * @tparam EnumT The enumeration type.
+ */
 template <typename EnumT>
-void
-SetEnumValue(uint8_t parameterValue, std::function<void(EnumT)> setter)
+struct KnownEnumeration
 {
-    auto valueEnum = magic_enum::enum_cast<EnumT>(parameterValue);
-    if (valueEnum.has_value()) {
-        setter(*valueEnum);
-    }
-}
-} // namespace detail
+    static constexpr std::size_t BufferSize = 1;
 
-/* static */
-UwbConfiguration
-UwbConfiguration::FromDataObject(const encoding::TlvBer& tlvBer)
-{
-    UwbConfiguration::Builder builder{};
-
-    // clang-format off
-    // setter map for 8-bit values
-    static const std::unordered_map<ParameterTag, std::function<void(uint8_t)>> setters8 {
-        { ParameterTag::KeyRotationRate, [&](uint8_t value) { builder.SetKeyRotationRate(value); }},
-        { ParameterTag::MaxContentionPhaseLength, [&](uint8_t value) { builder.SetMaxContentionPhaseLength(value); }},
-        { ParameterTag::PreambleCodeIndex, [&](uint8_t value) { builder.SetPreambleCodeIndex(value); }},
-        { ParameterTag::SlotsPerRr, [&](uint8_t value) { builder.SetMaxSlotsPerRangingRound(value); }},
-        { ParameterTag::Sp0PhySetNumber, [&](uint8_t value) { builder.SetSp0PhySetNumber(value); }},
-        { ParameterTag::Sp1PhySetNumber, [&](uint8_t value) { builder.SetSp1PhySetNumber(value); }},
-        { ParameterTag::Sp3PhySetNumber, [&](uint8_t value) { builder.SetSp3PhySetNumber(value); }},
-    };
-    // setter map for 16-bit values
-    static const std::unordered_map<ParameterTag, std::function<void(uint16_t)>> setters16 {
-        { ParameterTag::FiraMacVersion, [&](uint16_t value){ builder.SetFiraVersionMac(value); }},
-        { ParameterTag::FiraPhyVersion, [&](uint16_t value){ builder.SetFiraVersionPhy(value); }},
-        { ParameterTag::MaxRrRetry, [&](uint16_t value){ builder.SetMaxRangingRoundRetry(value); }},
-        { ParameterTag::RangingInterval, [&](uint16_t value){ builder.SetRangingInterval(value); }},
-        { ParameterTag::SlotDuration, [&](uint16_t value){ builder.SetSlotDuration(value); }},
-    };
-    // clang-format on
-
-    std::vector<encoding::TlvBer> tlvBerValues = tlvBer.GetValues();
-
-    for (const auto& tlvBerValue : tlvBerValues) {
-        auto tagValue = tlvBerValue.GetTag();
-        // All tags for UwbConfiguration are 1-byte long, so ignore all others.
-        if (std::size(tagValue) != 1) {
-            continue;
-        }
+    static std::span<const uint8_t>
+    Encode(const EnumT& value, std::span<uint8_t, BufferSize> buffer) noexcept
+    {
+        buffer[0] = static_cast<uint8_t>(value);
+        return buffer;
+    }
 
-        // Ensure the tag has a corresponding enumeration value.
-        auto parameterTag = magic_enum::enum_cast<ParameterTag>(tagValue.front());
-        if (!parameterTag.has_value()) {
-            continue;
+    static bool
+    Decode(std::span<const uint8_t> data, EnumT& value) noexcept
+    {
+        if (std::size(data) != 1) {
+            return false;
         }
 
-        // Ensure all values have non-zero payload.
-        auto& parameterValue = tlvBerValue.GetValue();
-        if (std::empty(parameterValue)) {
-            continue;
+        auto valueEnum = magic_enum::enum_cast<EnumT>(data.front());
+        if (!valueEnum.has_value()) {
+            return false;
         }
 
-        switch (*parameterTag) {
-        // boolean values
-        case ParameterTag::HoppingMode: {
-            bool value = !!parameterValue.front();
-            builder.SetHoppingMode(value);
-            break;
-        }
-        case ParameterTag::BlockStriding: {
-            bool value = !!parameterValue.front();
-            builder.SetBlockStriding(value);
-            break;
-        }
+        value = *valueEnum;
+        return true;
+    }
+};
 
-        // 8-bit values
-        case ParameterTag::KeyRotationRate:
-        case ParameterTag::MaxContentionPhaseLength:
-        case ParameterTag::SlotsPerRr:
-        case ParameterTag::PreambleCodeIndex:
-        case ParameterTag::Sp0PhySetNumber:
-        case ParameterTag::Sp1PhySetNumber:
-        case ParameterTag::Sp3PhySetNumber: {
-            uint8_t value = parameterValue.front();
-            setters8.at(*parameterTag)(value);
-            break;
-        }
+/**
+ * @brief Encodes a RangingMethod as the single octet of the FiRa RANGING_METHOD
+ * parameter, which is 0 for one-way ranging and the RangingRoundUsage value
+ * otherwise.
+ */
+struct RangingMethodOctet
+{
+    static constexpr std::size_t BufferSize = 1;
 
-        // 16-bit values
-        case ParameterTag::FiraPhyVersion:
-        case ParameterTag::FiraMacVersion: {
-        case ParameterTag::SlotDuration:
-        case ParameterTag::RangingInterval:
-        case ParameterTag::MaxRrRetry:
-            uint16_t value = 0; // assumes endianness matches host
-            std::memcpy(&value, std::data(parameterValue), std::size(parameterValue));
-            setters16.at(*parameterTag)(value);
-            break;
-        }
+    static std::span<const uint8_t>
+    Encode(const RangingMethod& value, std::span<uint8_t, BufferSize> buffer)
+    {
+        buffer[0] = (value.Method == RangingDirection::OneWay) ? 0 : value.ToByte();
+        return buffer;
+    }
 
-        // 32-bit values
-        case ParameterTag::UwbInitiationTime: {
-            uint32_t value = 0; // assumes endianness matches host
-            std::memcpy(&value, std::data(parameterValue), std::size(parameterValue));
-            builder.SetUwbInitiationTime(value);
-            break;
+    static bool
+    Decode(std::span<const uint8_t> data, RangingMethod& value) noexcept
+    {
+        if (std::size(data) != 1) {
+            return false;
         }
 
-        // enumerations
-        case ParameterTag::DeviceRole: {
-            ::detail::SetEnumValue<DeviceRole>(parameterValue.front(), [&](auto&& value) {
-                builder.SetDeviceRole(value);
-            });
+        switch (data.front()) {
+        case 0:
+            value = RangingMethod{ RangingDirection::OneWay, MeasurementReportMode::None };
             break;
-        }
-        case ParameterTag::StsConfig: {
-            ::detail::SetEnumValue<StsConfiguration>(parameterValue.front(), [&](auto&& value) {
-                builder.SetStsConfiguration(value);
-            });
+        case notstd::to_underlying(RangingRoundUsage::SingleSidedTwoWayRangingWithDeferredMode):
+            value = RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::Deferred };
             break;
-        }
-        case ParameterTag::MultiNodeMode: {
-            ::detail::SetEnumValue<MultiNodeMode>(parameterValue.front(), [&](auto&& value) {
-                builder.SetMultiNodeMode(value);
-            });
+        case notstd::to_underlying(RangingRoundUsage::DoubleSidedTwoWayRangingWithDeferredMode):
+            value = RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::Deferred };
             break;
-        }
-        case ParameterTag::RangingTimeStruct: {
-            ::detail::SetEnumValue<RangingMode>(parameterValue.front(), [&](auto&& value) {
-                builder.SetRangingTimeStruct(value);
-            });
-            break;
-        }
-        case ParameterTag::ScheduledMode: {
-            ::detail::SetEnumValue<SchedulingMode>(parameterValue.front(), [&](auto&& value) {
-                builder.SetSchedulingMode(value);
-            });
-            break;
-        }
-        case ParameterTag::PrfMode: {
-            ::detail::SetEnumValue<PrfMode>(parameterValue.front(), [&](auto&& value) {
-                builder.SetPrfMode(value);
-            });
+        case notstd::to_underlying(RangingRoundUsage::SingleSidedTwoWayRangingNonDeferredMode):
+            value = RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred };
             break;
-        }
-        case ParameterTag::RFrameConfig: {
-            ::detail::SetEnumValue<StsPacketConfiguration>(parameterValue.front(), [&](auto&& value) {
-                builder.SetStsPacketConfiguration(value);
-            });
-            break;
-        }
-        case ParameterTag::ChannelNumber: {
-            ::detail::SetEnumValue<Channel>(parameterValue.front(), [&](auto&& value) {
-                builder.SetChannel(value);
-            });
-            break;
-        }
-        case ParameterTag::CcConstraintLength: {
-            ::detail::SetEnumValue<ConvolutionalCodeConstraintLength>(parameterValue.front(), [&](auto&& value) {
-                builder.SetConvolutionalCodeConstraintLength(value);
-            });
-            break;
-        }
-        case ParameterTag::MacAddressMode: {
-            ::detail::SetEnumValue<uwb::UwbMacAddressType>(parameterValue.front(), [&](auto&& value) {
-                builder.SetMacAddressType(value);
-            });
-            break;
-        }
-        case ParameterTag::MacFcsType: {
-            ::detail::SetEnumValue<uwb::UwbMacAddressFcsType>(parameterValue.front(), [&](auto&& value) {
-                builder.SetMacAddressFcsType(value);
-            });
+        case notstd::to_underlying(RangingRoundUsage::DoubleSidedTwoWayRangingNonDeferredMode):
+            value = RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::NonDeferred };
             break;
+        default:
+            return false;
         }
 
-        // special cases
-        case ParameterTag::RangingMethod: {
-            uint8_t value = parameterValue.front();
-            RangingDirection rangingDirection;
-            MeasurementReportMode measurementReportMode;
-
-            switch (value) {
-            case 0:
-                rangingDirection = RangingDirection::OneWay;
-                measurementReportMode = MeasurementReportMode::None;
-                break;
-            case (int)RangingRoundUsage::SingleSidedTwoWayRangingWithDeferredMode:
-                rangingDirection = RangingDirection::SingleSidedTwoWay;
-                measurementReportMode = MeasurementReportMode::Deferred;
-                break;
-            case (int)RangingRoundUsage::DoubleSidedTwoWayRangingWithDeferredMode:
-                rangingDirection = RangingDirection::DoubleSidedTwoWay;
-                measurementReportMode = MeasurementReportMode::Deferred;
-                break;
-            case (int)RangingRoundUsage::SingleSidedTwoWayRangingNonDeferredMode:
-                rangingDirection = RangingDirection::SingleSidedTwoWay;
-                measurementReportMode = MeasurementReportMode::NonDeferred;
-                break;
-            case (int)RangingRoundUsage::DoubleSidedTwoWayRangingNonDeferredMode:
-                rangingDirection = RangingDirection::DoubleSidedTwoWay;
-                measurementReportMode = MeasurementReportMode::NonDeferred;
-                break;
-            }
-
-            RangingMethod rangingMethod(rangingDirection, measurementReportMode);
-            builder.SetRangingMethod(rangingMethod);
-            break;
-        }
+        return true;
+    }
+};
+} // namespace detail
 
-        case ParameterTag::ResultReportConfig: {
-            uint8_t value = parameterValue.front();
-            for (const auto resultReportConfiguration : magic_enum::enum_values<ResultReportConfiguration>()) {
-                if ((value & notstd::to_underlying(resultReportConfiguration)) != 0) {
-                    builder.AddResultReportConfiguration(resultReportConfiguration);
-                }
-            }
-            break;
-        }
-        case ParameterTag::ControleeShortMacAddress: {
-            std::array<uint8_t, 2> addressData{ parameterValue[0], parameterValue[1] };
-            uwb::UwbMacAddress uwbMacAddressShort(addressData);
-            builder.SetMacAddressControleeShort(uwbMacAddressShort);
-            break;
-        }
-        case ParameterTag::ControllerMacAddress: {
-            std::optional<uwb::UwbMacAddress> uwbMacAddress;
-            switch (std::size(parameterValue)) {
-            case uwb::UwbMacAddress::ShortLength: {
-                std::array<uint8_t, uwb::UwbMacAddress::ShortLength> addressData{ parameterValue[0], parameterValue[1] };
-                uwbMacAddress = UwbMacAddress(addressData);
-                break;
-            }
-            case uwb::UwbMacAddress::ExtendedLength: {
-                std::array<uint8_t, uwb::UwbMacAddress::ExtendedLength> addressData{ 
-                    parameterValue[0], parameterValue[1], parameterValue[2], parameterValue[3], 
-                    parameterValue[4], parameterValue[5], parameterValue[6], parameterValue[7] };
-                uwbMacAddress = UwbMacAddress(addressData);
-                break;
-            }
-            default: {
-                break;
-            }
-            }
-            if (uwbMacAddress.has_value()) {
-                builder.SetMacAddressController(uwbMacAddress.value());
-            }
-            break;
-        }
-        default:
-            break;
-        } // switch (parameterTag)
+/**
+ * @brief Schema of the UWB Session Data object. Every parameter is optional
+ * and held in the slot of its tag. See FiRa Consortium Common Service
+ * Management Layer Technical Specification v1.0.0, Section 7.5.3.2, 'UWB
+ * Session Data structure', Table 53, pages 103-107.
+ */
+struct UwbConfiguration::DataObjectSchema
+{
+    template <ParameterTag Tag, typename ValueT, typename ValueRuleT>
+    using ParameterField = encoding::schema::Field<notstd::to_underlying(Tag), &UwbConfiguration::m_values, encoding::schema::VariantMapValue<Tag, ValueT, ValueRuleT>>;
+
+    template <ParameterTag Tag, typename EnumT>
+    using EnumerationField = ParameterField<Tag, EnumT, ::detail::KnownEnumeration<EnumT>>;
+
+    template <ParameterTag Tag, typename IntegerT>
+    using IntegerField = ParameterField<Tag, IntegerT, encoding::schema::UnsignedBigEndian<IntegerT>>;
+
+    template <ParameterTag Tag, std::size_t... Lengths>
+    using MacAddressField = ParameterField<Tag, ::uwb::UwbMacAddress, encoding::schema::MacAddress<::uwb::UwbMacAddress, Lengths...>>;
+
+    using Type = encoding::schema::Schema<UwbConfiguration::Tag,
+        IntegerField<ParameterTag::FiraPhyVersion, uint16_t>,
+        IntegerField<ParameterTag::FiraMacVersion, uint16_t>,
+        EnumerationField<ParameterTag::DeviceRole, DeviceRole>,
+        ParameterField<ParameterTag::RangingMethod, RangingMethod, ::detail::RangingMethodOctet>,
+        EnumerationField<ParameterTag::StsConfig, StsConfiguration>,
+        EnumerationField<ParameterTag::MultiNodeMode, MultiNodeMode>,
+        EnumerationField<ParameterTag::RangingTimeStruct, RangingMode>,
+        EnumerationField<ParameterTag::ScheduledMode, SchedulingMode>,
+        ParameterField<ParameterTag::HoppingMode, bool, encoding::schema::Boolean>,
+        ParameterField<ParameterTag::BlockStriding, bool, encoding::schema::Boolean>,
+        IntegerField<ParameterTag::UwbInitiationTime, uint32_t>,
+        EnumerationField<ParameterTag::ChannelNumber, Channel>,
+        EnumerationField<ParameterTag::RFrameConfig, StsPacketConfiguration>,
+        EnumerationField<ParameterTag::CcConstraintLength, ConvolutionalCodeConstraintLength>,
+        EnumerationField<ParameterTag::PrfMode, PrfMode>,
+        IntegerField<ParameterTag::Sp0PhySetNumber, uint8_t>,
+        IntegerField<ParameterTag::Sp1PhySetNumber, uint8_t>,
+        IntegerField<ParameterTag::Sp3PhySetNumber, uint8_t>,
+        IntegerField<ParameterTag::PreambleCodeIndex, uint8_t>,
+        ParameterField<ParameterTag::ResultReportConfig, ResultReportConfigurationSet, encoding::schema::FlagSetBitmap<UwbConfiguration::ResultReportConfigurationBit>>,
+        EnumerationField<ParameterTag::MacAddressMode, ::uwb::UwbMacAddressType>,
+        MacAddressField<ParameterTag::ControleeShortMacAddress, ::uwb::UwbMacAddress::ShortLength>,
+        MacAddressField<ParameterTag::ControllerMacAddress, ::uwb::UwbMacAddress::ShortLength, ::uwb::UwbMacAddress::ExtendedLength>,
+        IntegerField<ParameterTag::SlotsPerRr, uint8_t>,
+        IntegerField<ParameterTag::MaxContentionPhaseLength, uint8_t>,
+        IntegerField<ParameterTag::SlotDuration, uint16_t>,
+        IntegerField<ParameterTag::RangingInterval, uint16_t>,
+        IntegerField<ParameterTag::KeyRotationRate, uint8_t>,
+        EnumerationField<ParameterTag::MacFcsType, ::uwb::UwbMacAddressFcsType>,
+        IntegerField<ParameterTag::MaxRrRetry, uint16_t>>;
+};
+
+std::unique_ptr<encoding::TlvBer>
+UwbConfiguration::ToDataObject() const
+{
+    return std::make_unique<encoding::TlvBer>(DataObjectSchema::Type::Encode(*this));
+}
+
+/* static */
+template <typename TlvT>
+UwbConfiguration
+UwbConfiguration::FromDataObjectImpl(const TlvT& tlvBer)
+{
+    // Parameters with invalid values are ignored rather than failing the
+    // whole configuration, so a failed decode still yields the valid ones.
+    UwbConfiguration uwbConfiguration{};
+    if (!DataObjectSchema::Type::Decode(tlvBer, uwbConfiguration)) {
+        PLOG_WARNING << "UWB configuration data object contains invalid parameters; ignoring them";
     }
 
-    return builder;
+    return uwbConfiguration;
+}
+
+/* static */
+UwbConfiguration
+UwbConfiguration::FromDataObject(const encoding::TlvBer& tlvBer)
+{
+    return FromDataObjectImpl(tlvBer);
+}
+
+/* static */
+UwbConfiguration
+UwbConfiguration::FromDataObject(const encoding::TlvBerView& tlvBer)
+{
+    return FromDataObjectImpl(tlvBer);
 }
 
 std::optional<uint16_t>
@@ -447,10 +317,13 @@ UwbConfiguration::GetPreambleCodeIndex() const noexcept
 std::unordered_set<ResultReportConfiguration>
 UwbConfiguration::GetResultReportConfigurations() const noexcept
 {
-    auto it = m_values.find(ParameterTag::ResultReportConfig);
-    return (it != std::cend(m_values))
-        ? std::get<std::unordered_set<ResultReportConfiguration>>(it->second)
-        : std::unordered_set<ResultReportConfiguration>{};
+    const auto* value = m_values.get(ParameterTag::ResultReportConfig);
+    if (value == nullptr) {
+        return {};
+    }
+
+    const auto& resultReportConfigurations = std::get<ResultReportConfigurationSet>(*value);
+    return { std::cbegin(resultReportConfigurations), std::cend(resultReportConfigurations) };
 }
 
 std::optional<uwb::UwbMacAddressType>
@@ -513,8 +386,8 @@ UwbConfiguration::GetMaxRangingRoundRetry() const noexcept
     return GetValue<uint16_t>(ParameterTag::MaxRrRetry);
 }
 
-const std::unordered_map<UwbConfiguration::ParameterTag, UwbConfiguration::ParameterTypesVariant>&
-UwbConfiguration::GetValueMap() const noexcept
+const UwbConfiguration::ParameterValues&
+UwbConfiguration::GetValues() const noexcept
 {
     return m_values;
 }
@@ -1,4 +1,6 @@
 
+#include <utility>
+
 #include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 
 using namespace uwb::protocol::fira;
@@ -7,6 +9,11 @@ UwbConfiguration::Builder::Builder() :
     m_values(m_uwbConfiguration.m_values)
 {}
 
+UwbConfiguration::Builder::Builder(UwbConfiguration uwbConfiguration) :
+    m_uwbConfiguration(std::move(uwbConfiguration)),
+    m_values(m_uwbConfiguration.m_values)
+{}
+
 UwbConfiguration::Builder::operator UwbConfiguration() noexcept
 {
     auto uwbConfiguration = std::move(m_uwbConfiguration);
@@ -276,9 +283,11 @@ UwbConfiguration::Builder::Supports() noexcept
 UwbConfiguration::Builder&
 UwbConfiguration::Builder::AddResultReportConfiguration(uwb::protocol::fira::ResultReportConfiguration resultReportConfiguration) noexcept
 {
-    auto [it, _] = m_values.insert({ ParameterTag::ResultReportConfig, std::unordered_set<uwb::protocol::fira::ResultReportConfiguration>{} });
-    auto& resultReportConfigurations = std::get<std::unordered_set<uwb::protocol::fira::ResultReportConfiguration>>(it->second);
-    resultReportConfigurations.insert(std::move(resultReportConfiguration));
+    if (!m_values.contains(ParameterTag::ResultReportConfig)) {
+        m_values.insert_or_assign(ParameterTag::ResultReportConfig, ResultReportConfigurationSet{});
+    }
+    auto& resultReportConfigurations = std::get<ResultReportConfigurationSet>(m_values[ParameterTag::ResultReportConfig]);
+    resultReportConfigurations.Insert(resultReportConfiguration);
 
     return *this;
 }
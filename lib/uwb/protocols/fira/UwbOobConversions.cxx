@@ -1,152 +1,295 @@
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <utility>
+
 #include <magic_enum.hpp>
+#include <notstd/hash.hxx>
 #include <plog/Log.h>
 #include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 #include <uwb/protocols/fira/UwbOobConversions.hxx>
 #include <uwb/protocols/fira/UwbSessionData.hxx>
 
 using namespace uwb::protocol::fira;
+
+namespace detail
+{
+/**
+ * @brief Function which generates a uci parameter value given UwbConfiguration.
+ */
+using UciGenerator = std::optional<UwbApplicationConfigurationParameterValue> (*)(const UwbConfiguration&, DeviceType);
+
+/**
+ * @brief The number of uci parameter types, which indexes UciGenerators.
+ */
+constexpr std::size_t UciGeneratorsSize = static_cast<std::size_t>(UwbApplicationConfigurationParameterType::StsLength) + 1;
+
 /**
- * @brief map of uci parameter type to a function of how to generate that uci parameter value given UwbConfiguration
+ * @brief Get the index of a uci parameter type in UciGenerators.
  *
+ * @param type The uci parameter type.
+ * @return constexpr std::size_t
+ */
+constexpr std::size_t
+ToIndex(UwbApplicationConfigurationParameterType type) noexcept
+{
+    return static_cast<std::size_t>(type);
+}
+
+/**
+ * @brief Table of uci parameter type to a function of how to generate that uci
+ * parameter value given UwbConfiguration. Parameter types with no generator
+ * hold nullptr.
  */
-const std::unordered_map<UwbApplicationConfigurationParameterType, std::function<std::optional<UwbApplicationConfigurationParameterValue>(const UwbConfiguration&, DeviceType)>> uciGenerators{
+constexpr std::array<UciGenerator, UciGeneratorsSize> UciGenerators = []() {
+    std::array<UciGenerator, UciGeneratorsSize> generators{};
+
     // params that directly transfer
-    { UwbApplicationConfigurationParameterType::DeviceType, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return deviceType;
-     } },
-    { UwbApplicationConfigurationParameterType::DeviceRole, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetDeviceRole();
-     } },
-    { UwbApplicationConfigurationParameterType::StsConfiguration, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetStsConfiguration();
-     } },
-    { UwbApplicationConfigurationParameterType::MultiNodeMode, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetMultiNodeMode();
-     } },
-    { UwbApplicationConfigurationParameterType::ChannelNumber, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetChannel();
-     } },
-    { UwbApplicationConfigurationParameterType::SlotDuration, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetSlotDuration();
-     } },
-    { UwbApplicationConfigurationParameterType::RangingInterval, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetRangingInterval();
-     } },
-    { UwbApplicationConfigurationParameterType::MacFcsType, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetMacAddressFcsType();
-     } },
-    { UwbApplicationConfigurationParameterType::RFrameConfiguration, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetRFrameConfig();
-     } },
-    { UwbApplicationConfigurationParameterType::PreambleCodeIndex, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetPreambleCodeIndex();
-     } },
-    { UwbApplicationConfigurationParameterType::RangingTimeStruct, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetRangingTimeStruct();
-     } },
-    { UwbApplicationConfigurationParameterType::SlotsPerRangingRound, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetSlotsPerRangingRound();
-     } },
-    { UwbApplicationConfigurationParameterType::ScheduledMode, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetSchedulingMode();
-     } },
-    { UwbApplicationConfigurationParameterType::KeyRotationRate, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetKeyRotationRate();
-     } },
-    { UwbApplicationConfigurationParameterType::MacAddressMode, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetMacAddressMode();
-     } },
-    { UwbApplicationConfigurationParameterType::MaxRangingRoundRetry, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetMaxRangingRoundRetry();
-     } },
-    { UwbApplicationConfigurationParameterType::UwbInitiationTime, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetUwbInitiationTime();
-     } },
-    { UwbApplicationConfigurationParameterType::HoppingMode, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetHoppingMode();
-     } },
-    { UwbApplicationConfigurationParameterType::ResultReportConfig, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         return config.GetResultReportConfigurations();
-     } },
+    generators[ToIndex(UwbApplicationConfigurationParameterType::DeviceType)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return deviceType;
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::DeviceRole)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetDeviceRole();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::StsConfiguration)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetStsConfiguration();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::MultiNodeMode)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetMultiNodeMode();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::ChannelNumber)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetChannel();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::SlotDuration)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetSlotDuration();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::RangingInterval)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetRangingInterval();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::MacFcsType)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetMacAddressFcsType();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::RFrameConfiguration)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetRFrameConfig();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::PreambleCodeIndex)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetPreambleCodeIndex();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::RangingTimeStruct)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetRangingTimeStruct();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::SlotsPerRangingRound)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetSlotsPerRangingRound();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::ScheduledMode)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetSchedulingMode();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::KeyRotationRate)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetKeyRotationRate();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::MacAddressMode)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetMacAddressMode();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::MaxRangingRoundRetry)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetMaxRangingRoundRetry();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::UwbInitiationTime)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetUwbInitiationTime();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::HoppingMode)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetHoppingMode();
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::ResultReportConfig)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        return config.GetResultReportConfigurations();
+    };
 
     // params with different names
-    { UwbApplicationConfigurationParameterType::RangingRoundUsage, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         auto rangingMethod = config.GetRangingMethod();
-         if (not rangingMethod) {
-             return std::nullopt;
-         }
-         if (rangingMethod->Method == RangingDirection::SingleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::Deferred) {
-             return RangingRoundUsage::SingleSidedTwoWayRangingWithDeferredMode;
-         } else if (rangingMethod->Method == RangingDirection::DoubleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::Deferred) {
-             return RangingRoundUsage::DoubleSidedTwoWayRangingWithDeferredMode;
-         } else if (rangingMethod->Method == RangingDirection::SingleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::NonDeferred) {
-             return RangingRoundUsage::SingleSidedTwoWayRangingNonDeferredMode;
-         } else if (rangingMethod->Method == RangingDirection::DoubleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::NonDeferred) {
-             return RangingRoundUsage::DoubleSidedTwoWayRangingNonDeferredMode;
-         } else {
-             return std::nullopt;
-         }
-     } },
-    { UwbApplicationConfigurationParameterType::DeviceMacAddress, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         auto mode = config.GetMacAddressMode();
-         if (not mode) {
-             return std::nullopt;
-         }
-         if (deviceType == DeviceType::Controller) {
-             return config.GetControllerMacAddress();
-         } else {
-             if (mode == uwb::UwbMacAddressType::Short) {
-                 return config.GetControleeShortMacAddress();
-             } else {
-                 // TODO what do we do here
-                 return std::nullopt;
-             }
-         }
-         return std::nullopt;
-     } },
-    { UwbApplicationConfigurationParameterType::DestinationMacAddresses, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         auto mode = config.GetMacAddressMode();
-         if (not mode) {
-             return std::nullopt;
-         }
-         if (deviceType == DeviceType::Controller) {
-             if (mode == uwb::UwbMacAddressType::Short) {
-                 return config.GetControleeShortMacAddress(); // TODO this should reflect the possibility for multiple peers
-             } else {
-                 // TODO what do we do here
-                 return std::nullopt;
-             }
-         } else {
-             return config.GetControllerMacAddress();
-         }
-     } },
-    { UwbApplicationConfigurationParameterType::PrfMode, [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
-         auto prfMode = config.GetPrfMode();
-         if (prfMode == PrfMode::Bprf) {
-             return PrfModeDetailed::Bprf62MHz;
-         } else {                                // HPRF
-             return PrfModeDetailed::Hprf124MHz; // TODO: Is there a way to determine OOB which Hprf frequency is used?
-         }
-     } },
+    generators[ToIndex(UwbApplicationConfigurationParameterType::RangingRoundUsage)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        auto rangingMethod = config.GetRangingMethod();
+        if (not rangingMethod) {
+            return std::nullopt;
+        }
+        if (rangingMethod->Method == RangingDirection::SingleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::Deferred) {
+            return RangingRoundUsage::SingleSidedTwoWayRangingWithDeferredMode;
+        } else if (rangingMethod->Method == RangingDirection::DoubleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::Deferred) {
+            return RangingRoundUsage::DoubleSidedTwoWayRangingWithDeferredMode;
+        } else if (rangingMethod->Method == RangingDirection::SingleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::NonDeferred) {
+            return RangingRoundUsage::SingleSidedTwoWayRangingNonDeferredMode;
+        } else if (rangingMethod->Method == RangingDirection::DoubleSidedTwoWay and rangingMethod->ReportMode == MeasurementReportMode::NonDeferred) {
+            return RangingRoundUsage::DoubleSidedTwoWayRangingNonDeferredMode;
+        } else {
+            return std::nullopt;
+        }
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::DeviceMacAddress)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        auto mode = config.GetMacAddressMode();
+        if (not mode) {
+            return std::nullopt;
+        }
+        if (deviceType == DeviceType::Controller) {
+            return config.GetControllerMacAddress();
+        } else {
+            if (mode == uwb::UwbMacAddressType::Short) {
+                return config.GetControleeShortMacAddress();
+            } else {
+                // TODO what do we do here
+                return std::nullopt;
+            }
+        }
+        return std::nullopt;
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::DestinationMacAddresses)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        auto mode = config.GetMacAddressMode();
+        if (not mode) {
+            return std::nullopt;
+        }
+        if (deviceType == DeviceType::Controller) {
+            if (mode == uwb::UwbMacAddressType::Short) {
+                return config.GetControleeShortMacAddress(); // TODO this should reflect the possibility for multiple peers
+            } else {
+                // TODO what do we do here
+                return std::nullopt;
+            }
+        } else {
+            return config.GetControllerMacAddress();
+        }
+    };
+    generators[ToIndex(UwbApplicationConfigurationParameterType::PrfMode)] = [](const UwbConfiguration& config, DeviceType deviceType) -> std::optional<UwbApplicationConfigurationParameterValue> {
+        auto prfMode = config.GetPrfMode();
+        if (prfMode == PrfMode::Bprf) {
+            return PrfModeDetailed::Bprf62MHz;
+        } else {                                // HPRF
+            return PrfModeDetailed::Hprf124MHz; // TODO: Is there a way to determine OOB which Hprf frequency is used?
+        }
+    };
     // TODO figure out the rest of the uci params
+
+    return generators;
+}();
+
+/**
+ * @brief The maximum number of uci parameter lists held in the cache.
+ */
+constexpr std::size_t UciConfigParamsCacheCapacity = 16;
+
+/**
+ * @brief Least-recently-used cache of uci parameter lists generated from a
+ * UwbConfiguration and DeviceType.
+ *
+ * Entries are keyed by the content hash of the configuration and device type,
+ * and confirmed with a full comparison, so hash collisions only cost a miss.
+ * Sessions are typically started from a handful of OOB profiles, so the cache
+ * is small and searched linearly, most recently used first.
+ */
+class UciConfigParamsCache
+{
+public:
+    /**
+     * @brief Find the uci parameter list for a configuration, marking it as
+     * most recently used.
+     *
+     * @param hash The content hash of the configuration and device type.
+     * @param uwbConfiguration The configuration.
+     * @param deviceType The device type.
+     * @return std::optional<std::vector<UwbApplicationConfigurationParameter>>
+     */
+    std::optional<std::vector<UwbApplicationConfigurationParameter>>
+    Find(std::size_t hash, const UwbConfiguration& uwbConfiguration, DeviceType deviceType)
+    {
+        std::scoped_lock entriesLock{ m_entriesGate };
+        const auto entryIt = std::ranges::find_if(m_entries, [&](const auto& entry) {
+            return entry.Hash == hash && entry.DeviceType == deviceType && entry.Configuration == uwbConfiguration;
+        });
+        if (entryIt == std::end(m_entries)) {
+            return std::nullopt;
+        }
+
+        m_entries.splice(std::begin(m_entries), m_entries, entryIt);
+        return entryIt->Parameters;
+    }
+
+    /**
+     * @brief Insert the uci parameter list for a configuration, evicting the
+     * least recently used entry if the cache is full.
+     *
+     * @param hash The content hash of the configuration and device type.
+     * @param uwbConfiguration The configuration.
+     * @param deviceType The device type.
+     * @param parameters The uci parameter list generated from the configuration.
+     */
+    void
+    Insert(std::size_t hash, const UwbConfiguration& uwbConfiguration, DeviceType deviceType, std::vector<UwbApplicationConfigurationParameter> parameters)
+    {
+        std::scoped_lock entriesLock{ m_entriesGate };
+        m_entries.push_front(Entry{ hash, deviceType, uwbConfiguration, std::move(parameters) });
+        if (std::size(m_entries) > UciConfigParamsCacheCapacity) {
+            m_entries.pop_back();
+        }
+    }
+
+private:
+    struct Entry
+    {
+        std::size_t Hash;
+        ::uwb::protocol::fira::DeviceType DeviceType;
+        UwbConfiguration Configuration;
+        std::vector<UwbApplicationConfigurationParameter> Parameters;
+    };
+
+    std::mutex m_entriesGate;
+    std::list<Entry> m_entries{};
 };
 
+/**
+ * @brief Generate the uci parameter list for a configuration.
+ *
+ * @param uwbConfiguration The configuration.
+ * @param deviceType The device type.
+ * @return std::vector<UwbApplicationConfigurationParameter>
+ */
 std::vector<UwbApplicationConfigurationParameter>
-uwb::protocol::fira::GetUciConfigParams(const UwbConfiguration& uwbConfiguration, DeviceType deviceType)
+GenerateUciConfigParams(const UwbConfiguration& uwbConfiguration, DeviceType deviceType)
 {
     std::vector<UwbApplicationConfigurationParameter> result;
-    for (const auto& [uciParameterType, generator] : uciGenerators) {
-        const auto uciValue = generator(uwbConfiguration, deviceType);
+    for (std::size_t i = 0; i < std::size(UciGenerators); i++) {
+        const auto generator = UciGenerators[i];
+        if (generator == nullptr) {
+            continue;
+        }
+        auto uciValue = generator(uwbConfiguration, deviceType);
         if (not uciValue) {
             continue;
         }
         result.push_back(UwbApplicationConfigurationParameter{
-            .Type = uciParameterType,
-            .Value = uciValue.value() });
+            .Type = static_cast<UwbApplicationConfigurationParameterType>(i),
+            .Value = std::move(uciValue.value()) });
     }
     return result;
 }
+} // namespace detail
+
+std::vector<UwbApplicationConfigurationParameter>
+uwb::protocol::fira::GetUciConfigParams(const UwbConfiguration& uwbConfiguration, DeviceType deviceType)
+{
+    static ::detail::UciConfigParamsCache cache;
+
+    std::size_t hash = std::hash<UwbConfiguration>{}(uwbConfiguration);
+    notstd::hash_combine(hash, deviceType);
+
+    auto result = cache.Find(hash, uwbConfiguration, deviceType);
+    if (result) {
+        return std::move(result.value());
+    }
+
+    auto uciConfigParams = ::detail::GenerateUciConfigParams(uwbConfiguration, deviceType);
+    cache.Insert(hash, uwbConfiguration, deviceType, uciConfigParams);
+    return uciConfigParams;
+}
 
 UwbSessionData
 uwb::protocol::fira::GetUwbSessionData(std::vector<UwbApplicationConfigurationParameter> applicationConfigurationParameters)
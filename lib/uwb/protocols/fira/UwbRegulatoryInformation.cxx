@@ -1,197 +1,83 @@
 
-#include <unordered_set>
-
-#include <magic_enum.hpp>
 #include <notstd/utility.hxx>
-#include <tlv/TlvSerialize.hxx>
+#include <tlv/TlvSchema.hxx>
 #include <uwb/protocols/fira/UwbRegulatoryInformation.hxx>
 #include <uwb/protocols/fira/UwbException.hxx>
 
 using namespace uwb::protocol::fira;
 
-std::unique_ptr<encoding::TlvBer>
-UwbRegulatoryInformation::ToDataObject() const
+namespace detail
 {
-    using encoding::TlvBer, encoding::GetBytesBigEndianFromBitMap;
+using encoding::schema::Boolean, encoding::schema::Enumeration, encoding::schema::Field, encoding::schema::MapValue, encoding::schema::Schema, encoding::schema::UnsignedBigEndian;
 
-    auto tlvBerResult = std::make_unique<TlvBer>();
-    *tlvBerResult = TlvBer::Builder()
-        .SetTag(Tag)
-        // INFORMATION_SOURCE
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::InformationSource))
-                .SetValue(notstd::to_underlying(Source))
-                .Build())
-        // OUTDOOR_PERMITTED
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::OutdoorPermitted))
-                .SetValue(!!OutdoorPermitted)
-                .Build())
-        // COUNTRY_CODE
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::CountryCode))
-                .SetValue(GetBytesBigEndianFromBitMap(CountryCode, sizeof CountryCode))
-                .Build())
-        // TIMESTAMP
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Timestamp))
-                .SetValue(GetBytesBigEndianFromBitMap(Timestamp, sizeof Timestamp))
-                .Build())
-        // CHANNEL5
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel5))
-                .SetValue(MaximumTransmissionPower.at(Channel::C5))
-                .Build())
-        // CHANNEL6
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel6))
-                .SetValue(MaximumTransmissionPower.at(Channel::C6))
-                .Build())
-        // CHANNEL8
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel8))
-                .SetValue(MaximumTransmissionPower.at(Channel::C8))
-                .Build())
-        // CHANNEL9
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel9))
-                .SetValue(MaximumTransmissionPower.at(Channel::C9))
-                .Build())
-        // CHANNEL10
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel10))
-                .SetValue(MaximumTransmissionPower.at(Channel::C10))
-                .Build())
-        // CHANNEL12
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel12))
-                .SetValue(MaximumTransmissionPower.at(Channel::C12))
-                .Build())
-        // CHANNEL13
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel13))
-                .SetValue(MaximumTransmissionPower.at(Channel::C13))
-                .Build())
-        // CHANNEL14
-        .AddTlv(
-            TlvBer::Builder()
-                .SetTag(notstd::to_underlying(ParameterTag::Channel14))
-                .SetValue(MaximumTransmissionPower.at(Channel::C14))
-                .Build())
-        .Build();
+/**
+ * @brief Field holding the maximum transmission power of a channel.
+ *
+ * @tparam Tag The parameter tag of the channel.
+ * @tparam ChannelValue The channel.
+ */
+template <UwbRegulatoryInformation::ParameterTag Tag, Channel ChannelValue>
+using MaximumTransmissionPowerField = Field<notstd::to_underlying(Tag), &UwbRegulatoryInformation::MaximumTransmissionPower, MapValue<ChannelValue, UnsignedBigEndian<uint8_t>>>;
 
-    return tlvBerResult;
-}
+/**
+ * @brief Schema of the UwbRegulatoryInformation data object.
+ */
+using UwbRegulatoryInformationSchema = Schema<UwbRegulatoryInformation::Tag,
+    // INFORMATION_SOURCE
+    Field<notstd::to_underlying(UwbRegulatoryInformation::ParameterTag::InformationSource), &UwbRegulatoryInformation::Source, Enumeration<UwbRegulatoryInformation::InformationSource, UwbRegulatoryInformation::InformationSource::OtherFiraDevice>>,
+    // OUTDOOR_PERMITTED
+    Field<notstd::to_underlying(UwbRegulatoryInformation::ParameterTag::OutdoorPermitted), &UwbRegulatoryInformation::OutdoorPermitted, Boolean>,
+    // COUNTRY_CODE
+    Field<notstd::to_underlying(UwbRegulatoryInformation::ParameterTag::CountryCode), &UwbRegulatoryInformation::CountryCode, UnsignedBigEndian<uint16_t>>,
+    // TIMESTAMP
+    Field<notstd::to_underlying(UwbRegulatoryInformation::ParameterTag::Timestamp), &UwbRegulatoryInformation::Timestamp, UnsignedBigEndian<uint32_t>>,
+    // CHANNEL5 .. CHANNEL14
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel5, Channel::C5>,
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel6, Channel::C6>,
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel8, Channel::C8>,
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel9, Channel::C9>,
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel10, Channel::C10>,
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel12, Channel::C12>,
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel13, Channel::C13>,
+    MaximumTransmissionPowerField<UwbRegulatoryInformation::ParameterTag::Channel14, Channel::C14>>;
 
-/* static */
+/**
+ * @brief Decodes a UwbRegulatoryInformation object from either an owning TlvBer or a
+ * non-owning TlvBerView.
+ *
+ * @tparam TlvT The type of tlv to decode from.
+ * @param tlvBer
+ * @return UwbRegulatoryInformation
+ */
+template <typename TlvT>
 UwbRegulatoryInformation
-UwbRegulatoryInformation::FromDataObject(const encoding::TlvBer& tlvBer)
+FromDataObject(const TlvT& tlvBer)
 {
-     using encoding::ReadSizeTFromBytesBigEndian;
-
     UwbRegulatoryInformation uwbRegulatoryInformation{};
-    std::unordered_set<ParameterTag> parameterTagsDecoded{};
-    std::vector<encoding::TlvBer> tlvBerValues = tlvBer.GetValues();
-
-    for (const auto &tlvBerValue : tlvBerValues) {
-        auto tagValue = tlvBerValue.GetTag();
-        // All tags for UwbRegulatoryInformation are 1-byte long, so ignore all others.
-        if (std::size(tagValue) != 1) {
-            continue;
-        }
-
-        // Ensure the tag has a corresponding enumeration value.
-        auto parameterTag = magic_enum::enum_cast<ParameterTag>(tagValue.front());
-        if (!parameterTag.has_value()) {
-            continue;
-        }
-
-        // Ensure all values have non-zero payload.
-        bool parameterValueWasDecoded = true;
-        auto& parameterValue = tlvBerValue.GetValue();
-        if (std::empty(parameterValue)) {
-            continue;
-        }
-
-        switch (*parameterTag) {
-        case ParameterTag::InformationSource: {
-            auto valueEnum = magic_enum::enum_cast<InformationSource>(parameterValue.front());
-            if (valueEnum.has_value()) {
-                uwbRegulatoryInformation.Source = *valueEnum;    
-            } else {
-                parameterValueWasDecoded = false;
-            }
-            break;
-        }
-        case ParameterTag::OutdoorPermitted: {
-            uwbRegulatoryInformation.OutdoorPermitted = !!parameterValue.front();
-            break;
-        }
-        case ParameterTag::CountryCode: {
-            uwbRegulatoryInformation.CountryCode = ReadSizeTFromBytesBigEndian<decltype(uwbRegulatoryInformation.CountryCode)>(parameterValue);
-            break;
-        }
-        case ParameterTag::Timestamp: {
-            uwbRegulatoryInformation.Timestamp = ReadSizeTFromBytesBigEndian<decltype(uwbRegulatoryInformation.Timestamp)>(parameterValue);
-            break;
-        }
-        case ParameterTag::Channel5: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C5] = parameterValue.front();
-            break;
-        }
-        case ParameterTag::Channel6: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C6] = parameterValue.front();
-            break;
-        }
-         case ParameterTag::Channel8: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C8] = parameterValue.front();
-            break;
-        }
-        case ParameterTag::Channel9: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C9] = parameterValue.front();
-            break;
-        }
-        case ParameterTag::Channel10: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C10] = parameterValue.front();
-            break;
-        }
-        case ParameterTag::Channel12: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C12] = parameterValue.front();
-            break;
-        }
-        case ParameterTag::Channel13: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C13] = parameterValue.front();
-            break;
-        }
-        case ParameterTag::Channel14: {
-            uwbRegulatoryInformation.MaximumTransmissionPower[Channel::C14] = parameterValue.front();
-            break;
-        }
-        default: {
-            parameterValueWasDecoded = false;
-            break;
-        }
-        }
-
-        if (parameterValueWasDecoded) {
-            parameterTagsDecoded.insert(*parameterTag);
-        }
-    }
-
-    if (std::size(parameterTagsDecoded) < magic_enum::enum_count<ParameterTag>()) {
+    if (!UwbRegulatoryInformationSchema::Decode(tlvBer, uwbRegulatoryInformation)) {
         throw UwbException(UwbStatusGeneric::SyntaxError);
     }
 
     return uwbRegulatoryInformation;
 }
+} // namespace detail
+
+std::unique_ptr<encoding::TlvBer>
+UwbRegulatoryInformation::ToDataObject() const
+{
+    return std::make_unique<encoding::TlvBer>(::detail::UwbRegulatoryInformationSchema::Encode(*this));
+}
+
+/* static */
+UwbRegulatoryInformation
+UwbRegulatoryInformation::FromDataObject(const encoding::TlvBer& tlvBer)
+{
+    return ::detail::FromDataObject(tlvBer);
+}
+
+/* static */
+UwbRegulatoryInformation
+UwbRegulatoryInformation::FromDataObject(const encoding::TlvBerView& tlvBer)
+{
+    return ::detail::FromDataObject(tlvBer);
+}
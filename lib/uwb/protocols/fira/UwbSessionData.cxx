@@ -1,7 +1,9 @@
 
 #include <array>
+#include <bitset>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 #include <magic_enum.hpp>
 #include <notstd/type_traits.hxx>
@@ -17,7 +19,7 @@ using namespace uwb::protocol::fira;
 std::unique_ptr<encoding::TlvBer>
 UwbSessionData::ToDataObject() const
 {
-    using encoding::TlvBer, encoding::GetBytesBigEndianFromBitMap;
+    using encoding::TlvBer, encoding::GetBytesBigEndian;
 
     auto builder = TlvBer::Builder()
                        .SetTag(Tag)
@@ -25,22 +27,22 @@ UwbSessionData::ToDataObject() const
                        .AddTlv(
                            TlvBer::Builder()
                                .SetTag(notstd::to_underlying(ParameterTag::SessionDataVersion))
-                               .SetValue(GetBytesBigEndianFromBitMap(sessionDataVersion, sizeof sessionDataVersion))
+                               .SetValue(GetBytesBigEndian<sizeof sessionDataVersion>(sessionDataVersion))
                                .Build())
                        // UWB_SESSION_ID
                        .AddTlv(
                            TlvBer::Builder()
                                .SetTag(notstd::to_underlying(ParameterTag::SessionId))
-                               .SetValue(GetBytesBigEndianFromBitMap(sessionId, sizeof sessionId))
+                               .SetValue(GetBytesBigEndian<sizeof sessionId>(sessionId))
                                .Build())
                        // UWB_SUB_SESSION_ID
                        .AddTlv(
                            TlvBer::Builder()
                                .SetTag(notstd::to_underlying(ParameterTag::SubSessionId))
-                               .SetValue(GetBytesBigEndianFromBitMap(subSessionId, sizeof subSessionId))
+                               .SetValue(GetBytesBigEndian<sizeof subSessionId>(subSessionId))
                                .Build())
                        // CONFIGURATION_PARAMETERS
-                       .AddTlv(*uwbConfiguration.ToDataObject())
+                       .AddTlv(std::move(*uwbConfiguration.ToDataObject()))
                        // UWB_CONFIG_AVAILABLE
                        .AddTlv(
                            TlvBer::Builder()
@@ -50,42 +52,48 @@ UwbSessionData::ToDataObject() const
 
     // STATIC_RANGING_INFO
     if (staticRangingInfo.has_value()) {
-        builder.AddTlv(*staticRangingInfo->ToDataObject());
+        builder.AddTlv(std::move(*staticRangingInfo->ToDataObject()));
     }
     // SECURE_RANGING_INFO
     if (secureRangingInfo.has_value()) {
-        builder.AddTlv(*secureRangingInfo->ToDataObject());
+        builder.AddTlv(std::move(*secureRangingInfo->ToDataObject()));
     }
     // REGULATORY_INFORMATION
     if (regulatoryInformation.has_value()) {
-        builder.AddTlv(*regulatoryInformation->ToDataObject());
+        builder.AddTlv(std::move(*regulatoryInformation->ToDataObject()));
     }
 
-    auto tlvBerResult = std::make_unique<TlvBer>();
-    *tlvBerResult = builder.Build();
-
-    return tlvBerResult;
+    return std::make_unique<TlvBer>(builder.Build());
 }
 
-/* static */
+namespace detail
+{
+/**
+ * @brief Decodes a UwbSessionData object from either an owning TlvBer or a
+ * non-owning TlvBerView.
+ *
+ * @tparam TlvT The type of tlv to decode from.
+ * @param tlvBer
+ * @return UwbSessionData
+ */
+template <typename TlvT>
 UwbSessionData
-UwbSessionData::FromDataObject(const encoding::TlvBer& tlvBer)
+FromDataObject(const TlvT& tlvBer)
 {
-    static const std::unordered_set<ParameterTag> parameterTagsRequired{
+    using ParameterTag = UwbSessionData::ParameterTag;
+    using encoding::ReadSizeTFromBytesBigEndian;
+
+    static constexpr std::array<ParameterTag, 4> ParameterTagsRequired{
         ParameterTag::SessionDataVersion,
         ParameterTag::SessionId,
         ParameterTag::SubSessionId,
         ParameterTag::ConfigurationParameters,
     };
 
-    using encoding::ReadSizeTFromBytesBigEndian;
-
     UwbSessionData uwbSessionData;
+    std::bitset<magic_enum::enum_count<ParameterTag>()> parameterTagsDecoded{};
 
-    std::vector<encoding::TlvBer> tlvBerValues = tlvBer.GetValues();
-    std::unordered_set<ParameterTag> parameterTagsRequiredNotSeen = parameterTagsRequired;
-
-    for (const auto& tlvBerValue : tlvBerValues) {
+    for (const auto& tlvBerValue : tlvBer.GetValues()) {
         auto tagValue = tlvBerValue.GetTag();
         // All tags for UwbSessionData are 1-byte long, so ignore all others.
         if (std::size(tagValue) != 1) {
@@ -100,7 +108,7 @@ UwbSessionData::FromDataObject(const encoding::TlvBer& tlvBer)
 
         // Ensure all primitive values have non-zero payload.
         bool parameterValueWasDecoded = true;
-        auto& parameterValue = tlvBerValue.GetValue();
+        const auto& parameterValue = tlvBerValue.GetValue();
         if (tlvBerValue.IsPrimitive() && std::empty(parameterValue)) {
             continue;
         }
@@ -145,16 +153,33 @@ UwbSessionData::FromDataObject(const encoding::TlvBer& tlvBer)
         }
 
         if (parameterValueWasDecoded) {
-            parameterTagsRequiredNotSeen.erase(*parameterTag);
+            parameterTagsDecoded.set(*magic_enum::enum_index(*parameterTag));
         }
     }
 
-    if (!std::empty(parameterTagsRequiredNotSeen)) {
-        throw UwbException(UwbStatusGeneric::SyntaxError);
+    for (const auto parameterTagRequired : ParameterTagsRequired) {
+        if (!parameterTagsDecoded.test(*magic_enum::enum_index(parameterTagRequired))) {
+            throw UwbException(UwbStatusGeneric::SyntaxError);
+        }
     }
 
     return uwbSessionData;
 }
+} // namespace detail
+
+/* static */
+UwbSessionData
+UwbSessionData::FromDataObject(const encoding::TlvBer& tlvBer)
+{
+    return ::detail::FromDataObject(tlvBer);
+}
+
+/* static */
+UwbSessionData
+UwbSessionData::FromDataObject(const encoding::TlvBerView& tlvBer)
+{
+    return ::detail::FromDataObject(tlvBer);
+}
 
 /* static */
 UwbSessionData
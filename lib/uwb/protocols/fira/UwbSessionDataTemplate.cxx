@@ -0,0 +1,166 @@
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+#include <notstd/utility.hxx>
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <tlv/TlvSerialize.hxx>
+#include <uwb/protocols/fira/UwbConfiguration.hxx>
+#include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
+#include <uwb/protocols/fira/UwbSessionDataTemplate.hxx>
+
+using namespace uwb::protocol::fira;
+
+namespace detail
+{
+/**
+ * @brief Get the location of the value of a nested TLV within an encoding.
+ *
+ * @param encoding The encoding the view was parsed from.
+ * @param tlv The view of the containing TLV.
+ * @param path The tag path of the nested TLV, starting with the tag of tlv.
+ * @return std::optional<std::pair<std::size_t, std::size_t>> The offset and
+ * length of the value, or std::nullopt if there is no such TLV.
+ */
+std::optional<std::pair<std::size_t, std::size_t>>
+FindValueLocation(std::span<const uint8_t> encoding, const encoding::TlvBerView& tlv, std::initializer_list<uint32_t> path)
+{
+    const auto tlvNested = tlv.Find(path);
+    if (!tlvNested.has_value() || !tlvNested->IsPrimitive()) {
+        return std::nullopt;
+    }
+    const auto value = tlvNested->GetValue();
+    return std::make_pair(static_cast<std::size_t>(value.data() - encoding.data()), value.size());
+}
+
+/**
+ * @brief Determine whether a MAC address can be patched into a location.
+ *
+ * @tparam FieldLocationT The type of location.
+ * @param location The location of the MAC address in the template, if present.
+ * @param macAddress The MAC address to patch, if any.
+ * @return true If the MAC address is unspecified or has the same length as the location.
+ * @return false Otherwise.
+ */
+template <typename FieldLocationT>
+bool
+CanPatchMacAddress(const std::optional<FieldLocationT>& location, const std::optional<uwb::UwbMacAddress>& macAddress) noexcept
+{
+    return !macAddress.has_value() || (location.has_value() && location->Length == macAddress->GetLength());
+}
+} // namespace detail
+
+UwbSessionDataTemplate::UwbSessionDataTemplate(UwbSessionData uwbSessionData) :
+    m_uwbSessionData(std::move(uwbSessionData)),
+    m_encoding(m_uwbSessionData.ToDataObject()->ToBytes())
+{
+    using ParameterTag = UwbSessionData::ParameterTag;
+
+    encoding::TlvBerView tlv{};
+    std::size_t bytesParsed = 0;
+    if (encoding::TlvBer::ParseView(tlv, m_encoding, bytesParsed) != encoding::Tlv::ParseResult::Succeeded) {
+        return;
+    }
+
+    const auto findLocation = [&](std::initializer_list<uint32_t> path) -> std::optional<FieldLocation> {
+        if (const auto location = ::detail::FindValueLocation(m_encoding, tlv, path)) {
+            return FieldLocation{ location->first, location->second };
+        }
+        return std::nullopt;
+    };
+
+    static constexpr uint32_t Tag = UwbSessionData::Tag;
+    static constexpr uint32_t ConfigurationParametersTag = notstd::to_underlying(ParameterTag::ConfigurationParameters);
+    m_sessionIdLocation = findLocation({ Tag, notstd::to_underlying(ParameterTag::SessionId) });
+    m_subSessionIdLocation = findLocation({ Tag, notstd::to_underlying(ParameterTag::SubSessionId) });
+    m_controllerMacAddressLocation = findLocation({ Tag, ConfigurationParametersTag, notstd::to_underlying(UwbConfiguration::ParameterTag::ControllerMacAddress) });
+    m_controleeShortMacAddressLocation = findLocation({ Tag, ConfigurationParametersTag, notstd::to_underlying(UwbConfiguration::ParameterTag::ControleeShortMacAddress) });
+
+    // Session identifiers are always encoded at their full width, so a location of any other size is unusable.
+    if (m_sessionIdLocation.has_value() && m_sessionIdLocation->Length != sizeof m_uwbSessionData.sessionId) {
+        m_sessionIdLocation.reset();
+    }
+    if (m_subSessionIdLocation.has_value() && m_subSessionIdLocation->Length != sizeof m_uwbSessionData.subSessionId) {
+        m_subSessionIdLocation.reset();
+    }
+}
+
+const UwbSessionData&
+UwbSessionDataTemplate::GetSessionData() const noexcept
+{
+    return m_uwbSessionData;
+}
+
+const std::vector<uint8_t>&
+UwbSessionDataTemplate::GetEncoding() const noexcept
+{
+    return m_encoding;
+}
+
+bool
+UwbSessionDataTemplate::CanPatch(const Fields& fields) const noexcept
+{
+    // clang-format off
+    return m_sessionIdLocation.has_value()
+        && m_subSessionIdLocation.has_value()
+        && ::detail::CanPatchMacAddress(m_controllerMacAddressLocation, fields.ControllerMacAddress)
+        && ::detail::CanPatchMacAddress(m_controleeShortMacAddressLocation, fields.ControleeShortMacAddress);
+    // clang-format on
+}
+
+std::vector<uint8_t>
+UwbSessionDataTemplate::Generate(const Fields& fields) const
+{
+    std::vector<uint8_t> encoded;
+    Generate(fields, encoded);
+    return encoded;
+}
+
+void
+UwbSessionDataTemplate::Generate(const Fields& fields, std::vector<uint8_t>& encoded) const
+{
+    using encoding::GetBytesBigEndian;
+
+    if (!CanPatch(fields)) {
+        Encode(fields, encoded);
+        return;
+    }
+
+    encoded.assign(std::cbegin(m_encoding), std::cend(m_encoding));
+
+    const auto patch = [&](const FieldLocation& location, std::span<const uint8_t> value) {
+        std::ranges::copy(value, std::next(std::begin(encoded), static_cast<std::ptrdiff_t>(location.Offset)));
+    };
+
+    patch(*m_sessionIdLocation, GetBytesBigEndian<sizeof fields.SessionId>(fields.SessionId));
+    patch(*m_subSessionIdLocation, GetBytesBigEndian<sizeof fields.SubSessionId>(fields.SubSessionId));
+    if (fields.ControllerMacAddress.has_value()) {
+        patch(*m_controllerMacAddressLocation, fields.ControllerMacAddress->GetValue());
+    }
+    if (fields.ControleeShortMacAddress.has_value()) {
+        patch(*m_controleeShortMacAddressLocation, fields.ControleeShortMacAddress->GetValue());
+    }
+}
+
+void
+UwbSessionDataTemplate::Encode(const Fields& fields, std::vector<uint8_t>& encoded) const
+{
+    auto uwbSessionData = m_uwbSessionData;
+    uwbSessionData.sessionId = fields.SessionId;
+    uwbSessionData.subSessionId = fields.SubSessionId;
+
+    if (fields.ControllerMacAddress.has_value() || fields.ControleeShortMacAddress.has_value()) {
+        UwbConfiguration::Builder builder{ uwbSessionData.uwbConfiguration };
+        if (fields.ControllerMacAddress.has_value()) {
+            builder.SetMacAddressController(*fields.ControllerMacAddress);
+        }
+        if (fields.ControleeShortMacAddress.has_value()) {
+            builder.SetMacAddressControleeShort(*fields.ControleeShortMacAddress);
+        }
+        uwbSessionData.uwbConfiguration = builder;
+    }
+
+    encoded = uwbSessionData.ToDataObject()->ToBytes();
+}
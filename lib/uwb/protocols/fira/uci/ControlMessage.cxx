@@ -1,4 +1,120 @@
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
 #include <uwb/protocols/fira/uci/ControlMessage.hxx>
 
 using namespace uwb::protocol::fira::uci;
+
+const MessageDescriptor*
+ControlMessage::GetDescriptor() const noexcept
+{
+    return LookupMessageDescriptor(Gid, Oid);
+}
+
+std::optional<StatusCode>
+ControlMessage::GetStatus() const noexcept
+{
+    if (Type != MessageType::Response || std::empty(Payload)) {
+        return std::nullopt;
+    }
+
+    return static_cast<StatusCode>(Payload.front());
+}
+
+std::size_t
+ControlMessage::GetNumPackets(std::size_t payloadSizeMaximum) const noexcept
+{
+    if (std::empty(Payload) || payloadSizeMaximum == 0) {
+        return 1;
+    }
+
+    return (std::size(Payload) + payloadSizeMaximum - 1) / payloadSizeMaximum;
+}
+
+void
+ControlMessage::Encode(std::vector<uint8_t>& output, std::size_t payloadSizeMaximum) const
+{
+    if (payloadSizeMaximum == 0 || payloadSizeMaximum > ControlPacket::PayloadSizeMaximum) {
+        throw std::invalid_argument("invalid uci control packet payload size");
+    }
+
+    const auto numPackets = GetNumPackets(payloadSizeMaximum);
+    output.reserve(std::size(output) + (numPackets * ControlPacket::HeaderSize) + std::size(Payload));
+
+    ControlPacket packet{
+        .Type = Type,
+        .Gid = Gid,
+        .Oid = Oid,
+    };
+
+    auto payload = Payload;
+    do {
+        const auto payloadSize = std::min(std::size(payload), payloadSizeMaximum);
+        packet.Payload = payload.first(payloadSize);
+        payload = payload.subspan(payloadSize);
+        packet.PacketBoundaryFlag = !std::empty(payload);
+        packet.Encode(output);
+    } while (!std::empty(payload));
+}
+
+ControlMessageReassembler::ControlMessageReassembler(std::size_t payloadSizeMaximum) :
+    m_payloadSizeMaximum(payloadSizeMaximum)
+{}
+
+std::optional<ControlMessage>
+ControlMessageReassembler::Push(const ControlPacket& packet)
+{
+    const ControlMessage header{
+        .Type = packet.Type,
+        .Gid = packet.Gid,
+        .Oid = packet.Oid,
+    };
+
+    if (m_message.has_value() && (m_message->Type != header.Type || m_message->Gid != header.Gid || m_message->Oid != header.Oid)) {
+        Reset();
+    }
+
+    // Fast path: unsegmented messages refer directly to the packet payload.
+    if (!m_message.has_value() && !packet.PacketBoundaryFlag) {
+        auto message = header;
+        message.Payload = packet.Payload;
+        return message;
+    }
+
+    if (!m_message.has_value()) {
+        m_payload.clear();
+        m_message = header;
+    }
+
+    if (std::size(m_payload) + std::size(packet.Payload) > m_payloadSizeMaximum) {
+        Reset();
+        throw std::length_error("uci control message payload exceeds maximum size");
+    }
+
+    m_payload.insert(std::cend(m_payload), std::cbegin(packet.Payload), std::cend(packet.Payload));
+    if (packet.PacketBoundaryFlag) {
+        return std::nullopt;
+    }
+
+    // The buffer is only cleared when the next segmented message starts, so
+    // the returned view remains valid until then.
+    auto message = *m_message;
+    message.Payload = m_payload;
+    m_message.reset();
+    return message;
+}
+
+void
+ControlMessageReassembler::Reset() noexcept
+{
+    m_message.reset();
+    m_payload.clear();
+}
+
+bool
+ControlMessageReassembler::HasPartialMessage() const noexcept
+{
+    return m_message.has_value();
+}
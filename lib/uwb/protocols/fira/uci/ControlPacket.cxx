@@ -0,0 +1,49 @@
+
+#include <iterator>
+#include <stdexcept>
+
+#include <uwb/protocols/fira/uci/ControlPacket.hxx>
+
+using namespace uwb::protocol::fira::uci;
+
+void
+ControlPacket::Encode(std::vector<uint8_t>& output) const
+{
+    if (std::size(Payload) > PayloadSizeMaximum) {
+        throw std::length_error("uci control packet payload exceeds maximum size");
+    }
+
+    const auto header = EncodeHeader();
+    output.insert(std::cend(output), std::cbegin(header), std::cend(header));
+    output.insert(std::cend(output), std::cbegin(Payload), std::cend(Payload));
+}
+
+/* static */
+std::optional<ControlPacket>
+ControlPacket::Decode(std::span<const uint8_t> data, std::size_t& bytesParsed) noexcept
+{
+    if (std::size(data) < HeaderSize) {
+        return std::nullopt;
+    }
+
+    // Data packets have a different header layout, and message types above
+    // Notification are reserved.
+    const auto messageType = static_cast<uint8_t>(data[0] >> BitShiftMessageType);
+    if (messageType == static_cast<uint8_t>(MessageType::Data) || messageType > static_cast<uint8_t>(MessageType::Notification)) {
+        return std::nullopt;
+    }
+
+    const std::size_t payloadLength = data[3];
+    if (std::size(data) - HeaderSize < payloadLength) {
+        return std::nullopt;
+    }
+
+    bytesParsed = HeaderSize + payloadLength;
+    return ControlPacket{
+        .Type = static_cast<MessageType>(messageType),
+        .PacketBoundaryFlag = (data[0] & BitmaskPacketBoundaryFlag) != 0,
+        .Gid = static_cast<GroupId>(data[0] & BitmaskGroupId),
+        .Oid = static_cast<uint8_t>(data[1] & BitmaskOpcodeId),
+        .Payload = data.subspan(HeaderSize, payloadLength),
+    };
+}
@@ -0,0 +1,240 @@
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <stdexcept>
+
+#include <uwb/protocols/fira/uci/RangeDataNotification.hxx>
+#include <uwb/protocols/fira/uci/StatusCodes.hxx>
+
+using namespace uwb::protocol::fira;
+using namespace uwb::protocol::fira::uci;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace detail
+{
+/**
+ * @brief Offsets of the fields of the fixed part of the payload.
+ */
+constexpr std::size_t OffsetSequenceNumber = 0;
+constexpr std::size_t OffsetSessionId = 4;
+constexpr std::size_t OffsetCurrentRangingInterval = 9;
+constexpr std::size_t OffsetRangingMeasurementType = 13;
+constexpr std::size_t OffsetMacAddressingMode = 15;
+constexpr std::size_t OffsetNumberOfMeasurements = 24;
+
+/**
+ * @brief Offsets of the fields of a measurement, relative to the end of the
+ * peer MAC address.
+ */
+constexpr std::size_t OffsetStatus = 0;
+constexpr std::size_t OffsetLineOfSight = 1;
+constexpr std::size_t OffsetDistance = 2;
+constexpr std::size_t OffsetAoAAzimuth = 4;
+constexpr std::size_t OffsetAoAElevation = 7;
+constexpr std::size_t OffsetAoADestinationAzimuth = 10;
+constexpr std::size_t OffsetAoADestinationElevation = 13;
+constexpr std::size_t OffsetSlotIndex = 16;
+
+constexpr uint8_t RangingMeasurementTypeTwoWay = 0x01;
+constexpr uint8_t MacAddressingModeShort = 0x00;
+constexpr uint8_t MacAddressingModeExtended = 0x01;
+constexpr uint8_t LineOfSight = 0x00;
+constexpr uint8_t NonLineOfSight = 0x01;
+constexpr uint8_t LineOfSightIndeterminant = 0xFF;
+
+/**
+ * @brief Read a little endian value from the start of the specified data.
+ *
+ * @tparam IntegerT The type of the value to read.
+ * @param data The data to read from. Must hold at least sizeof(IntegerT)
+ * octets.
+ * @return IntegerT
+ */
+template <typename IntegerT>
+IntegerT
+ReadLittleEndian(std::span<const uint8_t> data) noexcept
+{
+    IntegerT value = 0;
+    for (std::size_t i = 0; i < sizeof(IntegerT); i++) {
+        value |= static_cast<IntegerT>(static_cast<IntegerT>(data[i]) << (i * CHAR_BIT));
+    }
+    return value;
+}
+
+/**
+ * @brief Append a little endian value to the specified buffer.
+ *
+ * @tparam IntegerT The type of the value to write.
+ * @param value The value to write.
+ * @param data The buffer to append to.
+ */
+template <typename IntegerT>
+void
+WriteLittleEndian(IntegerT value, std::vector<uint8_t>& data)
+{
+    for (std::size_t i = 0; i < sizeof(IntegerT); i++) {
+        data.push_back(static_cast<uint8_t>(value >> (i * CHAR_BIT)));
+    }
+}
+
+/**
+ * @brief Decode an angle of arrival and its figure of merit in place.
+ *
+ * @param data The data starting with the angle of arrival.
+ * @param measurementData The measurement data to decode into.
+ */
+void
+DecodeAoA(std::span<const uint8_t> data, UwbRangingMeasurementData& measurementData) noexcept
+{
+    measurementData.Result = ReadLittleEndian<uint16_t>(data);
+    // A figure of merit of 0 indicates the value is unavailable.
+    if (data[2] != 0) {
+        measurementData.FigureOfMerit = data[2];
+    } else {
+        measurementData.FigureOfMerit.reset();
+    }
+}
+
+/**
+ * @brief Append an angle of arrival and its figure of merit to a buffer.
+ *
+ * @param measurementData The measurement data to encode.
+ * @param data The buffer to append to.
+ */
+void
+EncodeAoA(const UwbRangingMeasurementData& measurementData, std::vector<uint8_t>& data)
+{
+    WriteLittleEndian(measurementData.Result, data);
+    data.push_back(measurementData.FigureOfMerit.value_or(0));
+}
+
+/**
+ * @brief Decode a two-way ranging measurement in place.
+ *
+ * @tparam AddressType The type of the peer MAC address.
+ * @param data The encoded measurement.
+ * @param measurement The measurement to decode into.
+ */
+template <typename AddressType>
+void
+DecodeMeasurement(std::span<const uint8_t> data, UwbRangingMeasurement& measurement) noexcept
+{
+    AddressType address{};
+    std::copy_n(std::cbegin(data), std::size(address), std::begin(address));
+    measurement.PeerMacAddress = uwb::UwbMacAddress{ address };
+
+    const auto fields = data.subspan(std::size(address));
+    measurement.Status = ToUwbStatus(static_cast<StatusCode>(fields[OffsetStatus])).value_or(UwbStatusGeneric::Failed);
+    switch (fields[OffsetLineOfSight]) {
+    case LineOfSight:
+        measurement.LineOfSightIndicator = UwbLineOfSightIndicator::LineOfSight;
+        break;
+    case NonLineOfSight:
+        measurement.LineOfSightIndicator = UwbLineOfSightIndicator::NonLineOfSight;
+        break;
+    default:
+        measurement.LineOfSightIndicator = UwbLineOfSightIndicator::Indeterminant;
+        break;
+    }
+    measurement.Distance = ReadLittleEndian<uint16_t>(fields.subspan(OffsetDistance));
+    DecodeAoA(fields.subspan(OffsetAoAAzimuth), measurement.AoAAzimuth);
+    DecodeAoA(fields.subspan(OffsetAoAElevation), measurement.AoAElevation);
+    DecodeAoA(fields.subspan(OffsetAoADestinationAzimuth), measurement.AoaDestinationAzimuth);
+    DecodeAoA(fields.subspan(OffsetAoADestinationElevation), measurement.AoaDestinationElevation);
+    measurement.SlotIndex = fields[OffsetSlotIndex];
+}
+} // namespace detail
+
+/* static */
+bool
+RangeDataNotification::Decode(std::span<const uint8_t> payload, UwbRangingData& rangingData)
+{
+    if (std::size(payload) < HeaderSize || payload[::detail::OffsetRangingMeasurementType] != ::detail::RangingMeasurementTypeTwoWay) {
+        return false;
+    }
+
+    const auto macAddressingMode = payload[::detail::OffsetMacAddressingMode];
+    if (macAddressingMode != ::detail::MacAddressingModeShort && macAddressingMode != ::detail::MacAddressingModeExtended) {
+        return false;
+    }
+
+    const std::size_t numMeasurements = payload[::detail::OffsetNumberOfMeasurements];
+    if (std::size(payload) != HeaderSize + (numMeasurements * MeasurementSize)) {
+        return false;
+    }
+
+    rangingData.SequenceNumber = ::detail::ReadLittleEndian<uint32_t>(payload.subspan(::detail::OffsetSequenceNumber));
+    rangingData.SessionId = ::detail::ReadLittleEndian<uint32_t>(payload.subspan(::detail::OffsetSessionId));
+    rangingData.CurrentRangingInterval = ::detail::ReadLittleEndian<uint32_t>(payload.subspan(::detail::OffsetCurrentRangingInterval));
+    rangingData.RangingMeasurementType = UwbRangingMeasurementType::TwoWay;
+
+    // Measurements beyond the current size are value-initialized within the
+    // retained capacity, then overwritten below.
+    rangingData.RangingMeasurements.resize(numMeasurements);
+    auto measurementData = payload.subspan(HeaderSize);
+    for (auto& measurement : rangingData.RangingMeasurements) {
+        if (macAddressingMode == ::detail::MacAddressingModeShort) {
+            ::detail::DecodeMeasurement<uwb::UwbMacAddress::ShortType>(measurementData, measurement);
+        } else {
+            ::detail::DecodeMeasurement<uwb::UwbMacAddress::ExtendedType>(measurementData, measurement);
+        }
+        measurementData = measurementData.subspan(MeasurementSize);
+    }
+
+    return true;
+}
+
+/* static */
+void
+RangeDataNotification::Encode(const UwbRangingData& rangingData, std::vector<uint8_t>& payload)
+{
+    const auto& measurements = rangingData.RangingMeasurements;
+    const auto addressType = std::empty(measurements) ? uwb::UwbMacAddressType::Short : measurements.front().PeerMacAddress.GetType();
+    if (std::ranges::any_of(measurements, [&](const auto& measurement) { return measurement.PeerMacAddress.GetType() != addressType; })) {
+        throw std::invalid_argument("range data peer addresses must all be of the same type");
+    }
+    if (std::size(measurements) > UINT8_MAX) {
+        throw std::invalid_argument("too many range data measurements");
+    }
+
+    payload.reserve(std::size(payload) + HeaderSize + (std::size(measurements) * MeasurementSize));
+    ::detail::WriteLittleEndian(rangingData.SequenceNumber, payload);
+    ::detail::WriteLittleEndian(rangingData.SessionId, payload);
+    payload.push_back(0x00); // RCR indicator
+    ::detail::WriteLittleEndian(rangingData.CurrentRangingInterval, payload);
+    payload.push_back(::detail::RangingMeasurementTypeTwoWay);
+    payload.push_back(0x00); // RFU
+    payload.push_back((addressType == uwb::UwbMacAddressType::Short) ? ::detail::MacAddressingModeShort : ::detail::MacAddressingModeExtended);
+    payload.insert(std::cend(payload), 8, 0x00); // RFU
+    payload.push_back(static_cast<uint8_t>(std::size(measurements)));
+
+    for (const auto& measurement : measurements) {
+        const auto measurementBegin = std::size(payload);
+        const auto address = measurement.PeerMacAddress.GetValue();
+        payload.insert(std::cend(payload), std::cbegin(address), std::cend(address));
+        payload.push_back(static_cast<uint8_t>(ToStatusCode(measurement.Status)));
+        switch (measurement.LineOfSightIndicator) {
+        case UwbLineOfSightIndicator::LineOfSight:
+            payload.push_back(::detail::LineOfSight);
+            break;
+        case UwbLineOfSightIndicator::NonLineOfSight:
+            payload.push_back(::detail::NonLineOfSight);
+            break;
+        default:
+            payload.push_back(::detail::LineOfSightIndeterminant);
+            break;
+        }
+        ::detail::WriteLittleEndian(measurement.Distance, payload);
+        ::detail::EncodeAoA(measurement.AoAAzimuth, payload);
+        ::detail::EncodeAoA(measurement.AoAElevation, payload);
+        ::detail::EncodeAoA(measurement.AoaDestinationAzimuth, payload);
+        ::detail::EncodeAoA(measurement.AoaDestinationElevation, payload);
+        payload.push_back(measurement.SlotIndex);
+        // RSSI and RFU.
+        payload.resize(measurementBegin + MeasurementSize, 0x00);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
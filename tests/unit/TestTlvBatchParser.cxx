@@ -0,0 +1,190 @@
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvBatchParser.hxx>
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace encoding::test
+{
+/**
+ * @brief Build an archive of concatenated constructed BER-TLV blobs,
+ * resembling encoded session data objects.
+ *
+ * @param numBlobs The number of blobs in the archive.
+ * @return std::vector<uint8_t>
+ */
+std::vector<uint8_t>
+buildBerArchive(std::size_t numBlobs)
+{
+    std::vector<uint8_t> archive;
+    TlvBer::Builder builder{};
+    TlvBer::Builder builderGroup{};
+    TlvBer::Builder builderParameter{};
+    for (std::size_t i = 0; i < numBlobs; i++) {
+        builder.Reset().SetTag(uint16_t{ 0xBF78 });
+        for (uint8_t group = 0; group < 4; group++) {
+            builderGroup.Reset().SetTag(uint8_t{ 0xA0 });
+            for (uint8_t parameter = 0; parameter < 6; parameter++) {
+                const std::vector<uint8_t> value{ static_cast<uint8_t>(i), group, parameter };
+                builderGroup.AddTlv(builderParameter.Reset().SetTag(static_cast<uint8_t>(0x80 + parameter)).SetValue(value).Build());
+            }
+            builder.AddTlv(builderGroup.Build());
+        }
+        auto blob = builder.Build().ToBytes();
+        archive.insert(std::cend(archive), std::cbegin(blob), std::cend(blob));
+    }
+
+    return archive;
+}
+} // namespace encoding::test
+
+TEST_CASE("TlvBatchParser parses concatenated records", "[basic][infra]")
+{
+    using namespace encoding;
+    using namespace encoding::test;
+
+    std::vector<TlvRecord> records;
+
+    SECTION("SIMPLE-TLV records are parsed with their offsets")
+    {
+        const std::vector<uint8_t> longValue(300, 0xA5);
+        std::vector<uint8_t> data{ 0x01, 0x03, 0x0A, 0x0B, 0x0C, 0x02, 0xFF, 0x01, 0x2C };
+        data.insert(std::cend(data), std::cbegin(longValue), std::cend(longValue));
+        data.insert(std::cend(data), { 0x03, 0x00 });
+
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Simple, data, records) == Tlv::ParseResult::Succeeded);
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[0].Offset == 0);
+        REQUIRE(records[0].Tag[0] == 0x01);
+        REQUIRE(std::vector<uint8_t>(std::cbegin(records[0].Value), std::cend(records[0].Value)) == std::vector<uint8_t>{ 0x0A, 0x0B, 0x0C });
+        REQUIRE(records[1].Offset == 5);
+        REQUIRE(records[1].EncodedSize() == 304);
+        REQUIRE(std::vector<uint8_t>(std::cbegin(records[1].Value), std::cend(records[1].Value)) == longValue);
+        REQUIRE(records[2].Offset == 309);
+        REQUIRE(records[2].Value.empty());
+    }
+
+    SECTION("BER-TLV records refer to the parsed buffer")
+    {
+        const std::vector<uint8_t> data{
+            0x9F, 0x20, 0x02, 0xAA, 0xBB,
+            0xBF, 0x78, 0x07, 0x80, 0x01, 0x01, 0x81, 0x02, 0x02, 0x03,
+            0x05, 0x00
+        };
+
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, data, records) == Tlv::ParseResult::Succeeded);
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[0].Tag.size() == 2);
+        REQUIRE(records[0].Value.data() == std::data(data) + 3);
+        REQUIRE(records[1].Offset == 5);
+        REQUIRE(records[1].EncodedSize() == 10);
+        REQUIRE(records[2].Offset == 15);
+
+        // A validated record can be viewed without further checks.
+        TlvBerView view{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::ParseView(view, std::span<const uint8_t>(data).subspan(records[1].Offset, records[1].EncodedSize()), bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(view.Find(0x81).has_value());
+    }
+
+    SECTION("parsing stops at the first invalid record")
+    {
+        // Truncated value.
+        const std::vector<uint8_t> truncated{ 0x01, 0x01, 0xAA, 0x02, 0x03, 0xBB };
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Simple, truncated, records) == Tlv::ParseResult::Failed);
+        REQUIRE(records.size() == 1);
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, truncated, records) == Tlv::ParseResult::Failed);
+        REQUIRE(records.size() == 1);
+
+        // Constructed record whose child overruns its parent.
+        const std::vector<uint8_t> invalidChild{ 0x01, 0x00, 0x21, 0x02, 0x01, 0x05, 0x01, 0x00 };
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, invalidChild, records) == Tlv::ParseResult::Failed);
+        REQUIRE(records.size() == 1);
+    }
+
+    SECTION("parallel parsing matches sequential parsing")
+    {
+        auto archive = buildBerArchive(500);
+        std::vector<TlvRecord> recordsParallel;
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, archive, records) == Tlv::ParseResult::Succeeded);
+        REQUIRE(records.size() == 500);
+
+        for (const std::size_t numThreads : { 1, 2, 3, 7 }) {
+            REQUIRE(TlvBatchParser::ParseParallel(TlvBatchParser::Encoding::Ber, archive, recordsParallel, numThreads, 1) == Tlv::ParseResult::Succeeded);
+            REQUIRE(recordsParallel.size() == records.size());
+            for (std::size_t i = 0; i < records.size(); i++) {
+                REQUIRE(recordsParallel[i].Offset == records[i].Offset);
+                REQUIRE(recordsParallel[i].Tag.data() == records[i].Tag.data());
+                REQUIRE(recordsParallel[i].Value.data() == records[i].Value.data());
+                REQUIRE(recordsParallel[i].Value.size() == records[i].Value.size());
+            }
+        }
+
+        // Corrupt the first child of a record near the end so that only its
+        // nested structure is invalid.
+        const auto& recordInvalid = records[400];
+        const auto childLengthOffset = static_cast<std::size_t>(std::data(recordInvalid.Value) - std::data(archive)) + 1;
+        archive[childLengthOffset] = 0x7F;
+        REQUIRE(TlvBatchParser::ParseParallel(TlvBatchParser::Encoding::Ber, archive, recordsParallel, 4, 1) == Tlv::ParseResult::Failed);
+        REQUIRE(recordsParallel.size() == 400);
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, archive, records) == Tlv::ParseResult::Failed);
+        REQUIRE(records.size() == 400);
+    }
+
+    SECTION("the output capacity is reused")
+    {
+        const auto archive = buildBerArchive(64);
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, archive, records) == Tlv::ParseResult::Succeeded);
+        const auto* recordsData = std::data(records);
+        REQUIRE(TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, archive, records) == Tlv::ParseResult::Succeeded);
+        REQUIRE(std::data(records) == recordsData);
+    }
+}
+
+TEST_CASE("TlvBatchParser performance", "[.][benchmark][infra]")
+{
+    using namespace encoding;
+    using namespace encoding::test;
+
+    auto archive = buildBerArchive(4096);
+    std::vector<TlvRecord> records;
+
+    BENCHMARK("TlvBer::Parse per blob")
+    {
+        std::size_t numBlobs = 0;
+        std::span<uint8_t> data{ archive };
+        while (!data.empty()) {
+            TlvBer tlv{};
+            std::size_t bytesParsed = 0;
+            if (TlvBer::Parse(tlv, data, bytesParsed) != Tlv::ParseResult::Succeeded) {
+                break;
+            }
+            data = data.subspan(bytesParsed);
+            numBlobs++;
+        }
+        return numBlobs;
+    };
+
+    BENCHMARK("TlvBatchParser::Parse")
+    {
+        TlvBatchParser::Parse(TlvBatchParser::Encoding::Ber, archive, records);
+        return records.size();
+    };
+
+    BENCHMARK("TlvBatchParser::ParseParallel")
+    {
+        TlvBatchParser::ParseParallel(TlvBatchParser::Encoding::Ber, archive, records);
+        return records.size();
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
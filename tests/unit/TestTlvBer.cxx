@@ -4,13 +4,17 @@
 #include <climits>
 #include <cstdint>
 #include <iterator>
+#include <memory_resource>
+#include <optional>
 #include <random>
 #include <vector>
 
 #include <notstd/unique_ptr_out.hxx>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
 
@@ -35,16 +39,131 @@ getOctets(size_t length)
 
     return holder;
 }
+
+static constexpr std::array<uint8_t, 2> tagTwoBytesPrimitive{ 0b11011111, 0x24 };
+static constexpr std::array<uint8_t, 2> tagTwoBytesConstructed{ 0xFF, 0x24 };
+static constexpr std::array<uint8_t, 3> tagThreeBytesPrimitive{ 0b11011111, 0x94, 0x17 };
+static constexpr std::array<uint8_t, 2> valueTwoBytes{ 0x91, 0x92 };
+static constexpr std::array<uint8_t, 3> valueThreeBytes{ 0x91, 0x92, 0x93 };
+static constexpr std::array<uint8_t, 5> valueFiveBytes{ 0x91, 0x92, 0x93, 0x94, 0x95 };
+
+/**
+ * @brief Replaces the default memory resource for the lifetime of the object.
+ */
+struct ScopedDefaultResource
+{
+    explicit ScopedDefaultResource(std::pmr::memory_resource* resource) :
+        ResourcePrevious(std::pmr::set_default_resource(resource))
+    {}
+
+    ~ScopedDefaultResource()
+    {
+        std::pmr::set_default_resource(ResourcePrevious);
+    }
+
+    ScopedDefaultResource(const ScopedDefaultResource&) = delete;
+    ScopedDefaultResource&
+    operator=(const ScopedDefaultResource&) = delete;
+
+    std::pmr::memory_resource* ResourcePrevious;
+};
+
+/**
+ * @brief Memory resource that counts the allocations made from it and the
+ * bytes still allocated.
+ */
+struct CountingResource : public std::pmr::memory_resource
+{
+    std::size_t NumAllocations{ 0 };
+    std::size_t NumBytesInUse{ 0 };
+
+private:
+    void*
+    do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        NumAllocations++;
+        NumBytesInUse += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void
+    do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        NumBytesInUse -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool
+    do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief Builds a two level constructed tlv from the test payloads, using the
+ * specified builder.
+ *
+ * @param builder The builder to use.
+ * @return TlvBer
+ */
+TlvBer
+buildTwoLevelConstructedTlv(TlvBer::Builder& builder)
+{
+    auto child = builder
+                     .Reset()
+                     .SetTag(tagTwoBytesPrimitive)
+                     .SetValue(valueTwoBytes)
+                     .Build();
+    auto child2 = builder
+                      .Reset()
+                      .SetTag(tagThreeBytesPrimitive)
+                      .SetValue(valueFiveBytes)
+                      .Build();
+    auto parent = builder
+                      .Reset()
+                      .SetTag(tagTwoBytesConstructed)
+                      .AddTlv(child)
+                      .AddTlv(child2)
+                      .Build();
+    return builder
+        .Reset()
+        .SetTag(tagTwoBytesConstructed)
+        .AddTlv(child)
+        .AddTlv(child2)
+        .AddTlv(parent)
+        .Build();
+}
+
+/**
+ * @brief Builds a constructed tlv resembling a configuration: numGroups
+ * constructed groups, each holding numParameters primitive parameters.
+ *
+ * @param builder The builder to use for the top-level tlv.
+ * @param builderGroup The builder to use for the groups.
+ * @param builderParameter The builder to use for the parameters.
+ * @param numGroups The number of groups.
+ * @param numParameters The number of parameters in each group.
+ * @return TlvBer
+ */
+TlvBer
+buildNestedConfigurationTlv(TlvBer::Builder& builder, TlvBer::Builder& builderGroup, TlvBer::Builder& builderParameter, std::size_t numGroups, std::size_t numParameters)
+{
+    builder.Reset().SetTag(tagTwoBytesConstructed);
+    for (std::size_t i = 0; i < numGroups; i++) {
+        builderGroup.Reset().SetTag(uint8_t{ 0xA0 });
+        for (std::size_t j = 0; j < numParameters; j++) {
+            builderGroup.AddTlv(builderParameter.Reset().SetTag(static_cast<uint8_t>(0x80 + j)).SetValue(valueThreeBytes).Build());
+        }
+        builder.AddTlv(builderGroup.Build());
+    }
+    return builder.Build();
+}
 } // namespace encoding::test 
 
 TEST_CASE("test TlvBer", "[basic][infra]")
 {
-    static constexpr std::array<uint8_t, 2> tagTwoBytesPrimitive{ 0b11011111, 0x24 };
-    static constexpr std::array<uint8_t, 2> tagTwoBytesConstructed{ 0xFF, 0x24 };
-    static constexpr std::array<uint8_t, 3> tagThreeBytesPrimitive{ 0b11011111, 0x94, 0x17 };
-    static constexpr std::array<uint8_t, 2> valueTwoBytes{ 0x91, 0x92 };
-    static constexpr std::array<uint8_t, 3> valueThreeBytes{ 0x91, 0x92, 0x93 };
-    static constexpr std::array<uint8_t, 5> valueFiveBytes{ 0x91, 0x92, 0x93, 0x94, 0x95 };
+    using namespace encoding::test;
 
     static constexpr std::size_t minSizeForTwoLengthOctets = 128;
     static constexpr std::size_t minSizeForThreeLengthOctets = 256;
@@ -222,6 +341,27 @@ TEST_CASE("test TlvBer", "[basic][infra]")
         }
     }
 
+    SECTION("encoding a TlvBer with a value that requires 2,3,4,5 length octets writes the expected length")
+    {
+        TlvBer::Builder builder{};
+        for (const auto &[numMinBytes, minSize] : minSizesForLengthOctets) {
+            const auto valueOctets = test::getOctets(minSize);
+            const auto tlvBer = builder
+                              .Reset()
+                              .SetTag(tagThreeBytesPrimitive)
+                              .SetValue(valueOctets)
+                              .Build();
+
+            const auto lengthEncoding = TlvBer::GetLengthEncoding(minSize);
+            REQUIRE(TlvBer::GetLengthEncodingSize(minSize) == std::size(lengthEncoding));
+
+            const auto bytes = tlvBer.ToBytes();
+            REQUIRE(std::size(bytes) == tlvBer.EncodedSize());
+            REQUIRE(std::size(bytes) == std::size(tagThreeBytesPrimitive) + std::size(lengthEncoding) + minSize);
+            REQUIRE(std::equal(std::cbegin(lengthEncoding), std::cend(lengthEncoding), std::cbegin(bytes) + std::size(tagThreeBytesPrimitive)));
+        }
+    }
+
     SECTION("resetting TlvBer::Builder works as expected")
     {
         TlvBer::Builder builder{};
@@ -412,6 +552,459 @@ TEST_CASE("test TlvBer", "[basic][infra]")
         REQUIRE(std::equal(std::cbegin(pValuesConstructed), std::cend(pValuesConstructed), std::cbegin(pValuesConstructedParsed)));
     }
 
+    SECTION("EncodedSize, WriteTo and AppendTo agree with ToBytes for a two level constructed tlv")
+    {
+        TlvBer::Builder builder{};
+        auto child = builder
+                         .SetTag(tagTwoBytesPrimitive)
+                         .SetValue(test::getOctets(minSizeForTwoLengthOctets))
+                         .Build();
+        auto child2 = builder
+                          .Reset()
+                          .SetTag(tagThreeBytesPrimitive)
+                          .SetValue(valueTwoBytes)
+                          .Build();
+        auto parent = builder
+                          .Reset()
+                          .SetTag(tagTwoBytesConstructed)
+                          .AddTlv(child)
+                          .AddTlv(child2)
+                          .Build();
+        auto parentparent = builder
+                                .Reset()
+                                .SetTag(tagTwoBytesConstructed)
+                                .AddTlv(child2)
+                                .AddTlv(parent)
+                                .Build();
+
+        const auto bytes = parentparent.ToBytes();
+        REQUIRE(parentparent.EncodedSize() == std::size(bytes));
+        REQUIRE(parent.EncodedSize() + child2.EncodedSize() + std::size(tagTwoBytesConstructed) + TlvBer::GetLengthEncodingSize(parent.EncodedSize() + child2.EncodedSize()) == std::size(bytes));
+
+        std::vector<uint8_t> buffer(std::size(bytes));
+        REQUIRE(parentparent.WriteTo(buffer) == std::size(bytes));
+        REQUIRE(buffer == bytes);
+
+        std::vector<uint8_t> bufferTooSmall(std::size(bytes) - 1, 0xAA);
+        REQUIRE(parentparent.WriteTo(bufferTooSmall) == 0);
+        REQUIRE(std::ranges::all_of(bufferTooSmall, [](auto b) {
+            return b == 0xAA;
+        }));
+
+        std::vector<uint8_t> prefix{ 0x01, 0x02, 0x03 };
+        auto appended = prefix;
+        parentparent.AppendTo(appended);
+        REQUIRE(std::size(appended) == std::size(prefix) + std::size(bytes));
+        REQUIRE(std::equal(std::cbegin(prefix), std::cend(prefix), std::cbegin(appended)));
+        REQUIRE(std::equal(std::cbegin(bytes), std::cend(bytes), std::cbegin(appended) + static_cast<std::ptrdiff_t>(std::size(prefix))));
+    }
+
+    SECTION("EncodedSize of an empty TlvBer is the size of its length")
+    {
+        TlvBer tlvBer{};
+        REQUIRE(tlvBer.EncodedSize() == 1);
+        REQUIRE(tlvBer.ToBytes() == std::vector<uint8_t>{ 0x00 });
+    }
+
+    SECTION("Parsing into a TlvBer with a memory resource allocates only from that resource")
+    {
+        TlvBer::Builder builder{};
+        auto tlvBer = buildTwoLevelConstructedTlv(builder);
+        auto tlvBerBytes = tlvBer.ToBytes();
+
+        std::array<std::byte, 4096> buffer{};
+        std::pmr::monotonic_buffer_resource resource{ std::data(buffer), std::size(buffer), std::pmr::null_memory_resource() };
+        TlvBer tlvParsed{ TlvBer::allocator_type{ &resource } };
+        std::size_t bytesParsed = 0;
+        Tlv::ParseResult presult;
+        {
+            // Any allocation not made from resource will throw.
+            ScopedDefaultResource resourceDefault{ std::pmr::null_memory_resource() };
+            presult = TlvBer::Parse(tlvParsed, tlvBerBytes, bytesParsed);
+        }
+
+        REQUIRE(presult == Tlv::ParseResult::Succeeded);
+        REQUIRE(tlvParsed == tlvBer);
+        REQUIRE(tlvParsed.get_allocator().resource() == &resource);
+        REQUIRE(tlvParsed.GetValues().back().get_allocator().resource() == &resource);
+        REQUIRE(tlvParsed.GetValues().back().GetValues().front().get_allocator().resource() == &resource);
+    }
+
+    SECTION("Building a TlvBer with a memory resource allocates only from that resource")
+    {
+        std::array<std::byte, 4096> buffer{};
+        std::pmr::monotonic_buffer_resource resource{ std::data(buffer), std::size(buffer), std::pmr::null_memory_resource() };
+        TlvBer::Builder builder{ &resource };
+        TlvBer::Builder builderDefault{};
+        std::optional<TlvBer> tlvBer;
+        {
+            // Any allocation not made from resource will throw.
+            ScopedDefaultResource resourceDefault{ std::pmr::null_memory_resource() };
+            tlvBer.emplace(buildTwoLevelConstructedTlv(builder));
+        }
+
+        REQUIRE(tlvBer->get_allocator().resource() == &resource);
+        REQUIRE(*tlvBer == buildTwoLevelConstructedTlv(builderDefault));
+    }
+
+    SECTION("Building and encoding a TlvBer allocates no storage for its tag or length")
+    {
+        CountingResource resource{};
+        TlvBer::Builder builder{ &resource };
+        // Warm up the scratch storage of the builder.
+        builder.SetTag(tagThreeBytesPrimitive).SetValue(valueFiveBytes).Build();
+
+        resource.NumAllocations = 0;
+        auto child = builder.Reset().SetTag(tagThreeBytesPrimitive).SetValue(valueFiveBytes).Build();
+        // Only the value is allocated.
+        REQUIRE(resource.NumAllocations == 1);
+
+        builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(std::move(child));
+        resource.NumAllocations = 0;
+        const auto parent = builder.Build();
+        REQUIRE(resource.NumAllocations == 0);
+
+        std::array<uint8_t, 64> buffer{};
+        {
+            ScopedDefaultResource resourceDefault{ std::pmr::null_memory_resource() };
+            REQUIRE(parent.WriteTo(buffer) == parent.EncodedSize());
+            const auto lengthEncoding = TlvBer::GetLengthEncoding(0x01000000);
+            REQUIRE(std::vector<uint8_t>(std::cbegin(lengthEncoding), std::cend(lengthEncoding)) == std::vector<uint8_t>{ 0x84, 0x01, 0x00, 0x00, 0x00 });
+        }
+        REQUIRE(resource.NumAllocations == 0);
+        REQUIRE_THROWS_AS(TlvBer::GetLengthEncoding(0x100000000), std::length_error);
+    }
+
+    SECTION("Building in canonical mode sorts nested TLVs and caches encodings")
+    {
+        TlvBer::Builder builder{};
+        builder.SetCanonical();
+        auto child = builder.Reset().SetTag(tagTwoBytesPrimitive).SetValue(valueTwoBytes).Build();
+        auto child2 = builder.Reset().SetTag(tagThreeBytesPrimitive).SetValue(valueFiveBytes).Build();
+        auto child3 = builder.Reset().SetTag(tagTwoBytesPrimitive).SetValue(valueThreeBytes).Build();
+        REQUIRE(child.IsCanonical());
+        REQUIRE(child.ToBytes() == std::vector<uint8_t>{ 0xDF, 0x24, 0x02, 0x91, 0x92 });
+
+        // Children of SET-like TLVs are sorted by tag, then by encoding, regardless of the order they're added in.
+        const auto parent = builder.Reset().SetTag(tagTwoBytesConstructed).SetUnordered().AddTlv(child2).AddTlv(child3).AddTlv(child).Build();
+        const auto parent2 = builder.Reset().SetTag(tagTwoBytesConstructed).SetUnordered().AddTlv(child).AddTlv(child2).AddTlv(child3).Build();
+        REQUIRE(parent.IsCanonical());
+        REQUIRE(parent == parent2);
+        REQUIRE(parent.ToBytes() == parent2.ToBytes());
+        REQUIRE(parent.GetValues()[0] == child);
+        REQUIRE(parent.GetValues()[1] == child3);
+        REQUIRE(parent.GetValues()[2] == child2);
+
+        // The encoding matches that of the same TLVs built in the sorted order without canonical mode.
+        TlvBer::Builder builderDefault{};
+        const auto parentDefault = builderDefault.SetTag(tagTwoBytesConstructed).AddTlv(child).AddTlv(child3).AddTlv(child2).Build();
+        REQUIRE_FALSE(parentDefault.IsCanonical());
+        REQUIRE(parent.ToBytes() == parentDefault.ToBytes());
+        REQUIRE(parent.EncodedSize() == parentDefault.EncodedSize());
+
+        // Canonical subtrees are spliced into parents, canonical or not, and survive copies.
+        const auto parentparent = builderDefault.Reset().SetTag(tagTwoBytesConstructed).AddTlv(parent).AddTlv(parent).Build();
+        auto bytes = parentparent.ToBytes();
+        TlvBer parentparentParsed{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(parentparentParsed, bytes, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(parentparentParsed == parentparent);
+        REQUIRE(parentparent.GetValues()[1].IsCanonical());
+        const TlvBer parentCopy{ parent };
+        REQUIRE(parentCopy.IsCanonical());
+        REQUIRE(parentCopy.ToBytes() == parent.ToBytes());
+    }
+
+    SECTION("Building in canonical mode frees the cached encodings of nested TLVs")
+    {
+        // Builds a three level TLV from the resource and returns the number of bytes it holds.
+        const auto buildAndMeasure = [](bool canonical, std::size_t& encodedSize) {
+            CountingResource resource{};
+            std::optional<TlvBer> parent;
+            {
+                TlvBer::Builder builder{ &resource };
+                builder.SetCanonical(canonical);
+                auto child = builder.Reset().SetTag(tagTwoBytesPrimitive).SetValue(valueTwoBytes).Build();
+                auto child2 = builder.Reset().SetTag(tagThreeBytesPrimitive).SetValue(valueFiveBytes).Build();
+                auto sequence = builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(child).AddTlv(child2).Build();
+                parent.emplace(builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(sequence).AddTlv(child).Build());
+            }
+            encodedSize = parent->EncodedSize();
+            return resource.NumBytesInUse;
+        };
+
+        std::size_t encodedSize = 0;
+        const auto numBytesDefault = buildAndMeasure(false, encodedSize);
+        const auto numBytesCanonical = buildAndMeasure(true, encodedSize);
+        // Only the encoding of the outermost TLV is kept.
+        REQUIRE(numBytesCanonical == numBytesDefault + encodedSize);
+    }
+
+    SECTION("Building in canonical mode orders SET-like TLVs by tag class, then tag number")
+    {
+        TlvBer::Builder builder{};
+        builder.SetCanonical();
+        // Private class, tag number 0.
+        const auto childPrivate = builder.Reset().SetTag(uint8_t{ 0xC0 }).SetValue(uint8_t{ 0x01 }).Build();
+        // Universal class, long-form tag number 32.
+        std::array<uint8_t, 2> tagUniversal{ 0x1F, 0x20 };
+        const auto childUniversal = builder.Reset().SetTag(tagUniversal).SetValue(uint8_t{ 0x02 }).Build();
+        // Application class, tag numbers 128 and 31, with tags of different lengths.
+        std::array<uint8_t, 3> tagApplication128{ 0x5F, 0x81, 0x00 };
+        std::array<uint8_t, 2> tagApplication31{ 0x5F, 0x1F };
+        const auto childApplication128 = builder.Reset().SetTag(tagApplication128).SetValue(uint8_t{ 0x03 }).Build();
+        const auto childApplication31 = builder.Reset().SetTag(tagApplication31).SetValue(uint8_t{ 0x04 }).Build();
+
+        const auto parent = builder.Reset().SetTag(tagTwoBytesConstructed).SetUnordered().AddTlv(childPrivate).AddTlv(childApplication128).AddTlv(childUniversal).AddTlv(childApplication31).Build();
+        const auto values = parent.GetValues();
+        REQUIRE(values.size() == 4);
+        REQUIRE(values[0] == childUniversal);
+        REQUIRE(values[1] == childApplication31);
+        REQUIRE(values[2] == childApplication128);
+        REQUIRE(values[3] == childPrivate);
+    }
+
+    SECTION("Building in canonical mode keeps the order of nested TLVs that are not SET-like")
+    {
+        TlvBer::Builder builder{};
+        builder.SetCanonical();
+        const auto child = builder.Reset().SetTag(tagTwoBytesPrimitive).SetValue(valueTwoBytes).Build();
+        const auto child2 = builder.Reset().SetTag(tagThreeBytesPrimitive).SetValue(valueFiveBytes).Build();
+
+        const auto sequence = builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(child2).AddTlv(child).Build();
+        REQUIRE(sequence.IsCanonical());
+        REQUIRE(sequence.GetValues()[0] == child2);
+        REQUIRE(sequence.GetValues()[1] == child);
+
+        // Universal SET TLVs are always SET-like.
+        const auto set = builder.Reset().SetTag(uint8_t{ 0x31 }).AddTlv(child2).AddTlv(child).Build();
+        REQUIRE(set.GetValues()[0] == child);
+        REQUIRE(set.GetValues()[1] == child2);
+    }
+
+    SECTION("Building in canonical mode makes nested TLVs canonical")
+    {
+        TlvBer::Builder builderDefault{};
+        const auto child = builderDefault.Reset().SetTag(tagTwoBytesPrimitive).SetValue(valueTwoBytes).Build();
+        const auto child2 = builderDefault.Reset().SetTag(tagThreeBytesPrimitive).SetValue(valueFiveBytes).Build();
+        const auto set = builderDefault.Reset().SetTag(uint8_t{ 0x31 }).AddTlv(child2).AddTlv(child).Build();
+        const auto sequence = builderDefault.Reset().SetTag(uint8_t{ 0x30 }).AddTlv(set).AddTlv(child2).Build();
+        REQUIRE_FALSE(sequence.IsCanonical());
+        REQUIRE(sequence.GetValues()[0].GetValues()[0] == child2);
+
+        TlvBer::Builder builder{};
+        builder.SetCanonical();
+        const auto parent = builder.SetTag(tagTwoBytesConstructed).AddTlv(sequence).Build();
+        const auto& sequenceCanonical = parent.GetValues()[0];
+        REQUIRE(sequenceCanonical.IsCanonical());
+        REQUIRE(sequenceCanonical.GetValues()[1] == child2);
+        REQUIRE(sequenceCanonical.GetValues()[0].IsCanonical());
+        REQUIRE(sequenceCanonical.GetValues()[0].GetValues()[0] == child);
+        REQUIRE(sequenceCanonical.GetValues()[0].GetValues()[1] == child2);
+
+        auto bytes = parent.ToBytes();
+        TlvBer parentParsed{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(parentParsed, bytes, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(parentParsed == parent);
+    }
+
+    SECTION("copies of a TlvBer refer to their own storage")
+    {
+        TlvBer::Builder builder{};
+        std::optional<TlvBer> tlvBer = builder
+                                           .SetTag(tagThreeBytesPrimitive)
+                                           .SetValue(valueFiveBytes)
+                                           .Build();
+        TlvBer tlvBerCopy{ *tlvBer };
+        tlvBer.reset();
+        REQUIRE(std::ranges::equal(tlvBerCopy.Tag, tagThreeBytesPrimitive));
+        REQUIRE(std::ranges::equal(tlvBerCopy.Value, valueFiveBytes));
+    }
+
+    SECTION("Parsing a primitive tlv view works")
+    {
+        TlvBer::Builder builder{};
+        auto tlv = builder
+                       .SetTag(tagThreeBytesPrimitive)
+                       .SetValue(valueFiveBytes)
+                       .Build();
+        auto tlvBytes = tlv.ToBytes();
+
+        TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        auto presult = TlvBer::ParseView(tlvView, tlvBytes, bytesParsed);
+        REQUIRE(presult == Tlv::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == std::size(tlvBytes));
+        REQUIRE(tlvView.IsPrimitive());
+        REQUIRE(tlvView.GetClass() == tlv.GetClass());
+        REQUIRE(tlvView.GetTagNumber() == tlv.GetTagNumber());
+        REQUIRE(std::ranges::equal(tlvView.GetTag(), tagThreeBytesPrimitive));
+        REQUIRE(std::ranges::equal(tlvView.GetValue(), valueFiveBytes));
+        REQUIRE(std::data(tlvView.GetValue()) == std::data(tlvBytes) + (std::size(tlvBytes) - std::size(valueFiveBytes)));
+        REQUIRE(std::ranges::empty(tlvView.GetValues()));
+    }
+
+    SECTION("Parsing a two level constructed tlv view matches Parse")
+    {
+        TlvBer::Builder builder{};
+        auto child = builder
+                         .SetTag(tagTwoBytesPrimitive)
+                         .SetValue(valueTwoBytes)
+                         .Build();
+        auto child2 = builder
+                          .Reset()
+                          .SetTag(tagThreeBytesPrimitive)
+                          .SetValue(valueThreeBytes)
+                          .Build();
+        auto parent = builder
+                          .Reset()
+                          .SetTag(tagTwoBytesConstructed)
+                          .AddTlv(child)
+                          .AddTlv(child2)
+                          .Build();
+        auto parentparent = builder
+                                .Reset()
+                                .SetTag(tagTwoBytesConstructed)
+                                .AddTlv(child)
+                                .AddTlv(parent)
+                                .AddTlv(child2)
+                                .Build();
+        auto parentparentBytes = parentparent.ToBytes();
+
+        TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        auto presult = TlvBer::ParseView(tlvView, parentparentBytes, bytesParsed);
+        REQUIRE(presult == Tlv::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == std::size(parentparentBytes));
+        REQUIRE(tlvView.IsConstructed());
+        REQUIRE(std::ranges::equal(tlvView.GetTag(), tagTwoBytesConstructed));
+
+        const auto expectedValues = parentparent.GetValues();
+        std::size_t index = 0;
+        for (const auto& childView : tlvView.GetValues()) {
+            REQUIRE(index < std::size(expectedValues));
+            const auto& expected = expectedValues[index++];
+            REQUIRE(childView.IsConstructed() == expected.IsConstructed());
+            REQUIRE(std::ranges::equal(childView.GetTag(), expected.GetTag()));
+            if (childView.IsPrimitive()) {
+                REQUIRE(std::ranges::equal(childView.GetValue(), expected.GetValue()));
+            } else {
+                const auto expectedGrandchildren = expected.GetValues();
+                REQUIRE(static_cast<std::size_t>(std::ranges::distance(childView.GetValues())) == std::size(expectedGrandchildren));
+            }
+        }
+        REQUIRE(index == std::size(expectedValues));
+    }
+
+    SECTION("Parsing a truncated tlv view fails")
+    {
+        TlvBer::Builder builder{};
+        auto child = builder
+                         .SetTag(tagTwoBytesPrimitive)
+                         .SetValue(valueThreeBytes)
+                         .Build();
+        auto parent = builder
+                          .Reset()
+                          .SetTag(tagTwoBytesConstructed)
+                          .AddTlv(child)
+                          .Build();
+        auto parentBytes = parent.ToBytes();
+
+        for (std::size_t length = 0; length < std::size(parentBytes); length++) {
+            TlvBerView tlvView{};
+            std::size_t bytesParsed = 0;
+            auto truncated = std::span<const uint8_t>(std::data(parentBytes), length);
+            REQUIRE(TlvBer::ParseView(tlvView, truncated, bytesParsed) == Tlv::ParseResult::Failed);
+        }
+    }
+
+    SECTION("Parsing a constructed tlv view with an invalid child fails")
+    {
+        // Constructed tag 0xFF24 with a child whose length exceeds its parent.
+        std::array<uint8_t, 7> invalidChild{ 0xFF, 0x24, 0x04, 0xDF, 0x24, 0x05, 0x91 };
+        TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::ParseView(tlvView, invalidChild, bytesParsed) == Tlv::ParseResult::Failed);
+    }
+
+    SECTION("Find, FindAll and path lookups work for a two level constructed tlv")
+    {
+        TlvBer::Builder builder{};
+        auto tlvBer = buildTwoLevelConstructedTlv(builder);
+
+        REQUIRE(TlvBer::GetTagValue(tagThreeBytesPrimitive) == 0xDF9417);
+
+        const auto* child = tlvBer.Find(0xDF24);
+        REQUIRE(child != nullptr);
+        REQUIRE(child == &tlvBer.GetValues()[0]);
+        REQUIRE(tlvBer.Find(0xDF9417) == &tlvBer.GetValues()[1]);
+        REQUIRE(tlvBer.Find(0x81) == nullptr);
+        REQUIRE(tlvBer.FindAll(0xFF24) == std::vector<const TlvBer*>{ &tlvBer.GetValues()[2] });
+        REQUIRE(tlvBer.FindAll(0x81).empty());
+
+        const auto* nested = tlvBer.Find({ 0xFF24, 0xFF24, 0xDF9417 });
+        REQUIRE(nested != nullptr);
+        REQUIRE(std::ranges::equal(nested->GetValue(), valueFiveBytes));
+        REQUIRE(tlvBer.Find({ 0xFF24 }) == &tlvBer);
+        REQUIRE(tlvBer.Find({ 0xDF24 }) == nullptr);
+        REQUIRE(tlvBer.Find({ 0xFF24, 0xDF24, 0xDF24 }) == nullptr);
+        REQUIRE(tlvBer.Find({}) == nullptr);
+
+        auto encoded = tlvBer.ToBytes();
+        TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::ParseView(tlvView, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        auto nestedView = tlvView.Find({ 0xFF24, 0xFF24, 0xDF9417 });
+        REQUIRE(nestedView.has_value());
+        REQUIRE(std::ranges::equal(nestedView->GetValue(), valueFiveBytes));
+        REQUIRE_FALSE(tlvView.Find(0x81).has_value());
+        REQUIRE_FALSE(tlvView.Find({ 0xFF24, 0x81 }).has_value());
+    }
+
+    SECTION("Find and FindAll use a tag index for large constructed tlvs")
+    {
+        constexpr std::size_t numValues = TlvBer::TagIndexSizeMinimum * 3;
+        TlvBer::Builder builderChild{};
+        TlvBer::Builder builder{};
+        builder.SetTag(tagTwoBytesConstructed);
+        for (std::size_t i = 0; i < numValues; i++) {
+            builder.AddTlv(builderChild
+                               .Reset()
+                               .SetTag(static_cast<uint8_t>(0x80 + (numValues - i) % 4))
+                               .SetValue(static_cast<uint8_t>(i))
+                               .Build());
+        }
+        auto tlvBer = builder.Build();
+
+        auto verify = [&](const TlvBer& tlv) {
+            for (uint32_t tag = 0x80; tag < 0x84; tag++) {
+                auto values = tlv.FindAll(tag);
+                REQUIRE(std::size(values) == numValues / 4);
+                REQUIRE(std::ranges::is_sorted(values));
+                REQUIRE(tlv.Find(tag) == values.front());
+                for (const auto* value : values) {
+                    REQUIRE(TlvBer::GetTagValue(value->GetTag()) == tag);
+                }
+            }
+            REQUIRE(tlv.Find(0x84) == nullptr);
+            REQUIRE(tlv.FindAll(0x84).empty());
+        };
+
+        verify(tlvBer);
+
+        // Copies and moves of a TlvBer with a built index look up their own values.
+        auto tlvBerCopy = tlvBer;
+        verify(tlvBerCopy);
+        REQUIRE(tlvBerCopy.Find(0x80) != tlvBer.Find(0x80));
+        auto tlvBerMoved = std::move(tlvBerCopy);
+        verify(tlvBerMoved);
+        tlvBerCopy = tlvBer;
+        verify(tlvBerCopy);
+        tlvBerCopy = std::move(tlvBerMoved);
+        verify(tlvBerCopy);
+    }
+
     SECTION("SetAsCopyOfTlv works for primitives"){
         TlvBer::Builder builder{};
         auto tlvBer = builder
@@ -470,4 +1063,144 @@ TEST_CASE("test TlvBer", "[basic][infra]")
     }
 }
 
+TEST_CASE("TlvBer allocation", "[.][benchmark][infra]")
+{
+    using namespace encoding::test;
+
+    TlvBer::Builder builderDefault{};
+    auto tlvBerBytes = buildTwoLevelConstructedTlv(builderDefault).ToBytes();
+
+    BENCHMARK("Parse, default allocator")
+    {
+        TlvBer tlvParsed{};
+        std::size_t bytesParsed = 0;
+        TlvBer::Parse(tlvParsed, tlvBerBytes, bytesParsed);
+        return tlvParsed.EncodedSize();
+    };
+
+    BENCHMARK("Parse, monotonic_buffer_resource")
+    {
+        std::array<std::byte, 4096> buffer;
+        std::pmr::monotonic_buffer_resource resource{ std::data(buffer), std::size(buffer) };
+        TlvBer tlvParsed{ TlvBer::allocator_type{ &resource } };
+        std::size_t bytesParsed = 0;
+        TlvBer::Parse(tlvParsed, tlvBerBytes, bytesParsed);
+        return tlvParsed.EncodedSize();
+    };
+
+    BENCHMARK("Build, default allocator")
+    {
+        TlvBer::Builder builder{};
+        return buildTwoLevelConstructedTlv(builder).EncodedSize();
+    };
+
+    BENCHMARK("Build, monotonic_buffer_resource")
+    {
+        std::array<std::byte, 4096> buffer;
+        std::pmr::monotonic_buffer_resource resource{ std::data(buffer), std::size(buffer) };
+        TlvBer::Builder builder{ &resource };
+        return buildTwoLevelConstructedTlv(builder).EncodedSize();
+    };
+}
+
+TEST_CASE("TlvBer canonical encoding", "[.][benchmark][infra]")
+{
+    using namespace encoding::test;
+
+    constexpr std::size_t NumGroups = 4;
+    constexpr std::size_t NumParameters = 16;
+    constexpr std::size_t NumParents = 32;
+
+    // A large configuration repeated in many parents, as a UWB configuration
+    // is in many session data objects.
+    TlvBer::Builder builder{};
+    TlvBer::Builder builderGroup{};
+    TlvBer::Builder builderParameter{};
+    const auto configuration = buildNestedConfigurationTlv(builder, builderGroup, builderParameter, NumGroups, NumParameters);
+    builder.SetCanonical();
+    builderGroup.SetCanonical();
+    builderParameter.SetCanonical();
+    const auto configurationCanonical = buildNestedConfigurationTlv(builder, builderGroup, builderParameter, NumGroups, NumParameters);
+
+    const auto buildParents = [&](const TlvBer& tlv) {
+        TlvBer::Builder builderParent{};
+        TlvBer::Builder builderIndex{};
+        std::vector<TlvBer> parents;
+        for (std::size_t i = 0; i < NumParents; i++) {
+            parents.push_back(builderParent
+                                  .Reset()
+                                  .SetTag(uint8_t{ 0xA1 })
+                                  .AddTlv(builderIndex.Reset().SetTag(uint8_t{ 0x80 }).SetValue(static_cast<uint8_t>(i)).Build())
+                                  .AddTlv(tlv)
+                                  .Build());
+        }
+        return parents;
+    };
+    const auto encodeParents = [](const std::vector<TlvBer>& parents) {
+        std::vector<uint8_t> bytes;
+        for (const auto& parent : parents) {
+            parent.AppendTo(bytes);
+        }
+        return bytes;
+    };
+
+    const auto parents = buildParents(configuration);
+    const auto parentsCanonical = buildParents(configurationCanonical);
+    REQUIRE(encodeParents(parents) == encodeParents(parentsCanonical));
+
+    BENCHMARK("Build parents, default")
+    {
+        return buildParents(configuration).size();
+    };
+
+    BENCHMARK("Build parents, canonical")
+    {
+        return buildParents(configurationCanonical).size();
+    };
+
+    BENCHMARK("Encode parents, default")
+    {
+        return encodeParents(parents).size();
+    };
+
+    BENCHMARK("Encode parents, canonical")
+    {
+        return encodeParents(parentsCanonical).size();
+    };
+}
+
+TEST_CASE("TlvBer header encoding", "[.][benchmark][infra]")
+{
+    using namespace encoding::test;
+
+    constexpr std::size_t NumGroups = 4;
+    constexpr std::size_t NumParameters = 16;
+
+    CountingResource resource{};
+    TlvBer::Builder builder{ &resource };
+    TlvBer::Builder builderGroup{ &resource };
+    TlvBer::Builder builderParameter{ &resource };
+    buildNestedConfigurationTlv(builder, builderGroup, builderParameter, NumGroups, NumParameters);
+
+    resource.NumAllocations = 0;
+    const auto tlvBer = buildNestedConfigurationTlv(builder, builderGroup, builderParameter, NumGroups, NumParameters);
+    WARN("Allocations building " << (1 + NumGroups + NumGroups * NumParameters) << " nested tlvs: " << resource.NumAllocations);
+
+    BENCHMARK("Build nested configuration")
+    {
+        return buildNestedConfigurationTlv(builder, builderGroup, builderParameter, NumGroups, NumParameters).EncodedSize();
+    };
+
+    std::vector<uint8_t> buffer(tlvBer.EncodedSize());
+    BENCHMARK("Encode nested configuration")
+    {
+        return tlvBer.WriteTo(buffer);
+    };
+
+    BENCHMARK("GetLengthEncoding")
+    {
+        return TlvBer::GetLengthEncoding(buffer.size()).size();
+    };
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,338 @@
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <tlv/TlvSchema.hxx>
+#include <tlv/TlvSerialize.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace encoding::test
+{
+enum class SchemaTestKind : uint8_t {
+    First,
+    Second,
+    Third,
+};
+
+struct SchemaTestObject
+{
+    uint32_t Number{ 0 };
+    SchemaTestKind Kind{ SchemaTestKind::First };
+    bool Flag{ false };
+    std::array<uint8_t, 4> Identifier{};
+    std::vector<uint8_t> Payload{};
+    std::map<uint8_t, uint16_t> Entries{};
+
+    bool
+    operator==(const SchemaTestObject&) const = default;
+};
+
+using SchemaTestObjectSchema = schema::Schema<0xBF20,
+    schema::Field<0x80, &SchemaTestObject::Number, schema::UnsignedBigEndian<uint32_t>>,
+    schema::Field<0x81, &SchemaTestObject::Kind, schema::Enumeration<SchemaTestKind, SchemaTestKind::Third>>,
+    schema::Field<0x82, &SchemaTestObject::Flag, schema::Boolean>,
+    schema::Field<0x9F21, &SchemaTestObject::Identifier, schema::FixedOctets<4>>,
+    schema::Field<0x84, &SchemaTestObject::Payload, schema::Octets>,
+    schema::Field<0x85, &SchemaTestObject::Entries, schema::MapValue<uint8_t{ 7 }, schema::UnsignedBigEndian<uint16_t>>>>;
+
+enum class SchemaTestFlag : uint8_t {
+    Low = 0b00000001,
+    High = 0b10000000,
+};
+
+struct SchemaTestAddress
+{
+    SchemaTestAddress() = default;
+
+    explicit SchemaTestAddress(std::array<uint8_t, 2> value) :
+        Value(std::cbegin(value), std::cend(value))
+    {}
+
+    explicit SchemaTestAddress(std::array<uint8_t, 4> value) :
+        Value(std::cbegin(value), std::cend(value))
+    {}
+
+    std::span<const uint8_t>
+    GetValue() const noexcept
+    {
+        return Value;
+    }
+
+    bool
+    operator==(const SchemaTestAddress&) const = default;
+
+    std::vector<uint8_t> Value{};
+};
+
+struct SchemaTestOptionalObject
+{
+    std::set<SchemaTestFlag> Flags{};
+    SchemaTestAddress Address{};
+    std::map<uint8_t, std::variant<uint8_t, uint16_t>> Values{};
+
+    bool
+    operator==(const SchemaTestOptionalObject&) const = default;
+};
+
+using SchemaTestOptionalObjectSchema = schema::Schema<0xA1,
+    schema::Field<0x80, &SchemaTestOptionalObject::Flags, schema::Bitmap<SchemaTestFlag, SchemaTestFlag::Low, SchemaTestFlag::High>>,
+    schema::Field<0x81, &SchemaTestOptionalObject::Address, schema::MacAddress<SchemaTestAddress, 2, 4>>,
+    schema::Field<0x82, &SchemaTestOptionalObject::Values, schema::VariantMapValue<uint8_t{ 1 }, uint8_t, schema::UnsignedBigEndian<uint8_t>>>,
+    schema::Field<0x83, &SchemaTestOptionalObject::Values, schema::VariantMapValue<uint8_t{ 2 }, uint16_t, schema::UnsignedBigEndian<uint16_t>>>>;
+
+constexpr auto SchemaTestKindBit = MakeBitIndexMapFromRange<SchemaTestKind, SchemaTestKind::First, SchemaTestKind::Third>();
+
+using SchemaTestKindSet = FlagSet<SchemaTestKindBit>;
+
+struct SchemaTestCombinedObject
+{
+    SchemaTestKindSet Kinds{};
+    uint8_t High{ 0 };
+    uint8_t Low{ 0 };
+
+    bool
+    operator==(const SchemaTestCombinedObject&) const = default;
+};
+
+/**
+ * @brief Encodes the High and Low members of SchemaTestCombinedObject as the
+ * two nibbles of a single octet.
+ */
+struct SchemaTestNibbles
+{
+    static constexpr std::size_t BufferSize = 1;
+
+    static std::span<const uint8_t>
+    Encode(const SchemaTestCombinedObject& value, std::span<uint8_t, BufferSize> buffer) noexcept
+    {
+        buffer[0] = static_cast<uint8_t>((value.High << 4U) | (value.Low & 0x0FU));
+        return buffer;
+    }
+
+    static bool
+    Decode(std::span<const uint8_t> data, SchemaTestCombinedObject& value) noexcept
+    {
+        if (std::size(data) != BufferSize) {
+            return false;
+        }
+
+        value.High = static_cast<uint8_t>(data.front() >> 4U);
+        value.Low = static_cast<uint8_t>(data.front() & 0x0FU);
+        return true;
+    }
+};
+
+using SchemaTestCombinedObjectSchema = schema::Schema<0xA2,
+    schema::Field<0x80, &SchemaTestCombinedObject::Kinds, schema::FlagSetBitmap<SchemaTestKindBit>>,
+    schema::ObjectField<0x81, SchemaTestCombinedObject, SchemaTestNibbles>>;
+} // namespace encoding::test
+
+TEST_CASE("TlvSchema encodes and decodes objects", "[basic][infra]")
+{
+    using namespace encoding;
+    using namespace encoding::test;
+
+    const SchemaTestObject object{
+        .Number = 0x01020304,
+        .Kind = SchemaTestKind::Third,
+        .Flag = true,
+        .Identifier = { 0xA1, 0xA2, 0xA3, 0xA4 },
+        .Payload = { 0x11, 0x22, 0x33 },
+        .Entries = { { 7, 0xBEEF } },
+    };
+
+    SECTION("encoding matches the equivalent built TlvBer")
+    {
+        const std::vector<uint8_t> encodedExpected{
+            0xBF, 0x20, 0x1C,
+            0x80, 0x04, 0x01, 0x02, 0x03, 0x04,
+            0x81, 0x01, 0x02,
+            0x82, 0x01, 0x01,
+            0x9F, 0x21, 0x04, 0xA1, 0xA2, 0xA3, 0xA4,
+            0x84, 0x03, 0x11, 0x22, 0x33,
+            0x85, 0x02, 0xBE, 0xEF
+        };
+
+        auto tlv = SchemaTestObjectSchema::Encode(object);
+        REQUIRE(tlv.ToBytes() == encodedExpected);
+
+        // The encoded tags must be indistinguishable from parsed ones.
+        auto encoded = encodedExpected;
+        TlvBer tlvParsed{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(tlvParsed, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(tlv == tlvParsed);
+    }
+
+    SECTION("decoding from a TlvBer and a TlvBerView round-trips")
+    {
+        auto tlv = SchemaTestObjectSchema::Encode(object);
+        SchemaTestObject objectDecoded{};
+        REQUIRE(SchemaTestObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded == object);
+
+        auto encoded = tlv.ToBytes();
+        TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::ParseView(tlvView, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        SchemaTestObject objectDecodedFromView{};
+        REQUIRE(SchemaTestObjectSchema::Decode(tlvView, objectDecodedFromView));
+        REQUIRE(objectDecodedFromView == object);
+    }
+
+    SECTION("decoding fails when a field is missing or invalid")
+    {
+        std::vector<uint8_t> missingField{ 0xBF, 0x20, 0x06, 0x80, 0x01, 0x05, 0x82, 0x01, 0x00 };
+        TlvBer tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(tlv, missingField, bytesParsed) == Tlv::ParseResult::Succeeded);
+        SchemaTestObject objectDecoded{};
+        REQUIRE_FALSE(SchemaTestObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded.Number == 5);
+
+        auto encoded = SchemaTestObjectSchema::Encode(object).ToBytes();
+        // Kind is out of range.
+        encoded[11] = 0x03;
+        REQUIRE(TlvBer::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE_FALSE(SchemaTestObjectSchema::Decode(tlv, objectDecoded));
+    }
+
+    SECTION("decoding fails when a fixed-size value has the wrong length")
+    {
+        auto encoded = SchemaTestObjectSchema::Encode(object).ToBytes();
+        TlvBer tlv{};
+        std::size_t bytesParsed = 0;
+        SchemaTestObject objectDecoded{};
+
+        // Identifier is one octet short.
+        auto encodedShort = encoded;
+        encodedShort[2] -= 1;
+        encodedShort[17] = 0x03;
+        encodedShort.erase(std::begin(encodedShort) + 21);
+        REQUIRE(TlvBer::Parse(tlv, encodedShort, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE_FALSE(SchemaTestObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded.Identifier == std::array<uint8_t, 4>{});
+
+        // Identifier is one octet long.
+        auto encodedLong = encoded;
+        encodedLong[2] += 1;
+        encodedLong[17] = 0x05;
+        encodedLong.insert(std::begin(encodedLong) + 22, 0xA5);
+        REQUIRE(TlvBer::Parse(tlv, encodedLong, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE_FALSE(SchemaTestObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded.Identifier == std::array<uint8_t, 4>{});
+    }
+}
+
+TEST_CASE("TlvSchema encodes bitmaps, MAC addresses and optional fields", "[basic][infra]")
+{
+    using namespace encoding;
+    using namespace encoding::test;
+
+    const SchemaTestOptionalObject object{
+        .Flags = { SchemaTestFlag::Low, SchemaTestFlag::High },
+        .Address = SchemaTestAddress{ std::array<uint8_t, 4>{ 0xA1, 0xA2, 0xA3, 0xA4 } },
+        .Values = { { 2, uint16_t{ 0xBEEF } } },
+    };
+
+    SECTION("absent optional fields are omitted when encoding")
+    {
+        const std::vector<uint8_t> encodedExpected{
+            0xA1, 0x0D,
+            0x80, 0x01, 0x81,
+            0x81, 0x04, 0xA1, 0xA2, 0xA3, 0xA4,
+            0x83, 0x02, 0xBE, 0xEF
+        };
+
+        auto tlv = SchemaTestOptionalObjectSchema::Encode(object);
+        REQUIRE(tlv.ToBytes() == encodedExpected);
+    }
+
+    SECTION("decoding round-trips and does not require optional fields")
+    {
+        auto tlv = SchemaTestOptionalObjectSchema::Encode(object);
+        SchemaTestOptionalObject objectDecoded{};
+        REQUIRE(SchemaTestOptionalObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded == object);
+    }
+
+    SECTION("decoding ignores unknown bitmap bits")
+    {
+        std::vector<uint8_t> encoded{ 0xA1, 0x07, 0x80, 0x01, 0x7F, 0x81, 0x02, 0xB1, 0xB2 };
+        TlvBer tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        SchemaTestOptionalObject objectDecoded{};
+        REQUIRE(SchemaTestOptionalObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded.Flags == std::set<SchemaTestFlag>{ SchemaTestFlag::Low });
+        REQUIRE(objectDecoded.Address == SchemaTestAddress{ std::array<uint8_t, 2>{ 0xB1, 0xB2 } });
+        REQUIRE(std::empty(objectDecoded.Values));
+    }
+
+    SECTION("decoding fails when a MAC address has an unsupported length")
+    {
+        std::vector<uint8_t> encoded{ 0xA1, 0x06, 0x80, 0x01, 0x01, 0x81, 0x01, 0xB1 };
+        TlvBer tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        SchemaTestOptionalObject objectDecoded{};
+        REQUIRE_FALSE(SchemaTestOptionalObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded.Address == SchemaTestAddress{});
+    }
+}
+
+TEST_CASE("TlvSchema encodes flag sets and fields combining several members", "[basic][infra]")
+{
+    using namespace encoding;
+    using namespace encoding::test;
+
+    const SchemaTestCombinedObject object{
+        .Kinds = { SchemaTestKind::First, SchemaTestKind::Third },
+        .High = 0x0A,
+        .Low = 0x05,
+    };
+
+    SECTION("encoding holds the flag set bitmap and the combined members")
+    {
+        const std::vector<uint8_t> encodedExpected{
+            0xA2, 0x06,
+            0x80, 0x01, 0x05,
+            0x81, 0x01, 0xA5
+        };
+
+        auto tlv = SchemaTestCombinedObjectSchema::Encode(object);
+        REQUIRE(tlv.ToBytes() == encodedExpected);
+    }
+
+    SECTION("decoding round-trips")
+    {
+        auto tlv = SchemaTestCombinedObjectSchema::Encode(object);
+        SchemaTestCombinedObject objectDecoded{};
+        REQUIRE(SchemaTestCombinedObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded == object);
+    }
+
+    SECTION("decoding fails when a flag set bitmap has the wrong length")
+    {
+        std::vector<uint8_t> encoded{ 0xA2, 0x07, 0x80, 0x02, 0x00, 0x05, 0x81, 0x01, 0xA5 };
+        TlvBer tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        SchemaTestCombinedObject objectDecoded{};
+        REQUIRE_FALSE(SchemaTestCombinedObjectSchema::Decode(tlv, objectDecoded));
+        REQUIRE(objectDecoded.Kinds.Empty());
+        REQUIRE(objectDecoded.High == 0x0A);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
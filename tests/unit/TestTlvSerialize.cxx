@@ -0,0 +1,131 @@
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvSerialize.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace encoding::test
+{
+enum class SerializeTestValue {
+    A = 2,
+    B = 3,
+    C = 4,
+    D = 5,
+};
+
+constexpr auto SerializeTestValueBitRange = MakeBitIndexMapFromRange<SerializeTestValue, SerializeTestValue::A, SerializeTestValue::D>();
+
+constexpr auto SerializeTestValueBitSparse = MakeBitIndexMap<SerializeTestValue>({
+    { SerializeTestValue::D, 0 },
+    { SerializeTestValue::A, 3 },
+    { SerializeTestValue::C, 33 },
+});
+
+using SerializeTestFlagsRange = FlagSet<SerializeTestValueBitRange>;
+using SerializeTestFlagsSparse = FlagSet<SerializeTestValueBitSparse>;
+
+// The tables and flag sets are usable at compile time.
+static_assert(SerializeTestValueBitRange.GetBitIndex(SerializeTestValue::C) == 2);
+static_assert(SerializeTestValueBitSparse.GetValue(33) == SerializeTestValue::C);
+static_assert(!SerializeTestValueBitSparse.GetBitIndex(SerializeTestValue::B).has_value());
+static_assert(SerializeTestFlagsRange::NumBytes == 1);
+static_assert(SerializeTestFlagsSparse::NumBytes == 5);
+static_assert(SerializeTestFlagsSparse{ SerializeTestValue::A, SerializeTestValue::C }.ToBytesBigEndian() == std::array<uint8_t, 5>{ 0x02, 0x00, 0x00, 0x00, 0x08 });
+} // namespace encoding::test
+
+TEST_CASE("big endian helpers encode and decode fixed-size values", "[basic][infra]")
+{
+    using namespace encoding;
+
+    SECTION("fixed-size encodings match the vector based encoding")
+    {
+        const std::vector<std::size_t> values{ 0, 1, 0xFF, 0x1234, 0xA1B2C3D4, 0x0102030405 };
+        for (const auto value : values) {
+            const auto bytes = GetBytesBigEndian<5>(value);
+            REQUIRE(std::vector<uint8_t>(std::cbegin(bytes), std::cend(bytes)) == GetBytesBigEndianFromBitMap(value, 5));
+            REQUIRE(ReadBytesBigEndian(bytes) == value);
+        }
+    }
+
+    SECTION("values wider than the encoding are truncated")
+    {
+        REQUIRE(GetBytesBigEndian<2>(uint32_t{ 0xA1B2C3D4 }) == std::array<uint8_t, 2>{ 0xC3, 0xD4 });
+        REQUIRE(ReadBytesBigEndian<uint16_t>(std::array<uint8_t, 3>{ 0x01, 0x02, 0x03 }) == 0x0203);
+    }
+
+    SECTION("bit indices are recovered from single bit masks")
+    {
+        for (std::size_t bitIndex = 0; bitIndex < 64; bitIndex++) {
+            REQUIRE(GetBitIndexFromBitMask(GetBitMaskFromBitIndex(bitIndex)) == bitIndex);
+        }
+        REQUIRE_THROWS(GetBitIndexFromBitMask(0));
+        REQUIRE_THROWS(GetBitIndexFromBitMask(0b11));
+    }
+}
+
+TEST_CASE("FlagSet encodes and decodes value bitmaps", "[basic][infra]")
+{
+    using namespace encoding;
+    using namespace encoding::test;
+
+    SECTION("values map to the bits given by the table")
+    {
+        const SerializeTestFlagsRange flagsRange{ SerializeTestValue::B, SerializeTestValue::D };
+        REQUIRE(flagsRange.GetBits() == 0b1010);
+        REQUIRE(flagsRange.ToValues() == std::vector<SerializeTestValue>{ SerializeTestValue::B, SerializeTestValue::D });
+
+        const SerializeTestFlagsSparse flagsSparse{ std::vector<SerializeTestValue>{ SerializeTestValue::A, SerializeTestValue::B, SerializeTestValue::D } };
+        REQUIRE(flagsSparse.GetBits() == 0b1001);
+        REQUIRE(flagsSparse.Size() == 2);
+        REQUIRE(flagsSparse.Contains(SerializeTestValue::A));
+        REQUIRE_FALSE(flagsSparse.Contains(SerializeTestValue::B));
+        REQUIRE(flagsSparse.ToValues() == std::vector<SerializeTestValue>{ SerializeTestValue::D, SerializeTestValue::A });
+    }
+
+    SECTION("insert and erase update the bitmap")
+    {
+        SerializeTestFlagsSparse flags{};
+        REQUIRE(flags.Empty());
+        REQUIRE(flags.Insert(SerializeTestValue::C));
+        REQUIRE_FALSE(flags.Insert(SerializeTestValue::B));
+        REQUIRE(flags.GetBits() == (uint64_t{ 1 } << 33U));
+        flags.Erase(SerializeTestValue::C);
+        REQUIRE(flags.Empty());
+    }
+
+    SECTION("decoding discards bits not in the table")
+    {
+        const std::array<uint8_t, 5> bytes{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+        const auto flags = SerializeTestFlagsSparse::FromBytesBigEndian(bytes);
+        REQUIRE(flags == SerializeTestFlagsSparse{ SerializeTestValue::A, SerializeTestValue::C, SerializeTestValue::D });
+        REQUIRE(flags.ToBytesBigEndian() == std::array<uint8_t, 5>{ 0x02, 0x00, 0x00, 0x00, 0x09 });
+        REQUIRE(SerializeTestFlagsRange::FromBits(0xF0).Empty());
+    }
+
+    SECTION("set operations act on the bitmaps")
+    {
+        const SerializeTestFlagsRange flagsOne{ SerializeTestValue::A, SerializeTestValue::B, SerializeTestValue::C };
+        const SerializeTestFlagsRange flagsTwo{ SerializeTestValue::B, SerializeTestValue::C, SerializeTestValue::D };
+        REQUIRE(flagsOne.Intersect(flagsTwo) == SerializeTestFlagsRange{ SerializeTestValue::B, SerializeTestValue::C });
+        REQUIRE(flagsOne.Union(flagsTwo).Size() == 4);
+        REQUIRE(flagsOne.Intersect(flagsTwo).IsSubsetOf(flagsOne));
+        REQUIRE_FALSE(flagsOne.IsSubsetOf(flagsTwo));
+        REQUIRE(SerializeTestFlagsRange{}.IsSubsetOf(flagsTwo));
+    }
+
+    SECTION("iteration visits values in bit index order")
+    {
+        const SerializeTestFlagsSparse flags{ SerializeTestValue::A, SerializeTestValue::C, SerializeTestValue::D };
+        const std::vector<SerializeTestValue> values(std::cbegin(flags), std::cend(flags));
+        REQUIRE(values == flags.ToValues());
+        REQUIRE(std::cbegin(SerializeTestFlagsSparse{}) == std::cend(SerializeTestFlagsSparse{}));
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,189 @@
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <tlv/TlvStreamDecoder.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace encoding::test
+{
+/**
+ * @brief Owning copy of a decoded TLV, since the decoder only lends TLVs to
+ * the callback.
+ */
+struct DecodedTlv
+{
+    std::vector<uint8_t> Tag;
+    std::vector<uint8_t> Value;
+    std::size_t NumChildren{ 0 };
+
+    bool
+    operator==(const DecodedTlv&) const = default;
+};
+
+/**
+ * @brief Push the specified data to the decoder in chunks of the specified
+ * sizes, cycling through the sizes until all data has been pushed.
+ *
+ * @param decoder The decoder to push data to.
+ * @param data The data to push.
+ * @param chunkSizes The sizes of the chunks to push.
+ * @return Tlv::ParseResult The first failure, or Succeeded.
+ */
+Tlv::ParseResult
+PushChunked(TlvStreamDecoder& decoder, std::span<const uint8_t> data, const std::vector<std::size_t>& chunkSizes)
+{
+    for (std::size_t i = 0; !data.empty(); i++) {
+        auto chunkSize = std::min(chunkSizes[i % chunkSizes.size()], data.size());
+        auto result = decoder.Push(data.first(chunkSize));
+        if (result != Tlv::ParseResult::Succeeded) {
+            return result;
+        }
+        data = data.subspan(chunkSize);
+    }
+
+    return Tlv::ParseResult::Succeeded;
+}
+} // namespace encoding::test
+
+TEST_CASE("TlvStreamDecoder decodes fragmented streams", "[basic][infra]")
+{
+    using namespace encoding;
+    using namespace encoding::test;
+
+    std::vector<DecodedTlv> decoded;
+
+    SECTION("BER-TLVs split at every possible chunk size are decoded")
+    {
+        // Primitive, 2-byte tag.
+        std::vector<uint8_t> stream{ 0x9F, 0x20, 0x02, 0xAA, 0xBB };
+        // Constructed with two children.
+        const std::vector<uint8_t> constructed{ 0xBF, 0x78, 0x07, 0x80, 0x01, 0x01, 0x81, 0x02, 0x02, 0x03 };
+        stream.insert(std::cend(stream), std::cbegin(constructed), std::cend(constructed));
+        // Primitive with a long-form length.
+        const std::vector<uint8_t> longValue(200, 0x5A);
+        stream.insert(std::cend(stream), { 0x04, 0x81, 0xC8 });
+        stream.insert(std::cend(stream), std::cbegin(longValue), std::cend(longValue));
+        // Primitive with an empty value.
+        stream.insert(std::cend(stream), { 0x05, 0x00 });
+
+        const std::vector<DecodedTlv> expected{
+            { { 0x9F, 0x20 }, { 0xAA, 0xBB }, 0 },
+            { { 0xBF, 0x78 }, { 0x80, 0x01, 0x01, 0x81, 0x02, 0x02, 0x03 }, 2 },
+            { { 0x04 }, longValue, 0 },
+            { { 0x05 }, {}, 0 },
+        };
+
+        TlvStreamDecoder decoder{ [&](const TlvBerView& tlv) {
+            auto values = tlv.GetValues();
+            decoded.push_back({ { std::cbegin(tlv.Tag), std::cend(tlv.Tag) }, { std::cbegin(tlv.Value), std::cend(tlv.Value) }, static_cast<std::size_t>(std::distance(std::begin(values), std::end(values))) });
+        } };
+
+        for (std::size_t chunkSize = 1; chunkSize <= stream.size(); chunkSize++) {
+            decoded.clear();
+            REQUIRE(PushChunked(decoder, stream, { chunkSize }) == Tlv::ParseResult::Succeeded);
+            REQUIRE_FALSE(decoder.HasPartialTlv());
+            REQUIRE(decoded == expected);
+        }
+
+        std::mt19937 engine{ 0x5EED };
+        std::uniform_int_distribution<std::size_t> distribution{ 1, 16 };
+        for (auto i = 0; i < 32; i++) {
+            std::vector<std::size_t> chunkSizes(8);
+            std::generate(std::begin(chunkSizes), std::end(chunkSizes), [&] {
+                return distribution(engine);
+            });
+            decoded.clear();
+            REQUIRE(PushChunked(decoder, stream, chunkSizes) == Tlv::ParseResult::Succeeded);
+            REQUIRE(decoded == expected);
+        }
+    }
+
+    SECTION("SIMPLE-TLVs split at every possible chunk size are decoded")
+    {
+        const std::vector<uint8_t> longValue(300, 0xA5);
+        std::vector<uint8_t> stream{ 0x01, 0x03, 0x0A, 0x0B, 0x0C, 0x02, 0xFF, 0x01, 0x2C };
+        stream.insert(std::cend(stream), std::cbegin(longValue), std::cend(longValue));
+        stream.insert(std::cend(stream), { 0x03, 0x00 });
+
+        const std::vector<DecodedTlv> expected{
+            { { 0x01 }, { 0x0A, 0x0B, 0x0C }, 0 },
+            { { 0x02 }, longValue, 0 },
+            { { 0x03 }, {}, 0 },
+        };
+
+        TlvStreamDecoder decoder{ TlvStreamDecoder::Encoding::Simple, [&](const Tlv& tlv) {
+                                     decoded.push_back({ { std::cbegin(tlv.Tag), std::cend(tlv.Tag) }, { std::cbegin(tlv.Value), std::cend(tlv.Value) }, 0 });
+                                 } };
+
+        for (std::size_t chunkSize = 1; chunkSize <= stream.size(); chunkSize++) {
+            decoded.clear();
+            REQUIRE(PushChunked(decoder, stream, { chunkSize }) == Tlv::ParseResult::Succeeded);
+            REQUIRE_FALSE(decoder.HasPartialTlv());
+            REQUIRE(decoded == expected);
+        }
+    }
+
+    SECTION("a partially received TLV is only reported once complete")
+    {
+        TlvStreamDecoder decoder{ TlvStreamDecoder::Encoding::Ber, [&](const Tlv& tlv) {
+                                     decoded.push_back({ { std::cbegin(tlv.Tag), std::cend(tlv.Tag) }, { std::cbegin(tlv.Value), std::cend(tlv.Value) }, 0 });
+                                 } };
+
+        const std::vector<uint8_t> first{ 0x01, 0x03, 0x0A };
+        const std::vector<uint8_t> second{ 0x0B, 0x0C, 0x02 };
+        REQUIRE(decoder.Push(first) == Tlv::ParseResult::Succeeded);
+        REQUIRE(decoder.HasPartialTlv());
+        REQUIRE(decoded.empty());
+        REQUIRE(decoder.Push(second) == Tlv::ParseResult::Succeeded);
+        REQUIRE(decoder.HasPartialTlv());
+        REQUIRE(decoded.size() == 1);
+
+        decoder.Reset();
+        REQUIRE_FALSE(decoder.HasPartialTlv());
+    }
+
+    SECTION("invalid encodings fail until reset")
+    {
+        TlvStreamDecoder decoder{ [&](const TlvBerView& tlv) {
+            decoded.push_back({ { std::cbegin(tlv.Tag), std::cend(tlv.Tag) }, { std::cbegin(tlv.Value), std::cend(tlv.Value) }, 0 });
+        } };
+
+        // Second tag octet below 0x1F is not a valid multi-byte tag.
+        const std::vector<uint8_t> invalidTag{ 0x9F, 0x01, 0x00 };
+        REQUIRE(PushChunked(decoder, invalidTag, { 1 }) == Tlv::ParseResult::Failed);
+        const std::vector<uint8_t> valid{ 0x01, 0x00 };
+        REQUIRE(decoder.Push(valid) == Tlv::ParseResult::Failed);
+        REQUIRE(decoded.empty());
+
+        decoder.Reset();
+        REQUIRE(decoder.Push(valid) == Tlv::ParseResult::Succeeded);
+        REQUIRE(decoded.size() == 1);
+
+        // Constructed TLV whose child overruns its parent.
+        const std::vector<uint8_t> invalidChild{ 0x21, 0x02, 0x01, 0x05 };
+        REQUIRE(PushChunked(decoder, invalidChild, { 3 }) == Tlv::ParseResult::Failed);
+    }
+
+    SECTION("values longer than the maximum are rejected")
+    {
+        TlvStreamDecoder decoder{ TlvStreamDecoder::Encoding::Simple, nullptr, 16 };
+        const std::vector<uint8_t> header{ 0x01, 0x11 };
+        REQUIRE(decoder.Push(header) == Tlv::ParseResult::Failed);
+
+        decoder.Reset();
+        const std::vector<uint8_t> maximum{ 0x01, 0x10 };
+        REQUIRE(decoder.Push(maximum) == Tlv::ParseResult::Succeeded);
+        REQUIRE(decoder.HasPartialTlv());
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,89 @@
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <notstd/enum_map.hxx>
+
+namespace notstd::test
+{
+enum class Key : uint8_t {
+    A = 0x80,
+    B = 0x81,
+    C = 0x82,
+    D = 0x83,
+    OutOfRange = 0x84,
+};
+
+using KeyMap = notstd::enum_map<Key, std::string, Key::A, Key::D>;
+} // namespace notstd::test
+
+TEST_CASE("enum_map holds values by key", "[basic][enum_map]")
+{
+    using notstd::test::Key;
+    using notstd::test::KeyMap;
+
+    KeyMap map{};
+    REQUIRE(map.empty());
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.begin() == map.end());
+    REQUIRE(KeyMap::slot_count == 4);
+
+    SECTION("values can be inserted, replaced and erased")
+    {
+        map.insert_or_assign(Key::B, "b");
+        map[Key::D] = "d";
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.contains(Key::B));
+        REQUIRE_FALSE(map.contains(Key::C));
+        REQUIRE(map.at(Key::B) == "b");
+        REQUIRE(*map.get(Key::D) == "d");
+        REQUIRE(map.get(Key::C) == nullptr);
+
+        map.insert_or_assign(Key::B, "bb");
+        REQUIRE(map.at(Key::B) == "bb");
+        REQUIRE(map.size() == 2);
+
+        REQUIRE(map.erase(Key::B) == 1);
+        REQUIRE(map.erase(Key::B) == 0);
+        REQUIRE_FALSE(map.contains(Key::B));
+        REQUIRE(map.size() == 1);
+
+        map.clear();
+        REQUIRE(map.empty());
+    }
+
+    SECTION("keys outside the range are rejected")
+    {
+        REQUIRE_FALSE(map.contains(Key::OutOfRange));
+        REQUIRE_THROWS_AS(map.at(Key::OutOfRange), std::out_of_range);
+        REQUIRE_THROWS_AS(map[Key::OutOfRange], std::out_of_range);
+        REQUIRE_THROWS_AS(map.at(Key::A), std::out_of_range);
+    }
+
+    SECTION("iteration visits present keys in ascending order")
+    {
+        map = { { Key::D, "d" }, { Key::A, "a" }, { Key::C, "c" } };
+
+        std::vector<std::pair<Key, std::string>> entries;
+        for (const auto& [key, value] : map) {
+            entries.emplace_back(key, value);
+        }
+        REQUIRE(entries == std::vector<std::pair<Key, std::string>>{ { Key::A, "a" }, { Key::C, "c" }, { Key::D, "d" } });
+    }
+
+    SECTION("equality is independent of insertion order and history")
+    {
+        const KeyMap mapOne{ { Key::A, "a" }, { Key::C, "c" } };
+        KeyMap mapTwo{ { Key::C, "c" }, { Key::B, "b" }, { Key::A, "a" } };
+        REQUIRE(mapOne != mapTwo);
+
+        mapTwo.erase(Key::B);
+        REQUIRE(mapOne == mapTwo);
+        REQUIRE(mapOne.presence() == mapTwo.presence());
+    }
+}
@@ -0,0 +1,108 @@
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <notstd/seqlock.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace notstd::test
+{
+/**
+ * @brief A value spanning several words whose fields are always written
+ * with the same value, so a torn read is detectable.
+ */
+struct SeqlockValue
+{
+    std::array<uint64_t, 5> Fields{};
+    uint8_t Tag{ 0 };
+
+    bool
+    IsConsistent() const noexcept
+    {
+        for (const auto field : Fields) {
+            if (field != Fields[0] || static_cast<uint8_t>(field) != Tag) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+SeqlockValue
+MakeSeqlockValue(uint64_t value)
+{
+    SeqlockValue seqlockValue{};
+    seqlockValue.Fields.fill(value);
+    seqlockValue.Tag = static_cast<uint8_t>(value);
+    return seqlockValue;
+}
+} // namespace notstd::test
+
+TEST_CASE("seqlock stores and loads values", "[basic][seqlock]")
+{
+    using namespace notstd;
+
+    seqlock<test::SeqlockValue> value{};
+    REQUIRE(value.load().Fields[0] == 0);
+
+    value.store(test::MakeSeqlockValue(42));
+    REQUIRE(value.load().IsConsistent());
+    REQUIRE(value.load().Fields[0] == 42);
+
+    const seqlock<test::SeqlockValue> valueInitialized{ test::MakeSeqlockValue(7) };
+    REQUIRE(valueInitialized.load().Fields[0] == 7);
+}
+
+TEST_CASE("seqlock readers never observe torn values", "[concurrency][seqlock]")
+{
+    using namespace notstd;
+
+    static constexpr uint64_t WriteCount = 100000;
+    static constexpr std::size_t ReaderCount = 4;
+
+    seqlock<test::SeqlockValue> value{};
+    std::atomic<bool> writerDone{ false };
+    std::atomic<bool> tornReadObserved{ false };
+    std::atomic<bool> regressionObserved{ false };
+
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < ReaderCount; i++) {
+        readers.emplace_back([&] {
+            uint64_t valuePrevious = 0;
+            while (!writerDone.load(std::memory_order_relaxed)) {
+                const auto valueRead = value.load();
+                if (!valueRead.IsConsistent()) {
+                    tornReadObserved = true;
+                }
+                if (valueRead.Fields[0] < valuePrevious) {
+                    regressionObserved = true;
+                }
+                valuePrevious = valueRead.Fields[0];
+            }
+        });
+    }
+
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= WriteCount; i++) {
+            value.store(test::MakeSeqlockValue(i));
+        }
+        writerDone = true;
+    });
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE_FALSE(tornReadObserved);
+    REQUIRE_FALSE(regressionObserved);
+    REQUIRE(value.load().Fields[0] == WriteCount);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
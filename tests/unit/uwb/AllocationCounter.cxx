@@ -0,0 +1,44 @@
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.hxx"
+
+namespace uwb::test::detail
+{
+/**
+ * @brief The number of heap allocations made through the global operator new
+ * so far.
+ */
+std::atomic<std::size_t> NumAllocations{ 0 };
+} // namespace uwb::test::detail
+
+std::size_t
+uwb::test::GetNumAllocations() noexcept
+{
+    return detail::NumAllocations.load(std::memory_order_relaxed);
+}
+
+void*
+operator new(std::size_t size)
+{
+    uwb::test::detail::NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) { // NOLINT(cppcoreguidelines-no-malloc)
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* pointer) noexcept
+{
+    std::free(pointer); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void
+operator delete(void* pointer, std::size_t /* size */) noexcept
+{
+    std::free(pointer); // NOLINT(cppcoreguidelines-no-malloc)
+}
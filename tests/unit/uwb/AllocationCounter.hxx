@@ -0,0 +1,20 @@
+
+#ifndef ALLOCATION_COUNTER_HXX
+#define ALLOCATION_COUNTER_HXX
+
+#include <cstddef>
+
+namespace uwb::test
+{
+/**
+ * @brief Get the number of heap allocations made through the global operator
+ * new so far. The test executable replaces operator new to count them, see
+ * AllocationCounter.cxx.
+ *
+ * @return std::size_t
+ */
+std::size_t
+GetNumAllocations() noexcept;
+} // namespace uwb::test
+
+#endif // ALLOCATION_COUNTER_HXX
@@ -2,13 +2,16 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <compare>
 #include <istream>
 #include <ostream>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <uwb/UwbMacAddress.hxx>
@@ -392,4 +395,76 @@ TEST_CASE("uwb mac address can be constructed with a string input and address ty
     }
 }
 
+TEST_CASE("uwb mac address string conversion round-trips", "[basic][io]")
+{
+    using namespace uwb;
+
+    const UwbMacAddress uwbMacAddressShort{ std::array<uint8_t, 2>{ 0x0A, 0xBC } };
+    const UwbMacAddress uwbMacAddressExtended{ std::array<uint8_t, 8>{ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0xEE, 0xFF } };
+
+    REQUIRE(uwbMacAddressShort.ToString() == "0a:bc");
+    REQUIRE(uwbMacAddressExtended.ToString() == "00:11:22:33:44:55:ee:ff");
+    REQUIRE(UwbMacAddress::FromString(uwbMacAddressShort.ToString(), UwbMacAddressType::Short) == uwbMacAddressShort);
+    REQUIRE(UwbMacAddress::FromString(uwbMacAddressExtended.ToString(), UwbMacAddressType::Extended) == uwbMacAddressExtended);
+}
+
+TEST_CASE("uwb mac addresses are ordered", "[basic]")
+{
+    using namespace uwb;
+
+    const UwbMacAddress uwbMacAddressShort1{ std::array<uint8_t, 2>{ 0x11, 0xFF } };
+    const UwbMacAddress uwbMacAddressShort2{ std::array<uint8_t, 2>{ 0x22, 0x00 } };
+    const UwbMacAddress uwbMacAddressExtended{ std::array<uint8_t, 8>{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } };
+
+    REQUIRE(uwbMacAddressShort1 < uwbMacAddressShort2);
+    REQUIRE(uwbMacAddressShort2 < uwbMacAddressExtended);
+    REQUIRE((uwbMacAddressShort1 <=> UwbMacAddress{ uwbMacAddressShort1 }) == std::strong_ordering::equal);
+}
+
+TEST_CASE("uwb mac address performance", "[.][benchmark]")
+{
+    using namespace uwb;
+
+    std::vector<UwbMacAddress> uwbMacAddresses;
+    for (uint8_t i = 0; i < 128; i++) {
+        uwbMacAddresses.emplace_back(std::array<uint8_t, 2>{ i, 0xAA });
+        uwbMacAddresses.emplace_back(std::array<uint8_t, 8>{ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, i });
+    }
+    const UwbMacAddress uwbMacAddressToFind{ std::array<uint8_t, 8>{ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 } };
+
+    BENCHMARK("copy 256 addresses")
+    {
+        return std::vector<UwbMacAddress>(uwbMacAddresses);
+    };
+
+    BENCHMARK("hash 256 addresses")
+    {
+        std::size_t value = 0;
+        for (const auto& uwbMacAddress : uwbMacAddresses) {
+            value ^= std::hash<UwbMacAddress>{}(uwbMacAddress);
+        }
+        return value;
+    };
+
+    BENCHMARK("compare 256 addresses")
+    {
+        return std::count(std::cbegin(uwbMacAddresses), std::cend(uwbMacAddresses), uwbMacAddressToFind);
+    };
+
+    BENCHMARK("convert to string")
+    {
+        return uwbMacAddressToFind.ToString();
+    };
+
+    BENCHMARK("create from string")
+    {
+        return UwbMacAddress::FromString("00:11:22:33:44:55:66:77", UwbMacAddressType::Extended);
+    };
+
+    BENCHMARK("generate random extended address")
+    {
+        return UwbMacAddress::Random<UwbMacAddressType::Extended>();
+    };
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
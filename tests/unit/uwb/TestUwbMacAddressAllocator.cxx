@@ -0,0 +1,91 @@
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbMacAddressAllocator.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+TEST_CASE("uwb mac address allocator allocates unique addresses", "[basic]")
+{
+    using namespace uwb;
+
+    UwbMacAddressAllocator allocator{};
+
+    SECTION("single addresses have the requested type and are tracked")
+    {
+        for (const auto type : { UwbMacAddressType::Short, UwbMacAddressType::Extended }) {
+            const auto uwbMacAddress = allocator.Allocate(type);
+            REQUIRE(uwbMacAddress.has_value());
+            REQUIRE(uwbMacAddress->GetType() == type);
+            REQUIRE(allocator.IsAllocated(*uwbMacAddress));
+        }
+        REQUIRE(allocator.GetAllocatedCount() == 2);
+    }
+
+    SECTION("batches contain unique addresses")
+    {
+        const auto uwbMacAddresses = allocator.Allocate(UwbMacAddressType::Short, 1000);
+        REQUIRE(uwbMacAddresses.size() == 1000);
+
+        const std::unordered_set<UwbMacAddress> uwbMacAddressesUnique(std::cbegin(uwbMacAddresses), std::cend(uwbMacAddresses));
+        REQUIRE(uwbMacAddressesUnique.size() == uwbMacAddresses.size());
+        REQUIRE(allocator.GetAllocatedCount() == uwbMacAddresses.size());
+    }
+
+    SECTION("reserved addresses are never allocated")
+    {
+        const UwbMacAddress uwbMacAddressReserved{ std::array<uint8_t, 2>{ 0x12, 0x34 } };
+        REQUIRE(allocator.Reserve(uwbMacAddressReserved));
+        REQUIRE_FALSE(allocator.Reserve(uwbMacAddressReserved));
+
+        const auto uwbMacAddresses = allocator.Allocate(UwbMacAddressType::Short, UwbMacAddressAllocator::ShortAddressCount);
+        REQUIRE(uwbMacAddresses.size() == UwbMacAddressAllocator::ShortAddressCount - 1);
+        REQUIRE(std::find(std::cbegin(uwbMacAddresses), std::cend(uwbMacAddresses), uwbMacAddressReserved) == std::cend(uwbMacAddresses));
+    }
+
+    SECTION("allocation fails once the short address space is exhausted")
+    {
+        const auto uwbMacAddresses = allocator.Allocate(UwbMacAddressType::Short, UwbMacAddressAllocator::ShortAddressCount);
+        REQUIRE(uwbMacAddresses.size() == UwbMacAddressAllocator::ShortAddressCount);
+        REQUIRE_FALSE(allocator.Allocate(UwbMacAddressType::Short).has_value());
+        REQUIRE(allocator.Allocate(UwbMacAddressType::Extended).has_value());
+
+        SECTION("released addresses can be allocated again")
+        {
+            REQUIRE(allocator.Release(uwbMacAddresses.front()));
+            REQUIRE_FALSE(allocator.Release(uwbMacAddresses.front()));
+            REQUIRE(allocator.Allocate(UwbMacAddressType::Short) == uwbMacAddresses.front());
+        }
+    }
+}
+
+TEST_CASE("uwb mac address allocator performance", "[.][benchmark]")
+{
+    using namespace uwb;
+
+    BENCHMARK("allocate 1000 extended addresses individually")
+    {
+        UwbMacAddressAllocator allocator{};
+        for (std::size_t i = 0; i < 1000; i++) {
+            allocator.Allocate(UwbMacAddressType::Extended);
+        }
+        return allocator.GetAllocatedCount();
+    };
+
+    BENCHMARK("allocate 1000 extended addresses in a batch")
+    {
+        UwbMacAddressAllocator allocator{};
+        return allocator.Allocate(UwbMacAddressType::Extended, 1000);
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -1,12 +1,17 @@
 
 #include <array>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <uwb/UwbPeer.hxx>
 #include <uwb/UwbPeerJsonSerializer.hxx>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
@@ -119,6 +124,59 @@ TEST_CASE("uwb peers can be copied", "[basic]")
     }
 }
 
+TEST_CASE("uwb peers can be moved", "[basic]")
+{
+    using namespace uwb;
+
+    UwbPeer peerOriginal{ test::UwbMacAddressRandomExtended, test::UwbPeerSpatialPropertiesAllPopulated };
+    UwbPeer peerMoved{ std::move(peerOriginal) };
+    REQUIRE(peerMoved.GetAddress() == test::UwbMacAddressRandomExtended);
+    REQUIRE(peerMoved.GetSpatialProperties() == test::UwbPeerSpatialPropertiesAllPopulated);
+
+    UwbPeer peerMoveAssigned{};
+    peerMoveAssigned = std::move(peerMoved);
+    REQUIRE(peerMoveAssigned.GetAddress() == test::UwbMacAddressRandomExtended);
+    REQUIRE(peerMoveAssigned.GetSpatialProperties() == test::UwbPeerSpatialPropertiesAllPopulated);
+}
+
+TEST_CASE("uwb peer spatial properties can be updated", "[basic]")
+{
+    using namespace uwb;
+
+    UwbPeer peer{ test::UwbMacAddressRandomShort };
+    peer.SetSpatialProperties(test::UwbPeerSpatialPropertiesAllPopulated);
+    REQUIRE(peer.GetSpatialProperties() == test::UwbPeerSpatialPropertiesAllPopulated);
+
+    SECTION("copies reflect updated properties")
+    {
+        const UwbPeer peerCopy{ peer };
+        REQUIRE(peerCopy.GetSpatialProperties() == test::UwbPeerSpatialPropertiesAllPopulated);
+    }
+
+    SECTION("readers concurrent with updates observe whole updates")
+    {
+        std::atomic<bool> writerDone{ false };
+        std::atomic<bool> mixedReadObserved{ false };
+
+        std::thread reader([&] {
+            while (!writerDone.load(std::memory_order_relaxed)) {
+                const auto spatialProperties = peer.GetSpatialProperties();
+                if (spatialProperties != test::UwbPeerSpatialPropertiesAllEmpty && spatialProperties != test::UwbPeerSpatialPropertiesAllPopulated) {
+                    mixedReadObserved = true;
+                }
+            }
+        });
+
+        for (auto i = 0; i < 100000; i++) {
+            peer.SetSpatialProperties((i % 2 == 0) ? test::UwbPeerSpatialPropertiesAllEmpty : test::UwbPeerSpatialPropertiesAllPopulated);
+        }
+        writerDone = true;
+        reader.join();
+
+        REQUIRE_FALSE(mixedReadObserved);
+    }
+}
+
 TEST_CASE("uwb peers can be compared for equality", "[basic]")
 {
     using namespace uwb;
@@ -217,4 +275,38 @@ TEST_CASE("uwb peer serialization is stable", "[basic][uwb][serialize]")
     }
 }
 
+TEST_CASE("uwb peer performance", "[.][benchmark]")
+{
+    using namespace uwb;
+
+    const UwbPeer uwbPeer{ test::UwbMacAddressRandomExtended, test::UwbPeerSpatialPropertiesAllPopulated };
+    const std::vector<UwbPeer> uwbPeers(256, uwbPeer);
+
+    BENCHMARK("read spatial properties")
+    {
+        return uwbPeer.GetSpatialProperties();
+    };
+
+    BENCHMARK("copy 256 peers")
+    {
+        return std::vector<UwbPeer>(uwbPeers);
+    };
+
+    UwbPeer uwbPeerUpdated{ test::UwbMacAddressRandomExtended };
+    std::atomic<bool> writerDone{ false };
+    std::thread writer([&] {
+        for (auto i = 0; !writerDone.load(std::memory_order_relaxed); i++) {
+            uwbPeerUpdated.SetSpatialProperties((i % 2 == 0) ? test::UwbPeerSpatialPropertiesAllEmpty : test::UwbPeerSpatialPropertiesAllPopulated);
+        }
+    });
+
+    BENCHMARK("read spatial properties with a concurrent writer")
+    {
+        return uwbPeerUpdated.GetSpatialProperties();
+    };
+
+    writerDone = true;
+    writer.join();
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
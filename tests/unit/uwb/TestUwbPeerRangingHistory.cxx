@@ -0,0 +1,291 @@
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbPeerRangingHistory.hxx>
+#include <uwb/UwbPeerRangingHistoryStore.hxx>
+#include <uwb/UwbRangingHistoryBudget.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::test
+{
+/**
+ * @brief Create a sample whose distance is the specified value, taken the
+ * same number of milliseconds after the epoch.
+ *
+ * @param value The distance and timestamp offset of the sample.
+ * @return UwbPeerRangingSample
+ */
+UwbPeerRangingSample
+MakeRangingSample(uint32_t value)
+{
+    UwbPeerSpatialProperties spatialProperties{};
+    spatialProperties.Distance = value;
+    spatialProperties.AngleAzimuth = 10.0;
+
+    const UwbPeer peer{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x00 } }, spatialProperties };
+    return UwbPeerRangingSample::FromPeer(peer, UwbPeerRangingSample::Clock::time_point{ std::chrono::milliseconds(value) });
+}
+
+/**
+ * @brief Create a set of peers that are all at the specified distance.
+ *
+ * @param numPeers The number of peers.
+ * @param distance The distance of the peers.
+ * @return std::vector<UwbPeer>
+ */
+std::vector<UwbPeer>
+MakeRangingHistoryPeers(std::size_t numPeers, double distance)
+{
+    std::vector<UwbPeer> peers{};
+    peers.reserve(numPeers);
+    for (std::size_t i = 0; i < numPeers; i++) {
+        UwbPeerSpatialProperties spatialProperties{};
+        spatialProperties.Distance = distance;
+        peers.emplace_back(UwbMacAddress{ std::array<uint8_t, 2>{ static_cast<uint8_t>(i + 1), 0x00 } }, spatialProperties);
+    }
+
+    return peers;
+}
+} // namespace uwb::test
+
+TEST_CASE("uwb peer ranging history retains the most recent samples", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::test;
+    using Clock = UwbPeerRangingHistory::Clock;
+
+    UwbPeerRangingHistory history{ 7 };
+    REQUIRE(history.GetCapacity() == 8);
+    REQUIRE(history.GetSize() == 0);
+    REQUIRE_FALSE(history.GetLatest().has_value());
+
+    std::array<UwbPeerRangingSample, 16> samples{};
+
+    SECTION("samples are retained until the capacity is reached")
+    {
+        for (uint32_t i = 1; i <= 5; i++) {
+            history.Push(MakeRangingSample(i));
+        }
+        REQUIRE(history.GetSize() == 5);
+        REQUIRE(history.GetLatest()->Distance == 5);
+
+        REQUIRE(history.CopyLast(samples) == 5);
+        for (std::size_t i = 0; i < 5; i++) {
+            REQUIRE(samples[i].Distance == static_cast<float>(i + 1));
+        }
+    }
+
+    SECTION("the oldest samples are overwritten once the capacity is reached")
+    {
+        for (uint32_t i = 1; i <= 21; i++) {
+            history.Push(MakeRangingSample(i));
+        }
+        REQUIRE(history.GetSize() == 8);
+
+        REQUIRE(history.CopyLast(std::span{ samples }.first(3)) == 3);
+        REQUIRE(samples[0].Distance == 19);
+        REQUIRE(samples[2].Distance == 21);
+
+        REQUIRE(history.CopyLast(samples) == 8);
+        REQUIRE(samples[0].Distance == 14);
+        REQUIRE(samples[7].Distance == 21);
+
+        history.Clear();
+        REQUIRE(history.GetSize() == 0);
+        REQUIRE(history.CopyLast(samples) == 0);
+    }
+
+    SECTION("samples can be queried by time")
+    {
+        for (uint32_t i = 1; i <= 21; i++) {
+            history.Push(MakeRangingSample(i));
+        }
+
+        REQUIRE(history.CopySince(Clock::time_point{ std::chrono::milliseconds(18) }, samples) == 4);
+        REQUIRE(samples[0].Distance == 18);
+        REQUIRE(samples[3].Distance == 21);
+
+        REQUIRE(history.CopySince(Clock::time_point{ std::chrono::milliseconds(18) }, std::span{ samples }.first(2)) == 2);
+        REQUIRE(samples[0].Distance == 20);
+
+        REQUIRE(history.CopySince(Clock::time_point{ std::chrono::milliseconds(0) }, samples) == 8);
+        REQUIRE(history.CopySince(Clock::time_point{ std::chrono::milliseconds(22) }, samples) == 0);
+    }
+
+    SECTION("samples can be aggregated by time")
+    {
+        for (uint32_t i = 1; i <= 4; i++) {
+            history.Push(MakeRangingSample(i));
+        }
+        auto sampleFailed = MakeRangingSample(5);
+        sampleFailed.Status = UwbPeerRangingSample::StatusCode::RangingRxTimeout;
+        history.Push(sampleFailed);
+
+        const auto aggregate = history.Aggregate(Clock::time_point{ std::chrono::milliseconds(2) });
+        REQUIRE(aggregate.Count == 4);
+        REQUIRE(aggregate.CountSuccessful == 3);
+        REQUIRE(aggregate.DistanceMin == 2.0f);
+        REQUIRE(aggregate.DistanceMax == 4.0f);
+        REQUIRE(aggregate.DistanceMean == 3.0f);
+        REQUIRE(aggregate.AngleAzimuthMean == 10.0f);
+        REQUIRE_FALSE(aggregate.AngleElevationMean.has_value());
+
+        const auto aggregateEmpty = history.Aggregate(Clock::time_point{ std::chrono::milliseconds(6) });
+        REQUIRE(aggregateEmpty.Count == 0);
+        REQUIRE_FALSE(aggregateEmpty.DistanceMean.has_value());
+    }
+}
+
+TEST_CASE("uwb peer ranging sample conversions", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+
+    UwbRangingMeasurement rangingMeasurement{};
+    rangingMeasurement.Distance = 150;
+    rangingMeasurement.Status = UwbStatusRanging::RxTimeout;
+    rangingMeasurement.AoAAzimuth.FigureOfMerit = 80;
+
+    const auto sample = UwbPeerRangingSample::FromRangingMeasurement(rangingMeasurement, UwbPeerRangingSample::Clock::now());
+    REQUIRE(sample.Distance == 150);
+    REQUIRE(sample.AngleAzimuthFom == 80);
+    REQUIRE(sample.Status == UwbPeerRangingSample::StatusCode::RangingRxTimeout);
+    REQUIRE(sample.ToSpatialProperties() == UwbPeer{ rangingMeasurement }.GetSpatialProperties());
+
+    const auto sampleEmpty = UwbPeerRangingSample::FromPeer(UwbPeer{ rangingMeasurement.PeerMacAddress }, UwbPeerRangingSample::Clock::now());
+    REQUIRE(std::isnan(sampleEmpty.Distance));
+    REQUIRE_FALSE(sampleEmpty.ToSpatialProperties().Distance.has_value());
+}
+
+TEST_CASE("uwb peer ranging history store tracks peers within a budget", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::test;
+    using Clock = UwbPeerRangingHistoryStore::Clock;
+
+    const auto peers = MakeRangingHistoryPeers(4, 1.0);
+    std::array<UwbPeerRangingSample, 8> samples{};
+
+    SECTION("samples are recorded per peer")
+    {
+        UwbPeerRangingHistoryStore store{ 8 };
+        store.Record(peers, Clock::time_point{ std::chrono::milliseconds(1) });
+        store.Record(std::span<const UwbPeer>{ peers }.first(1), Clock::time_point{ std::chrono::milliseconds(2) });
+        REQUIRE(store.GetPeerCount() == 4);
+
+        REQUIRE(store.CopyLast(peers[0].GetAddress(), samples) == 2);
+        REQUIRE(store.CopyLast(peers[1].GetAddress(), samples) == 1);
+        REQUIRE(store.CopySince(peers[0].GetAddress(), Clock::time_point{ std::chrono::milliseconds(2) }, samples) == 1);
+        REQUIRE(store.Aggregate(peers[0].GetAddress(), Clock::time_point{})->Count == 2);
+
+        const UwbMacAddress addressUnknown{ std::array<uint8_t, 2>{ 0xAA, 0xBB } };
+        REQUIRE(store.CopyLast(addressUnknown, samples) == 0);
+        REQUIRE_FALSE(store.Aggregate(addressUnknown, Clock::time_point{}).has_value());
+
+        store.Remove(std::span<const UwbPeer>{ peers }.first(1));
+        REQUIRE(store.GetPeerCount() == 3);
+        REQUIRE(store.CopyLast(peers[0].GetAddress(), samples) == 0);
+    }
+
+    SECTION("ranging data statuses are recorded")
+    {
+        protocol::fira::UwbRangingData rangingData{};
+        protocol::fira::UwbRangingMeasurement rangingMeasurement{};
+        rangingMeasurement.PeerMacAddress = peers[0].GetAddress();
+        rangingMeasurement.Status = protocol::fira::UwbStatusRanging::TxFailed;
+        rangingData.RangingMeasurements.push_back(rangingMeasurement);
+
+        UwbPeerRangingHistoryStore store{};
+        store.Record(rangingData, Clock::now());
+        REQUIRE(store.CopyLast(peers[0].GetAddress(), samples) == 1);
+        REQUIRE(samples[0].Status == UwbPeerRangingSample::StatusCode::RangingTxFailed);
+    }
+
+    SECTION("peers beyond the budget are not tracked")
+    {
+        auto budget = std::make_shared<UwbRangingHistoryBudget>();
+
+        {
+            UwbPeerRangingHistoryStore store{ 8, budget };
+            budget->SetLimit(store.GetPeerMemoryUsage() * 3);
+
+            store.Record(peers, Clock::now());
+            REQUIRE(store.GetPeerCount() == 3);
+            REQUIRE(budget->GetUsage() == store.GetPeerMemoryUsage() * 3);
+            REQUIRE(store.CopyLast(peers[3].GetAddress(), samples) == 0);
+
+            // Memory returned by one session is available to another.
+            UwbPeerRangingHistoryStore storeOther{ 8, budget };
+            store.Remove(std::span<const UwbPeer>{ peers }.first(1));
+            storeOther.Record(peers, Clock::now());
+            REQUIRE(storeOther.GetPeerCount() == 1);
+        }
+
+        REQUIRE(budget->GetUsage() == 0);
+    }
+}
+
+TEST_CASE("uwb ranging history budget limits usage", "[basic]")
+{
+    using namespace uwb;
+
+    UwbRangingHistoryBudget budget{ 100 };
+    REQUIRE(budget.TryAcquire(60));
+    REQUIRE_FALSE(budget.TryAcquire(41));
+    REQUIRE(budget.TryAcquire(40));
+    REQUIRE(budget.GetUsage() == 100);
+
+    budget.SetLimit(50);
+    REQUIRE_FALSE(budget.TryAcquire(1));
+    budget.Release(60);
+    REQUIRE(budget.TryAcquire(10));
+    REQUIRE(budget.GetUsage() == 50);
+}
+
+TEST_CASE("uwb peer ranging history performance", "[.][benchmark]")
+{
+    using namespace uwb;
+    using namespace uwb::test;
+    using Clock = UwbPeerRangingHistoryStore::Clock;
+
+    UwbPeerRangingHistoryStore store{};
+    const auto peers = MakeRangingHistoryPeers(16, 1.0);
+    for (std::size_t i = 0; i < UwbPeerRangingHistoryStore::CapacityDefault; i++) {
+        store.Record(peers, Clock::now());
+    }
+
+    std::array<UwbPeerRangingSample, UwbPeerRangingHistoryStore::CapacityDefault> samples{};
+    const auto since = Clock::now() - std::chrono::seconds(1);
+
+    BENCHMARK("record 16 peers")
+    {
+        store.Record(peers, Clock::now());
+        return store.GetPeerCount();
+    };
+
+    BENCHMARK("copy the full history of a peer")
+    {
+        return store.CopyLast(peers.back().GetAddress(), samples);
+    };
+
+    BENCHMARK("aggregate the full history of a peer")
+    {
+        return store.Aggregate(peers.back().GetAddress(), since);
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
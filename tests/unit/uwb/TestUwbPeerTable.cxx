@@ -0,0 +1,207 @@
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbPeerTable.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::test
+{
+/**
+ * @brief Create a set of peers whose spatial properties are all derived from
+ * a single value, so a torn read is detectable.
+ *
+ * @param numPeers The number of peers.
+ * @param value The value to derive the spatial properties from.
+ * @return std::vector<UwbPeer>
+ */
+std::vector<UwbPeer>
+MakePeerTablePeers(std::size_t numPeers, double value)
+{
+    std::vector<UwbPeer> peers{};
+    peers.reserve(numPeers);
+    for (std::size_t i = 0; i < numPeers; i++) {
+        UwbPeerSpatialProperties spatialProperties{};
+        spatialProperties.Distance = value;
+        spatialProperties.AngleAzimuth = value;
+        spatialProperties.AngleElevation = value;
+        peers.emplace_back(UwbMacAddress{ std::array<uint8_t, 2>{ static_cast<uint8_t>(i + 1), 0x00 } }, spatialProperties);
+    }
+
+    return peers;
+}
+} // namespace uwb::test
+
+TEST_CASE("uwb peer table tracks the latest state of each peer", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::test;
+
+    UwbPeerTable peerTable{};
+    REQUIRE(peerTable.GetPeerCount() == 0);
+    REQUIRE(peerTable.GetSequenceNumber() == 0);
+    REQUIRE(peerTable.GetPeers().empty());
+
+    const auto peers = MakePeerTablePeers(3, 1.0);
+    REQUIRE(peerTable.Update(peers) == 1);
+    REQUIRE(peerTable.GetPeerCount() == 3);
+
+    SECTION("new peers are added")
+    {
+        for (const auto& peer : peers) {
+            const auto entry = peerTable.GetPeer(peer.GetAddress());
+            REQUIRE(entry.has_value());
+            REQUIRE(entry->Address == peer.GetAddress());
+            REQUIRE(entry->SpatialProperties == peer.GetSpatialProperties());
+            REQUIRE(entry->SequenceNumber == 1);
+            REQUIRE(entry->ToPeer().GetSpatialProperties() == peer.GetSpatialProperties());
+        }
+    }
+
+    SECTION("unknown peers are not found")
+    {
+        REQUIRE_FALSE(peerTable.GetPeer(UwbMacAddress{ std::array<uint8_t, 2>{ 0xAA, 0xBB } }).has_value());
+    }
+
+    SECTION("known peers are updated in place")
+    {
+        const auto timestampPrevious = peerTable.GetPeer(peers.front().GetAddress())->Timestamp;
+        const auto peersUpdated = MakePeerTablePeers(1, 2.0);
+        REQUIRE(peerTable.Update(peersUpdated) == 2);
+        REQUIRE(peerTable.GetPeerCount() == 3);
+
+        const auto entryUpdated = peerTable.GetPeer(peersUpdated.front().GetAddress());
+        REQUIRE(entryUpdated->SpatialProperties.Distance == 2.0);
+        REQUIRE(entryUpdated->SequenceNumber == 2);
+        REQUIRE(entryUpdated->Timestamp >= timestampPrevious);
+
+        // Peers absent from the update retain their previous state.
+        const auto entryStale = peerTable.GetPeer(peers.back().GetAddress());
+        REQUIRE(entryStale->SpatialProperties.Distance == 1.0);
+        REQUIRE(entryStale->SequenceNumber == 1);
+    }
+
+    SECTION("peers can be removed")
+    {
+        peerTable.Remove(std::span<const UwbPeer>{ peers }.first(1));
+        REQUIRE(peerTable.GetPeerCount() == 2);
+        REQUIRE_FALSE(peerTable.GetPeer(peers.front().GetAddress()).has_value());
+
+        peerTable.Clear();
+        REQUIRE(peerTable.GetPeerCount() == 0);
+        REQUIRE(peerTable.GetSequenceNumber() == 1);
+    }
+}
+
+TEST_CASE("uwb peer table can be updated from ranging data", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+
+    UwbRangingData rangingData{};
+    rangingData.SequenceNumber = 7;
+    rangingData.RangingMeasurementType = UwbRangingMeasurementType::TwoWay;
+    for (const uint8_t peerIndex : std::array<uint8_t, 2>{ 0x01, 0x02 }) {
+        UwbRangingMeasurement rangingMeasurement{};
+        rangingMeasurement.Distance = static_cast<uint16_t>(120 * peerIndex);
+        rangingMeasurement.PeerMacAddress = UwbMacAddress{ std::array<uint8_t, 2>{ peerIndex, 0x00 } };
+        rangingData.RangingMeasurements.push_back(rangingMeasurement);
+    }
+
+    UwbPeerTable peerTable{};
+    REQUIRE(peerTable.Update(rangingData) == 1);
+    REQUIRE(peerTable.GetPeerCount() == 2);
+
+    for (const auto& rangingMeasurement : rangingData.RangingMeasurements) {
+        const auto entry = peerTable.GetPeer(rangingMeasurement.PeerMacAddress);
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->SpatialProperties == UwbPeer{ rangingMeasurement }.GetSpatialProperties());
+    }
+}
+
+TEST_CASE("uwb peer table readers never observe torn entries", "[concurrency]")
+{
+    using namespace uwb;
+    using namespace uwb::test;
+
+    static constexpr std::size_t NumPeers = 8;
+    static constexpr std::size_t UpdateCount = 20000;
+    static constexpr std::size_t ReaderCount = 4;
+
+    UwbPeerTable peerTable{};
+    std::atomic<bool> writerDone{ false };
+    std::atomic<bool> tornReadObserved{ false };
+
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < ReaderCount; i++) {
+        readers.emplace_back([&] {
+            while (!writerDone.load(std::memory_order_relaxed)) {
+                for (const auto& entry : peerTable.GetPeers()) {
+                    const auto& spatialProperties = entry.SpatialProperties;
+                    if (spatialProperties.Distance != spatialProperties.AngleAzimuth || spatialProperties.Distance != spatialProperties.AngleElevation || spatialProperties.Distance.value_or(0) != static_cast<double>(entry.SequenceNumber)) {
+                        tornReadObserved = true;
+                    }
+                }
+            }
+        });
+    }
+
+    std::thread writer([&] {
+        for (std::size_t i = 1; i <= UpdateCount; i++) {
+            // Periodically drop a peer so the index is republished while readers are active.
+            if (i % 1000 == 0) {
+                peerTable.Remove(std::span<const UwbPeer>{ MakePeerTablePeers(1, 0) });
+            }
+            peerTable.Update(MakePeerTablePeers(NumPeers, static_cast<double>(i)));
+        }
+        writerDone = true;
+    });
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE_FALSE(tornReadObserved);
+    REQUIRE(peerTable.GetPeerCount() == NumPeers);
+    REQUIRE(peerTable.GetSequenceNumber() == UpdateCount);
+}
+
+TEST_CASE("uwb peer table performance", "[.][benchmark]")
+{
+    using namespace uwb;
+    using namespace uwb::test;
+
+    UwbPeerTable peerTable{};
+    const auto peers = MakePeerTablePeers(16, 1.0);
+    peerTable.Update(peers);
+
+    BENCHMARK("update 16 known peers")
+    {
+        return peerTable.Update(peers);
+    };
+
+    BENCHMARK("snapshot 16 peers")
+    {
+        return peerTable.GetPeers();
+    };
+
+    BENCHMARK("lookup a single peer")
+    {
+        return peerTable.GetPeer(peers.back().GetAddress());
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
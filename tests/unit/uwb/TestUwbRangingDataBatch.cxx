@@ -0,0 +1,238 @@
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbRangingDataBatch.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::test
+{
+using namespace uwb::protocol::fira;
+
+/**
+ * @brief Create ranging data for a round with the specified number of peers.
+ *
+ * @param numMeasurements The number of measurements (peers).
+ * @param sequenceNumber The sequence number of the round.
+ * @return UwbRangingData
+ */
+UwbRangingData
+MakeBatchRangingData(std::size_t numMeasurements, uint32_t sequenceNumber)
+{
+    UwbRangingData rangingData{
+        .SequenceNumber = sequenceNumber,
+        .SessionId = 0x12345678,
+        .CurrentRangingInterval = 50,
+        .RangingMeasurementType = UwbRangingMeasurementType::TwoWay,
+    };
+
+    for (std::size_t i = 0; i < numMeasurements; i++) {
+        rangingData.RangingMeasurements.push_back(UwbRangingMeasurement{
+            .SlotIndex = static_cast<uint8_t>(i),
+            .Distance = static_cast<uint16_t>(100 * (i + 1) + sequenceNumber),
+            .Status = (i % 3 == 2) ? UwbStatus{ UwbStatusRanging::RxTimeout } : UwbStatus{ UwbStatusGeneric::Ok },
+            .PeerMacAddress = UwbMacAddress{ std::array<uint8_t, 2>{ static_cast<uint8_t>(i + 1), 0x00 } },
+            .LineOfSightIndicator = (i % 2 == 0) ? UwbLineOfSightIndicator::LineOfSight : UwbLineOfSightIndicator::Indeterminant,
+            .AoAAzimuth = { .Result = static_cast<uint16_t>(0x1280 + i), .FigureOfMerit = static_cast<uint8_t>(50 + ((i * 7 + sequenceNumber) % 50)) },
+            .AoAElevation = { .Result = 0xFF80 },
+            .AoaDestinationAzimuth = { .Result = 0x0040, .FigureOfMerit = 50 },
+            .AoaDestinationElevation = { .Result = 0x0000 },
+        });
+    }
+
+    return rangingData;
+}
+} // namespace uwb::test
+
+TEST_CASE("UwbRangingDataBatch stores measurements as parallel arrays", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::test;
+
+    UwbRangingDataBatch batch{};
+    const std::vector<UwbRangingData> rounds{ MakeBatchRangingData(4, 1), MakeBatchRangingData(0, 2), MakeBatchRangingData(6, 3) };
+    for (const auto& round : rounds) {
+        batch.Append(round);
+    }
+
+    SECTION("columns are indexed by measurement")
+    {
+        REQUIRE(batch.GetNumRounds() == 3);
+        REQUIRE(batch.GetNumMeasurements() == 10);
+        REQUIRE(batch.GetRoundOffsets().size() == 4);
+        REQUIRE(batch.GetRoundOffsets()[1] == 4);
+        REQUIRE(batch.GetRoundOffsets()[2] == 4);
+        REQUIRE(batch.GetRoundOffsets()[3] == 10);
+        REQUIRE(batch.GetSequenceNumbers()[2] == 3);
+        REQUIRE(batch.GetDistances()[5] == 203);
+        REQUIRE(batch.GetAoAElevationFoms()[5] == 0);
+        REQUIRE(batch.GetStatusCodes()[2] == UwbRangingDataBatch::StatusCode::RangingRxTimeout);
+        REQUIRE(batch.GetLineOfSightIndicators()[1] == UwbLineOfSightIndicator::Indeterminant);
+    }
+
+    SECTION("peer addresses are de-duplicated")
+    {
+        REQUIRE(batch.GetPeerAddresses().size() == 6);
+        REQUIRE(batch.GetPeerIndices()[0] == batch.GetPeerIndices()[4]);
+        REQUIRE(batch.GetPeerAddresses()[batch.GetPeerIndices()[9]] == rounds[2].RangingMeasurements[5].PeerMacAddress);
+    }
+
+    SECTION("rounds convert back to the original ranging data")
+    {
+        UwbRangingData rangingData{};
+        for (std::size_t i = 0; i < rounds.size(); i++) {
+            batch.GetRangingData(i, rangingData);
+            REQUIRE(rangingData == rounds[i]);
+        }
+        REQUIRE_THROWS_AS(batch.GetRangingData(rounds.size()), std::out_of_range);
+    }
+
+    SECTION("rounds convert to the peers of their measurements")
+    {
+        const auto peers = batch.GetPeers(2);
+        REQUIRE(peers.size() == rounds[2].RangingMeasurements.size());
+        for (std::size_t i = 0; i < peers.size(); i++) {
+            REQUIRE(peers[i] == UwbPeer{ rounds[2].RangingMeasurements[i] });
+        }
+    }
+
+    SECTION("clearing retains capacity")
+    {
+        batch.Clear();
+        REQUIRE(batch.GetNumRounds() == 0);
+        REQUIRE(batch.GetNumMeasurements() == 0);
+        REQUIRE(batch.GetPeerAddresses().empty());
+        REQUIRE(batch.GetRoundOffsets().size() == 1);
+
+        batch.Append(rounds[0]);
+        REQUIRE(batch.GetRangingData(0) == rounds[0]);
+        REQUIRE(batch.GetPeerIndices()[0] == 0);
+    }
+}
+
+TEST_CASE("UwbRangingDataBatch converts peers", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::test;
+
+    const std::vector<UwbPeer> peers{
+        UwbPeer{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x02 } }, UwbPeerSpatialProperties{ .Distance = 150, .AngleAzimuth = 12.5, .AngleElevation = 3.0, .Elevation = 1.25, .AngleAzimuthFom = 10, .AngleElevationFom = 20, .ElevationFom = 30 } },
+        UwbPeer{ UwbMacAddress{ std::array<uint8_t, 8>{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 } }, UwbPeerSpatialProperties{ .Distance = 7, .AngleAzimuth = 90.0, .AngleElevation = 45.0, .Elevation = 0.5, .AngleAzimuthFom = 1, .AngleElevationFom = 2, .ElevationFom = 3 } },
+    };
+
+    UwbRangingDataBatch batch{};
+    batch.Append(peers, 0xAABBCCDD, 9);
+    REQUIRE(batch.GetNumRounds() == 1);
+    REQUIRE(batch.GetSessionIds()[0] == 0xAABBCCDD);
+    REQUIRE(batch.GetAoAAzimuths()[0] == 0x0640);
+    REQUIRE(batch.GetPeers(0) == peers);
+
+    const UwbPeer peerEmpty{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x03, 0x04 } } };
+    batch.Append(std::vector<UwbPeer>{ peerEmpty });
+    REQUIRE(batch.GetDistances()[2] == 0);
+    REQUIRE(batch.GetAoAAzimuthFoms()[2] == 0);
+    REQUIRE(batch.GetPresence()[2] == 0);
+    REQUIRE_FALSE(batch.GetRangingData(1).RangingMeasurements[0].AoAAzimuth.FigureOfMerit.has_value());
+}
+
+TEST_CASE("UwbRangingDataBatch round-trips absent and zero-valued fields", "[basic]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::test;
+
+    UwbRangingDataBatch batch{};
+
+    SECTION("a figure of merit of 0 is distinct from an absent one")
+    {
+        auto rangingData = MakeBatchRangingData(2, 1);
+        rangingData.RangingMeasurements[0].AoAAzimuth.FigureOfMerit = 0;
+        rangingData.RangingMeasurements[1].AoAAzimuth.FigureOfMerit = std::nullopt;
+        batch.Append(rangingData);
+
+        REQUIRE(batch.GetAoAAzimuthFoms()[0] == batch.GetAoAAzimuthFoms()[1]);
+        REQUIRE((batch.GetPresence()[0] & UwbRangingDataBatch::Presence::AoAAzimuthFom) != 0);
+        REQUIRE((batch.GetPresence()[1] & UwbRangingDataBatch::Presence::AoAAzimuthFom) == 0);
+        REQUIRE(batch.GetRangingData(0) == rangingData);
+        REQUIRE(batch.GetPeers(0)[0].GetSpatialProperties().AngleAzimuthFom == std::optional<uint8_t>{ 0 });
+        REQUIRE_FALSE(batch.GetPeers(0)[1].GetSpatialProperties().AngleAzimuthFom.has_value());
+    }
+
+    SECTION("absent peer spatial properties remain absent")
+    {
+        const std::vector<UwbPeer> peers{
+            UwbPeer{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x02 } }, UwbPeerSpatialProperties{ .AngleAzimuth = 12.5, .AngleAzimuthFom = 0 } },
+            UwbPeer{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x03, 0x04 } }, UwbPeerSpatialProperties{ .Distance = 0, .Elevation = 0.0 } },
+            UwbPeer{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x05, 0x06 } } },
+        };
+
+        batch.Append(peers, 0xAABBCCDD, 9);
+        REQUIRE(batch.GetPeers(0) == peers);
+    }
+
+    SECTION("the ranging measurement type is stored per round")
+    {
+        batch.Append(MakeBatchRangingData(1, 1));
+        batch.Append(std::vector<UwbPeer>{});
+        REQUIRE(batch.GetRangingMeasurementTypes().size() == 2);
+        REQUIRE(batch.GetRangingMeasurementTypes()[0] == UwbRangingMeasurementType::TwoWay);
+        REQUIRE(batch.GetRangingData(1).RangingMeasurementType == UwbRangingMeasurementType::TwoWay);
+    }
+}
+
+TEST_CASE("UwbRangingDataBatch filtering performance", "[.][benchmark]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::test;
+
+    constexpr std::size_t NumRounds = 4096;
+    constexpr uint8_t FomThreshold = 75;
+
+    std::vector<UwbRangingData> rounds;
+    UwbRangingDataBatch batch{};
+    rounds.reserve(NumRounds);
+    for (uint32_t i = 0; i < NumRounds; i++) {
+        batch.Append(rounds.emplace_back(MakeBatchRangingData(1 + (i % 8), i)));
+    }
+
+    BENCHMARK("Filter std::vector<UwbRangingData>")
+    {
+        uint64_t distanceSum = 0;
+        for (const auto& round : rounds) {
+            for (const auto& measurement : round.RangingMeasurements) {
+                if (measurement.Status == UwbStatus{ UwbStatusGeneric::Ok } && measurement.AoAAzimuth.FigureOfMerit.value_or(0) >= FomThreshold) {
+                    distanceSum += measurement.Distance;
+                }
+            }
+        }
+        return distanceSum;
+    };
+
+    BENCHMARK("Filter UwbRangingDataBatch")
+    {
+        const auto distances = batch.GetDistances();
+        const auto statusCodes = batch.GetStatusCodes();
+        const auto foms = batch.GetAoAAzimuthFoms();
+        uint64_t distanceSum = 0;
+        for (std::size_t i = 0; i < distances.size(); i++) {
+            const bool accepted = (statusCodes[i] == UwbRangingDataBatch::StatusCode::Ok) & (foms[i] >= FomThreshold);
+            distanceSum += accepted ? distances[i] : 0U;
+        }
+        return distanceSum;
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
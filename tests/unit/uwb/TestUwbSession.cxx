@@ -0,0 +1,62 @@
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbSessionEventCallbacks.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+#include "UwbSessionRecording.hxx"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+TEST_CASE("uwb session tracks peers without event callbacks", "[basic]")
+{
+    using namespace uwb;
+
+    UwbPeerSpatialProperties spatialProperties{};
+    spatialProperties.Distance = 1.0;
+    const std::vector<UwbPeer> peers{
+        UwbPeer{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x00 } }, spatialProperties },
+        UwbPeer{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x02, 0x00 } }, spatialProperties },
+    };
+
+    test::UwbSessionRecording session{};
+    session.NotifyPeerPropertiesChanged(peers);
+    REQUIRE(session.GetPeers().size() == 2);
+
+    SECTION("removed peers leave the peer table")
+    {
+        session.NotifySessionMembershipChanged({}, { peers[0] });
+        REQUIRE(session.GetPeers().size() == 1);
+        REQUIRE_FALSE(session.GetPeer(peers[0].GetAddress()).has_value());
+        REQUIRE(session.GetPeer(peers[1].GetAddress()).has_value());
+    }
+
+    SECTION("removed peers leave the ranging history")
+    {
+        REQUIRE(session.GetRangingHistory().GetPeerCount() == 2);
+        session.NotifySessionMembershipChanged({}, { peers[0] });
+        REQUIRE(session.GetRangingHistory().GetPeerCount() == 1);
+    }
+
+    SECTION("ranging histories are cleared when the session ends")
+    {
+        session.NotifySessionEnded(UwbSessionEndReason::Stopped);
+        REQUIRE(session.GetRangingHistory().GetPeerCount() == 0);
+    }
+
+    SECTION("ranging histories are cleared when the session is deinitialized")
+    {
+        session.NotifySessionStateChanged(protocol::fira::UwbSessionState::Active);
+        REQUIRE(session.GetRangingHistory().GetPeerCount() == 2);
+        session.NotifySessionStateChanged(protocol::fira::UwbSessionState::Deinitialized);
+        REQUIRE(session.GetRangingHistory().GetPeerCount() == 0);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,135 @@
+
+#ifndef UWB_SESSION_RECORDING_HXX
+#define UWB_SESSION_RECORDING_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbSession.hxx>
+#include <uwb/UwbSessionEventCallbacks.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb::test
+{
+/**
+ * @brief Session which records the commands it would send to the UWBS, and
+ * which can simulate notifications from the UWBS without event callbacks.
+ */
+struct UwbSessionRecording :
+    public ::uwb::UwbSession
+{
+    UwbSessionRecording() :
+        ::uwb::UwbSession(1, std::weak_ptr<::uwb::UwbDevice>{})
+    {}
+
+    std::vector<std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>> ParametersSent{};
+    std::size_t NumStarts{ 0 };
+    std::size_t NumStops{ 0 };
+
+    /**
+     * @brief Invoked when application configuration parameters are sent, to
+     * simulate notifications the UWBS delivers synchronously.
+     */
+    std::function<void()> OnParametersSent{};
+
+    /**
+     * @brief Simulate a session status notification from the UWBS.
+     */
+    void
+    NotifySessionStateChanged(::uwb::protocol::fira::UwbSessionState state)
+    {
+        OnSessionStateChanged(nullptr, state, std::nullopt);
+    }
+
+    /**
+     * @brief Simulate a session ended notification from the UWBS.
+     */
+    void
+    NotifySessionEnded(::uwb::UwbSessionEndReason reason)
+    {
+        OnSessionEnded(nullptr, reason);
+    }
+
+    /**
+     * @brief Simulate a ranging data notification from the UWBS.
+     */
+    void
+    NotifyPeerPropertiesChanged(std::vector<::uwb::UwbPeer> peersChanged)
+    {
+        OnPeerPropertiesChanged(nullptr, std::move(peersChanged));
+    }
+
+    /**
+     * @brief Simulate a multicast list notification from the UWBS.
+     */
+    void
+    NotifySessionMembershipChanged(std::vector<::uwb::UwbPeer> peersAdded, std::vector<::uwb::UwbPeer> peersRemoved)
+    {
+        OnSessionMembershipChanged(nullptr, std::move(peersAdded), std::move(peersRemoved));
+    }
+
+private:
+    void
+    ConfigureImpl(const std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> configParams) override
+    {
+        ParametersSent.push_back(configParams);
+    }
+
+    void
+    StartRangingImpl() override
+    {
+        NumStarts++;
+    }
+
+    void
+    StopRangingImpl() override
+    {
+        NumStops++;
+    }
+
+    ::uwb::protocol::fira::UwbStatus
+    TryAddControleeImpl(::uwb::UwbMacAddress /* controleeMacAddress */) override
+    {
+        return ::uwb::protocol::fira::UwbStatusGeneric::Ok;
+    }
+
+    std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>
+    GetApplicationConfigurationParametersImpl(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameterType> /* requestedTypes */) override
+    {
+        return {};
+    }
+
+    void
+    SetApplicationConfigurationParametersImpl(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters) override
+    {
+        ParametersSent.push_back(std::move(uwbApplicationConfigurationParameters));
+        if (OnParametersSent) {
+            OnParametersSent();
+        }
+    }
+
+    ::uwb::protocol::fira::UwbSessionState
+    GetSessionStateImpl() override
+    {
+        return ::uwb::protocol::fira::UwbSessionState::Idle;
+    }
+
+    void
+    DestroyImpl() override
+    {}
+
+    std::vector<uint8_t>
+    GetOobDataObjectImpl() override
+    {
+        return {};
+    }
+};
+} // namespace uwb::test
+
+#endif // UWB_SESSION_RECORDING_HXX
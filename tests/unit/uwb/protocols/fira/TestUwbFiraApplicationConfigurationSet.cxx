@@ -0,0 +1,199 @@
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/ApplicationConfigurationSet.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+#include "AllocationCounter.hxx"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::protocol::fira::test
+{
+/**
+ * @brief Make a list of parameters holding every value alternative.
+ *
+ * @return std::vector<UwbApplicationConfigurationParameter>
+ */
+std::vector<UwbApplicationConfigurationParameter>
+MakeApplicationConfigurationParameters()
+{
+    using ParameterType = UwbApplicationConfigurationParameterType;
+
+    return {
+        { ParameterType::DeviceType, DeviceType::Controller },
+        { ParameterType::RangingRoundUsage, RangingRoundUsage::DoubleSidedTwoWayRangingWithDeferredMode },
+        { ParameterType::StsConfiguration, StsConfiguration::Static },
+        { ParameterType::MultiNodeMode, MultiNodeMode::OneToMany },
+        { ParameterType::ChannelNumber, Channel::C9 },
+        { ParameterType::NumberOfControlees, uint8_t{ 3 } },
+        { ParameterType::DeviceMacAddress, UwbMacAddress{ std::array<uint8_t, 2>{ 0x12, 0x34 } } },
+        { ParameterType::DestinationMacAddresses, std::unordered_set<UwbMacAddress>{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x03, 0x03 } }, UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x01 } }, UwbMacAddress{ std::array<uint8_t, 2>{ 0x02, 0x02 } } } },
+        { ParameterType::SlotDuration, uint16_t{ 2400 } },
+        // Ranging interval generated from a UwbConfiguration is 16 bits wide.
+        { ParameterType::RangingInterval, uint16_t{ 200 } },
+        { ParameterType::StsIndex, uint32_t{ 0xDEADBEEF } },
+        { ParameterType::MacFcsType, UwbMacAddressFcsType::Crc32 },
+        { ParameterType::RangingRoundControl, RangingRoundControl::ControlMessage },
+        { ParameterType::AoAResultRequest, AoAResult::Enable },
+        { ParameterType::RangeDataNotificationConfig, RangeDataNotificationConfiguration::EnableInProximityRange },
+        { ParameterType::DeviceRole, DeviceRole::Initiator },
+        { ParameterType::RFrameConfiguration, RFrameConfiguration::SP3 },
+        { ParameterType::PsduDataRate, PsduDataRate::Rate7800kbps },
+        { ParameterType::PreambleDuration, PreambleDuration::Symbols64 },
+        { ParameterType::RangingTimeStruct, RangingMode::Block },
+        { ParameterType::TxAdaptivePayloadPower, TxAdaptivePayloadPower::Enable },
+        { ParameterType::PrfMode, PrfModeDetailed::Hprf124MHz },
+        { ParameterType::ScheduledMode, SchedulingMode::Time },
+        { ParameterType::KeyRotation, KeyRotation::Enable },
+        { ParameterType::MacAddressMode, UwbMacAddressType::Extended },
+        { ParameterType::StaticStsIv, StaticStsInitializationVector{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 } },
+        { ParameterType::HoppingMode, true },
+        { ParameterType::ResultReportConfig, std::unordered_set<ResultReportConfiguration>{ ResultReportConfiguration::TofReport, ResultReportConfiguration::AoAFoMReport } },
+        { ParameterType::BprfPhrDataRate, BprfPhrDataRate::Rate6Mbps },
+        { ParameterType::StsLength, StsLength::Symbols128 },
+    };
+}
+} // namespace uwb::protocol::fira::test
+
+TEST_CASE("ApplicationConfigurationSet holds application configuration parameters", "[basic][protocol]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::test;
+    using ParameterType = UwbApplicationConfigurationParameterType;
+
+    const auto parameters = MakeApplicationConfigurationParameters();
+    const ApplicationConfigurationSet applicationConfigurationSet{ parameters };
+
+    SECTION("parameters round-trip in ascending type order")
+    {
+        REQUIRE(applicationConfigurationSet.Size() == parameters.size());
+        REQUIRE(applicationConfigurationSet.ToParameters() == parameters);
+    }
+
+    SECTION("values can be looked up by type")
+    {
+        REQUIRE(applicationConfigurationSet.Contains(ParameterType::StsIndex));
+        REQUIRE_FALSE(applicationConfigurationSet.Contains(ParameterType::VendorId));
+        REQUIRE(applicationConfigurationSet.Get<uint32_t>(ParameterType::StsIndex) == 0xDEADBEEF);
+        REQUIRE(applicationConfigurationSet.Get<Channel>(ParameterType::ChannelNumber) == Channel::C9);
+        REQUIRE(applicationConfigurationSet.Get<bool>(ParameterType::HoppingMode) == true);
+        REQUIRE(applicationConfigurationSet.Get<uint16_t>(ParameterType::RangingInterval) == 200);
+        REQUIRE_FALSE(applicationConfigurationSet.Get<uint32_t>(ParameterType::RangingInterval).has_value());
+        REQUIRE_FALSE(applicationConfigurationSet.Get<uint16_t>(ParameterType::VendorId).has_value());
+        REQUIRE(applicationConfigurationSet.Get<UwbMacAddress>(ParameterType::DeviceMacAddress) == UwbMacAddress{ std::array<uint8_t, 2>{ 0x12, 0x34 } });
+        REQUIRE(applicationConfigurationSet.Get<StaticStsInitializationVector>(ParameterType::StaticStsIv) == StaticStsInitializationVector{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 });
+        REQUIRE(applicationConfigurationSet.GetResultReportConfigurationMask() == 0b00001001);
+        REQUIRE(applicationConfigurationSet.GetValue(ParameterType::PrfMode) == UwbApplicationConfigurationParameterValue{ PrfModeDetailed::Hprf124MHz });
+
+        const auto destinationMacAddresses = applicationConfigurationSet.GetDestinationMacAddresses();
+        REQUIRE(destinationMacAddresses.size() == 3);
+        REQUIRE(destinationMacAddresses[0] == UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x01 } });
+        REQUIRE(destinationMacAddresses[2] == UwbMacAddress{ std::array<uint8_t, 2>{ 0x03, 0x03 } });
+    }
+
+    SECTION("values can be replaced and erased")
+    {
+        auto applicationConfigurationSetCopy = applicationConfigurationSet;
+        REQUIRE(applicationConfigurationSetCopy == applicationConfigurationSet);
+
+        applicationConfigurationSetCopy.Set(ParameterType::DestinationMacAddresses, UwbMacAddress{ std::array<uint8_t, 2>{ 0x04, 0x04 } });
+        REQUIRE(applicationConfigurationSetCopy.GetDestinationMacAddresses().size() == 1);
+        REQUIRE(applicationConfigurationSetCopy.GetValue(ParameterType::DestinationMacAddresses) == UwbApplicationConfigurationParameterValue{ UwbMacAddress{ std::array<uint8_t, 2>{ 0x04, 0x04 } } });
+        REQUIRE(applicationConfigurationSetCopy != applicationConfigurationSet);
+
+        applicationConfigurationSetCopy.Set(ParameterType::DestinationMacAddresses, std::get<std::unordered_set<UwbMacAddress>>(parameters[7].Value));
+        REQUIRE(applicationConfigurationSetCopy == applicationConfigurationSet);
+
+        applicationConfigurationSetCopy.Erase(ParameterType::StaticStsIv);
+        applicationConfigurationSetCopy.Erase(ParameterType::StaticStsIv);
+        REQUIRE(applicationConfigurationSetCopy.Size() == parameters.size() - 1);
+        REQUIRE_FALSE(applicationConfigurationSetCopy.GetValue(ParameterType::StaticStsIv).has_value());
+        applicationConfigurationSetCopy.Set(parameters[25]);
+        REQUIRE(applicationConfigurationSetCopy == applicationConfigurationSet);
+
+        applicationConfigurationSetCopy.Clear();
+        REQUIRE(applicationConfigurationSetCopy.Empty());
+        REQUIRE(applicationConfigurationSetCopy == ApplicationConfigurationSet{});
+    }
+
+    SECTION("insertion order does not affect equality")
+    {
+        auto parametersReversed = parameters;
+        std::reverse(std::begin(parametersReversed), std::end(parametersReversed));
+        REQUIRE(ApplicationConfigurationSet{ parametersReversed } == applicationConfigurationSet);
+    }
+
+    SECTION("values that cannot be held are rejected without modifying the set")
+    {
+        auto applicationConfigurationSetCopy = applicationConfigurationSet;
+        REQUIRE_THROWS_AS(applicationConfigurationSetCopy.Set(ParameterType::SlotDuration, UwbMacAddress{}), std::invalid_argument);
+        REQUIRE_THROWS_AS(applicationConfigurationSetCopy.Set(ParameterType::VendorId, StaticStsInitializationVector{}), std::invalid_argument);
+        REQUIRE_THROWS_AS(applicationConfigurationSetCopy.Set(ParameterType::DeviceMacAddress, std::unordered_set<UwbMacAddress>{}), std::invalid_argument);
+        REQUIRE_THROWS_AS(applicationConfigurationSetCopy.Set(static_cast<ParameterType>(0x40), uint8_t{ 0 }), std::invalid_argument);
+
+        std::unordered_set<UwbMacAddress> destinationMacAddressesTooMany;
+        for (uint8_t i = 0; i <= ApplicationConfigurationSet::DestinationMacAddressesMaximum; i++) {
+            destinationMacAddressesTooMany.insert(UwbMacAddress{ std::array<uint8_t, 2>{ i, i } });
+        }
+        REQUIRE_THROWS_AS(applicationConfigurationSetCopy.Set(ParameterType::DestinationMacAddresses, destinationMacAddressesTooMany), std::length_error);
+        REQUIRE(applicationConfigurationSetCopy == applicationConfigurationSet);
+    }
+
+    SECTION("copying and lookup do not allocate")
+    {
+        const auto numAllocationsBefore = uwb::test::GetNumAllocations();
+        const auto applicationConfigurationSetCopy = applicationConfigurationSet;
+        const auto rangingInterval = applicationConfigurationSetCopy.Get<uint16_t>(ParameterType::RangingInterval);
+        const auto numDestinationMacAddresses = applicationConfigurationSetCopy.GetDestinationMacAddresses().size();
+        const auto numAllocations = uwb::test::GetNumAllocations() - numAllocationsBefore;
+
+        REQUIRE(numAllocations == 0);
+        REQUIRE(rangingInterval == 200);
+        REQUIRE(numDestinationMacAddresses == 3);
+    }
+}
+
+TEST_CASE("ApplicationConfigurationSet performance", "[.][benchmark][protocol]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::test;
+    using ParameterType = UwbApplicationConfigurationParameterType;
+
+    const auto parameters = MakeApplicationConfigurationParameters();
+    const ApplicationConfigurationSet applicationConfigurationSet{ parameters };
+
+    BENCHMARK("Copy std::vector<UwbApplicationConfigurationParameter>")
+    {
+        return std::vector<UwbApplicationConfigurationParameter>{ parameters };
+    };
+
+    BENCHMARK("Copy ApplicationConfigurationSet")
+    {
+        return ApplicationConfigurationSet{ applicationConfigurationSet };
+    };
+
+    BENCHMARK("Lookup std::vector<UwbApplicationConfigurationParameter>")
+    {
+        const auto it = std::ranges::find(parameters, ParameterType::StsLength, &UwbApplicationConfigurationParameter::Type);
+        return std::get<StsLength>(it->Value);
+    };
+
+    BENCHMARK("Lookup ApplicationConfigurationSet")
+    {
+        return applicationConfigurationSet.Get<StsLength>(ParameterType::StsLength);
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,244 @@
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbSession.hxx>
+#include <uwb/protocols/fira/ApplicationConfigurationSet.hxx>
+#include <uwb/protocols/fira/ApplicationConfigurationTracker.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+#include "UwbSessionRecording.hxx"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+TEST_CASE("application configuration tracker plans minimal updates", "[basic][protocol][fira]")
+{
+    using namespace uwb::protocol::fira;
+    using ParameterType = UwbApplicationConfigurationParameterType;
+
+    const std::vector<UwbApplicationConfigurationParameter> parametersInitial{
+        { ParameterType::DeviceType, DeviceType::Controller },
+        { ParameterType::ChannelNumber, Channel::C9 },
+        { ParameterType::SlotDuration, uint16_t{ 2400 } },
+        { ParameterType::RangingInterval, uint16_t{ 200 } },
+        { ParameterType::DeviceMacAddress, uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x12, 0x34 } } },
+        { ParameterType::DestinationMacAddresses, std::unordered_set<uwb::UwbMacAddress>{ uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x01 } }, uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x02, 0x02 } } } },
+    };
+
+    ApplicationConfigurationTracker tracker{};
+    const ApplicationConfigurationSet configurationInitial{ parametersInitial };
+
+    SECTION("initial plan sends all parameters")
+    {
+        const auto plan = tracker.Plan(configurationInitial, false);
+        REQUIRE(plan.Parameters == configurationInitial.ToParameters());
+        REQUIRE_FALSE(plan.RequiresRestart);
+        REQUIRE(plan.NumCommands == 1);
+        REQUIRE(plan.NumCommands == plan.NumCommandsFull);
+        REQUIRE(plan.NumBytes == plan.NumBytesFull);
+    }
+
+    tracker.Commit(tracker.Plan(configurationInitial, false));
+    REQUIRE(tracker.GetApplied() == configurationInitial);
+
+    SECTION("unchanged configuration results in an empty plan")
+    {
+        const auto plan = tracker.Plan(configurationInitial, true);
+        REQUIRE(plan.IsEmpty());
+        REQUIRE_FALSE(plan.RequiresRestart);
+        REQUIRE(plan.NumCommands == 0);
+        REQUIRE(plan.NumBytes == 0);
+        // Sending the full set while active requires a restart, since it
+        // contains parameters that are not changeable while active.
+        REQUIRE(plan.NumCommandsFull == 3);
+    }
+
+    SECTION("destination mac addresses in a different order are unchanged")
+    {
+        ApplicationConfigurationSet configuration{ configurationInitial };
+        configuration.Set(ParameterType::DestinationMacAddresses, std::unordered_set<uwb::UwbMacAddress>{ uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x02, 0x02 } }, uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x01, 0x01 } } });
+        REQUIRE(tracker.Plan(configuration, false).IsEmpty());
+    }
+
+    SECTION("only changed parameters are sent")
+    {
+        ApplicationConfigurationSet configuration{ configurationInitial };
+        configuration.Set(ParameterType::RangingInterval, uint16_t{ 400 });
+        configuration.Set(ParameterType::DeviceMacAddress, uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x56, 0x78 } });
+
+        const auto plan = tracker.Plan(configuration, false);
+        REQUIRE(plan.Parameters.size() == 2);
+        REQUIRE(plan.Parameters[0].Type == ParameterType::DeviceMacAddress);
+        REQUIRE(plan.Parameters[1].Type == ParameterType::RangingInterval);
+        REQUIRE_FALSE(plan.RequiresRestart);
+        REQUIRE(plan.NumCommands == 1);
+        // header (4) + session id (4) + count (1) + 2 * (tag (1) + length (1) + value (2))
+        REQUIRE(plan.NumBytes == 17);
+        REQUIRE(plan.NumBytes < plan.NumBytesFull);
+    }
+
+    SECTION("parameters changeable while active do not require a restart")
+    {
+        ApplicationConfigurationSet configuration{ configurationInitial };
+        configuration.Set(ParameterType::RangingInterval, uint16_t{ 400 });
+
+        const auto plan = tracker.Plan(configuration, true);
+        REQUIRE(plan.Parameters.size() == 1);
+        REQUIRE_FALSE(plan.RequiresRestart);
+        REQUIRE(plan.NumCommands == 1);
+        REQUIRE(plan.NumBytes == 13);
+        REQUIRE(plan.NumCommandsFull == 3);
+    }
+
+    SECTION("parameters not changeable while active require a restart")
+    {
+        ApplicationConfigurationSet configuration{ configurationInitial };
+        configuration.Set(ParameterType::ChannelNumber, Channel::C5);
+
+        const auto planActive = tracker.Plan(configuration, true);
+        REQUIRE(planActive.RequiresRestart);
+        REQUIRE(planActive.NumCommands == 3);
+        REQUIRE(planActive.NumBytes == 12 + (2 * ApplicationConfigurationTracker::SessionControlCommandSize));
+
+        const auto planInactive = tracker.Plan(configuration, false);
+        REQUIRE_FALSE(planInactive.RequiresRestart);
+        REQUIRE(planInactive.NumCommands == 1);
+    }
+
+    SECTION("parameters absent from the desired configuration are retained")
+    {
+        ApplicationConfigurationSet configuration{};
+        configuration.Set(ParameterType::SlotDuration, uint16_t{ 1200 });
+
+        const auto plan = tracker.Plan(configuration, false);
+        REQUIRE(plan.Parameters.size() == 1);
+        tracker.Commit(plan);
+        REQUIRE(tracker.GetApplied().Size() == configurationInitial.Size());
+        REQUIRE(tracker.GetApplied().Get<uint16_t>(ParameterType::SlotDuration) == uint16_t{ 1200 });
+    }
+
+    SECTION("metrics accumulate across commits and survive reset")
+    {
+        const auto metricsInitial = tracker.GetMetrics();
+        REQUIRE(metricsInitial.NumCommandsSent == 1);
+        REQUIRE(metricsInitial.NumCommandsSaved == 0);
+        REQUIRE(metricsInitial.NumBytesSaved == 0);
+
+        const auto plan = tracker.Plan(configurationInitial, false);
+        tracker.Commit(plan);
+        const auto& metrics = tracker.GetMetrics();
+        REQUIRE(metrics.NumCommandsSent == 1);
+        REQUIRE(metrics.NumCommandsSaved == 1);
+        REQUIRE(metrics.NumBytesSent == metricsInitial.NumBytesSent);
+        REQUIRE(metrics.NumBytesSaved == plan.NumBytesFull);
+
+        tracker.Reset();
+        REQUIRE(tracker.GetApplied().Empty());
+        REQUIRE(tracker.GetMetrics() == metrics);
+        REQUIRE(tracker.Plan(configurationInitial, false).Parameters.size() == configurationInitial.Size());
+    }
+}
+
+TEST_CASE("application configuration command size spans multiple packets", "[basic][protocol][fira]")
+{
+    using namespace uwb::protocol::fira;
+
+    REQUIRE(ApplicationConfigurationTracker::GetSetApplicationConfigurationCommandSize({}) == 9);
+
+    // 5 + (63 * 4) = 257 octets of payload, which does not fit in one packet.
+    const std::vector<UwbApplicationConfigurationParameter> parameters(63, { UwbApplicationConfigurationParameterType::SlotDuration, uint16_t{ 2400 } });
+    REQUIRE(ApplicationConfigurationTracker::GetSetApplicationConfigurationCommandSize(parameters) == 257 + (2 * 4));
+}
+
+TEST_CASE("uwb session sends only changed application configuration parameters", "[basic][protocol][fira]")
+{
+    using namespace uwb::protocol::fira;
+    using ParameterType = UwbApplicationConfigurationParameterType;
+
+    const std::vector<UwbApplicationConfigurationParameter> parameters{
+        { ParameterType::ChannelNumber, Channel::C9 },
+        { ParameterType::RangingInterval, uint16_t{ 200 } },
+    };
+
+    uwb::test::UwbSessionRecording session{};
+    session.Configure(parameters);
+    REQUIRE(session.ParametersSent.size() == 1);
+
+    SECTION("unchanged parameters are not sent")
+    {
+        session.SetApplicationConfigurationParameters(parameters);
+        REQUIRE(session.ParametersSent.size() == 1);
+        REQUIRE(session.GetApplicationConfigurationMetrics().NumCommandsSaved == 1);
+    }
+
+    SECTION("parameters changeable while active are sent without a restart")
+    {
+        session.StartRanging();
+        session.SetApplicationConfigurationParameters({ { ParameterType::ChannelNumber, Channel::C9 }, { ParameterType::RangingInterval, uint16_t{ 400 } } });
+        REQUIRE(session.ParametersSent.size() == 2);
+        REQUIRE(session.ParametersSent.back().size() == 1);
+        REQUIRE(session.ParametersSent.back()[0].Type == ParameterType::RangingInterval);
+        REQUIRE(session.NumStops == 0);
+        REQUIRE(session.NumStarts == 1);
+    }
+
+    SECTION("parameters not changeable while active restart ranging")
+    {
+        session.StartRanging();
+        session.SetApplicationConfigurationParameters({ { ParameterType::ChannelNumber, Channel::C5 } });
+        REQUIRE(session.ParametersSent.size() == 2);
+        REQUIRE(session.NumStops == 1);
+        REQUIRE(session.NumStarts == 2);
+    }
+
+    SECTION("all parameters are sent after the session is deinitialized by the uwbs")
+    {
+        session.NotifySessionStateChanged(UwbSessionState::Initialized);
+        session.SetApplicationConfigurationParameters(parameters);
+        REQUIRE(session.ParametersSent.size() == 1);
+
+        session.NotifySessionStateChanged(UwbSessionState::Deinitialized);
+        session.SetApplicationConfigurationParameters(parameters);
+        REQUIRE(session.ParametersSent.size() == 2);
+        REQUIRE(session.ParametersSent.back().size() == parameters.size());
+    }
+
+    SECTION("all parameters are sent after the session is destroyed")
+    {
+        session.Destroy();
+        session.SetApplicationConfigurationParameters(parameters);
+        REQUIRE(session.ParametersSent.size() == 2);
+        REQUIRE(session.ParametersSent.back().size() == parameters.size());
+    }
+
+    SECTION("all parameters are sent after the application configuration is reset")
+    {
+        session.ResetApplicationConfiguration();
+        session.SetApplicationConfigurationParameters(parameters);
+        REQUIRE(session.ParametersSent.size() == 2);
+        REQUIRE(session.ParametersSent.back().size() == parameters.size());
+    }
+
+    SECTION("notifications delivered while parameters are sent do not deadlock")
+    {
+        session.OnParametersSent = [&session] {
+            session.NotifySessionStateChanged(UwbSessionState::Deinitialized);
+        };
+        session.SetApplicationConfigurationParameters({ { ParameterType::ChannelNumber, Channel::C5 } });
+        REQUIRE(session.ParametersSent.size() == 2);
+
+        // The update raced with a reset, so it is not tracked and all parameters are sent next.
+        session.OnParametersSent = nullptr;
+        session.SetApplicationConfigurationParameters(parameters);
+        REQUIRE(session.ParametersSent.size() == 3);
+        REQUIRE(session.ParametersSent.back().size() == parameters.size());
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,174 @@
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::protocol::fira::test
+{
+static_assert(ConvertQ97FormatToIEEE(0x0000) == 0.0);
+static_assert(ConvertQ97FormatToIEEE(0x0080) == 1.0);
+static_assert(ConvertQ97FormatToIEEE(0x0640) == 12.5);
+static_assert(ConvertQ97FormatToIEEE(0x7FFF) == 255.0 + (127.0 / 128.0));
+static_assert(ConvertQ97FormatToIEEE(0xFF80) == -1.0);
+static_assert(std::bit_cast<uint64_t>(ConvertQ97FormatToIEEE(0x8000)) == std::bit_cast<uint64_t>(-0.0));
+
+/**
+ * @brief The original, one value at a time, Q9.7 conversion, used as the
+ * reference for equivalence and performance.
+ *
+ * @param q97 a number in Q9.7 format
+ * @return double
+ */
+double
+ConvertQ97FormatToIEEEReference(uint16_t q97)
+{
+    static const double pow2 = std::pow(2, -7);
+    static const uint16_t signMask = 0b1000'0000'0000'0000U;
+    static const uint16_t unsignedIntegerMask = 0b0111'1111'1000'0000U;
+    static const uint16_t fractionMask = static_cast<uint16_t>(~(signMask | unsignedIntegerMask));
+
+    bool sign = q97 & signMask;
+    uint16_t unsignedIntegerPart = (q97 & unsignedIntegerMask) >> 7U;
+    uint16_t fractionPart = q97 & fractionMask;
+
+    if (sign) {
+        unsignedIntegerPart = (~unsignedIntegerPart + 1U) & 0x00FF;
+    }
+
+    double unsignedNumber = static_cast<double>(unsignedIntegerPart + (fractionPart * pow2));
+
+    return (sign ? -1 : 1) * unsignedNumber;
+}
+
+/**
+ * @brief Get all 65536 possible Q9.7 values.
+ *
+ * @return std::vector<uint16_t>
+ */
+std::vector<uint16_t>
+AllQ97Values()
+{
+    std::vector<uint16_t> values(UINT16_MAX + 1);
+    std::iota(std::begin(values), std::end(values), uint16_t{ 0 });
+    return values;
+}
+} // namespace uwb::protocol::fira::test
+
+TEST_CASE("Q9.7 conversion matches the reference for all inputs", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::test;
+
+    const auto q97 = AllQ97Values();
+
+    SECTION("scalar conversion")
+    {
+        std::size_t numMismatches = 0;
+        for (const auto value : q97) {
+            numMismatches += std::bit_cast<uint64_t>(ConvertQ97FormatToIEEE(value)) != std::bit_cast<uint64_t>(ConvertQ97FormatToIEEEReference(value));
+        }
+        REQUIRE(numMismatches == 0);
+    }
+
+    SECTION("double precision batch conversion")
+    {
+        std::vector<double> values(q97.size());
+        ConvertQ97FormatToIEEE(q97, values);
+
+        std::size_t numMismatches = 0;
+        for (std::size_t i = 0; i < q97.size(); i++) {
+            numMismatches += std::bit_cast<uint64_t>(values[i]) != std::bit_cast<uint64_t>(ConvertQ97FormatToIEEEReference(q97[i]));
+        }
+        REQUIRE(numMismatches == 0);
+    }
+
+    SECTION("single precision batch conversion")
+    {
+        std::vector<float> values(q97.size());
+        ConvertQ97FormatToIEEE(q97, values);
+
+        std::size_t numMismatches = 0;
+        for (std::size_t i = 0; i < q97.size(); i++) {
+            numMismatches += std::bit_cast<uint32_t>(values[i]) != std::bit_cast<uint32_t>(static_cast<float>(ConvertQ97FormatToIEEEReference(q97[i])));
+        }
+        REQUIRE(numMismatches == 0);
+    }
+}
+
+TEST_CASE("Q9.7 batch conversion handles unaligned and partial input", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::test;
+
+    const auto q97All = AllQ97Values();
+    const std::span<const uint16_t> q97{ std::data(q97All) + 0x7F7B, 40 };
+
+    for (std::size_t offset = 0; offset < 3; offset++) {
+        for (std::size_t count = 0; count <= 33; count++) {
+            std::vector<double> values(offset + count + 1, 42.0);
+            ConvertQ97FormatToIEEE(q97.subspan(offset, count), std::span<double>{ values }.subspan(offset));
+
+            for (std::size_t i = 0; i < count; i++) {
+                REQUIRE(values[offset + i] == ConvertQ97FormatToIEEEReference(q97[offset + i]));
+            }
+            REQUIRE(values[offset + count] == 42.0);
+        }
+    }
+
+    std::vector<float> valuesTooSmall(7);
+    REQUIRE_THROWS_AS(ConvertQ97FormatToIEEE(q97.subspan(0, 8), valuesTooSmall), std::invalid_argument);
+}
+
+TEST_CASE("Q9.7 conversion performance", "[.][benchmark][protocol]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::test;
+
+    std::vector<uint16_t> q97(4096);
+    for (std::size_t i = 0; i < q97.size(); i++) {
+        q97[i] = static_cast<uint16_t>(i * 2654435761U);
+    }
+    std::vector<double> values(q97.size());
+    std::vector<float> valuesSingle(q97.size());
+
+    BENCHMARK("Reference scalar conversion")
+    {
+        for (std::size_t i = 0; i < q97.size(); i++) {
+            values[i] = ConvertQ97FormatToIEEEReference(q97[i]);
+        }
+        return values.back();
+    };
+
+    BENCHMARK("Constexpr scalar conversion")
+    {
+        for (std::size_t i = 0; i < q97.size(); i++) {
+            values[i] = ConvertQ97FormatToIEEE(q97[i]);
+        }
+        return values.back();
+    };
+
+    BENCHMARK("Batch conversion to double")
+    {
+        ConvertQ97FormatToIEEE(q97, values);
+        return values.back();
+    };
+
+    BENCHMARK("Batch conversion to float")
+    {
+        ConvertQ97FormatToIEEE(q97, valuesSingle);
+        return valuesSingle.back();
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
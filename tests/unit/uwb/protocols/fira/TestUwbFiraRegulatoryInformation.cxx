@@ -1,8 +1,63 @@
 
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include <tlv/TlvBer.hxx>
+#include <uwb/protocols/fira/UwbException.hxx>
 #include <uwb/protocols/fira/UwbRegulatoryInformation.hxx>
 
-TEST_CASE("regulatory info placeholder", "[basic]")
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+TEST_CASE("UwbRegulatoryInformation can be encoded and decoded", "[basic][protocol]")
 {
+    using namespace uwb::protocol::fira;
+
+    UwbRegulatoryInformation uwbRegulatoryInformation{
+        .Source = UwbRegulatoryInformation::InformationSource::Cellular,
+        .OutdoorPermitted = false,
+        .CountryCode = 0x5553,
+        .Timestamp = 0x01020304,
+        .MaximumTransmissionPower = {
+            { Channel::C5, 5 },
+            { Channel::C6, 6 },
+            { Channel::C8, 8 },
+            { Channel::C9, 9 },
+            { Channel::C10, 10 },
+            { Channel::C12, 12 },
+            { Channel::C13, 13 },
+            { Channel::C14, 14 },
+        },
+    };
+
+    SECTION("decoding round-trips")
+    {
+        auto tlvBer = uwbRegulatoryInformation.ToDataObject();
+        auto uwbRegulatoryInformationDecoded = UwbRegulatoryInformation::FromDataObject(*tlvBer);
+        REQUIRE(uwbRegulatoryInformationDecoded.Source == uwbRegulatoryInformation.Source);
+        REQUIRE(uwbRegulatoryInformationDecoded.OutdoorPermitted == uwbRegulatoryInformation.OutdoorPermitted);
+        REQUIRE(uwbRegulatoryInformationDecoded.CountryCode == uwbRegulatoryInformation.CountryCode);
+        REQUIRE(uwbRegulatoryInformationDecoded.Timestamp == uwbRegulatoryInformation.Timestamp);
+        REQUIRE(uwbRegulatoryInformationDecoded.MaximumTransmissionPower == uwbRegulatoryInformation.MaximumTransmissionPower);
+    }
+
+    SECTION("encoding without all channels throws")
+    {
+        uwbRegulatoryInformation.MaximumTransmissionPower.erase(Channel::C9);
+        REQUIRE_THROWS(uwbRegulatoryInformation.ToDataObject());
+    }
+
+    SECTION("decoding an invalid information source throws")
+    {
+        auto encoded = uwbRegulatoryInformation.ToDataObject()->ToBytes();
+        // INFORMATION_SOURCE is the first parameter: tag, length, value.
+        REQUIRE(encoded[2] == 0x80);
+        encoded[4] = 0x04;
+        encoding::TlvBer tlvBer{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::Parse(tlvBer, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE_THROWS_AS(UwbRegulatoryInformation::FromDataObject(tlvBer), UwbException);
+    }
 }
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
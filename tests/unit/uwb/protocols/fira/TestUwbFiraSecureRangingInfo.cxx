@@ -1,8 +1,33 @@
 
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include <tlv/TlvBer.hxx>
 #include <uwb/protocols/fira/SecureRangingInfo.hxx>
 
-TEST_CASE("secure ranging info placeholder", "[basic]")
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+TEST_CASE("SecureRangingInfo can be encoded and decoded", "[basic][protocol]")
 {
+    using namespace uwb::protocol::fira;
+
+    SECTION("decoding round-trips, including empty parameters")
+    {
+        SecureRangingInfo secureRangingInfo{
+            .UwbSessionKeyInfo = { 0x01, 0x02, 0x03 },
+            .ResponderSpecificSubSessionKeyInfo = {},
+            .SusAdditionalParameters = { 0x04 },
+        };
+
+        auto tlvBer = secureRangingInfo.ToDataObject();
+        REQUIRE(tlvBer->ToBytes() == std::vector<uint8_t>{ 0xA5, 0x0A, 0x80, 0x03, 0x01, 0x02, 0x03, 0x81, 0x00, 0x82, 0x01, 0x04 });
+
+        auto secureRangingInfoDecoded = SecureRangingInfo::FromDataObject(*tlvBer);
+        REQUIRE(secureRangingInfoDecoded.UwbSessionKeyInfo == secureRangingInfo.UwbSessionKeyInfo);
+        REQUIRE(secureRangingInfoDecoded.ResponderSpecificSubSessionKeyInfo == secureRangingInfo.ResponderSpecificSubSessionKeyInfo);
+        REQUIRE(secureRangingInfoDecoded.SusAdditionalParameters == secureRangingInfo.SusAdditionalParameters);
+    }
 }
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -1,8 +1,153 @@
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <notstd/utility.hxx>
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <tlv/TlvSerialize.hxx>
 #include <uwb/protocols/fira/StaticRangingInfo.hxx>
+#include <uwb/protocols/fira/UwbException.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::protocol::fira::test
+{
+const StaticRangingInfo StaticRangingInfoTest{
+    .VendorId = 0x1234,
+    .InitializationVector = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 },
+};
+
+/**
+ * @brief Builder-based encoder, equivalent to the hand-written implementation
+ * that preceded the schema-generated one. Used as a benchmark baseline.
+ */
+std::unique_ptr<encoding::TlvBer>
+ToDataObjectWithBuilder(const StaticRangingInfo& staticRangingInfo)
+{
+    using encoding::TlvBer, encoding::GetBytesBigEndianFromBitMap;
+    using ParameterTag = StaticRangingInfo::ParameterTag;
+
+    return std::make_unique<TlvBer>(TlvBer::Builder()
+                                        .SetTag(StaticRangingInfo::Tag)
+                                        .AddTlv(
+                                            TlvBer::Builder()
+                                                .SetTag(notstd::to_underlying(ParameterTag::VendorId))
+                                                .SetValue(GetBytesBigEndianFromBitMap(staticRangingInfo.VendorId, sizeof staticRangingInfo.VendorId))
+                                                .Build())
+                                        .AddTlv(
+                                            TlvBer::Builder()
+                                                .SetTag(notstd::to_underlying(ParameterTag::StaticStsIv))
+                                                .SetValue(staticRangingInfo.InitializationVector)
+                                                .Build())
+                                        .Build());
+}
+
+/**
+ * @brief Switch-based decoder, equivalent to the hand-written implementation
+ * that preceded the schema-generated one. Used as a benchmark baseline.
+ */
+StaticRangingInfo
+FromDataObjectWithSwitch(const encoding::TlvBer& tlvBer)
+{
+    using ParameterTag = StaticRangingInfo::ParameterTag;
+
+    StaticRangingInfo staticRangingInfo{};
+    std::size_t numParametersDecoded = 0;
+    for (const auto& tlvBerValue : tlvBer.GetValues()) {
+        auto tagValue = tlvBerValue.GetTag();
+        const auto& parameterValue = tlvBerValue.GetValue();
+        if (std::size(tagValue) != 1 || std::empty(parameterValue)) {
+            continue;
+        }
+
+        switch (static_cast<ParameterTag>(tagValue.front())) {
+        case ParameterTag::VendorId:
+            staticRangingInfo.VendorId = encoding::ReadSizeTFromBytesBigEndian<uint16_t>(parameterValue);
+            numParametersDecoded++;
+            break;
+        case ParameterTag::StaticStsIv:
+            std::memcpy(std::data(staticRangingInfo.InitializationVector), std::data(parameterValue), std::min(std::size(parameterValue), std::size(staticRangingInfo.InitializationVector)));
+            numParametersDecoded++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (numParametersDecoded != 2) {
+        throw UwbException(UwbStatusGeneric::SyntaxError);
+    }
+
+    return staticRangingInfo;
+}
+} // namespace uwb::protocol::fira::test
+
+TEST_CASE("StaticRangingInfo can be encoded and decoded", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::test;
+
+    SECTION("encoding matches the builder-based encoding")
+    {
+        auto tlvBer = StaticRangingInfoTest.ToDataObject();
+        REQUIRE(*tlvBer == *ToDataObjectWithBuilder(StaticRangingInfoTest));
+        REQUIRE(tlvBer->ToBytes() == std::vector<uint8_t>{ 0xA4, 0x0C, 0x80, 0x02, 0x12, 0x34, 0x81, 0x06, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 });
+    }
+
+    SECTION("decoding round-trips from a TlvBer and a TlvBerView")
+    {
+        auto tlvBer = StaticRangingInfoTest.ToDataObject();
+        REQUIRE(StaticRangingInfo::FromDataObject(*tlvBer) == StaticRangingInfoTest);
+
+        auto encoded = tlvBer->ToBytes();
+        encoding::TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::ParseView(tlvView, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE(StaticRangingInfo::FromDataObject(tlvView) == StaticRangingInfoTest);
+    }
+
+    SECTION("decoding without all parameters throws")
+    {
+        std::vector<uint8_t> encoded{ 0xA4, 0x04, 0x80, 0x02, 0x12, 0x34 };
+        encoding::TlvBer tlvBer{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::Parse(tlvBer, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE_THROWS_AS(StaticRangingInfo::FromDataObject(tlvBer), UwbException);
+    }
+}
 
-TEST_CASE("static ranging info placeholder", "[basic]")
+TEST_CASE("StaticRangingInfo encoding performance", "[.][benchmark][protocol]")
 {
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::test;
+
+    auto tlvBer = StaticRangingInfoTest.ToDataObject();
+
+    BENCHMARK("ToDataObject (schema)")
+    {
+        return StaticRangingInfoTest.ToDataObject();
+    };
+
+    BENCHMARK("ToDataObject (builder)")
+    {
+        return ToDataObjectWithBuilder(StaticRangingInfoTest);
+    };
+
+    BENCHMARK("FromDataObject (schema)")
+    {
+        return StaticRangingInfo::FromDataObject(*tlvBer);
+    };
+
+    BENCHMARK("FromDataObject (switch)")
+    {
+        return FromDataObjectWithSwitch(*tlvBer);
+    };
 }
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
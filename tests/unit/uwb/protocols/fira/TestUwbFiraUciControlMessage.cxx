@@ -0,0 +1,196 @@
+
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/protocols/fira/uci/ControlMessage.hxx>
+#include <uwb/protocols/fira/uci/ControlPacket.hxx>
+#include <uwb/protocols/fira/uci/StatusCodes.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::protocol::fira::uci::test
+{
+static_assert(ControlPacket{ .Type = MessageType::Notification, .PacketBoundaryFlag = true, .Gid = GroupId::SessionControl, .Oid = 0x3F }.EncodeHeader() == std::array<uint8_t, 4>{ 0x72, 0x3F, 0x00, 0x00 });
+static_assert(LookupMessageDescriptor(GroupId::SessionConfig, 0x03)->Name == "SESSION_SET_APP_CONFIG");
+static_assert(LookupMessageDescriptor(GroupId::SessionControl, 0x00)->Supports(MessageType::Notification));
+static_assert(LookupMessageDescriptor(GroupId::Core, 0x3F) == nullptr);
+static_assert(ToUwbStatus(StatusCode::UwbSessionMulticastListFull) == UwbStatus{ UwbStatusSession::MulticastListFull });
+static_assert(!ToUwbStatus(static_cast<StatusCode>(0x50)).has_value());
+
+/**
+ * @brief Decode all packets in the specified buffer and reassemble them.
+ *
+ * @param data The encoded packets.
+ * @param reassembler The reassembler to use.
+ * @return std::vector<ControlMessage> The reassembled messages.
+ */
+std::vector<ControlMessage>
+DecodeMessages(std::span<const uint8_t> data, ControlMessageReassembler& reassembler)
+{
+    std::vector<ControlMessage> messages;
+    while (!std::empty(data)) {
+        std::size_t bytesParsed = 0;
+        auto packet = ControlPacket::Decode(data, bytesParsed);
+        REQUIRE(packet.has_value());
+        auto message = reassembler.Push(*packet);
+        if (message.has_value()) {
+            messages.push_back(*message);
+        }
+        data = data.subspan(bytesParsed);
+    }
+
+    return messages;
+}
+} // namespace uwb::protocol::fira::uci::test
+
+TEST_CASE("uci control packets can be encoded and decoded", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira::uci;
+
+    SECTION("a SESSION_INIT command matches its specified encoding")
+    {
+        const std::vector<uint8_t> payload{ 0x01, 0x00, 0x00, 0x00, 0x00 };
+        const ControlMessage message{
+            .Type = MessageType::Command,
+            .Gid = GroupId::SessionConfig,
+            .Oid = static_cast<uint8_t>(OidSessionConfig::Init),
+            .Payload = payload,
+        };
+
+        std::vector<uint8_t> encoded;
+        message.Encode(encoded);
+        REQUIRE(encoded == std::vector<uint8_t>{ 0x21, 0x00, 0x00, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00 });
+
+        std::size_t bytesParsed = 0;
+        const auto packet = ControlPacket::Decode(encoded, bytesParsed);
+        REQUIRE(packet.has_value());
+        REQUIRE(bytesParsed == encoded.size());
+        REQUIRE(packet->Type == MessageType::Command);
+        REQUIRE_FALSE(packet->PacketBoundaryFlag);
+        REQUIRE(packet->Gid == GroupId::SessionConfig);
+        REQUIRE(packet->Oid == 0x00);
+        REQUIRE(packet->Payload.data() == encoded.data() + ControlPacket::HeaderSize);
+    }
+
+    SECTION("truncated and non-control packets are rejected")
+    {
+        std::size_t bytesParsed = 0;
+        const std::vector<uint8_t> truncated{ 0x41, 0x00, 0x00, 0x02, 0x00 };
+        REQUIRE_FALSE(ControlPacket::Decode(truncated, bytesParsed).has_value());
+        const std::vector<uint8_t> data{ 0x00, 0x00, 0x00, 0x00 };
+        REQUIRE_FALSE(ControlPacket::Decode(data, bytesParsed).has_value());
+        const std::vector<uint8_t> reserved{ 0x80, 0x00, 0x00, 0x00 };
+        REQUIRE_FALSE(ControlPacket::Decode(reserved, bytesParsed).has_value());
+    }
+
+    SECTION("response status is mapped to UwbStatus")
+    {
+        const std::vector<uint8_t> encoded{ 0x41, 0x00, 0x00, 0x01, 0x12 };
+        std::size_t bytesParsed = 0;
+        const auto packet = ControlPacket::Decode(encoded, bytesParsed);
+        REQUIRE(packet.has_value());
+
+        ControlMessageReassembler reassembler{};
+        const auto message = reassembler.Push(*packet);
+        REQUIRE(message.has_value());
+        REQUIRE(message->GetStatus() == StatusCode::UwbSessionDuplicate);
+        REQUIRE(ToUwbStatus(*message->GetStatus()) == uwb::protocol::fira::UwbStatus{ uwb::protocol::fira::UwbStatusSession::Duplicate });
+        REQUIRE(message->GetDescriptor()->Name == "SESSION_INIT");
+    }
+}
+
+TEST_CASE("uci control messages are segmented and reassembled", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira::uci;
+    using namespace uwb::protocol::fira::uci::test;
+
+    std::vector<uint8_t> payload(600);
+    std::iota(std::begin(payload), std::end(payload), uint8_t{ 0 });
+
+    const ControlMessage message{
+        .Type = MessageType::Notification,
+        .Gid = GroupId::SessionControl,
+        .Oid = static_cast<uint8_t>(OidSessionControl::Start),
+        .Payload = payload,
+    };
+
+    SECTION("large messages are split into maximum size packets")
+    {
+        std::vector<uint8_t> encoded;
+        message.Encode(encoded);
+        REQUIRE(message.GetNumPackets() == 3);
+        REQUIRE(encoded.size() == 3 * ControlPacket::HeaderSize + payload.size());
+        REQUIRE(encoded[0] == 0x72);
+        REQUIRE(encoded[3] == 255);
+        REQUIRE(encoded[ControlPacket::HeaderSize + 255] == 0x72);
+        REQUIRE(encoded[2 * (ControlPacket::HeaderSize + 255)] == 0x62);
+        REQUIRE(encoded[2 * (ControlPacket::HeaderSize + 255) + 3] == 90);
+
+        REQUIRE_THROWS_AS(message.Encode(encoded, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(message.Encode(encoded, 256), std::invalid_argument);
+    }
+
+    SECTION("segments are reassembled into the original message")
+    {
+        for (const std::size_t payloadSizeMaximum : { 1, 7, 128, 255 }) {
+            std::vector<uint8_t> encoded;
+            message.Encode(encoded, payloadSizeMaximum);
+
+            ControlMessageReassembler reassembler{};
+            const auto messages = DecodeMessages(encoded, reassembler);
+            REQUIRE(messages.size() == 1);
+            REQUIRE(messages[0].Type == message.Type);
+            REQUIRE(messages[0].Gid == message.Gid);
+            REQUIRE(messages[0].Oid == message.Oid);
+            REQUIRE(std::vector<uint8_t>(std::cbegin(messages[0].Payload), std::cend(messages[0].Payload)) == payload);
+            REQUIRE_FALSE(reassembler.HasPartialMessage());
+        }
+    }
+
+    SECTION("unsegmented messages refer to the receive buffer")
+    {
+        std::vector<uint8_t> encoded;
+        const std::vector<uint8_t> payloadShort{ 0x00 };
+        ControlMessage{ .Type = MessageType::Response, .Gid = GroupId::Core, .Oid = 0x00, .Payload = payloadShort }.Encode(encoded);
+
+        ControlMessageReassembler reassembler{};
+        const auto messages = DecodeMessages(encoded, reassembler);
+        REQUIRE(messages.size() == 1);
+        REQUIRE(messages[0].Payload.data() == encoded.data() + ControlPacket::HeaderSize);
+        REQUIRE(messages[0].GetStatus() == StatusCode::Ok);
+    }
+
+    SECTION("an interrupted message is discarded")
+    {
+        std::vector<uint8_t> encoded;
+        message.Encode(encoded);
+        // Drop the last segment and follow with a different message.
+        encoded.resize(2 * (ControlPacket::HeaderSize + 255));
+        const std::vector<uint8_t> payloadStatus{ 0x00, 0x00, 0x00, 0x00, 0x02, 0x00 };
+        ControlMessage{ .Type = MessageType::Notification, .Gid = GroupId::SessionConfig, .Oid = 0x02, .Payload = payloadStatus }.Encode(encoded);
+
+        ControlMessageReassembler reassembler{};
+        const auto messages = DecodeMessages(encoded, reassembler);
+        REQUIRE(messages.size() == 1);
+        REQUIRE(messages[0].Gid == GroupId::SessionConfig);
+        REQUIRE(messages[0].Payload.size() == payloadStatus.size());
+        REQUIRE_FALSE(reassembler.HasPartialMessage());
+    }
+
+    SECTION("messages exceeding the maximum size are rejected")
+    {
+        std::vector<uint8_t> encoded;
+        message.Encode(encoded);
+
+        ControlMessageReassembler reassembler{ 300 };
+        REQUIRE_THROWS_AS(DecodeMessages(encoded, reassembler), std::length_error);
+        REQUIRE_FALSE(reassembler.HasPartialMessage());
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
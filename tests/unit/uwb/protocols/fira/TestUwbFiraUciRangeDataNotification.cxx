@@ -0,0 +1,186 @@
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/uci/RangeDataNotification.hxx>
+
+#include "AllocationCounter.hxx"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::protocol::fira::uci::test
+{
+/**
+ * @brief Create ranging data for a round with the specified number of peers.
+ *
+ * @tparam AddressType The type of the peer addresses.
+ * @param numMeasurements The number of measurements (peers).
+ * @param sequenceNumber The sequence number of the round.
+ * @return UwbRangingData
+ */
+template <UwbMacAddressType AddressType = UwbMacAddressType::Short>
+UwbRangingData
+MakeRangingData(std::size_t numMeasurements, uint32_t sequenceNumber)
+{
+    UwbRangingData rangingData{
+        .SequenceNumber = sequenceNumber,
+        .SessionId = 0x12345678,
+        .CurrentRangingInterval = 50,
+        .RangingMeasurementType = UwbRangingMeasurementType::TwoWay,
+    };
+
+    for (std::size_t i = 0; i < numMeasurements; i++) {
+        std::array<uint8_t, detail::UwbMacAddressSizeV<AddressType>> address{};
+        address.fill(static_cast<uint8_t>(i + 1));
+        rangingData.RangingMeasurements.push_back(UwbRangingMeasurement{
+            .SlotIndex = static_cast<uint8_t>(i),
+            .Distance = static_cast<uint16_t>(100 * (i + 1) + sequenceNumber),
+            .Status = (i % 3 == 2) ? UwbStatus{ UwbStatusRanging::RxTimeout } : UwbStatus{ UwbStatusGeneric::Ok },
+            .PeerMacAddress = UwbMacAddress{ address },
+            .LineOfSightIndicator = (i % 2 == 0) ? UwbLineOfSightIndicator::LineOfSight : UwbLineOfSightIndicator::Indeterminant,
+            .AoAAzimuth = { .Result = static_cast<uint16_t>(0x1280 + i), .FigureOfMerit = 100 },
+            .AoAElevation = { .Result = 0xFF80 },
+            .AoaDestinationAzimuth = { .Result = 0x0040, .FigureOfMerit = 50 },
+            .AoaDestinationElevation = { .Result = 0x0000 },
+        });
+    }
+
+    return rangingData;
+}
+} // namespace uwb::protocol::fira::uci::test
+
+TEST_CASE("RANGE_DATA_NTF payloads can be encoded and decoded", "[basic][protocol][uci]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+    using namespace uwb::protocol::fira::uci::test;
+
+    SECTION("a single measurement matches its specified encoding")
+    {
+        auto rangingData = MakeRangingData(1, 7);
+        std::vector<uint8_t> payload;
+        RangeDataNotification::Encode(rangingData, payload);
+
+        const std::vector<uint8_t> payloadExpected{
+            0x07, 0x00, 0x00, 0x00,                         // sequence number
+            0x78, 0x56, 0x34, 0x12,                         // session id
+            0x00,                                           // rcr indicator
+            0x32, 0x00, 0x00, 0x00,                         // current ranging interval
+            0x01, 0x00, 0x00,                               // measurement type, rfu, short addresses
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // rfu
+            0x01,                                           // number of measurements
+            0x01, 0x01,                                     // peer mac address
+            0x00, 0x00,                                     // status, line of sight
+            0x6B, 0x00,                                     // distance
+            0x80, 0x12, 0x64,                               // aoa azimuth
+            0x80, 0xFF, 0x00,                               // aoa elevation
+            0x40, 0x00, 0x32,                               // aoa destination azimuth
+            0x00, 0x00, 0x00,                               // aoa destination elevation
+            0x00,                                           // slot index
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        };
+        REQUIRE(payload == payloadExpected);
+
+        UwbRangingData rangingDataDecoded{};
+        REQUIRE(RangeDataNotification::Decode(payload, rangingDataDecoded));
+        REQUIRE(rangingDataDecoded == rangingData);
+    }
+
+    SECTION("short and extended addresses round-trip")
+    {
+        for (const auto& rangingData : { MakeRangingData<UwbMacAddressType::Short>(8, 1), MakeRangingData<UwbMacAddressType::Extended>(8, 2) }) {
+            std::vector<uint8_t> payload;
+            RangeDataNotification::Encode(rangingData, payload);
+            REQUIRE(payload.size() == RangeDataNotification::HeaderSize + 8 * RangeDataNotification::MeasurementSize);
+
+            UwbRangingData rangingDataDecoded{};
+            REQUIRE(RangeDataNotification::Decode(payload, rangingDataDecoded));
+            REQUIRE(rangingDataDecoded == rangingData);
+        }
+    }
+
+    SECTION("malformed payloads are rejected")
+    {
+        std::vector<uint8_t> payload;
+        RangeDataNotification::Encode(MakeRangingData(2, 1), payload);
+        UwbRangingData rangingData{};
+
+        auto payloadTruncated = payload;
+        payloadTruncated.pop_back();
+        REQUIRE_FALSE(RangeDataNotification::Decode(payloadTruncated, rangingData));
+
+        auto payloadNotTwoWay = payload;
+        payloadNotTwoWay[13] = 0x02;
+        REQUIRE_FALSE(RangeDataNotification::Decode(payloadNotTwoWay, rangingData));
+
+        auto payloadInvalidAddressingMode = payload;
+        payloadInvalidAddressingMode[15] = 0x02;
+        REQUIRE_FALSE(RangeDataNotification::Decode(payloadInvalidAddressingMode, rangingData));
+    }
+
+    SECTION("decoding in steady state does not allocate")
+    {
+        std::vector<std::vector<uint8_t>> payloads;
+        for (uint32_t round = 0; round < 16; round++) {
+            RangeDataNotification::Encode(MakeRangingData(1 + round % 8, round), payloads.emplace_back());
+        }
+        payloads.emplace_back();
+        RangeDataNotification::Encode(MakeRangingData<UwbMacAddressType::Extended>(8, 16), payloads.back());
+
+        UwbRangingData rangingData{};
+        rangingData.RangingMeasurements.reserve(8);
+
+        const auto numAllocationsBefore = uwb::test::GetNumAllocations();
+        bool decoded = true;
+        for (const auto& payload : payloads) {
+            decoded = decoded && RangeDataNotification::Decode(payload, rangingData);
+        }
+        const auto numAllocations = uwb::test::GetNumAllocations() - numAllocationsBefore;
+
+        REQUIRE(decoded);
+        REQUIRE(numAllocations == 0);
+        REQUIRE(rangingData == MakeRangingData<UwbMacAddressType::Extended>(8, 16));
+
+        // Decoding into a fresh object must grow its measurement list, which
+        // shows the allocations above would have been counted.
+        UwbRangingData rangingDataFresh{};
+        const auto numAllocationsBeforeFresh = uwb::test::GetNumAllocations();
+        REQUIRE(RangeDataNotification::Decode(payloads.back(), rangingDataFresh));
+        REQUIRE(uwb::test::GetNumAllocations() > numAllocationsBeforeFresh);
+    }
+}
+
+TEST_CASE("RANGE_DATA_NTF decoding performance", "[.][benchmark][protocol][uci]")
+{
+    using namespace uwb;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+    using namespace uwb::protocol::fira::uci::test;
+
+    std::vector<uint8_t> payload;
+    RangeDataNotification::Encode(MakeRangingData(8, 1), payload);
+
+    BENCHMARK("Decode into new UwbRangingData")
+    {
+        UwbRangingData rangingData{};
+        RangeDataNotification::Decode(payload, rangingData);
+        return rangingData;
+    };
+
+    UwbRangingData rangingData{};
+    BENCHMARK("Decode into reused UwbRangingData")
+    {
+        RangeDataNotification::Decode(payload, rangingData);
+        return rangingData.SequenceNumber;
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -1,4 +1,5 @@
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <notstd/utility.hxx>
@@ -12,8 +13,10 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 #include <uwb/protocols/fira/UwbCapability.hxx>
 
 namespace uwb::protocol::fira::TestUwbCapability
@@ -196,25 +199,6 @@ TEST_CASE("UwbCapability OOB encoding is stable", "[basic][oob][encoding]")
     }
 }
 
-// TODO find better place for this
-template <class T>
-bool
-leftIsSubset(const std::vector<T>& lhs, const std::vector<T>& rhs)
-{
-    return std::ranges::all_of(lhs, [&rhs](const auto& elem) {
-        return std::ranges::any_of(rhs, [&elem](const auto& elem2) {
-            return elem == elem2;
-        });
-    });
-}
-
-template <class T>
-bool
-leftUnorderedEquals(const std::vector<T>& lhs, const std::vector<T>& rhs)
-{
-    return leftIsSubset(lhs, rhs) and leftIsSubset(rhs, lhs);
-}
-
 TEST_CASE("Parsing from TlvBer", "[basic][protocol]")
 {
     using namespace uwb::protocol::fira;
@@ -237,26 +221,65 @@ TEST_CASE("Parsing from TlvBer", "[basic][protocol]")
         REQUIRE_NOTHROW(decodedCapability = UwbCapability::FromOobDataObject(*tlv));
         REQUIRE(decodedCapability.FiraPhyVersionRange == TestUwbCapability::testUwbCapability.FiraPhyVersionRange);
         REQUIRE(decodedCapability.FiraMacVersionRange == TestUwbCapability::testUwbCapability.FiraMacVersionRange);
-        REQUIRE(leftUnorderedEquals(decodedCapability.DeviceRoles, TestUwbCapability::testUwbCapability.DeviceRoles));
-        REQUIRE(leftUnorderedEquals(decodedCapability.RangingMethods, TestUwbCapability::testUwbCapability.RangingMethods));
-        REQUIRE(leftUnorderedEquals(decodedCapability.StsConfigurations, TestUwbCapability::testUwbCapability.StsConfigurations));
-        REQUIRE(leftUnorderedEquals(decodedCapability.MultiNodeModes, TestUwbCapability::testUwbCapability.MultiNodeModes));
-        REQUIRE(leftUnorderedEquals(decodedCapability.RangingTimeStructs, TestUwbCapability::testUwbCapability.RangingTimeStructs));
-        REQUIRE(leftUnorderedEquals(decodedCapability.SchedulingModes, TestUwbCapability::testUwbCapability.SchedulingModes));
+        REQUIRE(decodedCapability.DeviceRoles == TestUwbCapability::testUwbCapability.DeviceRoles);
+        REQUIRE(decodedCapability.RangingMethods == TestUwbCapability::testUwbCapability.RangingMethods);
+        REQUIRE(decodedCapability.StsConfigurations == TestUwbCapability::testUwbCapability.StsConfigurations);
+        REQUIRE(decodedCapability.MultiNodeModes == TestUwbCapability::testUwbCapability.MultiNodeModes);
+        REQUIRE(decodedCapability.RangingTimeStructs == TestUwbCapability::testUwbCapability.RangingTimeStructs);
+        REQUIRE(decodedCapability.SchedulingModes == TestUwbCapability::testUwbCapability.SchedulingModes);
         REQUIRE(decodedCapability.HoppingMode == TestUwbCapability::testUwbCapability.HoppingMode);
         REQUIRE(decodedCapability.BlockStriding == TestUwbCapability::testUwbCapability.BlockStriding);
         REQUIRE(decodedCapability.UwbInitiationTime == TestUwbCapability::testUwbCapability.UwbInitiationTime);
 
-        REQUIRE(leftUnorderedEquals(decodedCapability.Channels, TestUwbCapability::testUwbCapability.Channels));
-        REQUIRE(leftUnorderedEquals(decodedCapability.RFrameConfigurations, TestUwbCapability::testUwbCapability.RFrameConfigurations));
-        REQUIRE(leftUnorderedEquals(decodedCapability.ConvolutionalCodeConstraintLengths, TestUwbCapability::testUwbCapability.ConvolutionalCodeConstraintLengths));
-        REQUIRE(leftUnorderedEquals(decodedCapability.BprfParameterSets, TestUwbCapability::testUwbCapability.BprfParameterSets));
-        REQUIRE(leftUnorderedEquals(decodedCapability.HprfParameterSets, TestUwbCapability::testUwbCapability.HprfParameterSets));
-        REQUIRE(leftUnorderedEquals(decodedCapability.AngleOfArrivalTypes, TestUwbCapability::testUwbCapability.AngleOfArrivalTypes));
+        REQUIRE(decodedCapability.Channels == TestUwbCapability::testUwbCapability.Channels);
+        REQUIRE(decodedCapability.RFrameConfigurations == TestUwbCapability::testUwbCapability.RFrameConfigurations);
+        REQUIRE(decodedCapability.ConvolutionalCodeConstraintLengths == TestUwbCapability::testUwbCapability.ConvolutionalCodeConstraintLengths);
+        REQUIRE(decodedCapability.BprfParameterSets == TestUwbCapability::testUwbCapability.BprfParameterSets);
+        REQUIRE(decodedCapability.HprfParameterSets == TestUwbCapability::testUwbCapability.HprfParameterSets);
+        REQUIRE(decodedCapability.AngleOfArrivalTypes == TestUwbCapability::testUwbCapability.AngleOfArrivalTypes);
 
         REQUIRE(decodedCapability.AngleOfArrivalFom == TestUwbCapability::testUwbCapability.AngleOfArrivalFom);
         REQUIRE(decodedCapability.ExtendedMacAddress == TestUwbCapability::testUwbCapability.ExtendedMacAddress);
     }
+    SECTION("FromOobDataObject works with a TlvBerView")
+    {
+        const auto tlv = TestUwbCapability::testUwbCapability.ToOobDataObject();
+        REQUIRE(tlv);
+        const auto data = tlv->ToBytes();
+
+        encoding::TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::ParseView(tlvView, data, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+
+        UwbCapability decodedCapability;
+        REQUIRE_NOTHROW(decodedCapability = UwbCapability::FromOobDataObject(tlvView));
+        REQUIRE(decodedCapability == UwbCapability::FromOobDataObject(*tlv));
+    }
+    SECTION("FromOobDataObject keeps default values for omitted parameters")
+    {
+        std::vector<uint8_t> encoded{
+            0xA3, 0x06,
+            0x80, 0x04, 0x01, 0x01, 0x01, 0x02 // FiraPhyVersionRange
+        };
+        encoding::TlvBer tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+
+        UwbCapability capabilityExpected{};
+        capabilityExpected.FiraPhyVersionRange = 0x01010102;
+        REQUIRE(UwbCapability::FromOobDataObject(tlv) == capabilityExpected);
+    }
+    SECTION("FromOobDataObject throws when a parameter has the wrong length")
+    {
+        std::vector<uint8_t> encoded{
+            0xA3, 0x04,
+            0x88, 0x02, 0x01, 0x00 // HoppingMode
+        };
+        encoding::TlvBer tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE_THROWS_AS(UwbCapability::FromOobDataObject(tlv), UwbCapability::IncorrectNumberOfBytesInValueError);
+    }
 }
 
 TEST_CASE("UwbCapability can be used in unordered_containers", "[basic][container]")
@@ -312,3 +335,162 @@ TEST_CASE("UwbCapability can be used in unordered_containers", "[basic][containe
         }
     }
 }
+
+TEST_CASE("UwbCapability sets support set operations", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    UwbCapability uwbCapability = TestUwbCapability::testUwbCapability;
+    uwbCapability.FiraPhyVersionRange = 0;
+    uwbCapability.FiraMacVersionRange = 0;
+
+    SECTION("a capability is a subset of one supporting more values")
+    {
+        REQUIRE(uwbCapability.IsSubsetOf(UwbCapability{}));
+        REQUIRE_FALSE(UwbCapability{}.IsSubsetOf(uwbCapability));
+        REQUIRE(uwbCapability.IsSubsetOf(uwbCapability));
+    }
+
+    SECTION("intersecting with a superset yields the subset")
+    {
+        REQUIRE(UwbCapability{}.Intersect(uwbCapability) == uwbCapability);
+        REQUIRE(uwbCapability.Intersect(UwbCapability{}) == uwbCapability);
+        REQUIRE(UwbCapability{}.Intersect(TestUwbCapability::testUwbCapability) == uwbCapability);
+    }
+
+    SECTION("version ranges are narrowed to their overlap")
+    {
+        UwbCapability uwbCapabilityOne{};
+        UwbCapability uwbCapabilityTwo{};
+        uwbCapabilityOne.FiraPhyVersionRange = 0x01010202;
+        uwbCapabilityTwo.FiraPhyVersionRange = 0x01000105;
+        REQUIRE(uwbCapabilityOne.Intersect(uwbCapabilityTwo).FiraPhyVersionRange == 0x01010105);
+        REQUIRE_FALSE(uwbCapabilityOne.IsSubsetOf(uwbCapabilityTwo));
+
+        uwbCapabilityTwo.FiraPhyVersionRange = 0x02030204;
+        REQUIRE(uwbCapabilityOne.Intersect(uwbCapabilityTwo).FiraPhyVersionRange == 0);
+    }
+
+    SECTION("equality does not depend on the order values were added")
+    {
+        UwbCapability uwbCapabilityOne{};
+        UwbCapability uwbCapabilityTwo{};
+        uwbCapabilityOne.Channels = { Channel::C9, Channel::C5 };
+        uwbCapabilityTwo.Channels = { Channel::C5, Channel::C9 };
+        REQUIRE(uwbCapabilityOne == uwbCapabilityTwo);
+        REQUIRE(std::hash<UwbCapability>{}(uwbCapabilityOne) == std::hash<UwbCapability>{}(uwbCapabilityTwo));
+    }
+}
+
+TEST_CASE("UwbCapability negotiation", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    UwbCapability controller{};
+    UwbCapability controlee{};
+
+    SECTION("default capabilities negotiate the FiRa default configuration")
+    {
+        const auto uwbConfiguration = UwbCapability::Negotiate(controller, controlee);
+        REQUIRE(uwbConfiguration.has_value());
+        REQUIRE(uwbConfiguration->GetDeviceRole() == DeviceRole::Initiator);
+        REQUIRE(uwbConfiguration->GetRangingMethod() == RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::Deferred });
+        REQUIRE(uwbConfiguration->GetStsConfiguration() == StsConfiguration::Static);
+        REQUIRE(uwbConfiguration->GetMultiNodeMode() == MultiNodeMode::Unicast);
+        REQUIRE(uwbConfiguration->GetRangingTimeStruct() == RangingMode::Block);
+        REQUIRE(uwbConfiguration->GetSchedulingMode() == SchedulingMode::Time);
+        REQUIRE(uwbConfiguration->GetChannel() == Channel::C9);
+        REQUIRE(uwbConfiguration->GetRFrameConfig() == StsPacketConfiguration::SP3);
+        REQUIRE(uwbConfiguration->GetConvolutionalCodeConstraintLength() == ConvolutionalCodeConstraintLength::K3);
+        REQUIRE(uwbConfiguration->GetPrfMode() == PrfMode::Bprf);
+        REQUIRE_FALSE(uwbConfiguration->GetFiraPhyVersion().has_value());
+        REQUIRE_FALSE(uwbConfiguration->GetFiraMacVersion().has_value());
+    }
+
+    SECTION("device roles must be complementary")
+    {
+        controller.DeviceRoles = { DeviceRole::Responder };
+        controlee.DeviceRoles = { DeviceRole::Responder };
+        REQUIRE_FALSE(UwbCapability::Negotiate(controller, controlee).has_value());
+
+        controller.DeviceRoles = { DeviceRole::Initiator, DeviceRole::Responder };
+        controlee.DeviceRoles = { DeviceRole::Initiator };
+        const auto uwbConfiguration = UwbCapability::Negotiate(controller, controlee);
+        REQUIRE(uwbConfiguration.has_value());
+        REQUIRE(uwbConfiguration->GetDeviceRole() == DeviceRole::Responder);
+    }
+
+    SECTION("only values supported by both devices are chosen")
+    {
+        controller.Channels = { Channel::C5, Channel::C9 };
+        controlee.Channels = { Channel::C5, Channel::C6 };
+        controller.RangingMethods = { RangingMethod{ RangingDirection::OneWay, MeasurementReportMode::None }, RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred } };
+        controller.BprfParameterSets = {};
+        auto uwbConfiguration = UwbCapability::Negotiate(controller, controlee);
+        REQUIRE(uwbConfiguration.has_value());
+        REQUIRE(uwbConfiguration->GetChannel() == Channel::C5);
+        REQUIRE(uwbConfiguration->GetRangingMethod() == RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred });
+        REQUIRE(uwbConfiguration->GetPrfMode() == PrfMode::Hprf);
+
+        controlee.Channels = { Channel::C6 };
+        REQUIRE_FALSE(UwbCapability::Negotiate(controller, controlee).has_value());
+    }
+
+    SECTION("the highest common version is chosen")
+    {
+        controller.FiraPhyVersionRange = 0x01010202;
+        controlee.FiraPhyVersionRange = 0x01000105;
+        auto uwbConfiguration = UwbCapability::Negotiate(controller, controlee);
+        REQUIRE(uwbConfiguration.has_value());
+        REQUIRE(uwbConfiguration->GetFiraPhyVersion() == 0x0105);
+        REQUIRE_FALSE(uwbConfiguration->GetFiraMacVersion().has_value());
+
+        controlee.FiraPhyVersionRange = 0x02030204;
+        REQUIRE_FALSE(UwbCapability::Negotiate(controller, controlee).has_value());
+    }
+}
+
+TEST_CASE("UwbCapability negotiation performance", "[.][benchmark][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    constexpr std::size_t NumCandidates = 10000;
+
+    // Vary the supported values of each candidate so a mix of them can and cannot be negotiated with.
+    std::vector<UwbCapability> candidates(NumCandidates);
+    std::vector<std::vector<uint8_t>> candidateBlobs;
+    candidateBlobs.reserve(NumCandidates);
+    for (std::size_t i = 0; i < NumCandidates; i++) {
+        auto& candidate = candidates[i];
+        candidate.DeviceRoles = UwbCapability::DeviceRoleSet::FromBits(i);
+        candidate.Channels = UwbCapability::ChannelSet::FromBits(i >> 2U);
+        candidate.RangingMethods = UwbCapability::RangingMethodSet::FromBits(i * 7U);
+        candidate.StsConfigurations = UwbCapability::StsConfigurationSet::FromBits(i * 3U + 1U);
+        candidate.BprfParameterSets = UwbCapability::BprfParameterSet::FromBits(i * 5U);
+        candidateBlobs.push_back(candidate.ToOobDataObject()->ToBytes());
+    }
+
+    const UwbCapability controller{};
+
+    BENCHMARK("negotiate with 10k candidates")
+    {
+        std::size_t numNegotiated = 0;
+        for (const auto& candidate : candidates) {
+            numNegotiated += UwbCapability::Negotiate(controller, candidate).has_value() ? 1 : 0;
+        }
+        return numNegotiated;
+    };
+
+    BENCHMARK("decode and negotiate with 10k candidate blobs")
+    {
+        std::size_t numNegotiated = 0;
+        for (const auto& candidateBlob : candidateBlobs) {
+            encoding::TlvBerView tlvView{};
+            std::size_t bytesParsed = 0;
+            if (encoding::TlvBer::ParseView(tlvView, candidateBlob, bytesParsed) == encoding::Tlv::ParseResult::Succeeded) {
+                numNegotiated += UwbCapability::Negotiate(controller, UwbCapability::FromOobDataObject(tlvView)).has_value() ? 1 : 0;
+            }
+        }
+        return numNegotiated;
+    };
+}
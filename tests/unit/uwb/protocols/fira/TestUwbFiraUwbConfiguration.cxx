@@ -1,10 +1,18 @@
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <vector>
 #include <unordered_set>
 #include <unordered_map>
 
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+
 #include <uwb/protocols/fira/UwbConfiguration.hxx>
 #include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 
@@ -76,3 +84,166 @@ TEST_CASE("UwbConfiguration can be used in unordered_containers", "[basic][conta
         }
     }
 }
+
+TEST_CASE("UwbConfiguration values are independent of the order they were set", "[basic]")
+{
+    using namespace uwb::protocol::fira;
+
+    UwbConfiguration::Builder builderOne{};
+    builderOne.SetChannel(Channel::C9);
+    builderOne.SetRangingInterval(200);
+    builderOne.AddResultReportConfiguration(ResultReportConfiguration::TofReport);
+    builderOne.AddResultReportConfiguration(ResultReportConfiguration::AoAAzimuthReport);
+    const UwbConfiguration uwbConfigurationOne = builderOne;
+
+    UwbConfiguration::Builder builderTwo{};
+    builderTwo.AddResultReportConfiguration(ResultReportConfiguration::AoAAzimuthReport);
+    builderTwo.AddResultReportConfiguration(ResultReportConfiguration::TofReport);
+    builderTwo.SetRangingInterval(200);
+    builderTwo.SetChannel(Channel::C9);
+    const UwbConfiguration uwbConfigurationTwo = builderTwo;
+
+    SECTION("equality and hash do not depend on order")
+    {
+        REQUIRE(uwbConfigurationOne == uwbConfigurationTwo);
+        REQUIRE(std::hash<UwbConfiguration>{}(uwbConfigurationOne) == std::hash<UwbConfiguration>{}(uwbConfigurationTwo));
+    }
+
+    SECTION("equality compares the values of present parameters")
+    {
+        REQUIRE(uwbConfigurationOne.GetResultReportConfigurations() == std::unordered_set<ResultReportConfiguration>{ ResultReportConfiguration::TofReport, ResultReportConfiguration::AoAAzimuthReport });
+
+        UwbConfiguration::Builder builderThree{};
+        builderThree.SetChannel(Channel::C9);
+        builderThree.SetRangingInterval(200);
+        builderThree.AddResultReportConfiguration(ResultReportConfiguration::TofReport);
+        const UwbConfiguration uwbConfigurationThree = builderThree;
+        REQUIRE(uwbConfigurationOne != uwbConfigurationThree);
+    }
+
+    SECTION("values are visited in ascending tag order")
+    {
+        std::vector<UwbConfiguration::ParameterTag> parameterTags;
+        for (const auto& [parameterTag, parameterValue] : uwbConfigurationOne.GetValues()) {
+            parameterTags.push_back(parameterTag);
+        }
+        REQUIRE(parameterTags == std::vector<UwbConfiguration::ParameterTag>{ UwbConfiguration::ParameterTag::ChannelNumber, UwbConfiguration::ParameterTag::ResultReportConfig, UwbConfiguration::ParameterTag::RangingInterval });
+    }
+
+    SECTION("round-trips through a data object")
+    {
+        UwbConfiguration::Builder builder{};
+        builder.SetChannel(Channel::C9);
+        builder.AddResultReportConfiguration(ResultReportConfiguration::TofReport);
+        builder.AddResultReportConfiguration(ResultReportConfiguration::AoAAzimuthReport);
+        const UwbConfiguration uwbConfiguration = builder;
+
+        const auto dataObject = uwbConfiguration.ToDataObject();
+        REQUIRE(UwbConfiguration::FromDataObject(*dataObject) == uwbConfiguration);
+    }
+}
+
+TEST_CASE("UwbConfiguration data object encoding", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    UwbConfiguration::Builder builder{};
+    builder.SetFiraVersionPhy(0x0102);
+    builder.SetDeviceRole(DeviceRole::Initiator);
+    builder.SetRangingMethod(RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred });
+    builder.SetHoppingMode(true);
+    builder.SetUwbInitiationTime(0x01020304);
+    builder.SetChannel(Channel::C9);
+    builder.SetSp0PhySetNumber(3);
+    builder.AddResultReportConfiguration(ResultReportConfiguration::TofReport);
+    builder.AddResultReportConfiguration(ResultReportConfiguration::AoAFoMReport);
+    builder.SetMacAddressControleeShort(uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0xAA, 0xBB } });
+    builder.SetMacAddressController(uwb::UwbMacAddress{ std::array<uint8_t, 8>{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 } });
+    builder.SetSlotDuration(2400);
+    builder.SetMacAddressFcsType(uwb::UwbMacAddressFcsType::Crc32);
+    const UwbConfiguration uwbConfiguration = builder;
+
+    SECTION("present parameters are encoded in ascending tag order")
+    {
+        const std::vector<uint8_t> encodedExpected{
+            0xA3, 0x31,
+            0x80, 0x02, 0x01, 0x02,
+            0x82, 0x01, 0x01,
+            0x83, 0x01, 0x03,
+            0x88, 0x01, 0x01,
+            0x8A, 0x04, 0x01, 0x02, 0x03, 0x04,
+            0x8B, 0x01, 0x09,
+            0x8F, 0x01, 0x03,
+            0x93, 0x01, 0x09,
+            0x95, 0x02, 0xAA, 0xBB,
+            0x96, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+            0x99, 0x02, 0x09, 0x60,
+            0x9C, 0x01, 0x01
+        };
+
+        REQUIRE(uwbConfiguration.ToDataObject()->ToBytes() == encodedExpected);
+    }
+
+    SECTION("decoding from a TlvBer and a TlvBerView round-trips")
+    {
+        const auto dataObject = uwbConfiguration.ToDataObject();
+        REQUIRE(UwbConfiguration::FromDataObject(*dataObject) == uwbConfiguration);
+
+        auto encoded = dataObject->ToBytes();
+        encoding::TlvBerView dataObjectView{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::ParseView(dataObjectView, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE(UwbConfiguration::FromDataObject(dataObjectView) == uwbConfiguration);
+    }
+
+    SECTION("parameters with invalid values are ignored")
+    {
+        std::vector<uint8_t> encoded{
+            0xA3, 0x11,
+            0x82, 0x01, 0x01, // DeviceRole::Initiator
+            0x83, 0x01, 0x07, // unknown ranging method
+            0x8B, 0x01, 0x07, // unknown channel
+            0x95, 0x01, 0xAA, // short address too short
+            0x99, 0x03, 0x01, 0x02, 0x03 // slot duration too long
+        };
+        encoding::TlvBer dataObject{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBer::Parse(dataObject, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+
+        const auto uwbConfigurationDecoded = UwbConfiguration::FromDataObject(dataObject);
+        REQUIRE(uwbConfigurationDecoded == UwbConfiguration{ UwbConfiguration::Builder().SetDeviceRole(DeviceRole::Initiator) });
+    }
+}
+
+TEST_CASE("UwbConfiguration access performance", "[.][benchmark]")
+{
+    using namespace uwb::protocol::fira;
+
+    UwbConfiguration::Builder builder{};
+    builder.SetDeviceRole(DeviceRole::Initiator);
+    builder.SetStsConfiguration(StsConfiguration::Static);
+    builder.SetMultiNodeMode(MultiNodeMode::Unicast);
+    builder.SetChannel(Channel::C9);
+    builder.SetPrfMode(PrfMode::Bprf);
+    builder.SetPreambleCodeIndex(10);
+    builder.SetSlotDuration(2400);
+    builder.SetRangingInterval(200);
+    builder.SetMaxRangingRoundRetry(3);
+    const UwbConfiguration uwbConfiguration = builder;
+    const UwbConfiguration uwbConfigurationCopy = uwbConfiguration;
+
+    BENCHMARK("getters")
+    {
+        return uwbConfiguration.GetChannel().value_or(Channel::C5) == Channel::C9 && uwbConfiguration.GetRangingInterval().value_or(0) == 200 && !uwbConfiguration.GetHoppingMode();
+    };
+
+    BENCHMARK("equality")
+    {
+        return uwbConfiguration == uwbConfigurationCopy;
+    };
+
+    BENCHMARK("hash")
+    {
+        return std::hash<UwbConfiguration>{}(uwbConfiguration);
+    };
+}
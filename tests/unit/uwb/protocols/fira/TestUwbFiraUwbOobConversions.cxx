@@ -0,0 +1,139 @@
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/UwbConfiguration.hxx>
+#include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
+#include <uwb/protocols/fira/UwbOobConversions.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::protocol::fira::test
+{
+/**
+ * @brief Make a configuration typical of an OOB profile.
+ *
+ * @param rangingInterval The ranging interval, to allow creating distinct configurations.
+ * @return UwbConfiguration
+ */
+UwbConfiguration
+MakeOobConfiguration(uint16_t rangingInterval = 200)
+{
+    UwbConfiguration::Builder builder{};
+    builder.SetDeviceRole(DeviceRole::Initiator);
+    builder.SetRangingMethod(RangingMethod{ RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::Deferred });
+    builder.SetStsConfiguration(StsConfiguration::Static);
+    builder.SetMultiNodeMode(MultiNodeMode::Unicast);
+    builder.SetChannel(Channel::C9);
+    builder.SetPrfMode(PrfMode::Bprf);
+    builder.SetPreambleCodeIndex(10);
+    builder.SetMacAddressType(uwb::UwbMacAddressType::Short);
+    builder.SetMacAddressFcsType(uwb::UwbMacAddressFcsType::Crc16);
+    builder.SetMacAddressController(uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x12, 0x34 } });
+    builder.SetMacAddressControleeShort(uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x56, 0x78 } });
+    builder.SetSlotDuration(2400);
+    builder.SetRangingInterval(rangingInterval);
+    builder.SetMaxRangingRoundRetry(3);
+    return builder;
+}
+
+/**
+ * @brief Find the value of a parameter in a list.
+ *
+ * @param parameters The parameters to search.
+ * @param type The parameter type to find.
+ * @return const UwbApplicationConfigurationParameterValue*
+ */
+const UwbApplicationConfigurationParameterValue*
+FindValue(const std::vector<UwbApplicationConfigurationParameter>& parameters, UwbApplicationConfigurationParameterType type)
+{
+    const auto parameter = std::ranges::find(parameters, type, &UwbApplicationConfigurationParameter::Type);
+    return (parameter != std::cend(parameters)) ? &parameter->Value : nullptr;
+}
+} // namespace uwb::protocol::fira::test
+
+TEST_CASE("uci configuration parameters can be generated from a uwb configuration", "[basic][protocol][fira]")
+{
+    using namespace uwb::protocol::fira;
+    using ParameterType = UwbApplicationConfigurationParameterType;
+
+    const auto uwbConfiguration = test::MakeOobConfiguration();
+
+    SECTION("parameters are generated once each, in ascending type order")
+    {
+        const auto parameters = GetUciConfigParams(uwbConfiguration, DeviceType::Controller);
+        REQUIRE_FALSE(parameters.empty());
+        REQUIRE(std::ranges::is_sorted(parameters, std::less<>{}, &UwbApplicationConfigurationParameter::Type));
+        REQUIRE(std::ranges::adjacent_find(parameters, std::equal_to<>{}, &UwbApplicationConfigurationParameter::Type) == std::cend(parameters));
+
+        REQUIRE(*test::FindValue(parameters, ParameterType::DeviceType) == UwbApplicationConfigurationParameterValue{ DeviceType::Controller });
+        REQUIRE(*test::FindValue(parameters, ParameterType::ChannelNumber) == UwbApplicationConfigurationParameterValue{ Channel::C9 });
+        REQUIRE(*test::FindValue(parameters, ParameterType::RangingRoundUsage) == UwbApplicationConfigurationParameterValue{ RangingRoundUsage::DoubleSidedTwoWayRangingWithDeferredMode });
+        REQUIRE(*test::FindValue(parameters, ParameterType::PrfMode) == UwbApplicationConfigurationParameterValue{ PrfModeDetailed::Bprf62MHz });
+        REQUIRE(*test::FindValue(parameters, ParameterType::DeviceMacAddress) == UwbApplicationConfigurationParameterValue{ uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x12, 0x34 } } });
+    }
+
+    SECTION("repeated conversions return identical, independent results")
+    {
+        auto parameters = GetUciConfigParams(uwbConfiguration, DeviceType::Controller);
+        const auto parametersExpected = parameters;
+        parameters.clear();
+        REQUIRE(GetUciConfigParams(uwbConfiguration, DeviceType::Controller) == parametersExpected);
+        REQUIRE(GetUciConfigParams(test::MakeOobConfiguration(), DeviceType::Controller) == parametersExpected);
+    }
+
+    SECTION("device type is part of the conversion")
+    {
+        const auto parametersController = GetUciConfigParams(uwbConfiguration, DeviceType::Controller);
+        const auto parametersControlee = GetUciConfigParams(uwbConfiguration, DeviceType::Controlee);
+        REQUIRE(parametersController != parametersControlee);
+        REQUIRE(*test::FindValue(parametersControlee, ParameterType::DeviceType) == UwbApplicationConfigurationParameterValue{ DeviceType::Controlee });
+        REQUIRE(*test::FindValue(parametersControlee, ParameterType::DeviceMacAddress) == UwbApplicationConfigurationParameterValue{ uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x56, 0x78 } } });
+    }
+
+    SECTION("distinct configurations beyond the cache capacity convert correctly")
+    {
+        for (uint16_t rangingInterval = 100; rangingInterval < 164; rangingInterval++) {
+            const auto parameters = GetUciConfigParams(test::MakeOobConfiguration(rangingInterval), DeviceType::Controller);
+            REQUIRE(*test::FindValue(parameters, ParameterType::RangingInterval) == UwbApplicationConfigurationParameterValue{ rangingInterval });
+        }
+        for (uint16_t rangingInterval = 163; rangingInterval >= 100; rangingInterval--) {
+            const auto parameters = GetUciConfigParams(test::MakeOobConfiguration(rangingInterval), DeviceType::Controller);
+            REQUIRE(*test::FindValue(parameters, ParameterType::RangingInterval) == UwbApplicationConfigurationParameterValue{ rangingInterval });
+        }
+    }
+}
+
+TEST_CASE("uci configuration parameter generation performance", "[.][benchmark][protocol][fira]")
+{
+    using namespace uwb::protocol::fira;
+
+    const auto uwbConfiguration = test::MakeOobConfiguration();
+    uint16_t rangingInterval = 0;
+
+    BENCHMARK("repeated configuration")
+    {
+        return GetUciConfigParams(uwbConfiguration, DeviceType::Controller);
+    };
+
+    BENCHMARK_ADVANCED("distinct configurations")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<UwbConfiguration> uwbConfigurations;
+        for (int i = 0; i < meter.runs(); i++) {
+            uwbConfigurations.push_back(test::MakeOobConfiguration(rangingInterval++));
+        }
+        meter.measure([&](int i) {
+            return GetUciConfigParams(uwbConfigurations[static_cast<std::size_t>(i)], DeviceType::Controller);
+        });
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -16,6 +16,7 @@
 #include <notstd/unique_ptr_out.hxx>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 #include <uwb/protocols/fira/UwbConfiguration.hxx>
 #include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 #include <uwb/protocols/fira/UwbSessionData.hxx>
@@ -53,4 +54,39 @@ TEST_CASE("UwbSessionData encoding")
         std::hash<uwb::protocol::fira::UwbSessionData> usdHash;
         REQUIRE(usdHash(sessionDataParsed) == usdHash(sessionData));
     }
+
+    SECTION("UwbSessionData convert to TlvBer and back again through a TlvBerView works")
+    {
+        using namespace uwb::protocol::fira;
+        using namespace encoding;
+
+        UwbSessionData sessionData;
+
+        sessionData.uwbConfiguration = UwbConfiguration::Builder()
+                                           .SetMacAddressController(uwb::UwbMacAddress::FromString("67:89", uwb::UwbMacAddressType::Short).value())
+                                           .SetMacAddressControleeShort(uwb::UwbMacAddress::FromString("12:34", uwb::UwbMacAddressType::Short).value())
+                                           .SetMultiNodeMode(MultiNodeMode::Unicast)
+                                           .SetDeviceRole(DeviceRole::Initiator)
+                                           .SetPreambleCodeIndex(10)
+                                           .SetMaxSlotsPerRangingRound(8);
+
+        sessionData.sessionDataVersion = 1;
+        sessionData.sessionId = 1234;
+
+        auto tlvBer = sessionData.ToDataObject();
+        REQUIRE(tlvBer);
+        auto data = tlvBer->ToBytes();
+
+        TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        auto parseResult = TlvBer::ParseView(tlvView, data, bytesParsed);
+        REQUIRE(parseResult == TlvBer::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == std::size(data));
+
+        UwbSessionData sessionDataParsed;
+        REQUIRE_NOTHROW(sessionDataParsed = UwbSessionData::FromDataObject(tlvView));
+        std::hash<uwb::protocol::fira::UwbSessionData> usdHash;
+        REQUIRE(usdHash(sessionDataParsed) == usdHash(sessionData));
+        REQUIRE(sessionDataParsed.uwbConfiguration == sessionData.uwbConfiguration);
+    }
 }
\ No newline at end of file
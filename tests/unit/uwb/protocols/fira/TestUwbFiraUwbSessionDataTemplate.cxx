@@ -0,0 +1,169 @@
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/UwbConfiguration.hxx>
+#include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
+#include <uwb/protocols/fira/UwbSessionData.hxx>
+#include <uwb/protocols/fira/UwbSessionDataTemplate.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace uwb::protocol::fira::test
+{
+/**
+ * @brief Make session data typical of a controller serving OOB data.
+ *
+ * @return UwbSessionData
+ */
+UwbSessionData
+MakeTemplateSessionData()
+{
+    UwbSessionData uwbSessionData{};
+    uwbSessionData.sessionId = 0x11223344;
+    uwbSessionData.subSessionId = 0x55667788;
+    uwbSessionData.uwbConfigurationAvailable = true;
+    uwbSessionData.uwbConfiguration = UwbConfiguration::Builder()
+                                          .SetDeviceRole(DeviceRole::Initiator)
+                                          .SetMultiNodeMode(MultiNodeMode::Unicast)
+                                          .SetChannel(Channel::C9)
+                                          .SetMacAddressType(uwb::UwbMacAddressType::Short)
+                                          .SetMacAddressController(uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x12, 0x34 } })
+                                          .SetMacAddressControleeShort(uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x56, 0x78 } });
+    return uwbSessionData;
+}
+
+/**
+ * @brief Encode session data with the specified fields applied, without using a template.
+ *
+ * @param uwbSessionData The session data.
+ * @param fields The fields to apply.
+ * @return std::vector<uint8_t>
+ */
+std::vector<uint8_t>
+EncodeWithFields(UwbSessionData uwbSessionData, const UwbSessionDataTemplate::Fields& fields)
+{
+    uwbSessionData.sessionId = fields.SessionId;
+    uwbSessionData.subSessionId = fields.SubSessionId;
+    UwbConfiguration::Builder builder{ uwbSessionData.uwbConfiguration };
+    if (fields.ControllerMacAddress.has_value()) {
+        builder.SetMacAddressController(*fields.ControllerMacAddress);
+    }
+    if (fields.ControleeShortMacAddress.has_value()) {
+        builder.SetMacAddressControleeShort(*fields.ControleeShortMacAddress);
+    }
+    uwbSessionData.uwbConfiguration = builder;
+    return uwbSessionData.ToDataObject()->ToBytes();
+}
+} // namespace uwb::protocol::fira::test
+
+TEST_CASE("UwbSessionDataTemplate produces per-session data objects", "[basic][protocol][fira]")
+{
+    using namespace uwb::protocol::fira;
+
+    const auto uwbSessionData = test::MakeTemplateSessionData();
+    const UwbSessionDataTemplate uwbSessionDataTemplate{ uwbSessionData };
+    REQUIRE(uwbSessionDataTemplate.GetEncoding() == uwbSessionData.ToDataObject()->ToBytes());
+
+    SECTION("session identifiers are patched in place")
+    {
+        const UwbSessionDataTemplate::Fields fields{ .SessionId = 0xAABBCCDD, .SubSessionId = 7 };
+        REQUIRE(uwbSessionDataTemplate.CanPatch(fields));
+
+        const auto encoded = uwbSessionDataTemplate.Generate(fields);
+        REQUIRE(encoded == test::EncodeWithFields(uwbSessionData, fields));
+        REQUIRE(encoded.size() == uwbSessionDataTemplate.GetEncoding().size());
+    }
+
+    SECTION("mac addresses of the same length are patched in place")
+    {
+        const UwbSessionDataTemplate::Fields fields{
+            .SessionId = 1,
+            .SubSessionId = 2,
+            .ControllerMacAddress = uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0xAB, 0xCD } },
+            .ControleeShortMacAddress = uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0xEF, 0x01 } },
+        };
+        REQUIRE(uwbSessionDataTemplate.CanPatch(fields));
+        REQUIRE(uwbSessionDataTemplate.Generate(fields) == test::EncodeWithFields(uwbSessionData, fields));
+    }
+
+    SECTION("fields that change length are re-encoded")
+    {
+        const UwbSessionDataTemplate::Fields fields{
+            .SessionId = 3,
+            .ControllerMacAddress = uwb::UwbMacAddress{ std::array<uint8_t, 8>{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 } },
+        };
+        REQUIRE_FALSE(uwbSessionDataTemplate.CanPatch(fields));
+
+        const auto encoded = uwbSessionDataTemplate.Generate(fields);
+        REQUIRE(encoded == test::EncodeWithFields(uwbSessionData, fields));
+        REQUIRE(encoded.size() == uwbSessionDataTemplate.GetEncoding().size() + 6);
+    }
+
+    SECTION("fields absent from the template are re-encoded")
+    {
+        auto uwbSessionDataNoAddresses = uwbSessionData;
+        uwbSessionDataNoAddresses.uwbConfiguration = UwbConfiguration::Builder().SetChannel(Channel::C5);
+        const UwbSessionDataTemplate uwbSessionDataTemplateNoAddresses{ uwbSessionDataNoAddresses };
+
+        const UwbSessionDataTemplate::Fields fields{
+            .SessionId = 4,
+            .ControleeShortMacAddress = uwb::UwbMacAddress{ std::array<uint8_t, 2>{ 0x22, 0x33 } },
+        };
+        REQUIRE_FALSE(uwbSessionDataTemplateNoAddresses.CanPatch(fields));
+        REQUIRE(uwbSessionDataTemplateNoAddresses.Generate(fields) == test::EncodeWithFields(uwbSessionDataNoAddresses, fields));
+    }
+
+    SECTION("generated data objects decode to the patched session data")
+    {
+        std::vector<uint8_t> encoded;
+        for (uint32_t sessionId = 100; sessionId < 110; sessionId++) {
+            uwbSessionDataTemplate.Generate({ .SessionId = sessionId, .SubSessionId = sessionId + 1 }, encoded);
+
+            encoding::TlvBerView tlv{};
+            std::size_t bytesParsed = 0;
+            REQUIRE(encoding::TlvBer::ParseView(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+            const auto uwbSessionDataDecoded = UwbSessionData::FromDataObject(tlv);
+            REQUIRE(uwbSessionDataDecoded.sessionId == sessionId);
+            REQUIRE(uwbSessionDataDecoded.subSessionId == sessionId + 1);
+            REQUIRE(uwbSessionDataDecoded.uwbConfiguration == uwbSessionData.uwbConfiguration);
+        }
+    }
+}
+
+TEST_CASE("UwbSessionDataTemplate performance", "[.][benchmark][protocol][fira]")
+{
+    using namespace uwb::protocol::fira;
+
+    auto uwbSessionData = test::MakeTemplateSessionData();
+    const UwbSessionDataTemplate uwbSessionDataTemplate{ uwbSessionData };
+    uint32_t sessionId = 0;
+
+    BENCHMARK("full encode")
+    {
+        uwbSessionData.sessionId = sessionId++;
+        return uwbSessionData.ToDataObject()->ToBytes();
+    };
+
+    BENCHMARK("template")
+    {
+        return uwbSessionDataTemplate.Generate({ .SessionId = sessionId++ });
+    };
+
+    std::vector<uint8_t> encoded;
+    BENCHMARK("template into existing buffer")
+    {
+        uwbSessionDataTemplate.Generate({ .SessionId = sessionId++ }, encoded);
+        return encoded.size();
+    };
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -14,6 +14,7 @@
 
 #include <notstd/utility.hxx>
 #include <plog/Log.h>
+#include <tlv/TlvSerialize.hxx>
 #include <wil/common.h>
 
 #include <uwb/UwbMacAddress.hxx>
@@ -766,25 +767,20 @@ windows::devices::uwb::ddi::lrp::From(const std::vector<UwbApplicationConfigurat
 namespace detail
 {
 /**
- * @brief Helper to process supported parameters from a given map which
- * associates a value with a bit position. If the specified bitmap contains
- * support for the value, the value is added to the result container.
+ * @brief Helper to process supported parameters from a bitmap. If the
+ * specified bitmap contains support for a value, the value is added to the
+ * result set.
  *
  * @tparam N The size of the bitset.
- * @tparam T The type of the value.
- * @param map The map associating values with bit positions in the bitset.
+ * @tparam BitIndexMapT The map associating values with bit positions in the bitset.
  * @param support The bitset defining parameter support.
- * @param result The vector to hold supported values that are present in the bitset.
+ * @param result The set to hold supported values that are present in the bitset.
  */
-template <std::size_t N, typename T>
+template <std::size_t N, const auto &BitIndexMapT>
 void
-ProcessSupportFromBitset(std::unordered_map<T, std::size_t> map, const std::bitset<N> &support, std::vector<T> &result)
+ProcessSupportFromBitset(const std::bitset<N> &support, encoding::FlagSet<BitIndexMapT> &result)
 {
-    for (const auto &[value, bit] : map) {
-        if (support.test(bit)) {
-            result.push_back(value);
-        }
-    }
+    result = result.Union(encoding::FlagSet<BitIndexMapT>::FromBits(support.to_ullong()));
 }
 } // namespace detail
 
@@ -798,13 +794,13 @@ windows::devices::uwb::ddi::lrp::To(const UWB_DEVICE_CAPABILITIES &deviceCapabil
         case UWB_CAPABILITY_PARAM_TYPE_RANGING_METHOD: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<4> rangingMethods{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::RangingMethodBit, rangingMethods, uwbCapability.RangingMethods);
+            detail::ProcessSupportFromBitset(rangingMethods, uwbCapability.RangingMethods);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_DEVICE_ROLES: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<2> deviceRoles{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::DeviceRoleBit, deviceRoles, uwbCapability.DeviceRoles);
+            detail::ProcessSupportFromBitset(deviceRoles, uwbCapability.DeviceRoles);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_PHY_VERSION_RANGE: {
@@ -832,19 +828,19 @@ windows::devices::uwb::ddi::lrp::To(const UWB_DEVICE_CAPABILITIES &deviceCapabil
         case UWB_CAPABILITY_PARAM_TYPE_SCHEDULED_MODE: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<2> schedulingModes{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::SchedulingModeBit, schedulingModes, uwbCapability.SchedulingModes);
+            detail::ProcessSupportFromBitset(schedulingModes, uwbCapability.SchedulingModes);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_RANGING_TIME_STRUCT: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<2> rangingTimeStructs{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::RangingModeBit, rangingTimeStructs, uwbCapability.RangingTimeStructs);
+            detail::ProcessSupportFromBitset(rangingTimeStructs, uwbCapability.RangingTimeStructs);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_MULTI_NODE_MODE: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<3> modes{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::MultiNodeModeBit, modes, uwbCapability.MultiNodeModes);
+            detail::ProcessSupportFromBitset(modes, uwbCapability.MultiNodeModes);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_UWB_INITIATION_TIME: {
@@ -855,19 +851,19 @@ windows::devices::uwb::ddi::lrp::To(const UWB_DEVICE_CAPABILITIES &deviceCapabil
         case UWB_CAPABILITY_PARAM_TYPE_STS_CONFIG: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<3> stsConfigurations{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::StsConfigurationBit, stsConfigurations, uwbCapability.StsConfigurations);
+            detail::ProcessSupportFromBitset(stsConfigurations, uwbCapability.StsConfigurations);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_RFRAME_CONFIG: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<4> rframeConfigurations{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::RFrameConfigurationBit, rframeConfigurations, uwbCapability.RFrameConfigurations);
+            detail::ProcessSupportFromBitset(rframeConfigurations, uwbCapability.RFrameConfigurations);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_AOA_SUPPORT: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<4> aoaTypes{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::AngleOfArrivalBit, aoaTypes, uwbCapability.AngleOfArrivalTypes);
+            detail::ProcessSupportFromBitset(aoaTypes, uwbCapability.AngleOfArrivalTypes);
             uwbCapability.AngleOfArrivalFom = aoaTypes.test(UwbCapability::AngleOfArrivalFomBit);
             break;
         }
@@ -879,25 +875,25 @@ windows::devices::uwb::ddi::lrp::To(const UWB_DEVICE_CAPABILITIES &deviceCapabil
         case UWB_CAPABILITY_PARAM_TYPE_CC_CONSTRAINT_LENGTH: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<2> convolutionalCodeConstraintLengths{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::ConvolutionalCodeConstraintLengthsBit, convolutionalCodeConstraintLengths, uwbCapability.ConvolutionalCodeConstraintLengths);
+            detail::ProcessSupportFromBitset(convolutionalCodeConstraintLengths, uwbCapability.ConvolutionalCodeConstraintLengths);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_CHANNELS: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<8> channels{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::ChannelsBit, channels, uwbCapability.Channels);
+            detail::ProcessSupportFromBitset(channels, uwbCapability.Channels);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_BPRF_PARAMETER_SETS: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<6> bprfParameterSets{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::BprfParameterSetsBit, bprfParameterSets, uwbCapability.BprfParameterSets);
+            detail::ProcessSupportFromBitset(bprfParameterSets, uwbCapability.BprfParameterSets);
             break;
         }
         case UWB_CAPABILITY_PARAM_TYPE_HPRF_PARAMETER_SETS: {
             const auto value = *reinterpret_cast<const uint8_t *>(&capability.paramValue);
             std::bitset<35> hprfParameterSets{ value };
-            detail::ProcessSupportFromBitset(UwbCapability::HprfParameterSetsBit, hprfParameterSets, uwbCapability.HprfParameterSets);
+            detail::ProcessSupportFromBitset(hprfParameterSets, uwbCapability.HprfParameterSets);
             break;
         }
         default:
@@ -3,9 +3,12 @@
 #include <format>
 #include <ios>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <utility>
 
 #include <magic_enum.hpp>
+#include <notstd/scope.hxx>
 #include <plog/Log.h>
 #include <wil/result.h>
 
@@ -23,12 +26,15 @@ UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> devic
     ::uwb::UwbSession(sessionId, std::move(device), callbacks, deviceType),
     m_uwbSessionConnector(std::move(uwbSessionConnector))
 {
+    // The handlers update the session itself, which includes its state, its
+    // applied application configuration and its peer table. They therefore
+    // stay registered (return false) for the lifetime of the session, even
+    // when no event callbacks are set.
     m_onSessionEndedCallback =
         std::make_shared<::uwb::UwbRegisteredSessionEventCallbackTypes::OnSessionEnded>([this, sessionId](::uwb::UwbSessionEndReason reason) {
             auto callbacks = ResolveEventCallbacks();
             if (callbacks == nullptr) {
-                PLOG_WARNING << std::format("session {}: missing session event callback for UwbSessionEndReason, skipping", sessionId);
-                return true;
+                PLOG_VERBOSE << std::format("session {}: missing session event callback for UwbSessionEndReason, updating session only", sessionId);
             }
 
             ::uwb::UwbSession::OnSessionEnded(callbacks, reason);
@@ -36,10 +42,14 @@ UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> devic
         });
     m_onSessionStatusChangedCallback =
         std::make_shared<::uwb::UwbRegisteredSessionEventCallbackTypes::OnSessionStatusChanged>([this, sessionId](::uwb::protocol::fira::UwbSessionState state, std::optional<::uwb::protocol::fira::UwbSessionReasonCode> reasonCode) {
+            // The UWBS discards the application configuration of a deinitialized session.
+            if (state == ::uwb::protocol::fira::UwbSessionState::Deinitialized) {
+                InvalidateOobDataTemplate();
+            }
+
             auto callbacks = ResolveEventCallbacks();
             if (callbacks == nullptr) {
-                PLOG_WARNING << std::format("session {}: missing session event callback for session status changed, skipping", sessionId);
-                return true;
+                PLOG_VERBOSE << std::format("session {}: missing session event callback for session status changed, updating session only", sessionId);
             }
 
             ::uwb::UwbSession::OnSessionStateChanged(callbacks, state, reasonCode);
@@ -49,10 +59,9 @@ UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> devic
         std::make_shared<::uwb::UwbRegisteredSessionEventCallbackTypes::OnPeerPropertiesChanged>([this, sessionId](std::vector<::uwb::UwbPeer> peersChanged) {
             auto callbacks = ResolveEventCallbacks();
             if (callbacks == nullptr) {
-                PLOG_WARNING << std::format("session {}: missing session event callback for ranging data, skipping", sessionId);
-                return true;
+                PLOG_VERBOSE << std::format("session {}: missing session event callback for ranging data, updating peer table only", sessionId);
             }
-            
+
             ::uwb::UwbSession::OnPeerPropertiesChanged(callbacks, std::move(peersChanged));
             return false;
         });
@@ -60,8 +69,7 @@ UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> devic
         std::make_shared<::uwb::UwbRegisteredSessionEventCallbackTypes::OnSessionMembershipChanged>([this, sessionId](std::vector<::uwb::UwbPeer> peersAdded, std::vector<::uwb::UwbPeer> peersRemoved) {
             auto callbacks = ResolveEventCallbacks();
             if (callbacks == nullptr) {
-                PLOG_WARNING << std::format("session {}: missing session event callback for peer list changes, skipping", sessionId);
-                return true;
+                PLOG_VERBOSE << std::format("session {}: missing session event callback for peer list changes, updating peer table only", sessionId);
             }
 
             ::uwb::UwbSession::OnSessionMembershipChanged(callbacks, std::move(peersAdded), std::move(peersRemoved));
@@ -86,6 +94,11 @@ UwbSession::ConfigureImpl(const std::vector<::uwb::protocol::fira::UwbApplicatio
 {
     UwbSessionType sessionType = UwbSessionType::RangingSession;
 
+    // The driver session and its parameters are replaced, even on partial failure.
+    auto invalidateOobDataTemplate = notstd::scope_exit([this] {
+        InvalidateOobDataTemplate();
+    });
+
     // Request a new session from the driver.
     auto sessionInitResultFuture = m_uwbSessionConnector->SessionInitialize(m_sessionId, sessionType);
     if (!sessionInitResultFuture.valid()) {
@@ -227,6 +240,10 @@ void
 UwbSession::SetApplicationConfigurationParametersImpl(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters)
 {
     uint32_t sessionId = GetId();
+    auto invalidateOobDataTemplate = notstd::scope_exit([this] {
+        InvalidateOobDataTemplate();
+    });
+
     auto resultFuture = m_uwbSessionConnector->SetApplicationConfigurationParameters(sessionId, uwbApplicationConfigurationParameters);
     try {
         auto [uwbStatus, applicationConfigurationParametersStatus] = resultFuture.get();
@@ -275,6 +292,8 @@ void
 UwbSession::DestroyImpl()
 {
     uint32_t sessionId = GetId();
+    InvalidateOobDataTemplate();
+
     auto resultFuture = m_uwbSessionConnector->SessionDeinitialize(sessionId);
     if (!resultFuture.valid()) {
         PLOG_ERROR << std::format("session {}: failed to issue device deinitialization request", sessionId);
@@ -295,11 +314,21 @@ UwbSession::DestroyImpl()
 std::vector<uint8_t>
 UwbSession::GetOobDataObjectImpl()
 {
-    auto applicationConfigurationParameters = GetApplicationConfigurationParameters(AllParameters);
-    auto uwbSessionData = GetUwbSessionData(applicationConfigurationParameters);
+    // Only query the driver when the template was invalidated by a configuration change.
+    std::scoped_lock oobDataTemplateLock{ m_oobDataTemplateGate };
+    if (!m_oobDataTemplate.has_value()) {
+        m_oobDataTemplate.emplace(GetUwbSessionData(GetApplicationConfigurationParameters(AllParameters)));
+    }
 
-    uwbSessionData.sessionId = GetId();
-    auto dataObject = uwbSessionData.ToDataObject();
+    return m_oobDataTemplate->Generate({
+        .SessionId = GetId(),
+        .SubSessionId = m_oobDataTemplate->GetSessionData().subSessionId,
+    });
+}
 
-    return dataObject->ToBytes();
+void
+UwbSession::InvalidateOobDataTemplate() noexcept
+{
+    std::scoped_lock oobDataTemplateLock{ m_oobDataTemplateGate };
+    m_oobDataTemplate.reset();
 }
@@ -4,12 +4,16 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include <uwb/UwbMacAddress.hxx>
 #include <uwb/UwbRegisteredCallbacks.hxx>
 #include <uwb/UwbSession.hxx>
 #include <uwb/UwbSessionEventCallbacks.hxx>
 #include <uwb/protocols/fira/UwbConfiguration.hxx>
+#include <uwb/protocols/fira/UwbSessionDataTemplate.hxx>
 #include <windows/devices/uwb/IUwbSessionDdi.hxx>
 
 namespace windows::devices::uwb
@@ -125,6 +129,14 @@ protected:
     std::shared_ptr<IUwbSessionDdiConnector>
     GetUwbSessionConnector() noexcept;
 
+private:
+    /**
+     * @brief Discard the OOB data object template so the next request
+     * re-reads the application configuration from the driver.
+     */
+    void
+    InvalidateOobDataTemplate() noexcept;
+
 private:
     std::shared_ptr<IUwbSessionDdiConnector> m_uwbSessionConnector;
     std::shared_ptr<::uwb::UwbRegisteredSessionEventCallbackTypes::OnSessionEnded> m_onSessionEndedCallback;
@@ -132,6 +144,10 @@ private:
     std::shared_ptr<::uwb::UwbRegisteredSessionEventCallbackTypes::OnPeerPropertiesChanged> m_onPeerPropertiesChangedCallback;
     std::shared_ptr<::uwb::UwbRegisteredSessionEventCallbackTypes::OnSessionMembershipChanged> m_onSessionMembershipChangedCallback;
     ::uwb::UwbRegisteredSessionEventCallbackTokens m_registeredCallbacksTokens;
+
+    // The OOB data object is stamped out from a template, which is invalidated whenever the application configuration is changed.
+    std::mutex m_oobDataTemplateGate;
+    std::optional<::uwb::protocol::fira::UwbSessionDataTemplate> m_oobDataTemplate;
 };
 
 } // namespace windows::devices::uwb